@@ -276,6 +276,24 @@ AutomationLine::nth (uint32_t n) const
 	}
 }
 
+/** @return the end of the model points which the selected point @param cp
+ *  stands for. If the next control point is selected as well this includes
+ *  the points between them which were thinned out of the view, so that
+ *  operations on a run of selected points also apply to those.
+ */
+AutomationList::iterator
+AutomationLine::selected_model_end (ControlPoint const & cp) const
+{
+	ControlPoint const * next = nth (cp.view_index() + 1);
+
+	if (next && next->selected()) {
+		return next->model ();
+	}
+
+	AutomationList::iterator end = cp.model ();
+	return ++end;
+}
+
 void
 AutomationLine::modify_point_y (ControlPoint& cp, double y)
 {
@@ -336,6 +354,38 @@ AutomationLine::sync_model_with_view_points (list<ControlPoint*> cp)
 	return moved;
 }
 
+/** Move the model points in [@param start, @param end) by @param dt in model
+ *  time and by @param dy as a fraction of the line height.
+ */
+void
+AutomationLine::shift_model_points (AutomationList::iterator start, AutomationList::iterator end, double dt, double dy)
+{
+	if (dt == 0 && dy == 0) {
+		return;
+	}
+
+	for (AutomationList::iterator i = start; i != end; ++i) {
+		double y = (*i)->value;
+
+		if (dy != 0) {
+			model_to_view_coord_y (y);
+			y = max (0.0, min (1.0, y + dy));
+			view_to_model_coord_y (y);
+		}
+
+		alist->modify (i, (*i)->when + dt, y);
+	}
+
+	update_pending = true;
+}
+
+/** @return the x position of a model point in canvas units */
+double
+AutomationLine::model_x (AutomationList::iterator p) const
+{
+	return trackview.editor().sample_to_pixel_unrounded (_time_converter->to ((*p)->when) - _offset);
+}
+
 string
 AutomationLine::get_verbose_cursor_string (double fraction) const
 {
@@ -549,8 +599,15 @@ AutomationLine::ContiguousControlPoints::compute_x_bounds (PublicEditor& e)
 		   contiguous range of control points
 		*/
 
-		if (front()->view_index() > 0) {
-			before_x = line.nth (front()->view_index() - 1)->get_x();
+		/* the neighbours may be model points which were thinned out
+		   of the view, so look at the model rather than at the other
+		   control points.
+		*/
+
+		AutomationList::iterator prev = front()->model();
+
+		if (prev != line.alist->begin()) {
+			before_x = line.model_x (--prev);
 
 			const framepos_t pos = e.pixel_to_sample(before_x);
 			const Meter& meter = map.meter_at_frame (pos);
@@ -565,8 +622,10 @@ AutomationLine::ContiguousControlPoints::compute_x_bounds (PublicEditor& e)
 		   we have an "after" bound
 		*/
 
-		if (back()->view_index() < (line.npoints() - 1)) {
-			after_x = line.nth (back()->view_index() + 1)->get_x();
+		AutomationList::iterator next = back()->model();
+
+		if (++next != line.alist->end()) {
+			after_x = line.model_x (next);
 
 			const framepos_t pos = e.pixel_to_sample(after_x);
 			const Meter& meter = map.meter_at_frame (pos);
@@ -754,15 +813,45 @@ AutomationLine::end_drag (bool with_push, uint32_t final_index)
 	}
 
 	alist->freeze ();
-	bool moved = sync_model_with_view_points (_drag_points);
+
+	/* model points which were thinned out of the view between two dragged
+	   points follow the earlier of them, and with push all points after
+	   the last dragged one follow it in time.
+	*/
+
+	bool moved = false;
+	double dt = 0;
+
+	for (vector<CCP>::iterator ccp = contiguous_points.begin(); ccp != contiguous_points.end(); ++ccp) {
+		for (list<ControlPoint*>::iterator i = (*ccp)->begin(); i != (*ccp)->end(); ++i) {
+
+			AutomationList::iterator model = (*i)->model();
+			double const when = (*model)->when;
+			double value = (*model)->value;
+			model_to_view_coord_y (value);
+
+			moved = sync_model_with_view_point (**i) || moved;
+
+			double new_value = (*model)->value;
+			model_to_view_coord_y (new_value);
+			dt = (*model)->when - when;
+
+			list<ControlPoint*>::iterator n = i;
+			if (++n != (*ccp)->end()) {
+				shift_model_points (++model, (*n)->model(), dt, new_value - value);
+			}
+		}
+	}
 
 	if (with_push) {
 		ControlPoint* p;
 		uint32_t i = final_index;
 		while ((p = nth (i)) != 0 && p->can_slide()) {
-			moved = sync_model_with_view_point (*p) || moved;
 			++i;
 		}
+
+		AutomationList::iterator start = contiguous_points.back()->back()->model();
+		shift_model_points (++start, p ? p->model() : alist->end(), dt, 0);
 	}
 
 	alist->thaw ();
@@ -973,10 +1062,61 @@ AutomationLine::list_changed ()
 	}
 }
 
+/** Reduce the points of a single pixel column to the first, last, lowest and
+ *  highest of them, if there are more than four. The others can neither be
+ *  seen nor grabbed at the current zoom level.
+ */
+void
+AutomationLine::thin_column (vector<ViewPoint>& column, vector<ViewPoint>& out)
+{
+	if (column.size() <= 4) {
+		out.insert (out.end(), column.begin(), column.end());
+		return;
+	}
+
+	size_t top = 0;
+	size_t bottom = 0;
+
+	for (size_t n = 1; n < column.size(); ++n) {
+		if (column[n].y < column[top].y) {
+			top = n;
+		}
+		if (column[n].y > column[bottom].y) {
+			bottom = n;
+		}
+	}
+
+	const size_t keep[4] = { 0, min (top, bottom), max (top, bottom), column.size() - 1 };
+
+	for (int k = 0; k < 4; ++k) {
+		if (k == 0 || keep[k] != keep[k - 1]) {
+			out.push_back (column[keep[k]]);
+		}
+	}
+}
+
+static ControlPoint::ShapeType
+control_point_shape (bool terminal_points_can_slide, uint32_t pi, uint32_t npoints, double tx, bool& can_slide)
+{
+	can_slide = true;
+
+	if (terminal_points_can_slide) {
+		return ControlPoint::Full;
+	}
+
+	if (pi == 0) {
+		can_slide = false;
+		return tx == 0 ? ControlPoint::Start : ControlPoint::Full;
+	} else if (pi == npoints - 1) {
+		can_slide = false;
+		return ControlPoint::End;
+	}
+	return ControlPoint::Full;
+}
+
 void
 AutomationLine::reset_callback (const Evoral::ControlList& events)
 {
-	uint32_t vp = 0;
 	uint32_t pi = 0;
 	uint32_t np;
 
@@ -985,21 +1125,20 @@ AutomationLine::reset_callback (const Evoral::ControlList& events)
 			delete *i;
 		}
 		control_points.clear ();
+		view_points.clear ();
 		line->hide();
 		return;
 	}
 
-	/* hide all existing points, and the line */
-
-	for (vector<ControlPoint*>::iterator i = control_points.begin(); i != control_points.end(); ++i) {
-		(*i)->hide();
-	}
-
-	line->hide ();
 	np = events.size();
 
 	Evoral::ControlList& e = const_cast<Evoral::ControlList&> (events);
 
+	vector<ViewPoint> column;
+	int64_t column_x = 0;
+
+	view_points.clear ();
+
 	for (AutomationList::iterator ai = e.begin(); ai != e.end(); ++ai, ++pi) {
 
 		double tx = (*ai)->when;
@@ -1031,33 +1170,93 @@ AutomationLine::reset_callback (const Evoral::ControlList& events)
 
 		ty = _height - (ty * _height);
 
-		add_visible_control_point (vp, pi, tx, ty, ai, np);
-		vp++;
+		/* thin out dense automation, one pixel column at a time */
+
+		const int64_t x = (int64_t) floor (tx);
+
+		if (!column.empty() && x != column_x) {
+			thin_column (column, view_points);
+			column.clear ();
+		}
+
+		column_x = x;
+		column.push_back (ViewPoint (tx, ty, ai, pi));
 	}
 
-	/* discard extra CP's to avoid confusing ourselves */
+	thin_column (column, view_points);
+
+	const uint32_t vp = view_points.size();
+	const uint32_t ncp = control_points.size();
+	bool can_slide;
 
-	while (control_points.size() > vp) {
-		ControlPoint* cp = control_points.back();
-		control_points.pop_back ();
-		delete cp;
+	/* find the range of points which changed. Control points before
+	 * and after it stay as they are, which avoids touching the canvas
+	 * for all of them when only a few points were edited.
+	 */
+
+	uint32_t head = 0;
+	uint32_t tail = 0;
+
+	while (head < vp && head < ncp) {
+		ControlPoint const& cp (*control_points[head]);
+		ViewPoint const& v (view_points[head]);
+		if (cp.model() != v.model || cp.get_x() != v.x || cp.get_y() != v.y ||
+		    cp.shape() != control_point_shape (terminal_points_can_slide, v.model_index, np, v.x, can_slide) ||
+		    cp.can_slide() != can_slide) {
+			break;
+		}
+		++head;
 	}
 
-	if (!terminal_points_can_slide) {
-		control_points.back()->set_can_slide(false);
+	while (tail < vp - head && tail < ncp - head) {
+		ControlPoint const& cp (*control_points[ncp - 1 - tail]);
+		ViewPoint const& v (view_points[vp - 1 - tail]);
+		if (cp.model() != v.model || cp.get_x() != v.x || cp.get_y() != v.y ||
+		    cp.shape() != control_point_shape (terminal_points_can_slide, v.model_index, np, v.x, can_slide) ||
+		    cp.can_slide() != can_slide) {
+			break;
+		}
+		++tail;
 	}
 
-	if (vp > 1) {
+	/* re-use, add or remove control points in the changed range */
 
-		/* reset the line coordinates given to the CanvasLine */
+	const uint32_t old_end = ncp - tail;
+	const uint32_t new_end = vp - tail;
 
-		while (line_points.size() < vp) {
-			line_points.push_back (ArdourCanvas::Duple (0,0));
+	if (old_end > new_end) {
+		for (uint32_t n = new_end; n < old_end; ++n) {
+			delete control_points[n];
 		}
-
-		while (line_points.size() > vp) {
-			line_points.pop_back ();
+		control_points.erase (control_points.begin() + new_end, control_points.begin() + old_end);
+	} else if (new_end > old_end) {
+		control_points.insert (control_points.begin() + old_end, new_end - old_end, (ControlPoint*) 0);
+		for (uint32_t n = old_end; n < new_end; ++n) {
+			control_points[n] = new ControlPoint (*this);
+			control_points[n]->set_size (control_point_box_size ());
 		}
+	}
+
+	for (uint32_t n = head; n < new_end; ++n) {
+		ViewPoint const& v (view_points[n]);
+		add_visible_control_point (n, v.model_index, v.x, v.y, v.model, np);
+	}
+
+	/* points after the changed range only moved within the list */
+
+	for (uint32_t n = new_end; n < vp; ++n) {
+		control_points[n]->set_view_index (n);
+	}
+
+	if (!terminal_points_can_slide && !control_points.empty()) {
+		control_points.back()->set_can_slide(false);
+	}
+
+	if (vp > 1 && (head < vp || vp != ncp || line_points.size() != vp)) {
+
+		/* reset the line coordinates given to the CanvasLine */
+
+		line_points.resize (vp);
 
 		for (uint32_t n = 0; n < vp; ++n) {
 			line_points[n].x = control_points[n]->get_x();
@@ -1065,10 +1264,10 @@ AutomationLine::reset_callback (const Evoral::ControlList& events)
 		}
 
 		line->set_steps (line_points, is_stepped());
-
-		update_visibility ();
 	}
 
+	update_visibility ();
+
 	set_selected_points (trackview.editor().get_selection().points);
 }
 
@@ -1269,8 +1468,6 @@ void
 AutomationLine::add_visible_control_point (uint32_t view_index, uint32_t pi, double tx, double ty,
                                            AutomationList::iterator model, uint32_t npoints)
 {
-	ControlPoint::ShapeType shape;
-
 	if (view_index >= control_points.size()) {
 
 		/* make sure we have enough control points */
@@ -1281,26 +1478,10 @@ AutomationLine::add_visible_control_point (uint32_t view_index, uint32_t pi, dou
 		control_points.push_back (ncp);
 	}
 
-	if (!terminal_points_can_slide) {
-		if (pi == 0) {
-			control_points[view_index]->set_can_slide (false);
-			if (tx == 0) {
-				shape = ControlPoint::Start;
-			} else {
-				shape = ControlPoint::Full;
-			}
-		} else if (pi == npoints - 1) {
-			control_points[view_index]->set_can_slide (false);
-			shape = ControlPoint::End;
-		} else {
-			control_points[view_index]->set_can_slide (true);
-			shape = ControlPoint::Full;
-		}
-	} else {
-		control_points[view_index]->set_can_slide (true);
-		shape = ControlPoint::Full;
-	}
+	bool can_slide;
+	const ControlPoint::ShapeType shape = control_point_shape (terminal_points_can_slide, pi, npoints, tx, can_slide);
 
+	control_points[view_index]->set_can_slide (can_slide);
 	control_points[view_index]->reset (tx, ty, model, view_index, shape);
 
 	/* finally, control visibility */
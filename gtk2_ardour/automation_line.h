@@ -93,6 +93,8 @@ public:
 	ControlPoint const * nth (uint32_t) const;
 	uint32_t npoints() const { return control_points.size(); }
 
+	ARDOUR::AutomationList::iterator selected_model_end (ControlPoint const &) const;
+
 	std::string  name()    const { return _name; }
 	bool    visible() const { return _visible != VisibleAspects(0); }
 	guint32 height()  const { return _height; }
@@ -186,6 +188,18 @@ protected:
 	ArdourCanvas::Points        line_points; /* coordinates for canvas line */
 	std::vector<ControlPoint*>  control_points; /* visible control points */
 
+	/** a model point in canvas coordinates */
+	struct ViewPoint {
+		ViewPoint (double x_, double y_, ARDOUR::AutomationList::iterator m, uint32_t i)
+			: x (x_), y (y_), model (m), model_index (i) {}
+		double x;
+		double y;
+		ARDOUR::AutomationList::iterator model;
+		uint32_t model_index;
+	};
+
+	std::vector<ViewPoint> view_points; /* model points left after thinning, one per control point */
+
 	class ContiguousControlPoints : public std::list<ControlPoint*> {
 public:
 		ContiguousControlPoints (AutomationLine& al);
@@ -205,6 +219,8 @@ private:
 
 	bool sync_model_with_view_point (ControlPoint&);
 	bool sync_model_with_view_points (std::list<ControlPoint*>);
+	void shift_model_points (ARDOUR::AutomationList::iterator, ARDOUR::AutomationList::iterator, double dt, double dy);
+	double model_x (ARDOUR::AutomationList::iterator) const;
 	void start_drag_common (double, float);
 
 	void reset_callback (const Evoral::ControlList&);
@@ -228,6 +244,7 @@ private:
 	void update_visibility ();
 	void reset_line_coords (ControlPoint&);
 	void add_visible_control_point (uint32_t, uint32_t, double, double, ARDOUR::AutomationList::iterator, uint32_t);
+	static void thin_column (std::vector<ViewPoint>&, std::vector<ViewPoint>&);
 	double control_point_box_size ();
 	void connect_to_list ();
 	void interpolation_changed (ARDOUR::AutomationList::InterpolationStyle);
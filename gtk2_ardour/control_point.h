@@ -58,6 +58,7 @@ class ControlPoint : public Selectable
 	void reset (double x, double y, ARDOUR::AutomationList::iterator, uint32_t, ShapeType);
 	double get_x() const { return _x; }
 	double get_y() const { return _y; }
+	ShapeType shape() const { return _shape; }
 
 	void hide ();
 	void show ();
@@ -878,6 +878,8 @@ Editor::set_horizontal_position (double p)
 	}
 
 	update_video_timeline();
+
+	HorizontalPositionChanged (); /* EMIT_SIGNAL */
 }
 
 void
@@ -4268,8 +4268,12 @@ Editor::cut_copy_points (Editing::CutCopyOp op, Evoral::Beats earliest, bool mid
 		for (PointSelection::iterator sel_point = selection->points.begin(); sel_point != selection->points.end(); ++sel_point) {
 			boost::shared_ptr<AutomationList>    al = (*sel_point)->line().the_list();
 			AutomationList::const_iterator ctrl_evt = (*sel_point)->model ();
+			AutomationList::const_iterator const ctrl_end = (*sel_point)->line().selected_model_end (**sel_point);
 
-			lists[al].copy->fast_simple_add ((*ctrl_evt)->when, (*ctrl_evt)->value);
+			/* include points hidden by thinning between this and the next selected point */
+			for (AutomationList::const_iterator e = ctrl_evt; e != ctrl_end; ++e) {
+				lists[al].copy->fast_simple_add ((*e)->when, (*e)->value);
+			}
 			if (midi) {
 				/* Update earliest MIDI start time in beats */
 				earliest = std::min(earliest, Evoral::Beats((*ctrl_evt)->when));
@@ -4320,17 +4324,19 @@ Editor::cut_copy_points (Editing::CutCopyOp op, Evoral::Beats earliest, bool mid
 			AutomationLine& line = (*sel_point)->line ();
 			boost::shared_ptr<AutomationList> al = line.the_list();
 
-			bool erase = true;
-			
+			AutomationList::iterator start = (*sel_point)->model ();
+			AutomationList::iterator const end = line.selected_model_end (**sel_point);
+
 			if (dynamic_cast<AudioRegionGainLine*> (&line)) {
 				/* removing of first and last gain point in region gain lines is prohibited*/
 				if (line.is_last_point (*(*sel_point)) || line.is_first_point (*(*sel_point))) {
-					erase = false;
+					++start;
 				}
 			}
 
-			if(erase) {
-				al->erase ((*sel_point)->model ());
+			/* also removes points hidden by thinning between this and the next selected point */
+			if (start != end) {
+				al->erase (start, end);
 			}
 		}
 
@@ -4353,8 +4359,10 @@ Editor::cut_copy_midi (CutCopyOp op)
 	for (MidiRegionSelection::iterator i = selection->midi_regions.begin(); i != selection->midi_regions.end(); ++i) {
 		MidiRegionView* mrv = dynamic_cast<MidiRegionView*>(*i);
 		if (mrv) {
-			if (!mrv->selection().empty()) {
-				earliest = std::min(earliest, (*mrv->selection().begin())->note()->time());
+			MidiRegionView::Notes selected;
+			mrv->selection_as_notelist (selected);
+			if (!selected.empty()) {
+				earliest = std::min(earliest, (*selected.begin())->time());
 			}
 			mrv->cut_copy_clear (op);
 
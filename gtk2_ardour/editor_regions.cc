@@ -79,6 +79,7 @@ EditorRegions::EditorRegions (Editor* e)
 	, ignore_selected_region_change (false)
  	, _no_redisplay (false)
 	, _sort_type ((Editing::RegionListSortType) 0)
+	, _generation (1)
 	, expanded (false)
 {
 	_display.set_size_request (100, -1);
@@ -258,6 +259,7 @@ EditorRegions::EditorRegions (Editor* e)
 
 	_display.signal_enter_notify_event().connect (sigc::mem_fun (*this, &EditorRegions::enter_notify), false);
 	_display.signal_leave_notify_event().connect (sigc::mem_fun (*this, &EditorRegions::leave_notify), false);
+	_display.signal_expose_event().connect (sigc::mem_fun (*this, &EditorRegions::display_exposed), false);
 
 	// _display.signal_popup_menu().connect (sigc::bind (sigc::mem_fun (*this, &Editor::show__display_context_menu), 1, 0));
 
@@ -270,6 +272,12 @@ EditorRegions::EditorRegions (Editor* e)
 	e->EditorThaw.connect (editor_thaw_connection, MISSING_INVALIDATOR, boost::bind (&EditorRegions::thaw_tree_model, this), gui_context());
 }
 
+EditorRegions::~EditorRegions ()
+{
+	_idle_update_connection.disconnect ();
+	_populate_connection.disconnect ();
+}
+
 bool
 EditorRegions::focus_in (GdkEventFocus*)
 {
@@ -440,7 +448,10 @@ EditorRegions::add_region (boost::shared_ptr<Region> region)
 			}
 		}
 
-		region_row_map.insert(pair<boost::shared_ptr<ARDOUR::Region>, Gtk::TreeModel::RowReference>(region, TreeRowReference(_model, TreePath (row))) );
+		/* whole file rows never show more than this */
+		row[_columns.generation] = _generation;
+
+		region_row_map.insert(pair<PBD::ID, Gtk::TreeModel::RowReference>(region->id(), TreeRowReference(_model, TreePath (row))) );
 		parent_regions_sources_map.insert(pair<string, Gtk::TreeModel::RowReference>(region->source_string(), TreeRowReference(_model, TreePath (row))) );
 
 		return;
@@ -482,9 +493,13 @@ EditorRegions::add_region (boost::shared_ptr<Region> region)
 
 	row[_columns.region] = region;
 
-	region_row_map.insert(pair<boost::shared_ptr<ARDOUR::Region>, Gtk::TreeModel::RowReference>(region, TreeRowReference(_model, TreePath (row))) );
-	PropertyChange pc;
-	populate_row(region, (*row), pc);
+	/* the name is needed for sorting, everything else is filled in
+	 * once the row is scrolled into view.
+	 */
+	populate_row_name (region, row);
+	row[_columns.generation] = 0;
+
+	region_row_map.insert(pair<PBD::ID, Gtk::TreeModel::RowReference>(region->id(), TreeRowReference(_model, TreePath (row))) );
 }
 
 void
@@ -530,48 +545,116 @@ EditorRegions::region_changed (boost::shared_ptr<Region> r, const PropertyChange
 	our_interests.add (ARDOUR::Properties::fade_out);
 	our_interests.add (ARDOUR::Properties::fade_in_active);
 	our_interests.add (ARDOUR::Properties::fade_out_active);
+	our_interests.add (ARDOUR::Properties::hidden);
 
-	if (what_changed.contains (our_interests)) {
-		if (last_row != 0) {
+	if (!what_changed.contains (our_interests)) {
+		return;
+	}
 
-			TreeModel::iterator j = _model->get_iter (last_row.get_path());
-			boost::shared_ptr<Region> c = (*j)[_columns.region];
+	/* operations on a large selection change many regions at once,
+	 * collect the changes and update the affected rows when idle.
+	 */
+	_pending_changes[r->id()].add (what_changed);
 
-			if (c == r) {
-				populate_row (r, (*j), what_changed);
+	if (!_idle_update_connection.connected ()) {
+		_idle_update_connection = Glib::signal_idle().connect (sigc::mem_fun (*this, &EditorRegions::idle_update_rows));
+	}
+}
 
-				if (what_changed.contains (ARDOUR::Properties::hidden)) {
-					redisplay ();
-				}
+bool
+EditorRegions::idle_update_rows ()
+{
+	PendingChanges pending;
+	pending.swap (_pending_changes);
 
-				return;
-			}
+	for (PendingChanges::const_iterator i = pending.begin(); i != pending.end(); ++i) {
+
+		boost::shared_ptr<Region> r = RegionFactory::region_by_id (i->first);
+
+		if (!r) {
+			continue;
 		}
 
-		RegionRowMap::iterator it;
+		if (i->second.contains (ARDOUR::Properties::hidden)) {
+			if (_no_redisplay) {
+				/* resume_redisplay() will take care of it */
+				continue;
+			}
+			if (!move_row (r)) {
+				redisplay ();
+				break;
+			}
+			continue;
+		}
 
-		it = region_row_map.find (r);
+		RegionRowMap::iterator it = region_row_map.find (i->first);
 
-		if (it != region_row_map.end()){
+		if (it == region_row_map.end()) {
+			continue;
+		}
 
-			TreeModel::iterator j = _model->get_iter ((*it).second.get_path());
-			boost::shared_ptr<Region> c = (*j)[_columns.region];
+		TreeModel::iterator j = _model->get_iter ((*it).second.get_path());
 
-			if (c == r) {
-				populate_row (r, (*j), what_changed);
+		if (!j) {
+			continue;
+		}
 
-				if (what_changed.contains (ARDOUR::Properties::hidden)) {
-					redisplay ();
-				}
+		uint32_t const generation = (*j)[_columns.generation];
 
-				return;
+		if (generation != _generation) {
+			/* not populated, yet: it will be when it becomes visible.
+			   The name is shown (and searched and sorted by) from the
+			   start, though, so keep it up to date.
+			*/
+			if (i->second.contains (ARDOUR::Properties::name)) {
+				populate_row_name (r, (*j));
 			}
+			continue;
 		}
+
+		populate_row (r, (*j), i->second);
 	}
 
-	if (what_changed.contains (ARDOUR::Properties::hidden)) {
-		redisplay ();
+	return false;
+}
+
+/** Move the row of a region whose hidden state changed, without
+ *  rebuilding the list.
+ *  @return false if the list has to be redisplayed instead.
+ */
+bool
+EditorRegions::move_row (boost::shared_ptr<Region> region)
+{
+	if (region->whole_file()) {
+		/* the row is the parent of the other regions of the source */
+		return false;
+	}
+
+	RegionRowMap::iterator it = region_row_map.find (region->id());
+
+	if (it != region_row_map.end()) {
+
+		TreeModel::iterator j = _model->get_iter ((*it).second.get_path());
+
+		if (j) {
+			TreeModel::iterator parent = (*j).parent();
+
+			_model->erase (j);
+
+			if (parent) {
+				boost::shared_ptr<Region> pr = (*parent)[_columns.region];
+				if (!pr && (*parent).children().empty()) {
+					/* the last of the hidden regions */
+					_model->erase (parent);
+				}
+			}
+		}
+
+		region_row_map.erase (it);
 	}
+
+	add_region (region);
+	return true;
 }
 
 void
@@ -621,11 +704,9 @@ EditorRegions::set_selected (RegionSelection& regions)
 {
 	for (RegionSelection::iterator i = regions.begin(); i != regions.end(); ++i) {
 
-		boost::shared_ptr<Region> r ((*i)->region());
-
 		RegionRowMap::iterator it;
 
-		it = region_row_map.find (r);
+		it = region_row_map.find ((*i)->region()->id());
 
 		if (it != region_row_map.end()){
 			TreeModel::iterator j = _model->get_iter ((*it).second.get_path());
@@ -655,6 +736,7 @@ EditorRegions::redisplay ()
 
 	region_row_map.clear();
 	parent_regions_sources_map.clear();
+	_pending_changes.clear ();
 
 	/* now add everything we have, via a temporary list used to help with sorting */
 
@@ -694,12 +776,13 @@ EditorRegions::update_row (boost::shared_ptr<Region> region)
 
 	RegionRowMap::iterator it;
 
-	it = region_row_map.find (region);
+	it = region_row_map.find (region->id());
 
 	if (it != region_row_map.end()){
 		PropertyChange c;
 		TreeModel::iterator j = _model->get_iter ((*it).second.get_path());
 		populate_row(region, (*j), c);
+		(*j)[_columns.generation] = _generation;
 	}
 }
 
@@ -710,19 +793,72 @@ EditorRegions::update_all_rows ()
 		return;
 	}
 
-	RegionRowMap::iterator i;
+	/* invalidate all rows, the visible ones are populated again when
+	 * the list is redrawn.
+	 */
+	if (++_generation == 0) {
+		_generation = 1;
+	}
+
+	_display.queue_draw ();
+}
+
+bool
+EditorRegions::display_exposed (GdkEventExpose*)
+{
+	if (!_populate_connection.connected ()) {
+		_populate_connection = Glib::signal_idle().connect (sigc::mem_fun (*this, &EditorRegions::populate_visible_rows));
+	}
+	return false;
+}
+
+/** Populate all rows which are currently visible in the list and
+ *  have not been populated since they were added or invalidated.
+ */
+bool
+EditorRegions::populate_visible_rows ()
+{
+	TreeModel::Path path;
+	TreeModel::Path end;
 
-	for (i = region_row_map.begin(); i != region_row_map.end(); ++i) {
+	if (!_session || !_display.get_model() || !_display.get_visible_range (path, end)) {
+		return false;
+	}
+
+	while (!(end < path)) {
+
+		TreeModel::iterator i = _model->get_iter (path);
+
+		if (!i) {
+			/* past the last child, continue after the parent */
+			if (!path.up () || path.empty ()) {
+				break;
+			}
+			path.next ();
+			continue;
+		}
 
-		TreeModel::iterator j = _model->get_iter ((*i).second.get_path());
+		boost::shared_ptr<Region> region = (*i)[_columns.region];
+		uint32_t const generation = (*i)[_columns.generation];
 
-		boost::shared_ptr<Region> region = (*j)[_columns.region];
+		if (region && generation != _generation) {
+			/* whole file and automatic rows were not populated
+			 * again when the clock mode changed
+			 */
+			if (generation == 0 || !region->automatic()) {
+				populate_row (region, (*i), PropertyChange ());
+			}
+			(*i)[_columns.generation] = _generation;
+		}
 
-		if (!region->automatic()) {
-			PropertyChange c;
-			populate_row(region, (*j), c);
+		if (!(*i).children().empty() && _display.row_expanded (path)) {
+			path.down ();
+		} else {
+			path.next ();
 		}
 	}
+
+	return false;
 }
 
 void
@@ -1022,10 +1158,19 @@ EditorRegions::populate_row_opaque (boost::shared_ptr<Region> region, TreeModel:
 void
 EditorRegions::populate_row_name (boost::shared_ptr<Region> region, TreeModel::Row const &row)
 {
+	string name;
+
 	if (region->n_channels() > 1) {
-		row[_columns.name] = string_compose("%1  [%2]", Gtkmm2ext::markup_escape_text (region->name()), region->n_channels());
+		name = string_compose("%1  [%2]", Gtkmm2ext::markup_escape_text (region->name()), region->n_channels());
 	} else {
-		row[_columns.name] = Gtkmm2ext::markup_escape_text (region->name());
+		name = Gtkmm2ext::markup_escape_text (region->name());
+	}
+
+	/* the name is the sort column: setting it re-sorts the row */
+	string const old_name = row[_columns.name];
+
+	if (name != old_name) {
+		row[_columns.name] = name;
 	}
 }
 
@@ -1430,6 +1575,7 @@ EditorRegions::clear ()
 	/* Clean up the maps */
 	region_row_map.clear();
 	parent_regions_sources_map.clear();
+	_pending_changes.clear ();
 }
 
 boost::shared_ptr<Region>
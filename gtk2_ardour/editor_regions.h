@@ -19,13 +19,18 @@
 #ifndef __gtk_ardour_editor_regions_h__
 #define __gtk_ardour_editor_regions_h__
 
-#include "editor_component.h"
+#include <map>
 #include <boost/unordered_map.hpp>
 
+#include "pbd/id.h"
+
+#include "editor_component.h"
+
 class EditorRegions : public EditorComponent, public ARDOUR::SessionHandlePtr
 {
 public:
 	EditorRegions (Editor *);
+	~EditorRegions ();
 
 	void set_session (ARDOUR::Session *);
 
@@ -93,6 +98,7 @@ private:
 			add (used);
 			add (path);
 			add (property_toggles_visible);
+			add (generation);
 		}
 
 		Gtk::TreeModelColumn<std::string> name;
@@ -112,15 +118,17 @@ private:
 		Gtk::TreeModelColumn<std::string> path;
 		/** used to indicate whether the locked/glued/muted/opaque should be visible or not */
 		Gtk::TreeModelColumn<bool> property_toggles_visible;
+		/** value of _generation when the row was last populated, 0 if it never was */
+		Gtk::TreeModelColumn<uint32_t> generation;
 	};
 
 	Columns _columns;
 
-	Gtk::TreeModel::RowReference last_row;
-
 	void freeze_tree_model ();
 	void thaw_tree_model ();
 	void region_changed (boost::shared_ptr<ARDOUR::Region>, PBD::PropertyChange const &);
+	bool idle_update_rows ();
+	bool move_row (boost::shared_ptr<ARDOUR::Region>);
 	void selection_changed ();
 
 	sigc::connection _change_connection;
@@ -171,6 +179,9 @@ private:
 	void update_row (boost::shared_ptr<ARDOUR::Region>);
 	void update_all_rows ();
 
+	bool display_exposed (GdkEventExpose*);
+	bool populate_visible_rows ();
+
 	void insert_into_tmp_regionlist (boost::shared_ptr<ARDOUR::Region>);
 
 	void drag_data_received (
@@ -203,12 +214,24 @@ private:
 
 	std::list<boost::shared_ptr<ARDOUR::Region> > tmp_region_list;
 
-	typedef boost::unordered_map<boost::shared_ptr<ARDOUR::Region>, Gtk::TreeModel::RowReference> RegionRowMap;
+	typedef std::map<PBD::ID, Gtk::TreeModel::RowReference> RegionRowMap;
 	typedef boost::unordered_map<std::string, Gtk::TreeModel::RowReference > RegionSourceMap;
 
 	RegionRowMap region_row_map;
 	RegionSourceMap parent_regions_sources_map;
 
+	/** property changes which have not been shown yet, by region ID */
+	typedef std::map<PBD::ID, PBD::PropertyChange> PendingChanges;
+	PendingChanges _pending_changes;
+
+	/** rows are only populated once they are visible, rows whose
+	 *  generation differs from this one have to be populated again.
+	 */
+	uint32_t _generation;
+
+	sigc::connection _idle_update_connection;
+	sigc::connection _populate_connection;
+
 	PBD::ScopedConnection region_property_connection;
 	PBD::ScopedConnection check_new_region_connection;
 
@@ -83,6 +83,7 @@ EditorRoutes::EditorRoutes (Editor* e)
 	, _redisplay_on_resume (false)
 	, _redisplay_active (0)
 	, _queue_tv_update (0)
+	, _update_all_rows (false)
 	, _menu (0)
 	, old_focus (0)
 	, selection_countdown (0)
@@ -789,6 +790,8 @@ EditorRoutes::time_axis_views_added (list<TimeAxisView*> tavs)
 		row[_columns.solo_safe_state] = RouteUI::solo_safe_active_state (stripable);
 		row[_columns.name_editable] = true;
 
+		_stripable_rows[stripable->id()] = TreeModel::RowReference (_model, _model->get_path (row));
+
 		boost::weak_ptr<Stripable> ws (stripable);
 
 		/* for now, we need both of these. PropertyChanged covers on
@@ -804,13 +807,13 @@ EditorRoutes::time_axis_views_added (list<TimeAxisView*> tavs)
 
 		if (boost::dynamic_pointer_cast<Track> (stripable)) {
 			boost::shared_ptr<Track> t = boost::dynamic_pointer_cast<Track> (stripable);
-			t->rec_enable_control()->Changed.connect (*this, MISSING_INVALIDATOR, boost::bind (&EditorRoutes::update_rec_display, this), gui_context());
-			t->rec_safe_control()->Changed.connect (*this, MISSING_INVALIDATOR, boost::bind (&EditorRoutes::update_rec_display, this), gui_context());
+			t->rec_enable_control()->Changed.connect (*this, MISSING_INVALIDATOR, boost::bind (&EditorRoutes::update_row_display, this, ws), gui_context());
+			t->rec_safe_control()->Changed.connect (*this, MISSING_INVALIDATOR, boost::bind (&EditorRoutes::update_row_display, this, ws), gui_context());
 		}
 
 		if (midi_trk) {
-			midi_trk->StepEditStatusChange.connect (*this, MISSING_INVALIDATOR, boost::bind (&EditorRoutes::update_rec_display, this), gui_context());
-			midi_trk->InputActiveChanged.connect (*this, MISSING_INVALIDATOR, boost::bind (&EditorRoutes::update_input_active_display, this), gui_context());
+			midi_trk->StepEditStatusChange.connect (*this, MISSING_INVALIDATOR, boost::bind (&EditorRoutes::update_row_display, this, ws), gui_context());
+			midi_trk->InputActiveChanged.connect (*this, MISSING_INVALIDATOR, boost::bind (&EditorRoutes::update_input_active_row, this, ws), gui_context());
 		}
 
 		boost::shared_ptr<AutomationControl> ac;
@@ -825,11 +828,12 @@ EditorRoutes::time_axis_views_added (list<TimeAxisView*> tavs)
 			ac->Changed.connect (*this, MISSING_INVALIDATOR, boost::bind (&EditorRoutes::update_solo_isolate_display, this), gui_context());
 		}
 		if ((ac = stripable->solo_safe_control()) != 0) {
-			ac->Changed.connect (*this, MISSING_INVALIDATOR, boost::bind (&EditorRoutes::update_solo_safe_display, this), gui_context());
+			/* solo safe only affects the stripable itself, unlike solo and solo isolate */
+			ac->Changed.connect (*this, MISSING_INVALIDATOR, boost::bind (&EditorRoutes::update_row_display, this, ws), gui_context());
 		}
 
 		if (rtav) {
-			rtav->route()->active_changed.connect (*this, MISSING_INVALIDATOR, boost::bind (&EditorRoutes::update_active_display, this), gui_context ());
+			rtav->route()->active_changed.connect (*this, MISSING_INVALIDATOR, boost::bind (&EditorRoutes::update_row_display, this, ws), gui_context ());
 		}
 	}
 
@@ -881,6 +885,10 @@ EditorRoutes::route_removed (TimeAxisView *tv)
 
 	for (ri = rows.begin(); ri != rows.end(); ++ri) {
 		if ((*ri)[_columns.tv] == tv) {
+			boost::shared_ptr<Stripable> stripable = (*ri)[_columns.stripable];
+			if (stripable) {
+				_stripable_rows.erase (stripable->id());
+			}
 			PBD::Unwinder<bool> uw (_route_deletion_in_progress, true);
 			_model->erase (ri);
 			break;
@@ -909,38 +917,61 @@ EditorRoutes::route_property_changed (const PropertyChange& what_changed, boost:
 		return;
 	}
 
-	TreeModel::Children rows = _model->children();
-	TreeModel::Children::iterator i;
+	TreeModel::iterator i = find_row (stripable->id());
 
-	for (i = rows.begin(); i != rows.end(); ++i) {
+	if (!i) {
+		return;
+	}
 
-		boost::shared_ptr<Stripable> ss = (*i)[_columns.stripable];
+	if (what_changed.contains (ARDOUR::Properties::name)) {
+		(*i)[_columns.text] = stripable->name();
+		return;
+	}
 
-		if (ss == stripable) {
+	if (what_changed.contains (ARDOUR::Properties::hidden)) {
+		(*i)[_columns.visible] = !stripable->presentation_info().hidden();
+		cerr << stripable->name() << " visibility changed, redisplay\n";
+		redisplay ();
+	}
+}
 
-			if (what_changed.contains (ARDOUR::Properties::name)) {
-				(*i)[_columns.text] = stripable->name();
-				break;
+/** @return the row of the stripable with the given ID, or an invalid iterator */
+TreeModel::iterator
+EditorRoutes::find_row (PBD::ID const & id)
+{
+	StripableRowMap::iterator m = _stripable_rows.find (id);
+
+	if (m != _stripable_rows.end() && m->second.is_valid ()) {
+		TreeModel::iterator i = _model->get_iter (m->second.get_path());
+		if (i) {
+			boost::shared_ptr<Stripable> stripable = (*i)[_columns.stripable];
+			if (stripable && stripable->id() == id) {
+				return i;
 			}
+		}
+	}
 
-			if (what_changed.contains (ARDOUR::Properties::hidden)) {
-				(*i)[_columns.visible] = !stripable->presentation_info().hidden();
-				cerr << stripable->name() << " visibility changed, redisplay\n";
-				redisplay ();
+	/* not cached, or the row was moved by drag and drop */
 
-			}
+	TreeModel::Children rows = _model->children();
 
-			break;
+	for (TreeModel::Children::iterator i = rows.begin(); i != rows.end(); ++i) {
+		boost::shared_ptr<Stripable> stripable = (*i)[_columns.stripable];
+		if (stripable && stripable->id() == id) {
+			_stripable_rows[id] = TreeModel::RowReference (_model, _model->get_path (i));
+			return i;
 		}
 	}
+
+	_stripable_rows.erase (id);
+	return TreeModel::iterator ();
 }
 
 void
 EditorRoutes::update_active_display ()
 {
-	if (g_atomic_int_compare_and_exchange (const_cast<gint*>(&_queue_tv_update), 0, 1)) {
-		Glib::signal_idle().connect (sigc::mem_fun (*this, &EditorRoutes::idle_update_mute_rec_solo_etc));
-	}
+	_update_all_rows = true;
+	queue_idle_update ();
 }
 
 void
@@ -1467,6 +1498,7 @@ EditorRoutes::initial_display ()
 {
 	DisplaySuspender ds;
 	_model->clear ();
+	_stripable_rows.clear ();
 
 	if (!_session) {
 		return;
@@ -1652,8 +1684,45 @@ EditorRoutes::update_input_active_display ()
 	}
 }
 
+void
+EditorRoutes::update_input_active_row (boost::weak_ptr<Stripable> ws)
+{
+	boost::shared_ptr<MidiTrack> mt = boost::dynamic_pointer_cast<MidiTrack> (ws.lock ());
+
+	if (!mt) {
+		return;
+	}
+
+	TreeModel::iterator i = find_row (mt->id());
+
+	if (i) {
+		(*i)[_columns.is_input_active] = mt->input_active();
+	}
+}
+
 void
 EditorRoutes::update_rec_display ()
+{
+	_update_all_rows = true;
+	queue_idle_update ();
+}
+
+/** update the row of a single stripable when idle */
+void
+EditorRoutes::update_row_display (boost::weak_ptr<Stripable> ws)
+{
+	boost::shared_ptr<Stripable> stripable = ws.lock ();
+
+	if (!stripable) {
+		return;
+	}
+
+	_pending_row_updates.insert (stripable->id());
+	queue_idle_update ();
+}
+
+void
+EditorRoutes::queue_idle_update ()
 {
 	if (g_atomic_int_compare_and_exchange (const_cast<gint*>(&_queue_tv_update), 0, 1)) {
 		Glib::signal_idle().connect (sigc::mem_fun (*this, &EditorRoutes::idle_update_mute_rec_solo_etc));
@@ -1664,78 +1733,93 @@ bool
 EditorRoutes::idle_update_mute_rec_solo_etc()
 {
 	g_atomic_int_set (const_cast<gint*>(&_queue_tv_update), 0);
-	TreeModel::Children rows = _model->children();
-	TreeModel::Children::iterator i;
 
-	for (i = rows.begin(); i != rows.end(); ++i) {
-		boost::shared_ptr<Stripable> stripable = (*i)[_columns.stripable];
-		boost::shared_ptr<Route> route = boost::dynamic_pointer_cast<Route> (stripable);
-		(*i)[_columns.mute_state] = RouteUI::mute_active_state (_session, stripable);
-		(*i)[_columns.solo_state] = RouteUI::solo_active_state (stripable);
-		(*i)[_columns.solo_isolate_state] = RouteUI::solo_isolate_active_state (stripable) ? 1 : 0;
-		(*i)[_columns.solo_safe_state] = RouteUI::solo_safe_active_state (stripable) ? 1 : 0;
-		if (route) {
-			(*i)[_columns.active] = route->active ();
-		} else {
-			(*i)[_columns.active] = true;
+	if (_update_all_rows) {
+		TreeModel::Children rows = _model->children();
+		TreeModel::Children::iterator i;
+
+		for (i = rows.begin(); i != rows.end(); ++i) {
+			update_row_state (*i);
 		}
+	} else {
+		for (std::set<PBD::ID>::const_iterator id = _pending_row_updates.begin(); id != _pending_row_updates.end(); ++id) {
+			TreeModel::iterator i = find_row (*id);
+			if (i) {
+				update_row_state (*i);
+			}
+		}
+	}
 
-		boost::shared_ptr<Track> trk (boost::dynamic_pointer_cast<Track>(route));
+	_update_all_rows = false;
+	_pending_row_updates.clear ();
 
-		if (trk) {
-			boost::shared_ptr<MidiTrack> mt = boost::dynamic_pointer_cast<MidiTrack> (route);
+	return false; // do not call again (until needed)
+}
 
-			if (trk->rec_enable_control()->get_value()) {
-				if (_session->record_status() == Session::Recording) {
-					(*i)[_columns.rec_state] = 1;
-				} else {
-					(*i)[_columns.rec_state] = 2;
-				}
-			} else if (mt && mt->step_editing()) {
-				(*i)[_columns.rec_state] = 3;
+void
+EditorRoutes::update_row_state (TreeModel::Row const & row)
+{
+	boost::shared_ptr<Stripable> stripable = row[_columns.stripable];
+	boost::shared_ptr<Route> route = boost::dynamic_pointer_cast<Route> (stripable);
+	row[_columns.mute_state] = RouteUI::mute_active_state (_session, stripable);
+	row[_columns.solo_state] = RouteUI::solo_active_state (stripable);
+	row[_columns.solo_isolate_state] = RouteUI::solo_isolate_active_state (stripable) ? 1 : 0;
+	row[_columns.solo_safe_state] = RouteUI::solo_safe_active_state (stripable) ? 1 : 0;
+	if (route) {
+		row[_columns.active] = route->active ();
+	} else {
+		row[_columns.active] = true;
+	}
+
+	boost::shared_ptr<Track> trk (boost::dynamic_pointer_cast<Track>(route));
+
+	if (trk) {
+		boost::shared_ptr<MidiTrack> mt = boost::dynamic_pointer_cast<MidiTrack> (route);
+
+		if (trk->rec_enable_control()->get_value()) {
+			if (_session->record_status() == Session::Recording) {
+				row[_columns.rec_state] = 1;
 			} else {
-				(*i)[_columns.rec_state] = 0;
+				row[_columns.rec_state] = 2;
 			}
-
-			(*i)[_columns.rec_safe] = trk->rec_safe_control()->get_value();
-			(*i)[_columns.name_editable] = !trk->rec_enable_control()->get_value();
+		} else if (mt && mt->step_editing()) {
+			row[_columns.rec_state] = 3;
+		} else {
+			row[_columns.rec_state] = 0;
 		}
-	}
 
-	return false; // do not call again (until needed)
+		row[_columns.rec_safe] = trk->rec_safe_control()->get_value();
+		row[_columns.name_editable] = !trk->rec_enable_control()->get_value();
+	}
 }
 
 
 void
 EditorRoutes::update_mute_display ()
 {
-	if (g_atomic_int_compare_and_exchange (const_cast<gint*>(&_queue_tv_update), 0, 1)) {
-		Glib::signal_idle().connect (sigc::mem_fun (*this, &EditorRoutes::idle_update_mute_rec_solo_etc));
-	}
+	_update_all_rows = true;
+	queue_idle_update ();
 }
 
 void
 EditorRoutes::update_solo_display ()
 {
-	if (g_atomic_int_compare_and_exchange (const_cast<gint*>(&_queue_tv_update), 0, 1)) {
-		Glib::signal_idle().connect (sigc::mem_fun (*this, &EditorRoutes::idle_update_mute_rec_solo_etc));
-	}
+	_update_all_rows = true;
+	queue_idle_update ();
 }
 
 void
 EditorRoutes::update_solo_isolate_display ()
 {
-	if (g_atomic_int_compare_and_exchange (const_cast<gint*>(&_queue_tv_update), 0, 1)) {
-		Glib::signal_idle().connect (sigc::mem_fun (*this, &EditorRoutes::idle_update_mute_rec_solo_etc));
-	}
+	_update_all_rows = true;
+	queue_idle_update ();
 }
 
 void
 EditorRoutes::update_solo_safe_display ()
 {
-	if (g_atomic_int_compare_and_exchange (const_cast<gint*>(&_queue_tv_update), 0, 1)) {
-		Glib::signal_idle().connect (sigc::mem_fun (*this, &EditorRoutes::idle_update_mute_rec_solo_etc));
-	}
+	_update_all_rows = true;
+	queue_idle_update ();
 }
 
 list<TimeAxisView*>
@@ -1754,6 +1838,7 @@ EditorRoutes::clear ()
 {
 	_display.set_model (Glib::RefPtr<Gtk::TreeStore> (0));
 	_model->clear ();
+	_stripable_rows.clear ();
 	_display.set_model (_model);
 }
 
@@ -20,6 +20,10 @@
 #ifndef __ardour_gtk_editor_route_h__
 #define __ardour_gtk_editor_route_h__
 
+#include <map>
+#include <set>
+
+#include "pbd/id.h"
 #include "pbd/signals.h"
 #include "gtkmm2ext/widget_state.h"
 
@@ -87,12 +91,16 @@ private:
 	void route_property_changed (const PBD::PropertyChange&, boost::weak_ptr<ARDOUR::Stripable>);
 	void handle_gui_changes (std::string const &, void *);
 	bool idle_update_mute_rec_solo_etc ();
+	void queue_idle_update ();
+	void update_row_display (boost::weak_ptr<ARDOUR::Stripable>);
+	void update_row_state (Gtk::TreeModel::Row const &);
 	void update_rec_display ();
 	void update_mute_display ();
 	void update_solo_display ();
 	void update_solo_isolate_display ();
 	void update_solo_safe_display ();
 	void update_input_active_display ();
+	void update_input_active_row (boost::weak_ptr<ARDOUR::Stripable>);
 	void update_active_display ();
 	void set_all_tracks_visibility (bool);
 	void set_all_audio_midi_visibility (int, bool);
@@ -172,6 +180,18 @@ private:
 	volatile gint _redisplay_active;
 	volatile gint _queue_tv_update;
 
+	/** rows to update when idle, unless all of them have to be */
+	std::set<PBD::ID> _pending_row_updates;
+	bool _update_all_rows;
+
+	/** cached rows, by stripable ID; drag and drop re-inserts rows, so
+	 *  a cached row may have become invalid.
+	 */
+	typedef std::map<PBD::ID, Gtk::TreeModel::RowReference> StripableRowMap;
+	StripableRowMap _stripable_rows;
+
+	Gtk::TreeModel::iterator find_row (PBD::ID const &);
+
 	Gtk::Menu* _menu;
 	Gtk::Widget* old_focus;
 	uint32_t selection_countdown;
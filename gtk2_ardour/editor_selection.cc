@@ -22,6 +22,7 @@
 
 #include "pbd/stacktrace.h"
 
+#include "ardour/analyser.h"
 #include "ardour/midi_region.h"
 #include "ardour/playlist.h"
 #include "ardour/profile.h"
@@ -1402,6 +1403,14 @@ Editor::region_selection_changed ()
 		}
 	}
 
+	/* have pending transient analysis of the selected regions done first */
+
+	for (RegionSelection::iterator r = selection->regions.begin(); r != selection->regions.end(); ++r) {
+		SourceList const & sources ((*r)->region()->sources());
+		for (SourceList::const_iterator s = sources.begin(); s != sources.end(); ++s) {
+			Analyser::prioritize (*s);
+		}
+	}
 }
 
 void
@@ -302,8 +302,6 @@ Editor::do_timefx ()
 	boost::shared_ptr<Region>   new_region;
 	set<boost::shared_ptr<Playlist> > playlists_affected;
 
-	uint32_t const N = current_timefx->regions.size ();
-
 	for (RegionList::iterator i = current_timefx->regions.begin(); i != current_timefx->regions.end(); ++i) {
 		boost::shared_ptr<Playlist> playlist = (*i)->playlist();
 
@@ -312,6 +310,56 @@ Editor::do_timefx ()
 		}
 	}
 
+	int rv = 0;
+
+#ifdef USE_RUBBERBAND
+	/* stretch all regions at once, using all CPUs */
+
+	std::vector<RBEffect*> fx;
+	std::vector<boost::shared_ptr<Region> > regions;
+
+	for (RegionList::iterator i = current_timefx->regions.begin(); i != current_timefx->regions.end(); ++i) {
+
+		boost::shared_ptr<AudioRegion> region = boost::dynamic_pointer_cast<AudioRegion> (*i);
+
+		if (!region || !region->playlist()) {
+			continue;
+		}
+
+		if (current_timefx->pitching) {
+			fx.push_back (new Pitch (*_session, current_timefx->request));
+		} else {
+			fx.push_back (new RBStretch (*_session, current_timefx->request));
+		}
+		regions.push_back (region);
+	}
+
+	rv = RBEffect::run (fx, regions, current_timefx);
+
+	/* if any region failed, none has been processed, and the caller
+	   will abort the command; leave all playlists alone.
+	*/
+	if (rv == 0 && !current_timefx->request.cancel) {
+		for (size_t n = 0; n < fx.size(); ++n) {
+			if (!fx[n]->results.empty()) {
+				playlist = regions[n]->playlist();
+				playlist->replace_region (regions[n], fx[n]->results.front(), regions[n]->position());
+				playlists_affected.insert (playlist);
+			}
+		}
+	}
+
+	for (std::vector<RBEffect*>::iterator f = fx.begin(); f != fx.end(); ++f) {
+		delete *f;
+	}
+
+	if (current_timefx->request.cancel) {
+		current_timefx->status = 1;
+		return;
+	}
+#else
+	uint32_t const N = current_timefx->regions.size ();
+
 	for (RegionList::iterator i = current_timefx->regions.begin(); i != current_timefx->regions.end(); ++i) {
 
 		boost::shared_ptr<AudioRegion> region = boost::dynamic_pointer_cast<AudioRegion> (*i);
@@ -332,11 +380,7 @@ Editor::do_timefx ()
 		if (current_timefx->pitching) {
 			fx = new Pitch (*_session, current_timefx->request);
 		} else {
-#ifdef USE_RUBBERBAND
-			fx = new RBStretch (*_session, current_timefx->request);
-#else
 			fx = new STStretch (*_session, current_timefx->request);
-#endif
 		}
 
 		current_timefx->descend (1.0 / N);
@@ -358,12 +402,13 @@ Editor::do_timefx ()
 		current_timefx->ascend ();
 		delete fx;
 	}
+#endif
 
 	for (set<boost::shared_ptr<Playlist> >::iterator p = playlists_affected.begin(); p != playlists_affected.end(); ++p) {
 		_session->add_command (new StatefulDiffCommand (*p));
 	}
 
-	current_timefx->status = 0;
+	current_timefx->status = rv ? -1 : 0;
 	current_timefx->request.done = true;
 }
 
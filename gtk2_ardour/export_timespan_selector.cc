@@ -19,6 +19,7 @@
 */
 
 #include "export_timespan_selector.h"
+#include "tooltips.h"
 
 #include "ardour/location.h"
 #include "ardour/types.h"
@@ -44,6 +45,7 @@ ExportTimespanSelector::ExportTimespanSelector (ARDOUR::Session * session, Profi
 	, _realtime_available (true)
 	, time_format_label (_("Show Times as:"), Gtk::ALIGN_LEFT)
 	, realtime_checkbutton (_("Realtime Export"))
+	, single_pass_checkbutton (_("Export All Ranges in One Pass"))
 {
 	set_session (session);
 
@@ -66,6 +68,14 @@ ExportTimespanSelector::ExportTimespanSelector (ARDOUR::Session * session, Profi
 					)
 				);
 		option_hbox.pack_start (*b, false, false, 6);
+
+		option_hbox.pack_start (single_pass_checkbutton, false, false, 6);
+		single_pass_checkbutton.set_active (session->config.get_single_pass_export ());
+		single_pass_checkbutton.signal_toggled ().connect (
+				sigc::mem_fun (*this, &ExportTimespanSelector::toggle_single_pass)
+				);
+		ARDOUR_UI_UTILS::set_tooltip (single_pass_checkbutton,
+				_("Process the session only once for all selected ranges, instead of once per range. Not used for realtime export."));
 	}
 	option_hbox.pack_start (realtime_checkbutton, false, false, 6);
 	realtime_checkbutton.set_active (session->config.get_realtime_export ());
@@ -202,6 +212,12 @@ ExportTimespanSelector::toggle_realtime ()
 	}
 }
 
+void
+ExportTimespanSelector::toggle_single_pass ()
+{
+	_session->config.set_single_pass_export (single_pass_checkbutton.get_active ());
+}
+
 void
 ExportTimespanSelector::change_time_format ()
 {
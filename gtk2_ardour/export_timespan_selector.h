@@ -81,6 +81,7 @@ class ExportTimespanSelector : public Gtk::VBox, public ARDOUR::SessionHandlePtr
 	void add_range_to_selection (ARDOUR::Location const * loc, bool rt);
 	void set_time_format_from_state ();
 	void toggle_realtime ();
+	void toggle_single_pass ();
 
 	void change_time_format ();
 
@@ -100,6 +101,7 @@ class ExportTimespanSelector : public Gtk::VBox, public ARDOUR::SessionHandlePtr
 	Gtk::HBox        option_hbox;
 	Gtk::Label       time_format_label;
 	Gtk::CheckButton realtime_checkbutton;
+	Gtk::CheckButton single_pass_checkbutton;
 
 	/* Time format */
 
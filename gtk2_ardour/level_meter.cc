@@ -19,8 +19,10 @@
 
 #include <limits.h>
 
+#include "ardour/ardour.h"
 #include "ardour/meter.h"
 #include "ardour/logmeter.h"
+#include "ardour/session.h"
 
 #include <gtkmm2ext/utils.h>
 #include "pbd/fastlog.h"
@@ -124,6 +126,26 @@ static float vu_standard() {
 	}
 }
 
+/** All meters share a single copy of the session's MeterSnapshot,
+ * which is fetched at most once per screen update.
+ */
+static MeterSnapshot::Frame const&
+snapshot_frame (Session& session)
+{
+	static MeterSnapshot::Frame frame;
+	static MeterSnapshot const* fetched_from = 0;
+	static microseconds_t fetched_at = 0;
+
+	const microseconds_t now = get_microseconds ();
+
+	if (fetched_from != &session.meter_snapshot () || now - fetched_at > 10000) {
+		session.meter_snapshot ().fetch (frame, true);
+		fetched_from = &session.meter_snapshot ();
+		fetched_at = now;
+	}
+	return frame;
+}
+
 float
 LevelMeterBase::update_meters ()
 {
@@ -134,11 +156,16 @@ LevelMeterBase::update_meters ()
 		return 0.0f;
 	}
 
+	MeterSnapshot::Frame const& frame (snapshot_frame (_meter->session ()));
+	const int slot = _meter->snapshot_slot ();
+	const uint32_t nchan = frame.n_channels (slot);
+
 	uint32_t nmidi = _meter->input_streams().n_midi();
 
-	for (n = 0, i = meters.begin(); i != meters.end(); ++i, ++n) {
+	for (n = 0, i = meters.begin(); i != meters.end() && n < nchan; ++i, ++n) {
 		if ((*i).packed) {
-			const float mpeak = _meter->meter_level(n, MeterMaxPeak);
+			MeterSnapshot::Level const& level (frame.level (slot, n));
+			const float mpeak = level.max_peak;
 			if (mpeak > (*i).max_peak) {
 				(*i).max_peak = mpeak;
 				(*i).meter->set_highlight(mpeak >= UIConfiguration::instance().get_meter_peak());
@@ -148,9 +175,9 @@ LevelMeterBase::update_meters ()
 			}
 
 			if (n < nmidi) {
-				(*i).meter->set (_meter->meter_level (n, MeterPeak));
+				(*i).meter->set (level.peak);
 			} else {
-				const float peak = _meter->meter_level (n, meter_type);
+				const float peak = (meter_type == MeterPeak || meter_type == MeterPeak0dB) ? level.peak : level.level;
 				if (meter_type == MeterPeak) {
 					(*i).meter->set (log_meter (peak));
 				} else if (meter_type == MeterPeak0dB) {
@@ -164,13 +191,13 @@ LevelMeterBase::update_meters ()
 				} else if (meter_type == MeterVU) {
 					(*i).meter->set (meter_deflect_vu (peak + vu_standard() + meter_lineup(0)));
 				} else if (meter_type == MeterK12) {
-					(*i).meter->set (meter_deflect_k (peak, 12), meter_deflect_k(_meter->meter_level(n, MeterPeak), 12));
+					(*i).meter->set (meter_deflect_k (peak, 12), meter_deflect_k(level.peak, 12));
 				} else if (meter_type == MeterK14) {
-					(*i).meter->set (meter_deflect_k (peak, 14), meter_deflect_k(_meter->meter_level(n, MeterPeak), 14));
+					(*i).meter->set (meter_deflect_k (peak, 14), meter_deflect_k(level.peak, 14));
 				} else if (meter_type == MeterK20) {
-					(*i).meter->set (meter_deflect_k (peak, 20), meter_deflect_k(_meter->meter_level(n, MeterPeak), 20));
+					(*i).meter->set (meter_deflect_k (peak, 20), meter_deflect_k(level.peak, 20));
 				} else { // RMS
-					(*i).meter->set (log_meter (peak), log_meter(_meter->meter_level(n, MeterPeak)));
+					(*i).meter->set (log_meter (peak), log_meter(level.peak));
 				}
 			}
 		}
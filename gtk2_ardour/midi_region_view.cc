@@ -92,6 +92,9 @@ using Gtkmm2ext::Keyboard;
 
 #define MIDI_BP_ZERO ((Config->get_first_midi_bank_is_zero())?0:1)
 
+/** maximum number of hidden canvas notes kept for re-use */
+static const size_t max_unused_notes = 1024;
+
 MidiRegionView::MidiRegionView (ArdourCanvas::Container*      parent,
                                 RouteTimeAxisView&            tv,
                                 boost::shared_ptr<MidiRegion> r,
@@ -113,8 +116,8 @@ MidiRegionView::MidiRegionView (ArdourCanvas::Container*      parent,
 	, _channel_selection_scoped_note (0)
 	, _mouse_state(None)
 	, _pressed_button(0)
-	, _sort_needed (true)
-	, _optimization_iterator (_events.end())
+	, _display_start_frame (0)
+	, _display_end_frame (0)
 	, _list_editor (0)
 	, _no_sound_notes (false)
 	, _last_display_zoom (0)
@@ -156,8 +159,8 @@ MidiRegionView::MidiRegionView (ArdourCanvas::Container*      parent,
 	, _channel_selection_scoped_note (0)
 	, _mouse_state(None)
 	, _pressed_button(0)
-	, _sort_needed (true)
-	, _optimization_iterator (_events.end())
+	, _display_start_frame (0)
+	, _display_end_frame (0)
 	, _list_editor (0)
 	, _no_sound_notes (false)
 	, _last_display_zoom (0)
@@ -204,8 +207,8 @@ MidiRegionView::MidiRegionView (const MidiRegionView& other)
 	, _channel_selection_scoped_note (0)
 	, _mouse_state(None)
 	, _pressed_button(0)
-	, _sort_needed (true)
-	, _optimization_iterator (_events.end())
+	, _display_start_frame (0)
+	, _display_end_frame (0)
 	, _list_editor (0)
 	, _no_sound_notes (false)
 	, _last_display_zoom (0)
@@ -236,8 +239,8 @@ MidiRegionView::MidiRegionView (const MidiRegionView& other, boost::shared_ptr<M
 	, _channel_selection_scoped_note (0)
 	, _mouse_state(None)
 	, _pressed_button(0)
-	, _sort_needed (true)
-	, _optimization_iterator (_events.end())
+	, _display_start_frame (0)
+	, _display_end_frame (0)
 	, _list_editor (0)
 	, _no_sound_notes (false)
 	, _last_display_zoom (0)
@@ -302,6 +305,8 @@ MidiRegionView::init (bool wfd)
 	                                            boost::bind (&MidiRegionView::mouse_mode_changed, this),
 	                                            gui_context ());
 
+	trackview.editor().HorizontalPositionChanged.connect (sigc::mem_fun (*this, &MidiRegionView::horizontal_position_changed));
+
 	Config->ParameterChanged.connect (*this, invalidator (*this), boost::bind (&MidiRegionView::parameter_changed, this, _1), gui_context());
 	connect_to_diskstream ();
 }
@@ -444,7 +449,7 @@ MidiRegionView::enter_internal (uint32_t state)
 		create_ghost_note(_last_event_x, _last_event_y, state);
 	}
 
-	if (!_selection.empty()) {
+	if (!selection_empty()) {
 		// Grab keyboard for moving selected notes with arrow keys
 		Keyboard::magic_widget_grab_focus();
 		_grabbed_keyboard = true;
@@ -686,7 +691,7 @@ MidiRegionView::motion (GdkEventMotion* ev)
 bool
 MidiRegionView::scroll (GdkEventScroll* ev)
 {
-	if (_selection.empty()) {
+	if (selection_empty()) {
 		return false;
 	}
 
@@ -747,7 +752,7 @@ MidiRegionView::key_press (GdkEventKey* ev)
 
 	} else if ((ev->keyval == GDK_BackSpace || ev->keyval == GDK_Delete) && unmodified) {
 
-		if (_selection.empty()) {
+		if (selection_empty()) {
 			return false;
 		}
 
@@ -831,15 +836,16 @@ MidiRegionView::key_release (GdkEventKey* ev)
 void
 MidiRegionView::channel_edit ()
 {
-	if (_selection.empty()) {
+	Notes selected;
+	selection_as_notelist (selected);
+
+	if (selected.empty()) {
 		return;
 	}
 
-	/* pick a note somewhat at random (since Selection is a set<>) to
-	 * provide the "current" channel for the dialog.
-	 */
+	/* pick the earliest note to provide the "current" channel for the dialog. */
 
-	uint8_t current_channel = (*_selection.begin())->note()->channel ();
+	uint8_t current_channel = (*selected.begin())->channel ();
 	MidiChannelDialog channel_dialog (current_channel);
 	int ret = channel_dialog.run ();
 
@@ -854,11 +860,8 @@ MidiRegionView::channel_edit ()
 
 	start_note_diff_command (_("channel edit"));
 
-	for (Selection::iterator i = _selection.begin(); i != _selection.end(); ) {
-		Selection::iterator next = i;
-		++next;
+	for (Notes::iterator i = selected.begin(); i != selected.end(); ++i) {
 		change_note_channel (*i, new_channel);
-		i = next;
 	}
 
 	apply_diff ();
@@ -867,15 +870,16 @@ MidiRegionView::channel_edit ()
 void
 MidiRegionView::velocity_edit ()
 {
-	if (_selection.empty()) {
+	Notes selected;
+	selection_as_notelist (selected);
+
+	if (selected.empty()) {
 		return;
 	}
 
-	/* pick a note somewhat at random (since Selection is a set<>) to
-	 * provide the "current" velocity for the dialog.
-	 */
+	/* pick the earliest note to provide the "current" velocity for the dialog. */
 
-	uint8_t current_velocity = (*_selection.begin())->note()->velocity ();
+	uint8_t current_velocity = (*selected.begin())->velocity ();
 	MidiVelocityDialog velocity_dialog (current_velocity);
 	int ret = velocity_dialog.run ();
 
@@ -890,11 +894,8 @@ MidiRegionView::velocity_edit ()
 
 	start_note_diff_command (_("velocity edit"));
 
-	for (Selection::iterator i = _selection.begin(); i != _selection.end(); ) {
-		Selection::iterator next = i;
-		++next;
+	for (Notes::iterator i = selected.begin(); i != selected.end(); ++i) {
 		change_note_velocity (*i, new_velocity, false);
-		i = next;
 	}
 
 	apply_diff ();
@@ -974,10 +975,21 @@ MidiRegionView::clear_events ()
 		delete *i;
 	}
 
+	for (vector<Note*>::iterator i = _unused_notes.begin(); i != _unused_notes.end(); ++i) {
+		delete *i;
+	}
+
+	for (vector<Hit*>::iterator i = _unused_hits.begin(); i != _unused_hits.end(); ++i) {
+		delete *i;
+	}
+
 	_events.clear();
+	_canvas_notes.clear();
+	_unused_notes.clear();
+	_unused_hits.clear();
+	_changed_notes.clear();
 	_patch_changes.clear();
 	_sys_exes.clear();
-	_optimization_iterator = _events.end();
 }
 
 void
@@ -986,7 +998,9 @@ MidiRegionView::display_model(boost::shared_ptr<MidiModel> model)
 	_model = model;
 
 	content_connection.disconnect ();
-	_model->ContentsChanged.connect (content_connection, invalidator (*this), boost::bind (&MidiRegionView::redisplay_model, this), gui_context());
+	_model->ContentsChanged.connect (content_connection, invalidator (*this), boost::bind (&MidiRegionView::model_changed, this), gui_context());
+	notes_changed_connection.disconnect ();
+	_model->NotesChanged.connect (notes_changed_connection, invalidator (*this), boost::bind (&MidiRegionView::notes_changed, this, _1), gui_context());
 	/* Don't signal as nobody else needs to know until selection has been altered. */
 	clear_events ();
 
@@ -1046,6 +1060,26 @@ MidiRegionView::note_diff_add_change (NoteBase* ev,
 	}
 }
 
+void
+MidiRegionView::note_diff_add_change (boost::shared_ptr<NoteType> note,
+                                      MidiModel::NoteDiffCommand::Property property,
+                                      uint8_t val)
+{
+	if (_note_diff_command) {
+		_note_diff_command->change (note, property, val);
+	}
+}
+
+void
+MidiRegionView::note_diff_add_change (boost::shared_ptr<NoteType> note,
+                                      MidiModel::NoteDiffCommand::Property property,
+                                      Evoral::Beats val)
+{
+	if (_note_diff_command) {
+		_note_diff_command->change (note, property, val);
+	}
+}
+
 void
 MidiRegionView::apply_diff (bool as_subcommand)
 {
@@ -1061,6 +1095,7 @@ MidiRegionView::apply_diff (bool as_subcommand)
 		for (Selection::iterator i = _selection.begin(); i != _selection.end(); ++i) {
 			_marked_for_selection.insert((*i)->note());
 		}
+		_marked_for_selection.insert (_hidden_selection.begin(), _hidden_selection.end());
 	}
 
 	midi_view()->midi_track()->midi_playlist()->region_edited(
@@ -1096,21 +1131,13 @@ MidiRegionView::abort_command()
 NoteBase*
 MidiRegionView::find_canvas_note (boost::shared_ptr<NoteType> note)
 {
-	if (_optimization_iterator != _events.end()) {
-		++_optimization_iterator;
-	}
-
-	if (_optimization_iterator != _events.end() && (*_optimization_iterator)->note() == note) {
-		return *_optimization_iterator;
-	}
+	CanvasNotes::const_iterator i = _canvas_notes.find (note);
 
-	for (_optimization_iterator = _events.begin(); _optimization_iterator != _events.end(); ++_optimization_iterator) {
-		if ((*_optimization_iterator)->note() == note) {
-			return *_optimization_iterator;
-		}
+	if (i == _canvas_notes.end()) {
+		return 0;
 	}
 
-	return 0;
+	return *(i->second);
 }
 
 /** This version finds any canvas note matching the supplied note. */
@@ -1135,13 +1162,110 @@ MidiRegionView::get_events (Events& e, Evoral::Sequence<Evoral::Beats>::NoteOper
 	_model->get_notes (notes, op, val, chan_mask);
 
 	for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end(); ++n) {
-		NoteBase* cne = find_canvas_note (*n);
+		NoteBase* cne = find_or_add_canvas_note (*n);
 		if (cne) {
 			e.push_back (cne);
 		}
 	}
 }
 
+/** Canvas notes are only created for notes within the display window.
+ *  Return the canvas note for @param note, creating it if necessary.
+ *  @return the canvas note, or 0 if the note is outside of the region.
+ */
+NoteBase*
+MidiRegionView::find_or_add_canvas_note (boost::shared_ptr<NoteType> note)
+{
+	NoteBase* cne = find_canvas_note (note);
+
+	if (!cne) {
+		bool visible;
+		if (note_in_region_range (note, visible)) {
+			cne = add_note (note, visible);
+		}
+	}
+
+	return cne;
+}
+
+/** @return the note of the model matching the supplied note, if any. */
+boost::shared_ptr<MidiRegionView::NoteType>
+MidiRegionView::find_model_note (NoteType note)
+{
+	boost::shared_ptr<NoteType> found;
+
+	if (!_model) {
+		return found;
+	}
+
+	MidiModel::ReadLock lock(_model->read_lock());
+	std::pair<MidiModel::Notes::iterator, MidiModel::Notes::iterator> r = _model->notes().equal_range (boost::shared_ptr<NoteType> (new NoteType (note)));
+
+	for (MidiModel::Notes::iterator i = r.first; i != r.second; ++i) {
+		if (*(*i) == note) {
+			found = *i;
+			break;
+		}
+	}
+
+	return found;
+}
+
+/** Selected notes only get a canvas note while they are shown within the
+ *  display window.  Return the canvas note for @param note, creating it
+ *  if the note is shown there.
+ *  @return the canvas note, or 0 if the note has none.
+ */
+NoteBase*
+MidiRegionView::canvas_note_for_selection (boost::shared_ptr<NoteType> note)
+{
+	NoteBase* cne = find_canvas_note (note);
+	bool visible;
+
+	if (!cne && note_in_region_range (note, visible) && visible && note_in_display_window (note)) {
+		cne = add_note (note, true);
+	}
+
+	return cne;
+}
+
+/** Remove a canvas note from the view, keeping it for re-use
+ *  by add_note() if there are not too many unused ones already.
+ *  @return the next canvas note.
+ */
+MidiRegionView::Events::iterator
+MidiRegionView::remove_canvas_note (Events::iterator i)
+{
+	NoteBase* cne = *i;
+
+	for (vector<GhostRegion*>::iterator g = ghosts.begin(); g != ghosts.end(); ++g) {
+		MidiGhostRegion* gr = dynamic_cast<MidiGhostRegion*> (*g);
+		if (gr) {
+			gr->remove_note (cne);
+		}
+	}
+
+	_selection.erase (cne);
+	_canvas_notes.erase (cne->note());
+
+	Note* note;
+	Hit*  hit;
+
+	if ((note = dynamic_cast<Note*> (cne)) != 0 && _unused_notes.size() < max_unused_notes) {
+		note->set_note (boost::shared_ptr<NoteType>());
+		note->hide ();
+		_unused_notes.push_back (note);
+	} else if ((hit = dynamic_cast<Hit*> (cne)) != 0 && _unused_hits.size() < max_unused_notes) {
+		hit->set_note (boost::shared_ptr<NoteType>());
+		hit->hide ();
+		_unused_hits.push_back (hit);
+	} else {
+		delete cne;
+	}
+
+	return _events.erase (i);
+}
+
 void
 MidiRegionView::redisplay_model()
 {
@@ -1166,94 +1290,269 @@ MidiRegionView::redisplay_model()
 		return;
 	}
 
+	update_display_window (true);
+
 	for (Events::iterator i = _events.begin(); i != _events.end(); ++i) {
 		(*i)->invalidate ();
 	}
 
-	MidiModel::ReadLock lock(_model->read_lock());
+	{
+		MidiModel::ReadLock lock(_model->read_lock());
+		MidiModel::Notes& notes (_model->notes());
 
-	MidiModel::Notes& notes (_model->notes());
-	_optimization_iterator = _events.begin();
+		_longest_note = Evoral::Beats();
 
-	bool empty_when_starting = _events.empty();
-	NoteBase* cne;
+		for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end(); ++n) {
+			_longest_note = max (_longest_note, (*n)->length());
+			display_note (*n);
+		}
 
-	for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end(); ++n) {
+		/* forget selected notes which are gone */
 
-		boost::shared_ptr<NoteType> note (*n);
-		bool visible;
+		for (set<boost::shared_ptr<NoteType> >::iterator i = _hidden_selection.begin(); i != _hidden_selection.end(); ) {
+			if (!model_has_note (*i)) {
+				_hidden_selection.erase (i++);
+			} else {
+				++i;
+			}
+		}
+	}
 
-		if (note_in_region_range (note, visible)) {
+	/* remove note items that are no longer valid */
 
-			if (!empty_when_starting && (cne = find_canvas_note (note)) != 0) {
+	for (Events::iterator i = _events.begin(); i != _events.end(); ) {
+		if (!(*i)->valid ()) {
+			i = remove_canvas_note (i);
+		} else {
+			++i;
+		}
+	}
 
-				if (visible) {
-					cne->validate ();
-					update_note (cne);
-					cne->show ();
-				} else {
-					cne->hide ();
-				}
+	_patch_changes.clear();
+	_sys_exes.clear();
 
-			} else {
+	display_sysexes();
+	display_patch_changes ();
 
-				cne = add_note (note, visible);
-			}
+	_marked_for_selection.clear ();
+	_marked_for_velocity.clear ();
+	_pending_note_selection.clear ();
+	_changed_notes.clear ();
+}
 
-			set<boost::shared_ptr<NoteType> >::iterator it;
-			for (it = _pending_note_selection.begin(); it != _pending_note_selection.end(); ++it) {
-				if (*(*it) == *note) {
-					add_to_selection (cne);
-				}
-			}
+/** Show, update or remove the canvas note for a note of the model, which
+ *  must be read-locked.  Canvas notes are only created for notes which
+ *  are visible within the display window; notes outside of it which are
+ *  (about to be) selected only become part of the hidden selection.
+ *  Any other canvas note for @param note is left invalid, for the caller
+ *  to remove it.
+ */
+void
+MidiRegionView::display_note (boost::shared_ptr<NoteType> note)
+{
+	bool visible;
+	const bool in_region = note_in_region_range (note, visible);
+	NoteBase* cne = find_canvas_note (note);
+	bool pending = false;
 
-		} else {
+	if (in_region) {
+		/* keep the data range of the stream view up to date, even
+		 * for notes we do not show.
+		 */
+		midi_stream_view()->update_note_range (note->note());
 
-			if (!empty_when_starting && (cne = find_canvas_note (note)) != 0) {
-				cne->validate ();
-				cne->hide ();
+		for (set<boost::shared_ptr<NoteType> >::iterator it = _pending_note_selection.begin(); it != _pending_note_selection.end(); ++it) {
+			if (*(*it) == *note) {
+				pending = true;
 			}
 		}
 	}
 
-	/* remove note items that are no longer valid */
+	if (!(in_region && visible && note_in_display_window (note)) && !(cne && cne->selected())) {
+		if (in_region && (pending || _marked_for_selection.find (note) != _marked_for_selection.end())) {
+			/* select it without creating a canvas note */
+			add_hidden_note_to_selection (note);
+		}
+		return;
+	}
 
-	if (!empty_when_starting) {
-		for (Events::iterator i = _events.begin(); i != _events.end(); ) {
-			if (!(*i)->valid ()) {
+	if (cne) {
+		cne->validate ();
+		if (in_region && visible) {
+			update_note (cne);
+			cne->show ();
+		} else {
+			cne->hide ();
+		}
+	} else {
+		cne = add_note (note, in_region && visible);
+	}
 
-				for (vector<GhostRegion*>::iterator j = ghosts.begin(); j != ghosts.end(); ++j) {
-					MidiGhostRegion* gr = dynamic_cast<MidiGhostRegion*> (*j);
-					if (gr) {
-						gr->remove_note (*i);
-					}
-				}
+	if (cne && pending) {
+		add_to_selection (cne);
+	}
+}
+
+/** Called when a NoteDiffCommand was applied to the model; the
+ *  ContentsChanged signal which follows only needs to update these notes.
+ */
+void
+MidiRegionView::notes_changed (std::set< boost::shared_ptr<NoteType> > const & notes)
+{
+	_changed_notes.insert (notes.begin(), notes.end());
+}
+
+void
+MidiRegionView::model_changed ()
+{
+	if (!_changed_notes.empty() && !_active_notes && _model) {
+		std::set< boost::shared_ptr<NoteType> > notes;
+		notes.swap (_changed_notes);
+		update_notes (notes);
+	} else {
+		redisplay_model ();
+	}
+}
+
+/** Redisplay only the given notes, rather than the whole model.
+ *  Patch changes and sysexes are not affected by a NoteDiffCommand,
+ *  so they are left alone.
+ */
+void
+MidiRegionView::update_notes (std::set< boost::shared_ptr<NoteType> > const & notes)
+{
+	{
+		MidiModel::ReadLock lock(_model->read_lock());
+
+		for (set<boost::shared_ptr<NoteType> >::const_iterator n = notes.begin(); n != notes.end(); ++n) {
 
-				delete *i;
-				i = _events.erase (i);
+			CanvasNotes::iterator c = _canvas_notes.find (*n);
+
+			if (c != _canvas_notes.end()) {
+				(*c->second)->invalidate ();
+			}
 
+			if (model_has_note (*n)) {
+				_longest_note = max (_longest_note, (*n)->length());
+				display_note (*n);
 			} else {
-				++i;
+				_hidden_selection.erase (*n);
 			}
-		}
-	}
 
-	_patch_changes.clear();
-	_sys_exes.clear();
+			c = _canvas_notes.find (*n);
 
-	display_sysexes();
-	display_patch_changes ();
+			if (c != _canvas_notes.end() && !(*c->second)->valid ()) {
+				remove_canvas_note (c->second);
+			}
+		}
+	}
 
 	_marked_for_selection.clear ();
 	_marked_for_velocity.clear ();
 	_pending_note_selection.clear ();
+}
 
-	/* we may have caused _events to contain things out of order (e.g. if a note
-	   moved earlier or later). we don't generally need them in time order, but
-	   make a note that a sort is required for those cases that require it.
-	*/
+/** @return true if @param note itself (not just an equal note) is part of
+ *  the model, which must be read-locked.
+ */
+bool
+MidiRegionView::model_has_note (boost::shared_ptr<NoteType> note) const
+{
+	std::pair<MidiModel::Notes::const_iterator, MidiModel::Notes::const_iterator> r = _model->notes().equal_range (note);
 
-	_sort_needed = true;
+	for (MidiModel::Notes::const_iterator i = r.first; i != r.second; ++i) {
+		if (*i == note) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/** Recompute the display window if the visible editor page is no longer
+ *  within it, or if @param force is true.
+ *  @return true if the display window was changed.
+ */
+bool
+MidiRegionView::update_display_window (bool force)
+{
+	PublicEditor& editor (trackview.editor());
+	const framepos_t left = editor.leftmost_sample ();
+	const framecnt_t page = editor.current_page_samples ();
+
+	if (!force && max (_region->position(), left) >= _display_start_frame && left + page <= _display_end_frame) {
+		return false;
+	}
+
+	_display_start_frame = max (_region->position(), left - page);
+	_display_end_frame = max (_display_start_frame, left + 2 * page);
+
+	_display_start = absolute_frames_to_source_beats (_display_start_frame);
+	_display_end = absolute_frames_to_source_beats (_display_end_frame);
+
+	return true;
+}
+
+bool
+MidiRegionView::note_in_display_window (boost::shared_ptr<NoteType> note) const
+{
+	return note->end_time() >= _display_start && note->time() <= _display_end;
+}
+
+/** Remove canvas notes which are no longer within the display window
+ *  (or within the visible note range), and add those which now are.
+ *  Selected notes which leave the window move to the hidden selection,
+ *  unless a drag (which may be moving them) is in progress.
+ */
+void
+MidiRegionView::redisplay_window ()
+{
+	const bool keep_selected = trackview.editor().drags()->active();
+
+	for (Events::iterator i = _events.begin(); i != _events.end(); ) {
+		bool visible;
+		boost::shared_ptr<NoteType> note ((*i)->note());
+
+		if ((*i)->selected() && keep_selected) {
+			++i;
+		} else if (!note_in_region_range (note, visible) || !visible || !note_in_display_window (note)) {
+			if ((*i)->selected()) {
+				_hidden_selection.insert (note);
+			}
+			i = remove_canvas_note (i);
+		} else {
+			++i;
+		}
+	}
+
+	MidiModel::ReadLock lock(_model->read_lock());
+	MidiModel::Notes& notes (_model->notes());
+
+	/* a note which starts more than the length of the longest note
+	 * before the window cannot reach into it.
+	 */
+	const Evoral::Beats first = _display_start > _longest_note ? _display_start - _longest_note : Evoral::Beats();
+
+	for (MidiModel::Notes::iterator n = _model->note_lower_bound (first); n != notes.end() && (*n)->time() <= _display_end; ++n) {
+
+		bool visible;
+
+		if (note_in_region_range (*n, visible) && visible && note_in_display_window (*n) && !find_canvas_note (*n)) {
+			add_note (*n, true);
+		}
+	}
+}
+
+void
+MidiRegionView::horizontal_position_changed ()
+{
+	if (!_enable_display || !_model || _active_notes) {
+		return;
+	}
+
+	if (update_display_window (false)) {
+		redisplay_window ();
+	}
 }
 
 void
@@ -1407,6 +1706,12 @@ MidiRegionView::region_resized (const PropertyChange& what_changed)
 	if (what_changed.contains (ARDOUR::Properties::start) ||
 	    what_changed.contains (ARDOUR::Properties::position)) {
 		_source_relative_time_converter.set_origin_b (_region->position() - _region->start());
+
+		if (_enable_display && _model && !_active_notes) {
+			/* the display window is measured in source beats */
+			update_display_window (true);
+			redisplay_window ();
+		}
 	}
 	/* catch end and start trim so we can update the view*/
 	if (!what_changed.contains (ARDOUR::Properties::start) &&
@@ -1480,6 +1785,13 @@ MidiRegionView::apply_note_range (uint8_t min, uint8_t max, bool force)
 	_current_range_min = min;
 	_current_range_max = max;
 
+	if (_model && !_active_notes) {
+		/* add canvas notes for pitches which just became visible,
+		 * and drop those which are no longer.
+		 */
+		redisplay_window ();
+	}
+
 	for (Events::const_iterator i = _events.begin(); i != _events.end(); ++i) {
 		NoteBase* event = *i;
 		boost::shared_ptr<NoteType> note (event->note());
@@ -1815,7 +2127,15 @@ MidiRegionView::add_note(const boost::shared_ptr<NoteType> note, bool visible)
 
 	if (midi_view()->note_mode() == Sustained) {
 
-		Note* ev_rect = new Note (*this, _note_group, note);
+		Note* ev_rect;
+
+		if (!_unused_notes.empty()) {
+			ev_rect = _unused_notes.back();
+			_unused_notes.pop_back();
+			ev_rect->set_note (note);
+		} else {
+			ev_rect = new Note (*this, _note_group, note);
+		}
 
 		update_sustained (ev_rect);
 
@@ -1823,9 +2143,16 @@ MidiRegionView::add_note(const boost::shared_ptr<NoteType> note, bool visible)
 
 	} else if (midi_view()->note_mode() == Percussive) {
 
-		const double diamond_size = std::max(1., floor(midi_stream_view()->note_height()) - 2.);
+		Hit* ev_diamond;
 
-		Hit* ev_diamond = new Hit (*this, _note_group, diamond_size, note);
+		if (!_unused_hits.empty()) {
+			ev_diamond = _unused_hits.back();
+			_unused_hits.pop_back();
+			ev_diamond->set_note (note);
+		} else {
+			const double diamond_size = std::max(1., floor(midi_stream_view()->note_height()) - 2.);
+			ev_diamond = new Hit (*this, _note_group, diamond_size, note);
+		}
 
 		update_hit (ev_diamond);
 
@@ -1844,7 +2171,11 @@ MidiRegionView::add_note(const boost::shared_ptr<NoteType> note, bool visible)
 			}
 		}
 
-		if (_marked_for_selection.find(note) != _marked_for_selection.end()) {
+		if (_hidden_selection.erase (note)) {
+			/* selected while it had no canvas note */
+			_selection.insert (event);
+			event->set_selected (true);
+		} else if (_marked_for_selection.find(note) != _marked_for_selection.end()) {
 			note_selected(event, true);
 		}
 
@@ -1853,7 +2184,7 @@ MidiRegionView::add_note(const boost::shared_ptr<NoteType> note, bool visible)
 		}
 
 		event->on_channel_selection_change (get_selected_channels());
-		_events.push_back(event);
+		_canvas_notes[note] = _events.insert (_events.end(), event);
 
 		if (visible) {
 			event->show();
@@ -2115,7 +2446,7 @@ MidiRegionView::note_deleted (NoteBase* cne)
 void
 MidiRegionView::delete_selection()
 {
-	if (_selection.empty()) {
+	if (selection_empty()) {
 		return;
 	}
 
@@ -2131,7 +2462,12 @@ MidiRegionView::delete_selection()
 		}
 	}
 
+	for (set<boost::shared_ptr<NoteType> >::iterator i = _hidden_selection.begin(); i != _hidden_selection.end(); ++i) {
+		_note_diff_command->remove (*i);
+	}
+
 	_selection.clear();
+	_hidden_selection.clear();
 
 	apply_diff ();
 	hide_verbose_cursor ();
@@ -2173,6 +2509,7 @@ MidiRegionView::clear_selection_internal ()
 		(*i)->hide_velocity();
 	}
 	_selection.clear();
+	_hidden_selection.clear();
 
 	if (_entered) {
 		// Clearing selection entirely, ungrab keyboard
@@ -2193,8 +2530,11 @@ MidiRegionView::select_all_notes ()
 {
 	clear_editor_note_selection ();
 
-	for (Events::iterator i = _events.begin(); i != _events.end(); ++i) {
-		add_to_selection (*i);
+	MidiModel::ReadLock lock(_model->read_lock());
+	MidiModel::Notes& notes (_model->notes());
+
+	for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end(); ++n) {
+		add_note_to_selection (*n);
 	}
 }
 
@@ -2203,10 +2543,16 @@ MidiRegionView::select_range (framepos_t start, framepos_t end)
 {
 	clear_editor_note_selection ();
 
-	for (Events::iterator i = _events.begin(); i != _events.end(); ++i) {
-		framepos_t t = source_beats_to_absolute_frames((*i)->note()->time());
-		if (t >= start && t <= end) {
-			add_to_selection (*i);
+	MidiModel::ReadLock lock(_model->read_lock());
+	MidiModel::Notes& notes (_model->notes());
+
+	for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end(); ++n) {
+		framepos_t t = source_beats_to_absolute_frames((*n)->time());
+		if (t > end) {
+			break;
+		}
+		if (t >= start) {
+			add_note_to_selection (*n);
 		}
 	}
 }
@@ -2214,11 +2560,14 @@ MidiRegionView::select_range (framepos_t start, framepos_t end)
 void
 MidiRegionView::invert_selection ()
 {
-	for (Events::iterator i = _events.begin(); i != _events.end(); ++i) {
-		if ((*i)->selected()) {
-			remove_from_selection(*i);
+	MidiModel::ReadLock lock(_model->read_lock());
+	MidiModel::Notes& notes (_model->notes());
+
+	for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end(); ++n) {
+		if (note_is_selected (*n)) {
+			remove_note_from_selection (*n);
 		} else {
-			add_to_selection (*i);
+			add_note_to_selection (*n);
 		}
 	}
 }
@@ -2229,12 +2578,12 @@ MidiRegionView::invert_selection ()
 void
 MidiRegionView::select_notes (list<boost::shared_ptr<NoteType> > notes)
 {
-	NoteBase* cne;
 	list<boost::shared_ptr<NoteType> >::iterator n;
 
 	for (n = notes.begin(); n != notes.end(); ++n) {
-		if ((cne = find_canvas_note(*(*n))) != 0) {
-			add_to_selection (cne);
+		boost::shared_ptr<NoteType> note = find_model_note (*(*n));
+		if (note) {
+			add_note_to_selection (note);
 		} else {
 			_pending_note_selection.insert(*n);
 		}
@@ -2244,11 +2593,10 @@ MidiRegionView::select_notes (list<boost::shared_ptr<NoteType> > notes)
 void
 MidiRegionView::select_matching_notes (uint8_t notenum, uint16_t channel_mask, bool add, bool extend)
 {
-	bool have_selection = !_selection.empty();
+	bool have_selection = !selection_empty();
 	uint8_t low_note = 127;
 	uint8_t high_note = 0;
 	MidiModel::Notes& notes (_model->notes());
-	_optimization_iterator = _events.begin();
 
 	if (extend && !have_selection) {
 		extend = false;
@@ -2256,12 +2604,15 @@ MidiRegionView::select_matching_notes (uint8_t notenum, uint16_t channel_mask, b
 
 	/* scan existing selection to get note range */
 
-	for (Selection::iterator i = _selection.begin(); i != _selection.end(); ++i) {
-		if ((*i)->note()->note() < low_note) {
-			low_note = (*i)->note()->note();
+	Notes selected;
+	selection_as_notelist (selected);
+
+	for (Notes::iterator i = selected.begin(); i != selected.end(); ++i) {
+		if ((*i)->note() < low_note) {
+			low_note = (*i)->note();
 		}
-		if ((*i)->note()->note() > high_note) {
-			high_note = (*i)->note()->note();
+		if ((*i)->note() > high_note) {
+			high_note = (*i)->note();
 		}
 	}
 
@@ -2286,7 +2637,6 @@ MidiRegionView::select_matching_notes (uint8_t notenum, uint16_t channel_mask, b
 	for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end(); ++n) {
 
 		boost::shared_ptr<NoteType> note (*n);
-		NoteBase* cne;
 		bool select = false;
 
 		if (((1 << note->channel()) & channel_mask) != 0) {
@@ -2300,15 +2650,10 @@ MidiRegionView::select_matching_notes (uint8_t notenum, uint16_t channel_mask, b
 		}
 
 		if (select) {
-			if ((cne = find_canvas_note (note)) != 0) {
-				// extend is false because we've taken care of it,
-				// since it extends by time range, not pitch.
-				note_selected (cne, add, false);
-			}
+			// the selection was cleared above unless adding to it,
+			// and extending has been taken care of by the pitch range.
+			add_note_to_selection (note);
 		}
-
-		add = true; // we need to add all remaining matching notes, even if the passed in value was false (for "set")
-
 	}
 
 	_no_sound_notes = false;
@@ -2318,20 +2663,16 @@ void
 MidiRegionView::toggle_matching_notes (uint8_t notenum, uint16_t channel_mask)
 {
 	MidiModel::Notes& notes (_model->notes());
-	_optimization_iterator = _events.begin();
 
 	for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end(); ++n) {
 
 		boost::shared_ptr<NoteType> note (*n);
-		NoteBase* cne;
 
 		if (note->note() == notenum && (((0x0001 << note->channel()) & channel_mask) != 0)) {
-			if ((cne = find_canvas_note (note)) != 0) {
-				if (cne->selected()) {
-					note_deselected (cne);
-				} else {
-					note_selected (cne, true, false);
-				}
+			if (note_is_selected (note)) {
+				remove_note_from_selection (note);
+			} else {
+				add_note_to_selection (note);
 			}
 		}
 	}
@@ -2357,12 +2698,15 @@ MidiRegionView::note_selected (NoteBase* ev, bool add, bool extend)
 		Evoral::Beats earliest = Evoral::MaxBeats;
 		Evoral::Beats latest   = Evoral::Beats();
 
-		for (Selection::iterator i = _selection.begin(); i != _selection.end(); ++i) {
-			if ((*i)->note()->end_time() > latest) {
-				latest = (*i)->note()->end_time();
+		Notes selected;
+		selection_as_notelist (selected);
+
+		for (Notes::iterator i = selected.begin(); i != selected.end(); ++i) {
+			if ((*i)->end_time() > latest) {
+				latest = (*i)->end_time();
 			}
-			if ((*i)->note()->time() < earliest) {
-				earliest = (*i)->note()->time();
+			if ((*i)->time() < earliest) {
+				earliest = (*i)->time();
 			}
 		}
 
@@ -2374,13 +2718,16 @@ MidiRegionView::note_selected (NoteBase* ev, bool add, bool extend)
 			earliest = ev->note()->time();
 		}
 
-		for (Events::iterator i = _events.begin(); i != _events.end(); ++i) {
+		MidiModel::ReadLock lock(_model->read_lock());
+		MidiModel::Notes& notes (_model->notes());
+
+		for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end() && (*n)->time() <= latest; ++n) {
 
 			/* find notes entirely within OR spanning the earliest..latest range */
 
-			if (((*i)->note()->time() >= earliest && (*i)->note()->end_time() <= latest) ||
-			    ((*i)->note()->time() <= earliest && (*i)->note()->end_time() >= latest)) {
-				add_to_selection (*i);
+			if (((*n)->time() >= earliest && (*n)->end_time() <= latest) ||
+			    ((*n)->time() <= earliest && (*n)->end_time() >= latest)) {
+				add_note_to_selection (*n);
 			}
 
 		}
@@ -2462,6 +2809,32 @@ MidiRegionView::update_vertical_drag_selection (double y1, double y2, bool exten
 			remove_from_selection (*i);
 		}
 	}
+
+	/* notes without a canvas note are selected by the bottom edge
+	 * their canvas note would have (see update_sustained()).
+	 */
+
+	MidiStreamView* const view = midi_stream_view();
+	const double height = std::max(1., floor(view->note_height()) - 1);
+
+	MidiModel::ReadLock lock(_model->read_lock());
+	MidiModel::Notes& notes (_model->notes());
+
+	for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end(); ++n) {
+		bool visible;
+
+		if (find_canvas_note (*n) || !note_in_region_range (*n, visible)) {
+			continue;
+		}
+
+		const double bottom = 1 + floor (view->note_to_y ((*n)->note())) + height;
+
+		if (bottom >= y1 && bottom <= y2) {
+			add_hidden_note_to_selection (*n);
+		} else if (!extend) {
+			remove_note_from_selection (*n);
+		}
+	}
 }
 
 void
@@ -2471,7 +2844,7 @@ MidiRegionView::remove_from_selection (NoteBase* ev)
 
 	if (i != _selection.end()) {
 		_selection.erase (i);
-		if (_selection.empty() && _grabbed_keyboard) {
+		if (selection_empty() && _grabbed_keyboard) {
 			// Ungrab keyboard
 			Keyboard::magic_widget_drop_focus();
 			_grabbed_keyboard = false;
@@ -2481,7 +2854,7 @@ MidiRegionView::remove_from_selection (NoteBase* ev)
 	ev->set_selected (false);
 	ev->hide_velocity ();
 
-	if (_selection.empty()) {
+	if (selection_empty()) {
 		PublicEditor& editor (trackview.editor());
 		editor.get_selection().remove (this);
 	}
@@ -2490,7 +2863,7 @@ MidiRegionView::remove_from_selection (NoteBase* ev)
 void
 MidiRegionView::add_to_selection (NoteBase* ev)
 {
-	const bool selection_was_empty = _selection.empty();
+	const bool selection_was_empty = selection_empty();
 
 	if (_selection.insert (ev).second) {
 		ev->set_selected (true);
@@ -2508,6 +2881,69 @@ MidiRegionView::add_to_selection (NoteBase* ev)
 	}
 }
 
+/** Select @param note, creating its canvas note only if it is shown
+ *  within the display window.
+ */
+void
+MidiRegionView::add_note_to_selection (boost::shared_ptr<NoteType> note)
+{
+	NoteBase* cne = canvas_note_for_selection (note);
+	bool visible;
+
+	if (cne) {
+		add_to_selection (cne);
+	} else if (note_in_region_range (note, visible)) {
+		add_hidden_note_to_selection (note);
+	}
+}
+
+/** Select @param note, which has no (valid) canvas note */
+void
+MidiRegionView::add_hidden_note_to_selection (boost::shared_ptr<NoteType> note)
+{
+	const bool selection_was_empty = selection_empty();
+
+	if (_hidden_selection.insert (note).second && selection_was_empty) {
+		if (_entered) {
+			// Grab keyboard for moving notes with arrow keys
+			Keyboard::magic_widget_grab_focus();
+			_grabbed_keyboard = true;
+		}
+		PublicEditor& editor (trackview.editor());
+		editor.get_selection().add (this);
+	}
+}
+
+void
+MidiRegionView::remove_note_from_selection (boost::shared_ptr<NoteType> note)
+{
+	NoteBase* cne = find_canvas_note (note);
+
+	if (cne) {
+		remove_from_selection (cne);
+	} else if (_hidden_selection.erase (note) && selection_empty()) {
+		if (_grabbed_keyboard) {
+			// Ungrab keyboard
+			Keyboard::magic_widget_drop_focus();
+			_grabbed_keyboard = false;
+		}
+		PublicEditor& editor (trackview.editor());
+		editor.get_selection().remove (this);
+	}
+}
+
+bool
+MidiRegionView::note_is_selected (boost::shared_ptr<NoteType> note)
+{
+	NoteBase* cne = find_canvas_note (note);
+
+	if (cne) {
+		return cne->selected();
+	}
+
+	return _hidden_selection.find (note) != _hidden_selection.end();
+}
+
 void
 MidiRegionView::move_selection(double dx, double dy, double cumulative_dy)
 {
@@ -2558,10 +2994,15 @@ MidiRegionView::note_dropped(NoteBase *, frameoffset_t dt, int8_t dnote)
 	uint8_t highest_note_in_selection = 0;
 	uint8_t highest_note_difference   = 0;
 
+	/* selected notes without a canvas note move along with the others */
+
+	Notes selected;
+	selection_as_notelist (selected);
+
 	// find highest and lowest notes first
 
-	for (Selection::iterator i = _selection.begin(); i != _selection.end(); ++i) {
-		uint8_t pitch = (*i)->note()->note();
+	for (Notes::iterator i = selected.begin(); i != selected.end(); ++i) {
+		uint8_t pitch = (*i)->note();
 		lowest_note_in_selection  = std::min(lowest_note_in_selection,  pitch);
 		highest_note_in_selection = std::max(highest_note_in_selection, pitch);
 	}
@@ -2584,10 +3025,10 @@ MidiRegionView::note_dropped(NoteBase *, frameoffset_t dt, int8_t dnote)
 
 	start_note_diff_command (_("move notes"));
 
-	for (Selection::iterator i = _selection.begin(); i != _selection.end() ; ++i) {
+	for (Notes::iterator i = selected.begin(); i != selected.end() ; ++i) {
 
 		double const start_qn = (_region->pulse() * 4.0) - midi_region()->start_beats().to_double();
-		framepos_t new_frames = map.frame_at_quarter_note (start_qn + (*i)->note()->time().to_double()) + dt;
+		framepos_t new_frames = map.frame_at_quarter_note (start_qn + (*i)->time().to_double()) + dt;
 		Evoral::Beats new_time = Evoral::Beats (map.quarter_note_at_frame (new_frames) - start_qn);
 		if (new_time < 0) {
 			continue;
@@ -2595,7 +3036,7 @@ MidiRegionView::note_dropped(NoteBase *, frameoffset_t dt, int8_t dnote)
 
 		note_diff_add_change (*i, MidiModel::NoteDiffCommand::StartTime, new_time);
 
-		uint8_t original_pitch = (*i)->note()->note();
+		uint8_t original_pitch = (*i)->note();
 		uint8_t new_pitch      = original_pitch + dnote - highest_note_difference;
 
 		// keep notes in standard midi range
@@ -2953,38 +3394,67 @@ MidiRegionView::abort_resizing ()
 
 void
 MidiRegionView::change_note_velocity(NoteBase* event, int8_t velocity, bool relative)
+{
+	change_note_velocity (event->note(), velocity, relative);
+	event->set_selected (event->selected()); // change color
+}
+
+void
+MidiRegionView::change_note_note (NoteBase* event, int8_t note, bool relative)
+{
+	change_note_note (event->note(), note, relative);
+}
+
+void
+MidiRegionView::trim_note (NoteBase* event, Evoral::Beats front_delta, Evoral::Beats end_delta)
+{
+	trim_note (event->note(), front_delta, end_delta);
+}
+
+void
+MidiRegionView::change_note_channel (NoteBase* event, int8_t chn, bool relative)
+{
+	change_note_channel (event->note(), chn, relative);
+}
+
+void
+MidiRegionView::change_note_time (NoteBase* event, Evoral::Beats delta, bool relative)
+{
+	change_note_time (event->note(), delta, relative);
+}
+
+void
+MidiRegionView::change_note_velocity (boost::shared_ptr<NoteType> n, int8_t velocity, bool relative)
 {
 	uint8_t new_velocity;
 
 	if (relative) {
-		new_velocity = event->note()->velocity() + velocity;
+		new_velocity = n->velocity() + velocity;
 		clamp_to_0_127(new_velocity);
 	} else {
 		new_velocity = velocity;
 	}
 
-	event->set_selected (event->selected()); // change color
-
-	note_diff_add_change (event, MidiModel::NoteDiffCommand::Velocity, new_velocity);
+	note_diff_add_change (n, MidiModel::NoteDiffCommand::Velocity, new_velocity);
 }
 
 void
-MidiRegionView::change_note_note (NoteBase* event, int8_t note, bool relative)
+MidiRegionView::change_note_note (boost::shared_ptr<NoteType> n, int8_t note, bool relative)
 {
 	uint8_t new_note;
 
 	if (relative) {
-		new_note = event->note()->note() + note;
+		new_note = n->note() + note;
 	} else {
 		new_note = note;
 	}
 
 	clamp_to_0_127 (new_note);
-	note_diff_add_change (event, MidiModel::NoteDiffCommand::NoteNumber, new_note);
+	note_diff_add_change (n, MidiModel::NoteDiffCommand::NoteNumber, new_note);
 }
 
 void
-MidiRegionView::trim_note (NoteBase* event, Evoral::Beats front_delta, Evoral::Beats end_delta)
+MidiRegionView::trim_note (boost::shared_ptr<NoteType> n, Evoral::Beats front_delta, Evoral::Beats end_delta)
 {
 	bool change_start = false;
 	bool change_length = false;
@@ -3003,28 +3473,28 @@ MidiRegionView::trim_note (NoteBase* event, Evoral::Beats front_delta, Evoral::B
 	if (!!front_delta) {
 		if (front_delta < 0) {
 
-			if (event->note()->time() < -front_delta) {
+			if (n->time() < -front_delta) {
 				new_start = Evoral::Beats();
 			} else {
-				new_start = event->note()->time() + front_delta; // moves earlier
+				new_start = n->time() + front_delta; // moves earlier
 			}
 
 			/* start moved toward zero, so move the end point out to where it used to be.
 			   Note that front_delta is negative, so this increases the length.
 			*/
 
-			new_length = event->note()->length() - front_delta;
+			new_length = n->length() - front_delta;
 			change_start = true;
 			change_length = true;
 
 		} else {
 
-			Evoral::Beats new_pos = event->note()->time() + front_delta;
+			Evoral::Beats new_pos = n->time() + front_delta;
 
-			if (new_pos < event->note()->end_time()) {
-				new_start = event->note()->time() + front_delta;
+			if (new_pos < n->end_time()) {
+				new_start = n->time() + front_delta;
 				/* start moved toward the end, so move the end point back to where it used to be */
-				new_length = event->note()->length() - front_delta;
+				new_length = n->length() - front_delta;
 				change_start = true;
 				change_length = true;
 			}
@@ -3035,68 +3505,68 @@ MidiRegionView::trim_note (NoteBase* event, Evoral::Beats front_delta, Evoral::B
 	if (!!end_delta) {
 		bool can_change = true;
 		if (end_delta < 0) {
-			if (event->note()->length() < -end_delta) {
+			if (n->length() < -end_delta) {
 				can_change = false;
 			}
 		}
 
 		if (can_change) {
-			new_length = event->note()->length() + end_delta;
+			new_length = n->length() + end_delta;
 			change_length = true;
 		}
 	}
 
 	if (change_start) {
-		note_diff_add_change (event, MidiModel::NoteDiffCommand::StartTime, new_start);
+		note_diff_add_change (n, MidiModel::NoteDiffCommand::StartTime, new_start);
 	}
 
 	if (change_length) {
-		note_diff_add_change (event, MidiModel::NoteDiffCommand::Length, new_length);
+		note_diff_add_change (n, MidiModel::NoteDiffCommand::Length, new_length);
 	}
 }
 
 void
-MidiRegionView::change_note_channel (NoteBase* event, int8_t chn, bool relative)
+MidiRegionView::change_note_channel (boost::shared_ptr<NoteType> n, int8_t chn, bool relative)
 {
 	uint8_t new_channel;
 
 	if (relative) {
 		if (chn < 0.0) {
-			if (event->note()->channel() < -chn) {
+			if (n->channel() < -chn) {
 				new_channel = 0;
 			} else {
-				new_channel = event->note()->channel() + chn;
+				new_channel = n->channel() + chn;
 			}
 		} else {
-			new_channel = event->note()->channel() + chn;
+			new_channel = n->channel() + chn;
 		}
 	} else {
 		new_channel = (uint8_t) chn;
 	}
 
-	note_diff_add_change (event, MidiModel::NoteDiffCommand::Channel, new_channel);
+	note_diff_add_change (n, MidiModel::NoteDiffCommand::Channel, new_channel);
 }
 
 void
-MidiRegionView::change_note_time (NoteBase* event, Evoral::Beats delta, bool relative)
+MidiRegionView::change_note_time (boost::shared_ptr<NoteType> n, Evoral::Beats delta, bool relative)
 {
 	Evoral::Beats new_time;
 
 	if (relative) {
 		if (delta < 0.0) {
-			if (event->note()->time() < -delta) {
+			if (n->time() < -delta) {
 				new_time = Evoral::Beats();
 			} else {
-				new_time = event->note()->time() + delta;
+				new_time = n->time() + delta;
 			}
 		} else {
-			new_time = event->note()->time() + delta;
+			new_time = n->time() + delta;
 		}
 	} else {
 		new_time = delta;
 	}
 
-	note_diff_add_change (event, MidiModel::NoteDiffCommand::StartTime, new_time);
+	note_diff_add_change (n, MidiModel::NoteDiffCommand::StartTime, new_time);
 }
 
 void
@@ -3111,7 +3581,10 @@ MidiRegionView::change_velocities (bool up, bool fine, bool allow_smush, bool al
 	int8_t delta;
 	int8_t value = 0;
 
-	if (_selection.empty()) {
+	Notes selected;
+	selection_as_notelist (selected);
+
+	if (selected.empty()) {
 		return;
 	}
 
@@ -3126,8 +3599,8 @@ MidiRegionView::change_velocities (bool up, bool fine, bool allow_smush, bool al
 	}
 
 	if (!allow_smush) {
-		for (Selection::iterator i = _selection.begin(); i != _selection.end(); ++i) {
-			if ((*i)->note()->velocity() < -delta || (*i)->note()->velocity() + delta > 127) {
+		for (Notes::iterator i = selected.begin(); i != selected.end(); ++i) {
+			if ((*i)->velocity() < -delta || (*i)->velocity() + delta > 127) {
 				goto cursor_label;
 			}
 		}
@@ -3135,14 +3608,12 @@ MidiRegionView::change_velocities (bool up, bool fine, bool allow_smush, bool al
 
 	start_note_diff_command (_("change velocities"));
 
-	for (Selection::iterator i = _selection.begin(); i != _selection.end();) {
-		Selection::iterator next = i;
-		++next;
+	for (Notes::iterator i = selected.begin(); i != selected.end(); ++i) {
 
 		if (all_together) {
-			if (i == _selection.begin()) {
+			if (i == selected.begin()) {
 				change_note_velocity (*i, delta, true);
-				value = (*i)->note()->velocity() + delta;
+				value = (*i)->velocity() + delta;
 			} else {
 				change_note_velocity (*i, value, false);
 			}
@@ -3150,17 +3621,15 @@ MidiRegionView::change_velocities (bool up, bool fine, bool allow_smush, bool al
 		} else {
 			change_note_velocity (*i, delta, true);
 		}
-
-		i = next;
 	}
 
 	apply_diff();
 
   cursor_label:
-	if (!_selection.empty()) {
+	if (!selected.empty()) {
 		char buf[24];
 		snprintf (buf, sizeof (buf), "Vel %d",
-		          (int) (*_selection.begin())->note()->velocity());
+		          (int) (*selected.begin())->velocity());
 		show_verbose_cursor (buf, 10, 10);
 	}
 }
@@ -3169,7 +3638,10 @@ MidiRegionView::change_velocities (bool up, bool fine, bool allow_smush, bool al
 void
 MidiRegionView::transpose (bool up, bool fine, bool allow_smush)
 {
-	if (_selection.empty()) {
+	Notes selected;
+	selection_as_notelist (selected);
+
+	if (selected.empty()) {
 		return;
 	}
 
@@ -3186,13 +3658,13 @@ MidiRegionView::transpose (bool up, bool fine, bool allow_smush)
 	}
 
 	if (!allow_smush) {
-		for (Selection::iterator i = _selection.begin(); i != _selection.end(); ++i) {
+		for (Notes::iterator i = selected.begin(); i != selected.end(); ++i) {
 			if (!up) {
-				if ((int8_t) (*i)->note()->note() + delta <= 0) {
+				if ((int8_t) (*i)->note() + delta <= 0) {
 					return;
 				}
 			} else {
-				if ((int8_t) (*i)->note()->note() + delta > 127) {
+				if ((int8_t) (*i)->note() + delta > 127) {
 					return;
 				}
 			}
@@ -3201,11 +3673,8 @@ MidiRegionView::transpose (bool up, bool fine, bool allow_smush)
 
 	start_note_diff_command (_("transpose"));
 
-	for (Selection::iterator i = _selection.begin(); i != _selection.end(); ) {
-		Selection::iterator next = i;
-		++next;
+	for (Notes::iterator i = selected.begin(); i != selected.end(); ++i) {
 		change_note_note (*i, delta, true);
-		i = next;
 	}
 
 	apply_diff ();
@@ -3227,18 +3696,18 @@ MidiRegionView::change_note_lengths (bool fine, bool shorter, Evoral::Beats delt
 		delta = -delta;
 	}
 
+	Notes selected;
+	selection_as_notelist (selected);
+
 	start_note_diff_command (_("change note lengths"));
 
-	for (Selection::iterator i = _selection.begin(); i != _selection.end(); ) {
-		Selection::iterator next = i;
-		++next;
+	for (Notes::iterator i = selected.begin(); i != selected.end(); ++i) {
 
 		/* note the negation of the delta for start */
 
 		trim_note (*i,
 		           (start ? -delta : Evoral::Beats()),
 		           (end   ? delta  : Evoral::Beats()));
-		i = next;
 	}
 
 	apply_diff ();
@@ -3248,16 +3717,16 @@ MidiRegionView::change_note_lengths (bool fine, bool shorter, Evoral::Beats delt
 void
 MidiRegionView::nudge_notes (bool forward, bool fine)
 {
-	if (_selection.empty()) {
+	Notes selected;
+	selection_as_notelist (selected);
+
+	if (selected.empty()) {
 		return;
 	}
 
-	/* pick a note as the point along the timeline to get the nudge distance.
-	   its not necessarily the earliest note, so we may want to pull the notes out
-	   into a vector and sort before using the first one.
-	*/
+	/* use the earliest note as the point along the timeline to get the nudge distance. */
 
-	const framepos_t ref_point = source_beats_to_absolute_frames ((*(_selection.begin()))->note()->time());
+	const framepos_t ref_point = source_beats_to_absolute_frames ((*selected.begin())->time());
 	Evoral::Beats    delta;
 
 	if (!fine) {
@@ -3305,11 +3774,8 @@ MidiRegionView::nudge_notes (bool forward, bool fine)
 
 	start_note_diff_command (_("nudge"));
 
-	for (Selection::iterator i = _selection.begin(); i != _selection.end(); ) {
-		Selection::iterator next = i;
-		++next;
+	for (Notes::iterator i = selected.begin(); i != selected.end(); ++i) {
 		change_note_time (*i, delta, true);
-		i = next;
 	}
 
 	apply_diff ();
@@ -3318,8 +3784,11 @@ MidiRegionView::nudge_notes (bool forward, bool fine)
 void
 MidiRegionView::change_channel(uint8_t channel)
 {
+	Notes selected;
+	selection_as_notelist (selected);
+
 	start_note_diff_command(_("change channel"));
-	for (Selection::iterator i = _selection.begin(); i != _selection.end(); ++i) {
+	for (Notes::iterator i = selected.begin(); i != selected.end(); ++i) {
 		note_diff_add_change (*i, MidiModel::NoteDiffCommand::Channel, channel);
 	}
 
@@ -3465,7 +3934,7 @@ MidiRegionView::instrument_settings_changed ()
 void
 MidiRegionView::cut_copy_clear (Editing::CutCopyOp op)
 {
-	if (_selection.empty()) {
+	if (selection_empty()) {
 		return;
 	}
 
@@ -3487,14 +3956,17 @@ MidiRegionView::cut_copy_clear (Editing::CutCopyOp op)
 
 		start_note_diff_command();
 
-		for (Selection::iterator i = _selection.begin(); i != _selection.end(); ++i) {
+		Notes selected;
+		selection_as_notelist (selected);
+
+		for (Notes::iterator i = selected.begin(); i != selected.end(); ++i) {
 			switch (op) {
 			case Copy:
 				break;
 			case Delete:
 			case Cut:
 			case Clear:
-				note_diff_remove_note (*i);
+				_note_diff_command->remove (*i);
 				break;
 			}
 		}
@@ -3513,6 +3985,10 @@ MidiRegionView::selection_as_cut_buffer () const
 		notes.insert (boost::shared_ptr<NoteType> (new NoteType (*n)));
 	}
 
+	for (set<boost::shared_ptr<NoteType> >::const_iterator i = _hidden_selection.begin(); i != _hidden_selection.end(); ++i) {
+		notes.insert (boost::shared_ptr<NoteType> (new NoteType (*(*i))));
+	}
+
 	MidiCutBuffer* cb = new MidiCutBuffer (trackview.session());
 	cb->set (notes);
 
@@ -3612,96 +4088,115 @@ MidiRegionView::paste_internal (framepos_t pos, unsigned paste_count, float time
 	apply_diff (true);
 }
 
-struct EventNoteTimeEarlyFirstComparator {
-	bool operator() (NoteBase* a, NoteBase* b) {
-		return a->note()->time() < b->note()->time();
-	}
-};
-
 void
-MidiRegionView::time_sort_events ()
+MidiRegionView::goto_next_note (bool add_to_selection)
 {
-	if (!_sort_needed) {
+	if (!_model) {
 		return;
 	}
 
-	EventNoteTimeEarlyFirstComparator cmp;
-	_events.sort (cmp);
-
-	_sort_needed = false;
-}
+	MidiTimeAxisView* const mtv = dynamic_cast<MidiTimeAxisView*>(&trackview);
+	uint16_t const channel_mask = mtv->midi_track()->get_playback_channel_mask();
 
-void
-MidiRegionView::goto_next_note (bool add_to_selection)
-{
+	boost::shared_ptr<NoteType> first;
+	boost::shared_ptr<NoteType> next;
 	bool use_next = false;
+	bool last_selected = false;
 
-	if (_events.back()->selected()) {
-		return;
-	}
+	{
+		MidiModel::ReadLock lock(_model->read_lock());
+		MidiModel::Notes& notes (_model->notes());
 
-	time_sort_events ();
+		for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end(); ++n) {
+			bool visible;
+			if (!note_in_region_range (*n, visible)) {
+				continue;
+			}
+			if (!first) {
+				first = *n;
+			}
+			last_selected = note_is_selected (*n);
+			if (last_selected) {
+				use_next = true;
+			} else if (use_next && !next && (channel_mask & (1 << (*n)->channel()))) {
+				next = *n;
+			}
+		}
+	}
 
-	MidiTimeAxisView* const mtv = dynamic_cast<MidiTimeAxisView*>(&trackview);
-	uint16_t const channel_mask = mtv->midi_track()->get_playback_channel_mask();
+	if (!first || last_selected) {
+		return;
+	}
 
-	for (Events::iterator i = _events.begin(); i != _events.end(); ++i) {
-		if ((*i)->selected()) {
-			use_next = true;
-			continue;
-		} else if (use_next) {
-			if (channel_mask & (1 << (*i)->note()->channel())) {
-				if (!add_to_selection) {
-					unique_select (*i);
-				} else {
-					note_selected (*i, true, false);
-				}
-				return;
-			}
+	if (next) {
+		if (!add_to_selection) {
+			clear_editor_note_selection ();
 		}
+		add_note_to_selection (next);
+		return;
 	}
 
 	/* use the first one */
 
-	if (!_events.empty() && (channel_mask & (1 << _events.front()->note()->channel ()))) {
-		unique_select (_events.front());
+	if (channel_mask & (1 << first->channel ())) {
+		clear_editor_note_selection ();
+		add_note_to_selection (first);
 	}
 }
 
 void
 MidiRegionView::goto_previous_note (bool add_to_selection)
 {
-	bool use_next = false;
-
-	if (_events.front()->selected()) {
+	if (!_model) {
 		return;
 	}
 
-	time_sort_events ();
-
 	MidiTimeAxisView* const mtv = dynamic_cast<MidiTimeAxisView*>(&trackview);
 	uint16_t const channel_mask = mtv->midi_track()->get_playback_channel_mask ();
 
-	for (Events::reverse_iterator i = _events.rbegin(); i != _events.rend(); ++i) {
-		if ((*i)->selected()) {
-			use_next = true;
-			continue;
-		} else if (use_next) {
-			if (channel_mask & (1 << (*i)->note()->channel())) {
-				if (!add_to_selection) {
-					unique_select (*i);
-				} else {
-					note_selected (*i, true, false);
-				}
-				return;
+	boost::shared_ptr<NoteType> last;
+	boost::shared_ptr<NoteType> next;
+	bool use_next = false;
+	bool first_selected = false;
+
+	{
+		MidiModel::ReadLock lock(_model->read_lock());
+		MidiModel::Notes& notes (_model->notes());
+
+		for (MidiModel::Notes::reverse_iterator n = notes.rbegin(); n != notes.rend(); ++n) {
+			bool visible;
+			if (!note_in_region_range (*n, visible)) {
+				continue;
+			}
+			if (!last) {
+				last = *n;
+			}
+			first_selected = note_is_selected (*n);
+			if (first_selected) {
+				use_next = true;
+			} else if (use_next && !next && (channel_mask & (1 << (*n)->channel()))) {
+				next = *n;
 			}
 		}
 	}
 
+	if (!last || first_selected) {
+		return;
+	}
+
+	if (next) {
+		if (!add_to_selection) {
+			clear_editor_note_selection ();
+		}
+		add_note_to_selection (next);
+		return;
+	}
+
 	/* use the last one */
 
-	if (!_events.empty() && (channel_mask & (1 << (*_events.rbegin())->note()->channel ()))) {
-		unique_select (*(_events.rbegin()));
+	if (channel_mask & (1 << last->channel ())) {
+		clear_editor_note_selection ();
+		add_note_to_selection (last);
 	}
 }
 
@@ -3710,18 +4205,25 @@ MidiRegionView::selection_as_notelist (Notes& selected, bool allow_all_if_none_s
 {
 	bool had_selected = false;
 
-	time_sort_events ();
+	for (Selection::iterator i = _selection.begin(); i != _selection.end(); ++i) {
+		selected.insert ((*i)->note());
+		had_selected = true;
+	}
 
-	for (Events::iterator i = _events.begin(); i != _events.end(); ++i) {
-		if ((*i)->selected()) {
-			selected.insert ((*i)->note());
-			had_selected = true;
-		}
+	for (set<boost::shared_ptr<NoteType> >::iterator i = _hidden_selection.begin(); i != _hidden_selection.end(); ++i) {
+		selected.insert (*i);
+		had_selected = true;
 	}
 
-	if (allow_all_if_none_selected && !had_selected) {
-		for (Events::iterator i = _events.begin(); i != _events.end(); ++i) {
-			selected.insert ((*i)->note());
+	if (allow_all_if_none_selected && !had_selected && _model) {
+		MidiModel::ReadLock lock(_model->read_lock());
+		MidiModel::Notes& notes (_model->notes());
+
+		for (MidiModel::Notes::iterator n = notes.begin(); n != notes.end(); ++n) {
+			bool visible;
+			if (note_in_region_range (*n, visible)) {
+				selected.insert (*n);
+			}
 		}
 	}
 }
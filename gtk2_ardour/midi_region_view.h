@@ -23,6 +23,8 @@
 #include <vector>
 #include <stdint.h>
 
+#include <boost/unordered_map.hpp>
+
 #include "pbd/signals.h"
 
 #include "ardour/midi_model.h"
@@ -176,6 +178,8 @@ public:
 	void start_note_diff_command (std::string name = "midi edit");
 	void note_diff_add_change (NoteBase* ev, ARDOUR::MidiModel::NoteDiffCommand::Property, uint8_t val);
 	void note_diff_add_change (NoteBase* ev, ARDOUR::MidiModel::NoteDiffCommand::Property, Evoral::Beats val);
+	void note_diff_add_change (boost::shared_ptr<NoteType>, ARDOUR::MidiModel::NoteDiffCommand::Property, uint8_t val);
+	void note_diff_add_change (boost::shared_ptr<NoteType>, ARDOUR::MidiModel::NoteDiffCommand::Property, Evoral::Beats val);
 	void note_diff_add_note (const boost::shared_ptr<NoteType> note, bool selected, bool show_velocity = false);
 	void note_diff_remove_note (NoteBase* ev);
 
@@ -194,7 +198,7 @@ public:
 	void   note_deselected(NoteBase* ev);
 	void   delete_selection();
 	void   delete_note (boost::shared_ptr<NoteType>);
-	size_t selection_size() { return _selection.size(); }
+	size_t selection_size() { return _selection.size() + _hidden_selection.size(); }
 	void   select_all_notes ();
 	void   select_range(framepos_t start, framepos_t end);
 	void   invert_selection ();
@@ -306,6 +310,9 @@ public:
 	void show_list_editor ();
 
 	typedef std::set<NoteBase*> Selection;
+	/** @return the selected notes which have a canvas note; see
+	 *  selection_as_notelist() for all of them.
+	 */
 	Selection selection () const {
 		return _selection;
 	}
@@ -389,12 +396,25 @@ private:
 	void trim_note(NoteBase* ev, ARDOUR::MidiModel::TimeType start_delta,
 	               ARDOUR::MidiModel::TimeType end_delta);
 
+	void change_note_channel (boost::shared_ptr<NoteType>, int8_t, bool relative=false);
+	void change_note_velocity (boost::shared_ptr<NoteType>, int8_t vel, bool relative=false);
+	void change_note_note (boost::shared_ptr<NoteType>, int8_t note, bool relative=false);
+	void change_note_time (boost::shared_ptr<NoteType>, ARDOUR::MidiModel::TimeType, bool relative=false);
+	void trim_note (boost::shared_ptr<NoteType>, ARDOUR::MidiModel::TimeType start_delta,
+	                ARDOUR::MidiModel::TimeType end_delta);
+
 	void update_drag_selection (framepos_t start, framepos_t end, double y0, double y1, bool extend);
 	void update_vertical_drag_selection (double last_y, double y, bool extend);
 
 	void add_to_selection (NoteBase*);
 	void remove_from_selection (NoteBase*);
 
+	void add_note_to_selection (boost::shared_ptr<NoteType>);
+	void add_hidden_note_to_selection (boost::shared_ptr<NoteType>);
+	void remove_note_from_selection (boost::shared_ptr<NoteType>);
+	bool note_is_selected (boost::shared_ptr<NoteType>);
+	bool selection_empty () const { return _selection.empty() && _hidden_selection.empty(); }
+
 	std::string get_note_name (boost::shared_ptr<NoteType> note, uint8_t note_value) const;
 
 	void show_verbose_cursor (std::string const &, double, double) const;
@@ -406,6 +426,7 @@ private:
 	uint8_t  _current_range_max;
 
 	typedef std::list<NoteBase*>                          Events;
+	typedef boost::unordered_map<boost::shared_ptr<NoteType>, Events::iterator> CanvasNotes;
 	typedef std::vector< boost::shared_ptr<PatchChange> > PatchChanges;
 	typedef std::vector< boost::shared_ptr<SysEx> >       SysExes;
 
@@ -415,6 +436,9 @@ private:
 
 	boost::shared_ptr<ARDOUR::MidiModel> _model;
 	Events                               _events;
+	CanvasNotes                          _canvas_notes;
+	std::vector<Note*>                   _unused_notes;
+	std::vector<Hit*>                    _unused_hits;
 	PatchChanges                         _patch_changes;
 	SysExes                              _sys_exes;
 	Note**                               _active_notes;
@@ -434,8 +458,10 @@ private:
 	/** Currently selected NoteBase objects */
 	Selection _selection;
 
-	bool _sort_needed;
-	void time_sort_events ();
+	/** Currently selected notes which have no canvas note, because
+	 *  they are outside of the display window.
+	 */
+	std::set< boost::shared_ptr<NoteType> > _hidden_selection;
 
 	MidiCutBuffer* selection_as_cut_buffer () const;
 
@@ -454,10 +480,45 @@ private:
 
 	/** connection used to connect to model's ContentChanged signal */
 	PBD::ScopedConnection content_connection;
+	/** connection used to connect to model's NotesChanged signal */
+	PBD::ScopedConnection notes_changed_connection;
+
+	/** Notes changed by the most recent NoteDiffCommand, to be redisplayed
+	 *  when the model's ContentsChanged signal arrives.
+	 */
+	std::set< boost::shared_ptr<NoteType> > _changed_notes;
+
+	void notes_changed (std::set< boost::shared_ptr<NoteType> > const &);
+	void model_changed ();
+	void update_notes (std::set< boost::shared_ptr<NoteType> > const &);
+	bool model_has_note (boost::shared_ptr<NoteType>) const;
+
+	/** Range of source beats (the visible editor page, and one page on
+	 *  either side) within which canvas notes are created.
+	 */
+	Evoral::Beats _display_start;
+	Evoral::Beats _display_end;
+	framepos_t    _display_start_frame;
+	framepos_t    _display_end_frame;
+
+	/** Length of the longest note of the model, so that redisplay_window()
+	 *  can skip the notes which end before the display window.  It is
+	 *  recomputed by redisplay_model() and only grows in between.
+	 */
+	Evoral::Beats _longest_note;
+
+	bool update_display_window (bool force);
+	bool note_in_display_window (boost::shared_ptr<NoteType>) const;
+	void redisplay_window ();
+	void display_note (boost::shared_ptr<NoteType>);
+	void horizontal_position_changed ();
 
 	NoteBase* find_canvas_note (boost::shared_ptr<NoteType>);
 	NoteBase* find_canvas_note (NoteType);
-	Events::iterator _optimization_iterator;
+	NoteBase* find_or_add_canvas_note (boost::shared_ptr<NoteType>);
+	boost::shared_ptr<NoteType> find_model_note (NoteType);
+	NoteBase* canvas_note_for_selection (boost::shared_ptr<NoteType>);
+	Events::iterator remove_canvas_note (Events::iterator);
 
 	void update_note (NoteBase*, bool update_ghost_regions = true);
 	void update_sustained (Note *, bool update_ghost_regions = true);
@@ -65,6 +65,22 @@ NoteBase::~NoteBase()
 	delete _text;
 }
 
+/** Re-use this canvas note for another model note, resetting all
+ *  state which belonged to the previous one.
+ */
+void
+NoteBase::set_note (boost::shared_ptr<NoteType> note)
+{
+	_note = note;
+	_state = None;
+	_selected = false;
+	_valid = true;
+	_mouse_x_fraction = -1.0;
+	_mouse_y_fraction = -1.0;
+
+	hide_velocity ();
+}
+
 void
 NoteBase::set_item (Item* item)
 {
@@ -98,6 +98,7 @@ class NoteBase : public sigc::trackable
 	float mouse_y_fraction() const { return _mouse_y_fraction; }
 
 	const boost::shared_ptr<NoteType> note() const { return _note; }
+	void set_note (boost::shared_ptr<NoteType>);
 	MidiRegionView& region_view() const { return _region; }
 
 	inline static uint32_t meter_style_fill_color(uint8_t vel, bool selected) {
@@ -138,7 +139,7 @@ protected:
 	ArdourCanvas::Item*               _item;
 	ArdourCanvas::Text*               _text;
 	State                             _state;
-	const boost::shared_ptr<NoteType> _note;
+	boost::shared_ptr<NoteType>       _note;
 	bool                              _with_events;
 	bool                              _own_note;
 	bool                              _selected;
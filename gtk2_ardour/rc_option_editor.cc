@@ -1888,12 +1888,35 @@ RCOptionEditor::RCOptionEditor ()
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
                 add_option (_("Misc"), procs);
+
+		EntryOption* cpus = new EntryOption (
+			"process-thread-cpus",
+			_("Pin signal processing threads to CPUs"),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::get_process_thread_cpus),
+			sigc::mem_fun (*_rc_config, &RCConfiguration::set_process_thread_cpus)
+			);
+
+		Gtkmm2ext::UI::instance()->set_tip (cpus->tip_widget(),
+			_("A list of CPUs, e.g. \"2-7\" or \"1,3,5,7\". Signal processing threads are each pinned to one of these, "
+			  "and other threads are kept off them. Leave empty to let the operating system decide."));
+		cpus->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
+
+		add_option (_("Misc"), cpus);
         }
 
 	add_option (_("Misc"), new OptionEditorHeading (S_("Options|Undo")));
 
 	add_option (_("Misc"), new UndoOptions (_rc_config));
 
+	add_option (_("Misc"),
+	     new SpinOption<uint32_t> (
+		     "history-memory-budget",
+		     _("Limit undo history memory to (0: unlimited)"),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::get_history_memory_budget),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_history_memory_budget),
+		     0, 65536, 16, 256, _("MB")
+		     ));
+
 	add_option (_("Misc"),
 	     new BoolOption (
 		     "verify-remove-last-capture",
@@ -2059,6 +2082,16 @@ RCOptionEditor::RCOptionEditor ()
 						   "that occurs when fast-forwarding or rewinding through some kinds of audio"));
 	add_option (_("Transport"), tsf);
 
+	tsf = new BoolOption (
+		     "sinc-varispeed",
+		     _("High quality varispeed"),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::get_sinc_varispeed),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_sinc_varispeed)
+		     );
+	Gtkmm2ext::UI::instance()->set_tip (tsf->tip_widget(), _("<b>When enabled</b> audio is resampled using a band-limited (windowed sinc) "
+						   "interpolator when playing at non-unity speed. This reduces aliasing at the expense of slightly higher CPU usage."));
+	add_option (_("Transport"), tsf);
+
 	ComboOption<float>* psc = new ComboOption<float> (
 		     "preroll-seconds",
 		     _("Preroll"),
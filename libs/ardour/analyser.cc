@@ -23,7 +23,10 @@
 #include "ardour/session_event.h"
 #include "ardour/transient_detector.h"
 
+#include <boost/scoped_ptr.hpp>
+
 #include "pbd/compose.h"
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 #include "pbd/i18n.h"
 
@@ -32,10 +35,14 @@ using namespace ARDOUR;
 using namespace PBD;
 
 Analyser* Analyser::the_analyser = 0;
-Glib::Threads::Mutex Analyser::analysis_active_lock;
 Glib::Threads::Mutex Analyser::analysis_queue_lock;
 Glib::Threads::Cond  Analyser::SourcesToAnalyse;
-list<boost::weak_ptr<Source> > Analyser::analysis_queue;
+Glib::Threads::Cond  Analyser::AnalysisDone;
+AnalysisQueue<Source> Analyser::analysis_queue;
+list<Analyser::Analysis*> Analyser::active;
+
+/* onset detection function, 3 = "General purpose" */
+static const uint32_t transient_mode = 3;
 
 Analyser::Analyser ()
 {
@@ -55,7 +62,26 @@ analyser_work ()
 void
 Analyser::init ()
 {
-	Glib::Threads::Thread::create (sigc::ptr_fun (analyser_work));
+	for (uint32_t n = 0; n < hardware_concurrency (); ++n) {
+		Glib::Threads::Thread::create (sigc::ptr_fun (analyser_work));
+	}
+}
+
+string
+Analyser::transient_parameters ()
+{
+	return string_compose ("%1-%2", transient_mode, Config->get_transient_sensitivity());
+}
+
+Analyser::Analysis*
+Analyser::find_active (boost::shared_ptr<Source> src)
+{
+	for (list<Analysis*>::const_iterator i = active.begin(); i != active.end(); ++i) {
+		if ((*i)->source == src) {
+			return *i;
+		}
+	}
+	return 0;
 }
 
 void
@@ -70,8 +96,52 @@ Analyser::queue_source_for_analysis (boost::shared_ptr<Source> src, bool force)
 	}
 
 	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
-	analysis_queue.push_back (boost::weak_ptr<Source>(src));
-	SourcesToAnalyse.broadcast ();
+
+	/* several workers must not analyse the same source at the same time;
+	   if it is being analysed, its worker will queue it again when done.
+	*/
+	Analysis* a = find_active (src);
+
+	if (a) {
+		if (force) {
+			a->again = true;
+		}
+		return;
+	}
+
+	if (analysis_queue.push (src)) {
+		SourcesToAnalyse.signal ();
+	}
+}
+
+void
+Analyser::prioritize (boost::shared_ptr<Source> src)
+{
+	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+
+	if (!analysis_queue.prioritize (src)) {
+		Analysis* a = find_active (src);
+		if (a) {
+			a->prioritized = true;
+		}
+	}
+}
+
+void
+Analyser::cancel (boost::shared_ptr<Source> src)
+{
+	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+
+	analysis_queue.remove (src);
+
+	for (list<Analysis*>::iterator a = active.begin(); a != active.end(); ++a) {
+		if ((*a)->source == src) {
+			(*a)->cancelled = true;
+			if ((*a)->detector) {
+				(*a)->detector->cancel ();
+			}
+		}
+	}
 }
 
 void
@@ -82,52 +152,99 @@ Analyser::work ()
 	while (true) {
 		analysis_queue_lock.lock ();
 
-	  wait:
-		if (analysis_queue.empty()) {
+		while (analysis_queue.empty()) {
 			SourcesToAnalyse.wait (analysis_queue_lock);
 		}
 
-		if (analysis_queue.empty()) {
-			goto wait;
+		boost::shared_ptr<Source> src (analysis_queue.pop ());
+
+		boost::shared_ptr<AudioFileSource> afs = boost::dynamic_pointer_cast<AudioFileSource> (src);
+
+		if (!afs || !afs->length(afs->timeline_position())) {
+			analysis_queue_lock.unlock ();
+			continue;
 		}
 
-		boost::shared_ptr<Source> src (analysis_queue.front().lock());
-		analysis_queue.pop_front();
+		/* register before unlocking, so that flush() knows about it */
+		Analysis analysis (src);
+		active.push_back (&analysis);
 		analysis_queue_lock.unlock ();
 
-		boost::shared_ptr<AudioFileSource> afs = boost::dynamic_pointer_cast<AudioFileSource> (src);
+		analyse_audio_file_source (afs, analysis);
+
+		Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+		active.remove (&analysis);
 
-		if (afs && afs->length(afs->timeline_position())) {
-			Glib::Threads::Mutex::Lock lm (analysis_active_lock);
-			analyse_audio_file_source (afs);
+		/* a forced analysis was requested while this one was running */
+		if (analysis.again && !analysis.cancelled && analysis_queue.push (src)) {
+			if (analysis.prioritized) {
+				analysis_queue.prioritize (src);
+			}
+			SourcesToAnalyse.signal ();
 		}
+
+		AnalysisDone.broadcast ();
 	}
 }
 
 void
-Analyser::analyse_audio_file_source (boost::shared_ptr<AudioFileSource> src)
+Analyser::analyse_audio_file_source (boost::shared_ptr<AudioFileSource> src, Analysis& analysis)
 {
 	AnalysisFeatureList results;
+	boost::scoped_ptr<TransientDetector> td;
 
 	try {
-		TransientDetector td (src->sample_rate());
-		td.set_sensitivity (3, Config->get_transient_sensitivity()); // "General purpose"
-		if (td.run (src->get_transients_path(), src.get(), 0, results) == 0) {
-			src->set_been_analysed (true);
-		} else {
-			src->set_been_analysed (false);
-		}
+		td.reset (new TransientDetector (src->sample_rate()));
 	} catch (...) {
 		error << string_compose(_("Transient Analysis failed for %1."), _("Audio File Source")) << endmsg;;
 		src->set_been_analysed (false);
 		return;
 	}
+
+	td->set_sensitivity (transient_mode, Config->get_transient_sensitivity());
+
+	{
+		Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+		if (analysis.cancelled) {
+			return;
+		}
+		analysis.detector = td.get();
+	}
+
+	int rv = -1;
+
+	try {
+		rv = td->run (src->get_transients_path(), src.get(), 0, results);
+	} catch (...) {
+		error << string_compose(_("Transient Analysis failed for %1."), _("Audio File Source")) << endmsg;;
+	}
+
+	{
+		Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+		analysis.detector = 0;
+		if (analysis.cancelled) {
+			return;
+		}
+	}
+
+	src->set_been_analysed (rv == 0);
 }
 
 void
 Analyser::flush ()
 {
-	Glib::Threads::Mutex::Lock lq (analysis_queue_lock);
-	Glib::Threads::Mutex::Lock la (analysis_active_lock);
+	Glib::Threads::Mutex::Lock lm (analysis_queue_lock);
+
 	analysis_queue.clear();
+
+	for (list<Analysis*>::iterator a = active.begin(); a != active.end(); ++a) {
+		(*a)->cancelled = true;
+		if ((*a)->detector) {
+			(*a)->detector->cancel ();
+		}
+	}
+
+	while (!active.empty()) {
+		AnalysisDone.wait (analysis_queue_lock);
+	}
 }
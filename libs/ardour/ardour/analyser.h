@@ -20,10 +20,15 @@
 #ifndef __ardour_analyser_h__
 #define __ardour_analyser_h__
 
+#include <list>
+#include <string>
+
 #include <glibmm/threads.h>
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 
 #include "ardour/libardour_visibility.h"
+#include "ardour/analysis_queue.h"
 
 namespace ARDOUR {
 
@@ -31,6 +36,14 @@ class AudioFileSource;
 class Source;
 class TransientDetector;
 
+/** Background analysis of sources.
+ *
+ * Sources are analysed by a pool of worker threads. Sources which are
+ * prioritized (the editor does this for the sources of selected regions)
+ * are analysed before all others. There is no separate priority for
+ * sources which are merely visible. Results are cached on disk, keyed by
+ * the source ID and the analysis parameters.
+ */
 class LIBARDOUR_API Analyser {
 
   public:
@@ -38,18 +51,41 @@ class LIBARDOUR_API Analyser {
 	~Analyser ();
 
 	static void init ();
+	/** Queue a source for analysis, unless it has been analysed already or
+	 *  @param force is false. A source which is being analysed is analysed
+	 *  again afterwards if @param force is true.
+	 */
 	static void queue_source_for_analysis (boost::shared_ptr<Source>, bool force);
+	/** analyse a queued source before all others */
+	static void prioritize (boost::shared_ptr<Source>);
+	/** drop a source from the queue, or stop its analysis if it is in progress */
+	static void cancel (boost::shared_ptr<Source>);
 	static void work ();
+	/** cancel all analyses, returns when none is in progress anymore */
 	static void flush ();
 
+	/** identifies the parameters of transient analysis, part of the cached results' name */
+	static std::string transient_parameters ();
+
   private:
+	struct Analysis {
+		Analysis (boost::shared_ptr<Source> s) : source (s), detector (0), cancelled (false), again (false), prioritized (false) {}
+		boost::shared_ptr<Source> source;
+		TransientDetector* detector;
+		bool cancelled;
+		bool again;       ///< queue the source again when done
+		bool prioritized; ///< ... with priority
+	};
+
 	static Analyser* the_analyser;
-	static Glib::Threads::Mutex analysis_active_lock;
 	static Glib::Threads::Mutex analysis_queue_lock;
 	static Glib::Threads::Cond  SourcesToAnalyse;
-	static std::list<boost::weak_ptr<Source> > analysis_queue;
+	static Glib::Threads::Cond  AnalysisDone;
+	static AnalysisQueue<Source> analysis_queue;
+	static std::list<Analysis*> active;
 
-	static void analyse_audio_file_source (boost::shared_ptr<AudioFileSource>);
+	static Analysis* find_active (boost::shared_ptr<Source>);
+	static void analyse_audio_file_source (boost::shared_ptr<AudioFileSource>, Analysis&);
 };
 
 
@@ -0,0 +1,133 @@
+/*
+    Copyright (C) 2017 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __ardour_analysis_queue_h__
+#define __ardour_analysis_queue_h__
+
+#include <list>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+namespace ARDOUR {
+
+/** Objects waiting to be analysed, in the order in which to analyse them.
+ *
+ * Prioritized objects come first, in the order in which they were
+ * prioritized, then all others in the order in which they were queued.
+ * An object is queued at most once, and the queue does not keep it alive.
+ * Not thread safe; the user must serialise access.
+ */
+template<typename T>
+class /*LIBARDOUR_API*/ AnalysisQueue
+{
+  public:
+	bool empty () const {
+		return _normal.empty() && _priority.empty();
+	}
+
+	bool contains (boost::shared_ptr<T> const & obj) const {
+		return find (_priority, obj) != _priority.end() || find (_normal, obj) != _normal.end();
+	}
+
+	/** add @param obj at the end, unless it is already queued
+	 *  @return true if it was added
+	 */
+	bool push (boost::shared_ptr<T> const & obj) {
+		if (contains (obj)) {
+			return false;
+		}
+		_normal.push_back (boost::weak_ptr<T> (obj));
+		return true;
+	}
+
+	/** move @param obj before all objects which are not prioritized
+	 *  @return true if it was queued
+	 */
+	bool prioritize (boost::shared_ptr<T> const & obj) {
+		typename Queue::iterator i = find (_normal, obj);
+		if (i == _normal.end()) {
+			return find (_priority, obj) != _priority.end();
+		}
+		_priority.splice (_priority.end(), _normal, i);
+		return true;
+	}
+
+	/** @return true if @param obj was queued */
+	bool remove (boost::shared_ptr<T> const & obj) {
+		typename Queue::iterator i;
+		if ((i = find (_priority, obj)) != _priority.end()) {
+			_priority.erase (i);
+			return true;
+		}
+		if ((i = find (_normal, obj)) != _normal.end()) {
+			_normal.erase (i);
+			return true;
+		}
+		return false;
+	}
+
+	/** @return the next object to analyse, or 0 if no queued object
+	 *  exists anymore.
+	 */
+	boost::shared_ptr<T> pop () {
+		while (!empty()) {
+			Queue& q (_priority.empty() ? _normal : _priority);
+			boost::shared_ptr<T> obj (q.front().lock());
+			q.pop_front ();
+			if (obj) {
+				return obj;
+			}
+		}
+		return boost::shared_ptr<T> ();
+	}
+
+	void clear () {
+		_normal.clear ();
+		_priority.clear ();
+	}
+
+  private:
+	typedef std::list<boost::weak_ptr<T> > Queue;
+
+	Queue _normal;
+	Queue _priority;
+
+	static typename Queue::iterator find (Queue& q, boost::shared_ptr<T> const & obj) {
+		for (typename Queue::iterator i = q.begin(); i != q.end(); ++i) {
+			if (i->lock() == obj) {
+				return i;
+			}
+		}
+		return q.end();
+	}
+
+	static typename Queue::const_iterator find (Queue const & q, boost::shared_ptr<T> const & obj) {
+		for (typename Queue::const_iterator i = q.begin(); i != q.end(); ++i) {
+			if (i->lock() == obj) {
+				return i;
+			}
+		}
+		return q.end();
+	}
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_analysis_queue_h__ */
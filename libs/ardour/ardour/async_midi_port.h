@@ -21,11 +21,13 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
 
 #include <boost/function.hpp>
 
 #include "pbd/xml++.h"
 #include "pbd/crossthread.h"
+#include "pbd/mpsc_queue.h"
 #include "pbd/signals.h"
 #include "pbd/ringbuffer.h"
 
@@ -82,8 +84,35 @@ class LIBARDOUR_API AsyncMIDIPort : public ARDOUR::MidiPort, public MIDI::Port {
         MIDI::timestamp_t       _last_write_timestamp;
 	bool                    have_timer;
 	boost::function<framecnt_t (void)> timer;
+	/* Short messages written by non-process threads are queued without
+	 * taking a lock. Anything that does not fit (sysex) goes into
+	 * output_fifo, whose writers serialize on output_fifo_lock. A shared
+	 * sequence number restores the order in which they were written.
+	 */
+	static const uint32_t max_queued_event_size = 16;
+
+	struct QueuedEvent {
+		MIDI::timestamp_t time;
+		guint             seq;
+		uint32_t          size;
+		MIDI::byte        data[max_queued_event_size];
+	};
+
+	PBD::MPSCQueue<QueuedEvent> output_queue;
 	RingBuffer< Evoral::Event<double> > output_fifo;
+	RingBuffer<guint> output_fifo_seq;
+	gint _output_seq;
+	/* process thread: short messages taken from output_queue, in write
+	 * order, including those held back until the events written before
+	 * them have arrived.
+	 */
+	std::vector<QueuedEvent> _queued;
+	guint    _next_seq;    ///< sequence number of the next event to send
+	guint    _gap_seq;     ///< missing sequence number at which flushing stopped
+	uint32_t _gap_flushes; ///< number of consecutive flushes that stopped at _gap_seq
+	gint     _n_held;      ///< size of _queued, for drain()
         EventRingBuffer<MIDI::timestamp_t> input_fifo;
+	std::vector<MIDI::byte> _input_buffer;
         Glib::Threads::Mutex output_fifo_lock;
 	CrossThreadChannel _xthread;
 
@@ -21,6 +21,8 @@
 
 #include <cstring>
 
+#include <glib.h>
+
 #include "ardour/buffer.h"
 #include "ardour/runtime_functions.h"
 
@@ -52,6 +54,7 @@ public:
 		memcpy(_data + dst_offset, src + src_offset, sizeof(Sample) * len);
 		_silent = false;
 		_written = true;
+		count_copy (len);
 	}
 
 	void read_from_with_gain (const Sample* src, framecnt_t len, gain_t gain, frameoffset_t dst_offset = 0, frameoffset_t src_offset = 0) {
@@ -64,6 +67,7 @@ public:
 		}
 		_silent = false;
 		_written = true;
+		count_copy (len);
 	}
 
 	/** Copy samples from src buffer starting at src_offset into self starting at dst_offset
@@ -85,6 +89,7 @@ public:
 			_silent = _silent && src.silent();
 		}
 		_written = true;
+		count_copy (len);
 	}
 
 	/** Accumulate (add) @a len frames @a src starting at @a src_offset into self starting at @a dst_offset */
@@ -106,6 +111,7 @@ public:
 
 		_silent = (src.silent() && _silent);
 		_written = true;
+		count_copy (len);
 	}
 
 	/** Accumulate (add) @a len frames @a src starting at @a src_offset into self starting at @a dst_offset */
@@ -120,6 +126,7 @@ public:
 
 		_silent = false;
 		_written = true;
+		count_copy (len);
 	}
 
 	/** Accumulate (add) @a len frames @a src starting at @a src_offset into self starting at @dst_offset
@@ -140,6 +147,7 @@ public:
 
 		_silent = ( (src.silent() && _silent) || (_silent && gain_coeff == 0) );
 		_written = true;
+		count_copy (len);
 	}
 
 	/** Accumulate (add) @a len frames FROM THE START OF @a src into self
@@ -155,6 +163,7 @@ public:
 
 		_silent = (_silent && gain_coeff == 0);
 		_written = true;
+		count_copy (len);
 	}
 
 	/** Accumulate (add) @a len frames FROM THE START OF @a src into self
@@ -174,6 +183,7 @@ public:
 
 		_silent = (_silent && initial == 0 && target == 0);
 		_written = true;
+		count_copy (len);
 	}
 
 	/** apply a fixed gain factor to the audio buffer
@@ -196,6 +206,13 @@ public:
 		_written = false;
 	}
 
+	/** Exchange the data of this buffer with that of @a other, instead of copying it.
+	 *
+	 * Both buffers must own their data and have the same capacity.
+	 * @return false (and leave both buffers untouched) otherwise.
+	 */
+	bool swap_data (AudioBuffer& other);
+
 	/** Reallocate the buffer used internally to handle at least @nframes of data
 	 *
 	 * Constructor MUST have been passed capacity!=0 or this will die (to prevent mem leaks).
@@ -230,10 +247,28 @@ public:
 	bool written() const { return _written; }
 	void set_written(bool w) { _written = w; }
 
+	/* Instrumentation: count the bytes of audio copied or mixed from one
+	 * buffer into another (by all threads), to measure the cost of moving
+	 * data between processors, routes and ports.
+	 */
+	static void set_count_copies (bool yn) { _count_copies = yn; }
+	static bool count_copies () { return _count_copies; }
+	/** @return the number of bytes copied since the last call */
+	static uint32_t reset_bytes_copied ();
+
   private:
 	bool    _owns_data;
 	bool    _written;
 	Sample* _data; ///< Actual buffer contents
+
+	static bool _count_copies;
+	static gint _bytes_copied;
+
+	static void count_copy (framecnt_t len) {
+		if (_count_copies) {
+			g_atomic_int_add (&_bytes_copied, len * sizeof (Sample));
+		}
+	}
 };
 
 
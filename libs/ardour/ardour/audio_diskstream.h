@@ -206,6 +206,12 @@ class LIBARDOUR_API AudioDiskstream : public Diskstream
 	typedef std::vector<ChannelInfo*> ChannelList;
 
 	CubicInterpolation interpolation;
+	SincInterpolation  sinc_interpolation;
+	bool               _sinc_varispeed;
+	bool               _varispeed_active;
+
+	void use_sinc_interpolation (bool);
+	void parameter_changed (std::string const &);
 
 	/* The two central butler operations */
 	int do_flush (RunContext context, bool force = false);
@@ -23,6 +23,7 @@
 #include <vector>
 #include <string>
 #include <boost/utility.hpp>
+#include <glib.h>
 #include "vamp-sdk/Plugin.h"
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
@@ -50,6 +51,9 @@ class LIBARDOUR_API AudioAnalyser : public boost::noncopyable {
 
 	void reset ();
 
+	/** stop a running analysis, may be called from any thread */
+	void cancel ();
+
   protected:
 	float sample_rate;
 	AnalysisPlugin* plugin;
@@ -58,6 +62,8 @@ class LIBARDOUR_API AudioAnalyser : public boost::noncopyable {
 	framecnt_t bufsize;
 	framecnt_t stepsize;
 
+	gint _cancelled;
+
 	int initialize_plugin (AnalysisPluginKey name, float sample_rate);
 	int analyse (const std::string& path, Readable*, uint32_t channel);
 
@@ -22,6 +22,11 @@
 
 #include <vector>
 #include <list>
+#include <map>
+
+#include <glibmm/threads.h>
+
+#include "evoral/Range.hpp"
 
 #include "ardour/ardour.h"
 #include "ardour/playlist.h"
@@ -45,8 +50,22 @@ public:
 
 	bool destroy_region (boost::shared_ptr<Region>);
 
+	/** A segment of region that needs to be read */
+	struct Segment {
+		Segment (boost::shared_ptr<AudioRegion> r, Evoral::Range<framepos_t> a) : region (r), range (a) {}
+
+		boost::shared_ptr<AudioRegion> region; ///< the region
+		Evoral::Range<framepos_t> range;       ///< range of the region to read, in session frames
+	};
+
+	typedef std::list<Segment> Segments;
+
+	void visible_segments (framepos_t start, framepos_t end, Segments&);
+
 protected:
 
+	void layout_changed (framepos_t start, framepos_t end);
+
 	void pre_combine (std::vector<boost::shared_ptr<Region> >&);
 	void post_combine (std::vector<boost::shared_ptr<Region> >&, boost::shared_ptr<Region>);
 	void pre_uncombine (std::vector<boost::shared_ptr<Region> >&, boost::shared_ptr<Region>);
@@ -57,6 +76,23 @@ private:
 	bool region_changed (const PBD::PropertyChange&, boost::shared_ptr<Region>);
 	void source_offset_changed (boost::shared_ptr<AudioRegion>);
         void load_legacy_crossfades (const XMLNode&, int version);
+
+	/* Segments are cached in tiles of a fixed number of frames, so that
+	   consecutive reads (and reads of each channel) do not need to work
+	   out the layout of the playlist again, and so that a change to
+	   the playlist only discards the tiles that it touches.
+	*/
+	static const framecnt_t segment_tile_frames = 65536;
+	static const size_t max_segment_tiles = 1024;
+
+	typedef std::map<framepos_t, Segments> SegmentTiles;
+
+	SegmentTiles _segment_tiles;
+	Glib::Threads::Mutex _segment_lock;
+
+	void compute_segments (framepos_t start, framepos_t end, Segments&);
+	Segments const & segment_tile (framepos_t tile);
+	void append_segments (framepos_t start, framepos_t end, Segments&);
 };
 
 } /* namespace ARDOUR */
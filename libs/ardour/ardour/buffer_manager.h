@@ -41,9 +41,11 @@ public:
 	static void           put_thread_buffers (ThreadBuffers*);
 
 	static void ensure_buffers (ChanCount howmany = ChanCount::ZERO, size_t custom = 0);
+	static void reallocate_thread_buffers (ThreadBuffers*);
 
 private:
         static Glib::Threads::Mutex rb_mutex;
+        static Glib::Threads::Mutex alloc_mutex;
 
 	typedef PBD::RingBufferNPT<ThreadBuffers*> ThreadBufferFIFO;
 	typedef std::list<ThreadBuffers*> ThreadBufferList;
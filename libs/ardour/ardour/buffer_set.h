@@ -137,6 +137,7 @@ public:
 	void read_from(const BufferSet& in, framecnt_t nframes);
 	void read_from(const BufferSet& in, framecnt_t nframes, DataType);
 	void merge_from(const BufferSet& in, framecnt_t nframes);
+	void forward_from(BufferSet& in, framecnt_t nframes);
 
 	template <typename BS, typename B>
 	class iterator_base {
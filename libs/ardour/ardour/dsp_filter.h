@@ -26,6 +26,8 @@
 #include <glibmm.h>
 #include <fftw3.h>
 
+#include <vector>
+
 #include "pbd/malign.h"
 
 #include "ardour/buffer_set.h"
@@ -257,6 +259,11 @@ namespace ARDOUR { namespace DSP {
 
 			/** reset filter state */
 			void reset () { _z1 = _z2 = 0.0; }
+
+			/** query current filter coefficients (normalized, a0 == 1) */
+			void coefficients (double& a1, double& a2, double& b0, double& b1, double& b2) const {
+				a1 = _a1; a2 = _a2; b0 = _b0; b1 = _b1; b2 = _b2;
+			}
 		private:
 			double _rate;
 			float  _z1, _z2;
@@ -264,6 +271,222 @@ namespace ARDOUR { namespace DSP {
 			double _b0, _b1, _b2;
 	};
 
+	/** Multi-channel cascade of Biquad filters
+	 *
+	 * All channels are processed in lock-step, the filter state
+	 * of all channels is kept in contiguous arrays so that the
+	 * inner loop (across channels) can be vectorized (SSE/AVX/NEON).
+	 *
+	 * Coefficients can be set for all channels at once or
+	 * individually per channel.
+	 */
+	class LIBARDOUR_API BiquadCascade {
+		public:
+			/** Instantiate filter cascade
+			 *
+			 * @param samplerate Samplerate
+			 * @param n_channels number of channels to process
+			 * @param n_stages number of Biquad sections per channel
+			 */
+			BiquadCascade (double samplerate, uint32_t n_channels, uint32_t n_stages);
+			~BiquadCascade ();
+
+			uint32_t n_channels () const { return _n_channels; }
+			uint32_t n_stages () const { return _n_stages; }
+
+			/** setup filter stage of all channels, compute coefficients
+			 *
+			 * @param stage filter section 0 .. n_stages - 1
+			 * @param t filter type (LowPass, HighPass, etc)
+			 * @param freq filter frequency
+			 * @param Q filter quality
+			 * @param gain filter gain
+			 */
+			void compute (uint32_t stage, Biquad::Type t, double freq, double Q, double gain);
+
+			/** setup filter stage of all channels, set coefficients directly */
+			void configure (uint32_t stage, double a1, double a2, double b0, double b1, double b2);
+
+			/** setup filter stage of a single channel, set coefficients directly */
+			void configure_channel (uint32_t stage, uint32_t chn, double a1, double a2, double b0, double b1, double b2);
+
+			/** process audio data, in-place
+			 *
+			 * @param data array of n_channels pointers to audio-data
+			 * @param n_samples number of samples to process
+			 */
+			void run (float** data, const uint32_t n_samples);
+
+			/** process audio data of a BufferSet, in-place
+			 *
+			 * channel c of the filter processes buffer in.get (AUDIO, c),
+			 * unmapped channels are skipped.
+			 */
+			void run_map (BufferSet* bufs, const ChanMapping& in, pframes_t n_samples, framecnt_t offset);
+
+			/** reset filter state */
+			void reset ();
+
+		private:
+			BiquadCascade (const BiquadCascade&);
+
+			double   _rate;
+			uint32_t _n_channels;
+			uint32_t _n_stages;
+			uint32_t _stride; // n_channels padded to a multiple of 8
+
+			/* [stage * _stride + channel] */
+			float* _a1;
+			float* _a2;
+			float* _b0;
+			float* _b1;
+			float* _b2;
+			float* _z1;
+			float* _z2;
+
+			float*  _x; // [_stride] current sample of every channel
+			float** _ptr;
+	};
+
+	/** FIR Filter, direct form convolution
+	 *
+	 * This is suitable for short impulse-responses (up to a few hundred taps).
+	 */
+	class LIBARDOUR_API FIRFilter {
+		public:
+			/** Instantiate FIR Filter
+			 *
+			 * @param max_taps maximum length of the impulse-response
+			 */
+			FIRFilter (uint32_t max_taps);
+			~FIRFilter ();
+
+			/** set filter coefficients (impulse response) and reset the filter state
+			 *
+			 * @param coeff array of coefficients
+			 * @param n_taps number of coefficients, at most max_taps
+			 */
+			void set_coefficients (float const* coeff, const uint32_t n_taps);
+
+			/** process audio data
+			 *
+			 * @param data pointer to audio-data
+			 * @param n_samples number of samples to process
+			 */
+			void run (float *data, const uint32_t n_samples);
+
+			/** reset filter state */
+			void reset ();
+
+		private:
+			FIRFilter (const FIRFilter&);
+			uint32_t _max_taps;
+			uint32_t _n_taps;
+			uint32_t _pos;
+			float*   _coeff;
+			float*   _hist;
+	};
+
+	/** Partitioned FFT Convolution
+	 *
+	 * Mono, zero-latency convolution engine for long impulse-responses
+	 * (reverb, cabinet and room simulation).
+	 *
+	 * The first block_size taps are processed in the time domain,
+	 * the remainder of the IR is split into partitions which are
+	 * convolved in the frequency domain (overlap-save, with a
+	 * frequency-domain delay-line).
+	 *
+	 * With uniform partitioning all partitions have block_size length.
+	 * Non-uniform partitioning uses partitions growing by a factor of 4
+	 * (up to max_partition) with increasing distance from the start of
+	 * the IR, which considerably reduces the CPU load for long IRs.
+	 *
+	 * run() may be called with arbitrary n_samples. Large partitions
+	 * are computed in the process-cycle that completes them, so the
+	 * DSP load is not constant for non-uniform partitions.
+	 */
+	class LIBARDOUR_API Convolver {
+		public:
+			/** Instantiate convolver
+			 *
+			 * @param block_size size of the smallest partition, rounded up to a power of two
+			 * @param uniform if true, use only partitions of block_size
+			 * @param max_partition upper limit for the size of non-uniform partitions
+			 */
+			Convolver (uint32_t block_size, bool uniform = false, uint32_t max_partition = 8192);
+			~Convolver ();
+
+			/** set impulse response and reset the convolver state.
+			 * This allocates memory and plans FFTs and must not be called
+			 * concurrently with run().
+			 *
+			 * @param ir impulse response
+			 * @param n_samples length of the impulse response
+			 */
+			void set_ir (float const* ir, const uint32_t n_samples);
+
+			/** process audio data, in-place
+			 *
+			 * @param data pointer to audio-data
+			 * @param n_samples number of samples to process
+			 */
+			void run (float* data, const uint32_t n_samples);
+
+			/** reset convolver state, keep the IR */
+			void reset ();
+
+			uint32_t block_size () const { return _block_size; }
+			uint32_t ir_length () const { return _ir_length; }
+			uint32_t n_partitions () const;
+
+		private:
+			Convolver (const Convolver&);
+
+			/** uniformly partitioned segment of the IR, FFT size 2 * size */
+			struct Segment {
+				Segment (uint32_t size, uint32_t offset, uint32_t n_part, float const* ir, uint32_t ir_len);
+				~Segment ();
+
+				void reset ();
+				void process (float const* hist, uint32_t hist_pos, uint32_t hist_mask, float* out, uint32_t out_mask);
+
+				uint32_t size;
+				uint32_t offset;
+				uint32_t n_part;
+				uint32_t cur;
+				uint32_t write_pos;
+
+				float*         time_data;  // [2 * size]
+				fftwf_complex* freq_data;  // [size + 1]
+				fftwf_complex* ir_freq;    // [n_part * (size + 1)]
+				fftwf_complex* fdl;        // [n_part * (size + 1)] frequency-domain delay-line
+
+				fftwf_plan fwd;
+				fftwf_plan inv;
+			};
+
+			void clear_segments ();
+			void process_block ();
+
+			uint32_t _block_size;
+			bool     _uniform;
+			uint32_t _max_partition;
+			uint32_t _ir_length;
+
+			FIRFilter _head;
+			std::vector<Segment*> _segments;
+
+			float*   _hist;     // input history ring-buffer
+			uint32_t _hist_mask;
+			uint32_t _hist_pos;
+			float*   _out;      // output accumulation ring-buffer
+			uint32_t _out_mask;
+			uint32_t _out_pos;
+			uint32_t _in_fill;
+			uint64_t _n_blocks;
+	};
+
 	class LIBARDOUR_API FFTSpectrum {
 		public:
 			FFTSpectrum (uint32_t window_size, double rate);
@@ -293,6 +516,7 @@ namespace ARDOUR { namespace DSP {
 			}
 
 		private:
+			friend class Convolver;
 			static Glib::Threads::Mutex fft_planner_lock;
 			float* hann_window;
 
@@ -0,0 +1,93 @@
+/*
+    Copyright (C) 2017 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __ardour_dsp_stats_h__
+#define __ardour_dsp_stats_h__
+
+#include <stdint.h>
+#include <glib.h>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/cycles.h"
+
+namespace ARDOUR {
+
+/** Execution time statistics of a single DSP unit (Route, Processor).
+ *
+ * Samples are added by the process thread, using CPU cycle counters.
+ * Readers (GUI, Lua, control surfaces) may query the statistics from any
+ * thread at any time. Neither side takes a lock: the writer publishes its
+ * data using a sequence counter and the reader simply retries if it
+ * raced with an update.
+ */
+class LIBARDOUR_API DSPStats
+{
+public:
+	DSPStats ();
+
+	/* process thread */
+
+	void start () { _start = get_cycles (); }
+	void update () { add (get_cycles () - _start); }
+	void add (cycles_t elapsed);
+
+	/* any thread */
+
+	/** discard all data; done by the writer on its next update */
+	void reset () { g_atomic_int_set (&_reset, 1); }
+
+	/** query execution time, all values in microseconds.
+	 * @return false if no data has been collected, yet.
+	 */
+	bool get_stats (uint64_t& count, double& min, double& max, double& avg) const;
+
+	/** estimate the execution time (in microseconds) below which
+	 * the given fraction (0..1) of all runs completed.
+	 */
+	double percentile (double fraction) const;
+
+	static double cycles_per_usec ();
+
+	/* histogram, 4 bins per octave */
+	static const int n_bins = 128;
+
+private:
+	struct Data {
+		uint64_t count;
+		uint64_t total;
+		cycles_t min;
+		cycles_t max;
+		uint32_t bins[n_bins];
+	};
+
+	void clear ();
+	bool snapshot (Data&) const;
+
+	static int bin_index (cycles_t);
+	static double bin_lower (int);
+
+	cycles_t _start;
+	Data _data;
+	mutable gint _seq;
+	mutable gint _reset;
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_dsp_stats_h__ */
@@ -26,8 +26,11 @@
 
 #include "audiographer/utils/identity_vertex.h"
 
+#include <set>
+
 #include <boost/ptr_container/ptr_list.hpp>
 #include <glibmm/threadpool.h>
+#include <glibmm/threads.h>
 
 namespace AudioGrapher {
 	class SampleRateConverter;
@@ -60,6 +63,7 @@ class LIBARDOUR_API ExportGraphBuilder
 	typedef boost::shared_ptr<AudioGrapher::IdentityVertex<Sample> > IdentityVertexPtr;
 	typedef boost::shared_ptr<AudioGrapher::Analyser> AnalysisPtr;
 	typedef std::map<ExportChannelPtr,  IdentityVertexPtr> ChannelMap;
+	typedef std::map<boost::shared_ptr<ExportTimespan>, ChannelMap> TimespanChannelMap;
 	typedef std::map<std::string, AnalysisPtr> AnalysisMap;
 
   public:
@@ -68,6 +72,7 @@ class LIBARDOUR_API ExportGraphBuilder
 	~ExportGraphBuilder ();
 
 	int process (framecnt_t frames, bool last_cycle);
+	int process_timespans (framepos_t position, framecnt_t frames);
 	bool post_process (); // returns true when finished
 	bool need_postprocessing () const { return !intermediates.empty(); }
 	bool realtime() const { return _realtime; }
@@ -106,7 +111,7 @@ class LIBARDOUR_API ExportGraphBuilder
 		void copy_files (std::string orig_path);
 
 		FileSpec               config;
-		std::list<ExportFilenamePtr> filenames;
+		std::list<std::string> copy_paths;
 		PBD::ScopedConnection  copy_files_connection;
 
 		std::string writer_filename;
@@ -245,6 +250,7 @@ class LIBARDOUR_API ExportGraphBuilder
 
 		ExportGraphBuilder &      parent;
 		FileSpec                  config;
+		boost::shared_ptr<ExportTimespan> timespan;
 		boost::ptr_list<SilenceHandler> children;
 		InterleaverPtr            interleaver;
 		ChunkerPtr                chunker;
@@ -258,18 +264,50 @@ class LIBARDOUR_API ExportGraphBuilder
 	typedef boost::ptr_list<ChannelConfig> ChannelConfigList;
 	ChannelConfigList channel_configs;
 
-	// The sources of all data, each channel is read only once
-	ChannelMap channels;
+	// The sources of all data, each channel is read only once per cycle
+	TimespanChannelMap channels;
 
 	framecnt_t process_buffer_frames;
 
 	std::list<Intermediate *> intermediates;
+	Glib::Threads::Mutex intermediates_lock;
+
+	/* processing several timespans at once */
+
+	struct TimespanJob {
+		ChannelMap const * channels;
+		framecnt_t offset;
+		framecnt_t frames;
+		bool last_cycle;
+	};
+
+	void process_timespan (TimespanJob const & job);
+	void run_timespan_job (TimespanJob const & job);
+	void run_post_process_job (Intermediate * intermediate);
+
+	void job_failed (std::exception const & e);
+	void job_finished ();
+	void wait_for_jobs ();
+
+	std::map<ExportChannelPtr, Sample const *> channel_data;
+	std::set<boost::shared_ptr<ExportTimespan> > finished_timespans;
+	std::vector<TimespanJob> jobs;
+	Glib::Threads::Mutex jobs_lock;
+	Glib::Threads::Cond  jobs_done;
+	gint                 jobs_pending;
+	std::string          job_error;
+
+	std::vector<Intermediate *> finished_intermediates;
+
+	/* samples of intermediate data which may still be kept in memory */
+	framecnt_t memory_budget;
 
 	AnalysisMap analysis_map;
 
 	bool _realtime;
 
 	Glib::ThreadPool thread_pool;
+	Glib::ThreadPool post_process_pool;
 };
 
 } // namespace ARDOUR
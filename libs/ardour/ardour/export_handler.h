@@ -155,6 +155,17 @@ class LIBARDOUR_API ExportHandler : public ExportElementFactory, public sigc::tr
 	PBD::ScopedConnection process_connection;
 	framepos_t             process_position;
 
+	/* Single pass export of all timespans */
+
+	bool use_single_pass () const;
+	void start_single_pass ();
+	int  process_single_pass (framecnt_t frames);
+
+	bool                   single_pass;
+	framepos_t             single_pass_end;
+	/** all timespans, in order of their start */
+	std::vector<ExportTimespanPtr> single_pass_timespans;
+
 	/* CD Marker stuff */
 
 	struct CDMarkerStatus {
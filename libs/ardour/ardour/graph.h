@@ -35,6 +35,8 @@
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
 #include "ardour/audio_backend.h"
+#include "ardour/cycles.h"
+#include "ardour/dsp_stats.h"
 #include "ardour/session_handle.h"
 
 namespace ARDOUR
@@ -46,12 +48,40 @@ class Graph;
 class Route;
 class Session;
 class GraphEdges;
+class ProcessThread;
 
 typedef boost::shared_ptr<GraphNode> node_ptr_t;
 
 typedef std::list< node_ptr_t > node_list_t;
 typedef std::set< node_ptr_t > node_set_t;
 
+/** Statistics of one of the threads which run the process graph.
+ *  Updated by the thread itself, may be read from any thread.
+ */
+class LIBARDOUR_API GraphThreadStats
+{
+public:
+	GraphThreadStats ();
+
+	/** time that the thread spent processing graph nodes, per cycle */
+	DSPStats& cycle_stats () { return _cycle_stats; }
+	/** number of times that the thread was found on a different CPU than before */
+	uint32_t migrations () const { return g_atomic_int_get (&_migrations); }
+	/** the CPU that the thread last ran on, or -1 if unknown */
+	int cpu () const { return g_atomic_int_get (&_cpu); }
+
+	void node_start (gint cycle);
+	void node_end () { _busy += get_cycles () - _start; }
+
+private:
+	DSPStats     _cycle_stats;
+	mutable gint _migrations;
+	mutable gint _cpu;
+	gint         _cycle;
+	cycles_t     _start;
+	cycles_t     _busy;
+};
+
 class LIBARDOUR_API Graph : public SessionHandleRef
 {
 public:
@@ -66,9 +96,13 @@ public:
 	void dec_ref();
 	void restart_cycle();
 
-	bool run_one();
-	void helper_thread();
-	void main_thread();
+	bool run_one (GraphThreadStats* stats = 0);
+	void helper_thread (uint32_t n);
+	void main_thread (uint32_t n);
+
+	/** @return statistics of the @param n th process thread, or 0 */
+	GraphThreadStats* thread_stats (uint32_t n);
+	uint32_t n_thread_stats () const { return _thread_stats.size (); }
 
 	int silent_process_routes (pframes_t nframes, framepos_t start_frame, framepos_t end_frame,
 	                           bool& need_butler);
@@ -93,6 +127,12 @@ private:
 
 	void reset_thread_list ();
 	void drop_threads ();
+	void setup_thread (ProcessThread*, uint32_t n);
+
+	/* one per possible thread, never resized so that stats can be
+	   read while threads come and go */
+	std::vector<GraphThreadStats> _thread_stats;
+	volatile gint _cycle;
 
 	node_list_t _nodes_rt[2];
 
@@ -54,6 +54,12 @@ class LIBARDOUR_API InternalSend : public Send
 		return mixbufs;
 	}
 
+	/** The buffers are only used by our target's InternalReturn, which
+	 *  may take their data (see BufferSet::forward_from()) */
+	BufferSet & get_buffers () {
+		return mixbufs;
+	}
+
 	void set_can_pan (bool yn);
 	uint32_t pan_outs () const;
 
@@ -18,8 +18,11 @@
 */
 
 #include <math.h>
+#include <stdint.h>
 #include <samplerate.h>
 
+#include <vector>
+
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
 
@@ -56,6 +59,11 @@ public:
 			phase[i] = 0.0;
 		}
 	}
+
+	/** continue where another interpolator (with the same number of channels) left off */
+	void copy_phase (Interpolation const& other) {
+		phase = other.phase;
+	}
 };
 
 class LIBARDOUR_API LinearInterpolation : public Interpolation {
@@ -66,6 +74,62 @@ public:
 class LIBARDOUR_API CubicInterpolation : public Interpolation {
 public:
 	framecnt_t interpolate (int channel, framecnt_t nframes, Sample* input, Sample* output);
+
+	/** interpolate n_channels at once.
+	 *
+	 * All channels are expected to be at the same phase (phase of channel 0
+	 * is used). Read-positions and weights are calculated once and shared by
+	 * all channels. The result is identical to calling interpolate() for
+	 * every channel.
+	 *
+	 * @param input array of n_channels input buffers
+	 * @param output array of n_channels output buffers
+	 */
+	framecnt_t interpolate (framecnt_t nframes, uint32_t n_channels, Sample** input, Sample** output);
+
+	/** allocate space for processing up to nframes with the multi-channel
+	 * interpolate() method. This is not realtime-safe. */
+	void reserve (framecnt_t nframes);
+
+private:
+	std::vector<int32_t> _idx;
+	std::vector<int32_t> _prev;
+	std::vector<float>   _frac;
+};
+
+/** Band-limited interpolation using a windowed-sinc kernel.
+ *
+ * The kernel is pre-computed in a polyphase table. Coefficients are
+ * interpolated linearly between adjacent phases, once per output sample,
+ * and shared by all channels.
+ *
+ * The playback-distance is calculated identically to CubicInterpolation,
+ * but the interpolator needs to look @ref lookahead samples beyond that
+ * (the last few samples are not consumed, and previously consumed samples
+ * are retained internally).
+ */
+class LIBARDOUR_API SincInterpolation : public Interpolation {
+public:
+	SincInterpolation ();
+	~SincInterpolation ();
+
+	enum {
+		taps = 16,
+		lookahead = taps / 2
+	};
+
+	framecnt_t interpolate (int channel, framecnt_t nframes, Sample* input, Sample* output);
+	framecnt_t interpolate (framecnt_t nframes, uint32_t n_channels, Sample** input, Sample** output);
+
+	void add_channel_to (int, int);
+	void remove_channel_from ();
+	void reset ();
+
+private:
+	framecnt_t process (uint32_t chn, uint32_t n_channels, framecnt_t nframes, Sample** input, Sample** output);
+
+	std::vector<Sample*> _history; // last `taps` consumed input samples, per channel
+	Sample _coeff[64 * taps];      // interpolated kernel for a chunk of 64 output samples
 };
 
 class BufferSet;
@@ -0,0 +1,233 @@
+/*
+    Copyright (C) 2017 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __ardour_interval_index_h__
+#define __ardour_interval_index_h__
+
+#include <algorithm>
+#include <vector>
+
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+/** An augmented interval tree over closed intervals [first, last].
+ *
+ * Items are kept in an array sorted by their first position, which is
+ * implicitly arranged as a balanced binary tree: the middle element of
+ * each sub-range is the root of that sub-range. Every node records the
+ * largest last position in its subtree, so queries can skip subtrees
+ * that end before the range of interest.
+ *
+ * Empty intervals (last < first) are never reported as overlapping.
+ *
+ * Items are reported in order of their first position; items with equal
+ * first positions stay in the order in which they were added.
+ *
+ * The index does not follow changes to the items: add() all of them,
+ * then build(), and start over with clear() when many of them change.
+ * A single item can be moved in place with move().
+ */
+template<typename T>
+class /*LIBARDOUR_API*/ IntervalIndex
+{
+  public:
+	void clear () {
+		_items.clear ();
+		_max_last.clear ();
+	}
+
+	void reserve (size_t n) {
+		_items.reserve (n);
+	}
+
+	void add (framepos_t first, framepos_t last, T const & value) {
+		_items.push_back (Item (first, last, value));
+	}
+
+	void build () {
+		std::stable_sort (_items.begin(), _items.end(), ItemSortByFirst());
+		_max_last.resize (_items.size());
+		if (!_items.empty()) {
+			build (0, _items.size());
+		}
+	}
+
+	/** Move @param value, which currently starts at @param old_first, to
+	 *  [first, last]. It goes after any other items starting at @param first,
+	 *  as if it had been added last. The cost is linear in the number of
+	 *  items between its old and new places.
+	 *  @return false if @param value is not in the index starting at @param old_first.
+	 */
+	bool move (T const & value, framepos_t old_first, framepos_t first, framepos_t last) {
+		typename Items::iterator i = std::lower_bound (_items.begin(), _items.end(), old_first, ItemSortByFirst());
+		while (i != _items.end() && i->first == old_first && !(i->value == value)) {
+			++i;
+		}
+		if (i == _items.end() || i->first != old_first) {
+			return false;
+		}
+
+		const size_t from = i - _items.begin();
+		size_t to;
+
+		if (first >= old_first) {
+			typename Items::iterator dest = std::upper_bound (i + 1, _items.end(), first, ItemSortByFirst());
+			std::rotate (i, i + 1, dest);
+			to = (dest - _items.begin()) - 1;
+		} else {
+			typename Items::iterator dest = std::upper_bound (_items.begin(), i, first, ItemSortByFirst());
+			std::rotate (dest, i, i + 1);
+			to = dest - _items.begin();
+		}
+
+		_items[to].first = first;
+		_items[to].last = last;
+
+		refresh (0, _items.size(), std::min (from, to), std::max (from, to));
+		return true;
+	}
+
+	size_t size () const { return _items.size(); }
+	bool empty () const { return _items.empty(); }
+
+	/** write all items which overlap [start, end] to @param out */
+	template<typename Out>
+	void find_overlapping (framepos_t start, framepos_t end, Out out) const {
+		if (start <= end) {
+			overlapping (0, _items.size(), start, end, out);
+		}
+	}
+
+	/** write all items whose first position is within [start, end] to @param out */
+	template<typename Out>
+	void find_starting_within (framepos_t start, framepos_t end, Out out) const {
+		for (typename Items::const_iterator i = lower_bound (start); i != _items.end() && i->first <= end; ++i) {
+			*out++ = i->value;
+		}
+	}
+
+	/** @return the first item which starts after @param pos, or 0 */
+	T const * first_starting_after (framepos_t pos) const {
+		typename Items::const_iterator i = lower_bound (pos);
+		while (i != _items.end() && i->first <= pos) {
+			++i;
+		}
+		return i == _items.end() ? 0 : &i->value;
+	}
+
+	/** @return the first of the items with the largest start before @param pos, or 0 */
+	T const * last_starting_before (framepos_t pos) const {
+		typename Items::const_iterator i = lower_bound (pos);
+		if (i == _items.begin()) {
+			return 0;
+		}
+		--i;
+		const framepos_t first = i->first;
+		while (i != _items.begin() && (i - 1)->first == first) {
+			--i;
+		}
+		return &i->value;
+	}
+
+  private:
+	struct Item {
+		Item (framepos_t f, framepos_t l, T const & v) : first (f), last (l), value (v) {}
+		framepos_t first;
+		framepos_t last;
+		T value;
+	};
+
+	struct ItemSortByFirst {
+		bool operator() (Item const & a, Item const & b) const {
+			return a.first < b.first;
+		}
+		bool operator() (Item const & a, framepos_t pos) const {
+			return a.first < pos;
+		}
+		bool operator() (framepos_t pos, Item const & b) const {
+			return pos < b.first;
+		}
+	};
+
+	typedef std::vector<Item> Items;
+
+	Items _items;
+	std::vector<framepos_t> _max_last;
+
+	/** @return first item which does not start before @param pos */
+	typename Items::const_iterator lower_bound (framepos_t pos) const {
+		return std::lower_bound (_items.begin(), _items.end(), pos, ItemSortByFirst());
+	}
+
+	framepos_t build (size_t lo, size_t hi) {
+		const size_t mid = lo + (hi - lo) / 2;
+		framepos_t m = _items[mid].last;
+		if (lo < mid) {
+			m = std::max (m, build (lo, mid));
+		}
+		if (mid + 1 < hi) {
+			m = std::max (m, build (mid + 1, hi));
+		}
+		_max_last[mid] = m;
+		return m;
+	}
+
+	/** recompute the subtree maxima after items @param a to @param b (inclusive) have changed */
+	framepos_t refresh (size_t lo, size_t hi, size_t a, size_t b) {
+		const size_t mid = lo + (hi - lo) / 2;
+		if (b < lo || a >= hi) {
+			return _max_last[mid];
+		}
+		framepos_t m = _items[mid].last;
+		if (lo < mid) {
+			m = std::max (m, refresh (lo, mid, a, b));
+		}
+		if (mid + 1 < hi) {
+			m = std::max (m, refresh (mid + 1, hi, a, b));
+		}
+		_max_last[mid] = m;
+		return m;
+	}
+
+	template<typename Out>
+	void overlapping (size_t lo, size_t hi, framepos_t start, framepos_t end, Out& out) const {
+		if (lo >= hi) {
+			return;
+		}
+		const size_t mid = lo + (hi - lo) / 2;
+		if (_max_last[mid] < start) {
+			/* everything in this subtree ends before the range */
+			return;
+		}
+		overlapping (lo, mid, start, end, out);
+		if (_items[mid].first > end) {
+			/* this and all later items start after the range */
+			return;
+		}
+		if (_items[mid].last >= start && _items[mid].last >= _items[mid].first) {
+			*out++ = _items[mid].value;
+		}
+		overlapping (mid + 1, hi, start, end, out);
+	}
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_interval_index_h__ */
@@ -140,6 +140,12 @@ private:
 #endif
 	LuaState lua;
 	luabridge::LuaRef * _lua_dsp;
+	/* persistent in/out tables passed to dsp_run(), only
+	 * re-assigned if a buffer pointer changes (no per-cycle allocations) */
+	luabridge::LuaRef * _lua_in_map;
+	luabridge::LuaRef * _lua_out_map;
+	std::vector<float*> _in_map_data;
+	std::vector<float*> _out_map_data;
 	std::string _script;
 	std::string _docs;
 	bool _lua_does_channelmapping;
@@ -22,6 +22,7 @@
 #include <vector>
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
+#include "ardour/meter_snapshot.h"
 #include "ardour/processor.h"
 #include "pbd/fastlog.h"
 
@@ -72,8 +73,14 @@ public:
 	ChanCount input_streams () const { return current_meters; }
 	ChanCount output_streams () const { return current_meters; }
 
+	/** @return the level of channel @param n as published by the most
+	 * recent cycle, see MeterSnapshot.
+	 */
 	float meter_level (uint32_t n, MeterType type);
 
+	/** the slot of this meter in the session's MeterSnapshot */
+	int snapshot_slot () const { return _snapshot_slot; }
+
 	void set_type(MeterType t);
 	MeterType get_type() { return _meter_type; }
 
@@ -84,6 +91,9 @@ public:
 private:
 	friend class IO;
 
+	float compute_level (uint32_t n, MeterType type);
+	void write_snapshot ();
+
 	/** The number of meters that we are currently handling;
 	 *  may be different to _configured_input and _configured_output
 	 *  as it can be altered outside a ::configure_io by ::reflect_inputs.
@@ -105,6 +115,10 @@ private:
 	std::vector<Vumeterdsp *> _vumeter;
 
 	MeterType _meter_type;
+
+	boost::shared_ptr<MeterSnapshot> _snapshot;
+	int _snapshot_slot;
+	MeterSnapshot::Levels _levels;
 };
 
 } // namespace ARDOUR
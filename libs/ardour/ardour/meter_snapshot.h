@@ -0,0 +1,160 @@
+/*
+    Copyright (C) 2017 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __ardour_meter_snapshot_h__
+#define __ardour_meter_snapshot_h__
+
+#include <stdint.h>
+#include <limits>
+#include <vector>
+#include <glib.h>
+
+#include "pbd/rcu.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+/** Session-wide, contiguous copy of all meter levels.
+ *
+ * Every PeakMeter owns a slot of one or more channels. Meters write their
+ * levels into a back buffer while the process graph runs, and once per
+ * cycle the session publishes the back buffer to the front buffer using a
+ * sequence counter. Readers (GUI, control surfaces) copy the front buffer
+ * without taking a lock and retry if they raced with an update.
+ *
+ * The slot layout is RCU managed: adding, removing or resizing slots
+ * (never done by the process thread) allocates a new layout.
+ */
+class LIBARDOUR_API MeterSnapshot
+{
+public:
+	/** levels of a single channel, all values in dB */
+	struct Level {
+		Level ()
+			: peak (-std::numeric_limits<float>::infinity ())
+			, level (-std::numeric_limits<float>::infinity ())
+			, max_peak (-std::numeric_limits<float>::infinity ())
+		{}
+		float peak;     ///< digital peak, including falloff
+		float level;    ///< the meter's own type, highest value since the last reset_hold
+		float max_peak; ///< peak hold, since the meter was last reset
+	};
+
+	typedef std::vector<Level> Levels;
+
+	/** Copy of all slots, owned by a reader */
+	class LIBARDOUR_API Frame {
+	public:
+		Frame () : _serial (0), _layout (0) {}
+
+		/** number of channels in the given slot, 0 if it does not exist */
+		uint32_t n_channels (int slot) const;
+		/** level of the given channel, which must be < n_channels (slot) */
+		Level const& level (int slot, uint32_t chn) const;
+		/** highest peak of all channels in the slot (linear, not dB) */
+		float combined_peak (int slot) const;
+		/** number of the cycle this frame was published in */
+		guint serial () const { return _serial; }
+
+	private:
+		friend class MeterSnapshot;
+		struct Slot {
+			Slot () : offset (0), n_channels (0), used (false) {}
+			uint32_t offset;
+			uint32_t n_channels;
+			bool used;
+		};
+
+		guint              _serial;
+		void const*        _layout;
+		std::vector<Slot>  _slots;
+		Levels             _levels;
+		std::vector<float> _combined;
+	};
+
+	MeterSnapshot ();
+
+	/* any thread but the process thread */
+
+	int  add_slot (uint32_t n_channels);
+	void resize_slot (int slot, uint32_t n_channels);
+	void remove_slot (int slot);
+
+	/* process thread */
+
+	/** write the current levels of the given slot into the back buffer.
+	 * The level is held at its highest value until the next hold-reset.
+	 */
+	void write (int slot, Levels const&, float combined_peak);
+
+	/** publish the back buffer, called once per cycle after all meters ran.
+	 * @param nframes length of the cycle
+	 * @param max_hold reset the level hold after this many frames even
+	 * if no reader asked for it.
+	 */
+	void publish (framecnt_t nframes, framecnt_t max_hold);
+
+	/* any thread */
+
+	/** copy the levels of the most recently published cycle.
+	 * This is a no-op if the frame is up to date.
+	 * @param reset_hold start a new hold period for the level of
+	 * all channels. Only one reader should do this.
+	 * @return false if the data could not be read consistently.
+	 */
+	bool fetch (Frame&, bool reset_hold = false) const;
+
+	/** read the published levels of a single channel.
+	 * @return false if the channel does not exist or could not be read
+	 */
+	bool read (int slot, uint32_t chn, Level&, float& combined_peak) const;
+
+	/** number of the most recently published cycle */
+	guint serial () const { return g_atomic_int_get (&_serial); }
+
+private:
+	typedef Frame::Slot Slot;
+
+	struct Layout {
+		Layout () : seq (0) {}
+		Layout (Layout const&);
+
+		std::vector<Slot>  slots;
+		Levels             back;
+		Levels             front;
+		std::vector<float> back_level; // level of the most recent cycle
+		std::vector<float> back_combined;
+		std::vector<float> front_combined;
+		mutable gint       seq;
+	};
+
+	void relayout (Layout&, std::vector<Slot> const& prev);
+
+	SerializedRCUManager<Layout> _layout;
+
+	mutable gint _serial;
+	mutable gint _reset_hold;
+	framecnt_t   _held;
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_meter_snapshot_h__ */
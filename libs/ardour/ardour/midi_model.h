@@ -23,6 +23,7 @@
 
 #include <deque>
 #include <queue>
+#include <set>
 #include <utility>
 
 #include <boost/utility.hpp>
@@ -74,6 +75,8 @@ public:
 		virtual int set_state (const XMLNode&, int version) = 0;
 		virtual XMLNode & get_state () = 0;
 
+		size_t memory_use () const;
+
 		boost::shared_ptr<MidiModel> model() const { return _model; }
 
 	protected:
@@ -102,6 +105,8 @@ public:
 		int set_state (const XMLNode&, int version);
 		XMLNode & get_state ();
 
+		size_t memory_use () const;
+
 		void add (const NotePtr note);
 		void remove (const NotePtr note);
 		void side_effect_remove (const NotePtr note);
@@ -153,6 +158,8 @@ public:
 
 		XMLNode &marshal_note(const NotePtr note);
 		NotePtr unmarshal_note(XMLNode *xml_note);
+
+		void notes_changed () const;
 	};
 
 	/* Currently this class only supports changes of sys-ex time, but could be expanded */
@@ -167,6 +174,8 @@ public:
 		int set_state (const XMLNode&, int version);
 		XMLNode & get_state ();
 
+		size_t memory_use () const;
+
 		void remove (SysExPtr sysex);
 		void operator() ();
 		void undo ();
@@ -200,6 +209,8 @@ public:
 		int set_state (const XMLNode &, int version);
 		XMLNode & get_state ();
 
+		size_t memory_use () const;
+
 		void operator() ();
 		void undo ();
 
@@ -275,6 +286,13 @@ public:
 
 	PBD::Signal0<void> ContentsChanged;
 
+	/** Emitted by note diff commands (and their undo) right before
+	 *  ContentsChanged, with all notes that were added, removed or
+	 *  changed. Not emitted if the command may have changed other
+	 *  notes as well (see InsertMergePolicy).
+	 */
+	PBD::Signal1<void, std::set<NotePtr> const &> NotesChanged;
+
 	boost::shared_ptr<const MidiSource> midi_source ();
 	void set_midi_source (boost::shared_ptr<MidiSource>);
 
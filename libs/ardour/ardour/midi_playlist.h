@@ -25,11 +25,14 @@
 
 #include <boost/utility.hpp>
 
+#include <glibmm/threads.h>
+
 #include "ardour/ardour.h"
 #include "ardour/midi_model.h"
 #include "ardour/midi_state_tracker.h"
 #include "ardour/note_fixer.h"
 #include "ardour/playlist.h"
+#include "evoral/EventSink.hpp"
 #include "evoral/Note.hpp"
 #include "evoral/Parameter.hpp"
 
@@ -87,7 +90,9 @@ public:
 
 	bool destroy_region (boost::shared_ptr<Region>);
 
-	void set_note_mode (NoteMode m) { _note_mode = m; }
+	void set_note_mode (NoteMode m);
+
+	void update_after_tempo_map_change ();
 
 	std::set<Evoral::Parameter> contained_automation();
 
@@ -112,6 +117,7 @@ public:
 
 protected:
 	void remove_dependents (boost::shared_ptr<Region> region);
+	bool region_changed (const PBD::PropertyChange&, boost::shared_ptr<Region>);
 
 private:
 	typedef Evoral::Note<Evoral::Beats> Note;
@@ -124,11 +130,51 @@ private:
 
 	typedef std::map< Region*, boost::shared_ptr<RegionTracker> > NoteTrackers;
 
+	/** Events of a region in session frames, as a single contiguous read
+	 * of the whole region would produce them (including note-offs for
+	 * notes still active at the end of the region).
+	 */
+	class RenderedRegion : public Evoral::EventSink<framepos_t>, public boost::noncopyable {
+	public:
+		RenderedRegion () : stale (new gint (0)) {}
+
+		uint32_t write (framepos_t time, Evoral::EventType type, uint32_t size, const uint8_t* buf);
+
+		struct Entry {
+			framepos_t        time;
+			Evoral::EventType type;
+			uint32_t          size;
+			size_t            offset; ///< into data
+		};
+
+		std::vector<Entry>   events;
+		std::vector<uint8_t> data;
+
+		/** set, without locking, when the source's model changed */
+		boost::shared_ptr<gint> stale;
+
+		PBD::ScopedConnectionList connections;
+	};
+
+	typedef std::map< Region*, boost::shared_ptr<RenderedRegion> > RenderCache;
+
 	void dump () const;
 
+	boost::shared_ptr<RenderedRegion> rendered (boost::shared_ptr<MidiRegion>);
+	void read_rendered (RenderedRegion const&, Evoral::EventSink<framepos_t>&,
+	                    framepos_t start, framepos_t end,
+	                    Evoral::Range<framepos_t>* loop_range,
+	                    MidiStateTracker*, MidiChannelFilter*);
+	void invalidate_rendered (Region*);
+
 	NoteTrackers _note_trackers;
 	NoteMode     _note_mode;
 	framepos_t   _read_end;
+
+	RenderCache          _render_cache;
+	Glib::Threads::Mutex _render_lock; ///< protects the cache only, never held while reading a source
+	int                  _render_generation; ///< bumped by invalidate_rendered()
+	std::vector<uint8_t> _render_scratch;
 };
 
 } /* namespace ARDOUR */
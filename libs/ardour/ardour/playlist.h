@@ -44,6 +44,7 @@
 #include "ardour/region.h"
 #include "ardour/session_object.h"
 #include "ardour/data_type.h"
+#include "ardour/interval_index.h"
 
 namespace ARDOUR  {
 
@@ -157,7 +158,7 @@ public:
 		 ripple (at, distance, &el);
 	}
 
-	void update_after_tempo_map_change ();
+	virtual void update_after_tempo_map_change ();
 
 	boost::shared_ptr<Playlist> cut  (std::list<AudioRange>&, bool result_is_hidden = true);
 	boost::shared_ptr<Playlist> copy (std::list<AudioRange>&, bool result_is_hidden = true);
@@ -242,6 +243,11 @@ public:
 
 	void set_capture_insertion_in_progress (bool yn);
 
+	/** Called by a region whose position or length has changed while its
+	 *  property changes are suspended, and so before we hear about it.
+	 */
+	void region_bounds_pending (boost::shared_ptr<Region>);
+
   protected:
 	friend class Session;
 
@@ -261,9 +267,13 @@ public:
                     if (block_notify) {
                             playlist->delay_notifications();
                     }
+                    playlist->invalidate_region_index ();
+                    playlist->layout_changed (0, max_framepos);
             }
 
         ~RegionWriteLock() {
+                playlist->drop_region_index ();
+                playlist->layout_changed (0, max_framepos);
                 Glib::Threads::RWLock::WriterLock::release ();
                 if (block_notify) {
                         playlist->release_notifications ();
@@ -283,6 +293,7 @@ public:
 	std::set<boost::shared_ptr<Region> > pending_adds;
 	std::set<boost::shared_ptr<Region> > pending_removes;
 	RegionList       pending_bounds;
+	std::list<Evoral::Range<framepos_t> > pending_bounds_ranges;
 	bool             pending_contents_change;
 	bool             pending_layering;
 
@@ -376,6 +387,13 @@ public:
 	boost::shared_ptr<Playlist> copy (framepos_t start, framecnt_t cnt, bool result_is_hidden);
 
 	void relayer ();
+	void relayer (std::list<Evoral::Range<framepos_t> > const &);
+
+	/** Called when what is audible within [start, end] may have changed:
+	 *  regions were added, removed, moved, trimmed or relayered, or their
+	 *  properties changed.
+	 */
+	virtual void layout_changed (framepos_t /*start*/, framepos_t /*end*/) {}
 
 	void begin_undo ();
 	void end_undo ();
@@ -398,8 +416,27 @@ public:
 	friend class RegionWriteLock;
 	mutable Glib::Threads::RWLock region_lock;
 
+	void invalidate_region_index () const { g_atomic_int_set (&_region_index_dirty, 1); }
+	void drop_region_index () const;
+
   private:
+	/** Regions by position, for range queries on large playlists.
+	 *  A region which is moved or trimmed is moved within the index;
+	 *  otherwise it is rebuilt on demand after the region list has
+	 *  changed. It holds references to its regions, so it is emptied
+	 *  whenever regions may have been removed.
+	 */
+	typedef IntervalIndex<boost::shared_ptr<Region> > RegionIndex;
+
+	mutable RegionIndex          _region_index;
+	mutable Glib::Threads::Mutex _region_index_lock;
+	mutable gint                 _region_index_dirty;
+
+	void update_region_index () const;
+	void move_in_region_index (boost::shared_ptr<Region>) const;
+
 	void setup_layering_indices (RegionList const &);
+	void assign_layers (RegionList const &);
 	void coalesce_and_check_crossfades (std::list<Evoral::Range<framepos_t> >);
 	boost::shared_ptr<RegionList> find_regions_at (framepos_t);
 
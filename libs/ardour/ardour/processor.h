@@ -28,6 +28,7 @@
 
 #include "ardour/ardour.h"
 #include "ardour/buffer_set.h"
+#include "ardour/dsp_stats.h"
 #include "ardour/latent.h"
 #include "ardour/session_object.h"
 #include "ardour/libardour_visibility.h"
@@ -130,6 +131,9 @@ class LIBARDOUR_API Processor : public SessionObject, public Automatable, public
 	void set_owner (SessionObject*);
 	SessionObject* owner() const;
 
+	/** execution time of ::run(), measured by the owning Route */
+	DSPStats& dsp_stats () { return _dsp_stats; }
+
 protected:
 	virtual int set_state_2X (const XMLNode&, int version);
 
@@ -145,6 +149,7 @@ protected:
 	ProcessorWindowProxy *_window_proxy;
 	PluginPinWindowProxy *_pinmgr_proxy;
 	SessionObject* _owner;
+	DSPStats  _dsp_stats;
 };
 
 } // namespace ARDOUR
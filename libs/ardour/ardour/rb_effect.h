@@ -20,6 +20,9 @@
 #ifndef __ardour_rbeffect_h__
 #define __ardour_rbeffect_h__
 
+#include <string>
+#include <vector>
+
 #include "ardour/filter.h"
 #include "ardour/timefx_request.h"
 
@@ -34,8 +37,36 @@ class LIBARDOUR_API RBEffect : public Filter {
 
 	int run (boost::shared_ptr<ARDOUR::Region>, Progress* progress = 0);
 
+	/** Apply each of @param fx to the corresponding region of @param regions.
+	 *  The time-stretching is done by a pool of worker threads, one region
+	 *  per thread; new sources and regions are still created by the calling
+	 *  thread. The results are the same as those of run() for each region.
+	 *  If any of the effects fails, none of them has any results.
+	 *  @return 0 if all effects succeeded.
+	 */
+	static int run (std::vector<RBEffect*> const & fx, std::vector<boost::shared_ptr<ARDOUR::Region> > const & regions, Progress* progress = 0);
+
   private:
 	TimeFXRequest& tsr;
+
+	/* the steps of run(); stretch() may be called from any thread,
+	 * concurrently with the stretch() of other effects.
+	 */
+	int prepare (boost::shared_ptr<ARDOUR::Region>);
+	int stretch (Progress*);
+	int complete (int ret);
+	void discard ();
+
+	struct Jobs;
+	void stretch_job (Progress*, int* ret, Jobs*);
+
+	boost::shared_ptr<AudioRegion> _region;
+	SourceList  _nsrcs;
+	std::string _suffix;
+	double      _stretch;
+	double      _shift;
+	framecnt_t  _read_start;
+	framecnt_t  _read_duration;
 };
 
 } /* namespace */
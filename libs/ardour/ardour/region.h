@@ -156,6 +156,14 @@ class LIBARDOUR_API Region
 		return Evoral::Range<framepos_t> (first_frame(), last_frame());
 	}
 
+	/** If this region was moved or trimmed several times while its property
+	 *  changes were suspended, last_range() only describes the last of those
+	 *  steps. While the merged change is being sent, this sets @param range
+	 *  to cover every extent that the region had since the suspension
+	 *  began, and returns true.
+	 */
+	bool merged_bounds_range (Evoral::Range<framepos_t>& range) const;
+
 	bool hidden ()           const { return _hidden; }
 	bool muted ()            const { return _muted; }
 	bool opaque ()           const { return _opaque; }
@@ -403,6 +411,7 @@ class LIBARDOUR_API Region
 
   private:
 	void mid_thaw (const PBD::PropertyChange&);
+	void bounds_changed ();
 
 	virtual void trim_to_internal (framepos_t position, framecnt_t length, const int32_t sub_num);
 	void modify_front (framepos_t new_position, bool reset_fade, const int32_t sub_num);
@@ -436,6 +445,9 @@ class LIBARDOUR_API Region
 
 	framecnt_t              _last_length;
 	framepos_t              _last_position;
+	framepos_t              _merged_first;
+	framepos_t              _merged_last;
+	bool                    _bounds_merged;
 	mutable RegionEditState _first_edit;
 	layer_t                 _layer;
 
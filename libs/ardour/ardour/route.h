@@ -282,6 +282,9 @@ public:
 
 	bool strict_io () const { return _strict_io; }
 	bool set_strict_io (bool);
+
+	/** execution time of process_output_buffers(), see also Processor::dsp_stats() */
+	DSPStats& dsp_stats () { return _dsp_stats; }
 	/** reset plugin-insert configuration to default, disable customizations.
 	 *
 	 * This is equivalent to calling
@@ -753,6 +756,7 @@ protected:
 	friend class ProcessorState;
 
 	bool _strict_io;
+	DSPStats _dsp_stats;
 
 	/* no copy construction */
 	Route (Route const &);
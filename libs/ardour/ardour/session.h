@@ -118,9 +118,11 @@ class Diskstream;
 class ExportHandler;
 class ExportStatus;
 class Graph;
+class GraphThreadStats;
 class IO;
 class IOProcessor;
 class ImportStatus;
+class MeterSnapshot;
 class MidiClockTicker;
 class MidiControlUI;
 class MidiPortManager;
@@ -270,6 +272,16 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 	BufferSet& get_route_buffers (ChanCount count = ChanCount::ZERO, bool silence = true);
 	BufferSet& get_mix_buffers (ChanCount count = ChanCount::ZERO);
 
+	/** Count the bytes of audio copied between buffers in each cycle */
+	void set_count_buffer_copies (bool yn);
+	/** @return bytes of audio copied between buffers in the last cycle,
+	 *  if enabled with set_count_buffer_copies().
+	 */
+	uint32_t buffer_bytes_copied () const { return _buffer_bytes_copied; }
+
+	/** @return statistics of the @param n th process graph thread, or 0 */
+	GraphThreadStats* process_thread_stats (uint32_t n);
+
 	bool have_rec_enabled_track () const;
     bool have_rec_disabled_track () const;
 
@@ -1149,6 +1161,11 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 
 	VCAManager& vca_manager() { return *_vca_manager; }
 
+	/** levels of all meters, published once per cycle. Meters keep a
+	 *  reference, as they may outlive the session's routes.
+	 */
+	boost::shared_ptr<MeterSnapshot> meter_snapshot() const { return _meter_snapshot; }
+
   protected:
 	friend class AudioEngine;
 	void set_block_size (pframes_t nframes);
@@ -1192,6 +1209,7 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 	bool                    _session_range_end_is_free;
 	Slave*                  _slave;
 	bool                    _silent;
+	uint32_t                _buffer_bytes_copied;
 
 	// varispeed playback
 	double                  _transport_speed;
@@ -1920,6 +1938,7 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 	XMLNode& get_control_protocol_state ();
 
 	void set_history_depth (uint32_t depth);
+	void set_history_memory_budget (uint32_t megabytes);
 
 	static bool _disable_all_loaded_plugins;
 	static bool _bypass_all_loaded_plugins;
@@ -2026,6 +2045,7 @@ class LIBARDOUR_API Session : public PBD::StatefulDestructible, public PBD::Scop
 	std::string _template_state_dir;
 
 	VCAManager* _vca_manager;
+	boost::shared_ptr<MeterSnapshot> _meter_snapshot;
 
 	boost::shared_ptr<Route> get_midi_nth_route_by_id (PresentationInfo::order_t n) const;
 
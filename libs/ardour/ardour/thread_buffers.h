@@ -36,6 +36,7 @@ public:
 	~ThreadBuffers ();
 
 	void ensure_buffers (ChanCount howmany = ChanCount::ZERO, size_t custom = 0);
+	void reallocate ();
 
 	BufferSet* silent_buffers;
 	BufferSet* scratch_buffers;
@@ -26,6 +26,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 #include <cmath>
 
 #include "boost/shared_ptr.hpp"
@@ -176,6 +177,15 @@ LIBARDOUR_API bool matching_unsuffixed_filename_exists_in (const std::string& di
 
 LIBARDOUR_API uint32_t how_many_dsp_threads ();
 
+/** @return the CPUs reserved for process threads (empty if threads are not pinned) */
+LIBARDOUR_API std::vector<uint32_t> process_thread_cpus ();
+/** Pin the calling thread to the CPU for the @param n th process thread.
+ *  @return true if the thread was pinned
+ */
+LIBARDOUR_API bool pin_process_thread (uint32_t n);
+/** Keep the calling thread off the CPUs reserved for process threads, if any */
+LIBARDOUR_API void keep_thread_off_process_cpus ();
+
 template<typename T> boost::shared_ptr<ControlList> route_list_to_control_list (boost::shared_ptr<RouteList> rl, boost::shared_ptr<T> (Stripable::*get_control)() const) {
 	boost::shared_ptr<ControlList> cl (new ControlList);
 	for (RouteList::const_iterator r = rl->begin(); r != rl->end(); ++r) {
@@ -18,6 +18,9 @@
     $Id$
 */
 
+#include <string.h>
+
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
@@ -47,10 +50,19 @@ AsyncMIDIPort::AsyncMIDIPort (string const & name, PortFlags flags)
 	, _currently_in_cycle (false)
 	, _last_write_timestamp (0)
 	, have_timer (false)
+	, output_queue (1024)
 	, output_fifo (2048)
+	, output_fifo_seq (2048)
+	, _output_seq (0)
+	, _next_seq (0)
+	, _gap_seq (0)
+	, _gap_flushes (0)
+	, _n_held (0)
 	, input_fifo (1024)
 	, _xthread (true)
 {
+	_queued.reserve (2 * output_queue.bufsize ());
+	_input_buffer.resize (input_fifo.capacity ());
 }
 
 AsyncMIDIPort::~AsyncMIDIPort ()
@@ -64,47 +76,116 @@ AsyncMIDIPort::set_timer (boost::function<MIDI::framecnt_t (void)>& f)
 	have_timer = true;
 }
 
+/** @return true if sequence number @param s0 was taken before @param s1 */
+static inline bool
+seq_before (guint s0, guint s1)
+{
+	/* sequence numbers may wrap */
+	return (gint) (s0 - s1) < 0;
+}
+
 void
 AsyncMIDIPort::flush_output_fifo (MIDI::pframes_t nframes)
 {
 	RingBuffer< Evoral::Event<double> >::rw_vector vec = { { 0, 0 }, { 0, 0 } };
-	size_t written = 0;
+	RingBuffer<guint>::rw_vector seq = { { 0, 0 }, { 0, 0 } };
 
+	/* copy the short messages that the writers have completed so far,
+	 * keeping them in write order. A writer takes its sequence number
+	 * before it claims a slot, so concurrent writers may end up a few
+	 * slots out of order.
+	 */
+
+	guint n_queued = 0;
+	QueuedEvent* qe;
+
+	while (_queued.size () < _queued.capacity () && (qe = output_queue.peek (n_queued)) != 0) {
+		std::vector<QueuedEvent>::iterator i = _queued.end ();
+		while (i != _queued.begin () && seq_before (qe->seq, (i - 1)->seq)) {
+			--i;
+		}
+		_queued.insert (i, *qe);
+		++n_queued;
+	}
+
+	output_queue.increment_read_idx (n_queued);
+
+	/* output_fifo and output_fifo_seq are written in lock-step, so their
+	 * read-vectors match, except that the sequence number may already
+	 * be visible while its event is not (yet). Their writers take the
+	 * sequence number under output_fifo_lock, so it is in write order.
+	 */
 	output_fifo.get_read_vector (&vec);
+	output_fifo_seq.get_read_vector (&seq);
+
+	const size_t n_fifo = std::min (vec.len[0] + vec.len[1], seq.len[0] + seq.len[1]);
+
+	/* merge both runs. If the next sequence number has not arrived yet,
+	 * its writer is still busy: hold back everything after it rather than
+	 * sending it out of order, unless it was already missing a cycle ago
+	 * (its write failed, or the writer was descheduled).
+	 */
 
 	MidiBuffer& mb (get_midi_buffer (nframes));
+	size_t q = 0;
+	size_t f = 0;
+	bool held = false;
 
-	if (vec.len[0]) {
-		Evoral::Event<double>* evp = vec.buf[0];
+	while (q < _queued.size () || f < n_fifo) {
+		Evoral::Event<double>* evp = 0;
+		guint s = 0;
 
-		assert (evp->size());
-		assert (evp->buffer());
+		if (f < n_fifo) {
+			evp = f < vec.len[0] ? &vec.buf[0][f] : &vec.buf[1][f - vec.len[0]];
+			s = f < seq.len[0] ? seq.buf[0][f] : seq.buf[1][f - seq.len[0]];
+		}
 
-		for (size_t n = 0; n < vec.len[0]; ++n, ++evp) {
-			if (mb.push_back (evp->time(), evp->size(), evp->buffer())) {
-				written++;
-			}
+		const bool from_queue = q < _queued.size () && (!evp || seq_before (_queued[q].seq, s));
+
+		if (from_queue) {
+			s = _queued[q].seq;
 		}
-	}
 
-	if (vec.len[1]) {
-		Evoral::Event<double>* evp = vec.buf[1];
+		if (seq_before (_next_seq, s) && (_gap_seq != _next_seq || _gap_flushes < 2)) {
+			held = true;
+			break;
+		}
 
-		assert (evp->size());
-		assert (evp->buffer());
+		/* events that do not fit into the buffer are dropped */
 
-		for (size_t n = 0; n < vec.len[1]; ++n, ++evp) {
-			if (mb.push_back (evp->time(), evp->size(), evp->buffer())) {
-				written++;
-			}
+		if (from_queue) {
+			mb.push_back (_queued[q].time, _queued[q].size, _queued[q].data);
+			++q;
+		} else {
+			assert (evp->size());
+			assert (evp->buffer());
+			mb.push_back ((MIDI::timestamp_t) evp->time(), evp->size(), evp->buffer());
+			++f;
+		}
+
+		if (!seq_before (s, _next_seq)) {
+			_next_seq = s + 1;
 		}
 	}
 
+	if (!held) {
+		_gap_flushes = 0;
+	} else if (_gap_seq == _next_seq) {
+		++_gap_flushes;
+	} else {
+		_gap_seq = _next_seq;
+		_gap_flushes = 1;
+	}
+
 	/* do this "atomically" after we're done pushing events into the
 	 * MidiBuffer
 	 */
 
-	output_fifo.increment_read_idx (written);
+	_queued.erase (_queued.begin (), _queued.begin () + q);
+	g_atomic_int_set (&_n_held, (gint) _queued.size ());
+
+	output_fifo.increment_read_idx (f);
+	output_fifo_seq.increment_read_idx (f);
 }
 
 void
@@ -189,7 +270,7 @@ AsyncMIDIPort::drain (int check_interval_usecs, int total_usecs_to_wait)
 
 	while (now < end) {
 		output_fifo.get_write_vector (&vec);
-		if (vec.len[0] + vec.len[1] >= output_fifo.bufsize() - 1) {
+		if (vec.len[0] + vec.len[1] >= output_fifo.bufsize() - 1 && output_queue.read_space () == 0 && g_atomic_int_get (&_n_held) == 0) {
 			break;
 		}
 		Glib::usleep (check_interval_usecs);
@@ -217,6 +298,21 @@ AsyncMIDIPort::write (const MIDI::byte * msg, size_t msglen, MIDI::timestamp_t t
 			_parser->scanner (msg[n]);
 		}
 
+		if (msglen <= max_queued_event_size) {
+			QueuedEvent qe;
+			qe.time = timestamp;
+			qe.seq = g_atomic_int_add (&_output_seq, 1);
+			qe.size = msglen;
+			memcpy (qe.data, msg, msglen);
+
+			if (!output_queue.write (qe)) {
+				error << "no space in FIFO for non-process thread MIDI write" << endmsg;
+				return 0;
+			}
+
+			return msglen;
+		}
+
 		Glib::Threads::Mutex::Lock lm (output_fifo_lock);
 		RingBuffer< Evoral::Event<double> >::rw_vector vec = { { 0, 0 }, { 0, 0} };
 
@@ -248,6 +344,9 @@ AsyncMIDIPort::write (const MIDI::byte * msg, size_t msglen, MIDI::timestamp_t t
 			vec.buf[1]->set (msg, msglen, timestamp);
 		}
 
+		/* sequence number first, see flush_output_fifo() */
+		const guint s = g_atomic_int_add (&_output_seq, 1);
+		output_fifo_seq.write (&s, 1);
 		output_fifo.increment_write_idx (1);
 
 		ret = msglen;
@@ -309,12 +408,11 @@ AsyncMIDIPort::read (MIDI::byte *, size_t)
 	timestamp_t time;
 	Evoral::EventType type;
 	uint32_t size;
-	vector<MIDI::byte> buffer(input_fifo.capacity());
 
-	while (input_fifo.read (&time, &type, &size, &buffer[0])) {
+	while (input_fifo.read (&time, &type, &size, &_input_buffer[0])) {
 		_parser->set_timestamp (time);
 		for (uint32_t i = 0; i < size; ++i) {
-			_parser->scanner (buffer[i]);
+			_parser->scanner (_input_buffer[i]);
 		}
 	}
 
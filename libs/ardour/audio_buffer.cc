@@ -18,6 +18,8 @@
 
 #include <errno.h>
 
+#include <algorithm>
+
 #include "ardour/audio_buffer.h"
 #include "pbd/error.h"
 #include "pbd/malign.h"
@@ -27,6 +29,9 @@
 using namespace PBD;
 using namespace ARDOUR;
 
+bool AudioBuffer::_count_copies = false;
+gint AudioBuffer::_bytes_copied = 0;
+
 AudioBuffer::AudioBuffer(size_t capacity)
 	: Buffer (DataType::AUDIO)
 	, _owns_data (false)
@@ -68,6 +73,30 @@ AudioBuffer::resize (size_t size)
 	_silent = false;
 }
 
+bool
+AudioBuffer::swap_data (AudioBuffer& other)
+{
+	if (!_owns_data || !other._owns_data || _capacity != other._capacity) {
+		return false;
+	}
+
+	std::swap (_data, other._data);
+	std::swap (_silent, other._silent);
+	std::swap (_written, other._written);
+
+	return true;
+}
+
+uint32_t
+AudioBuffer::reset_bytes_copied ()
+{
+	gint n;
+	do {
+		n = g_atomic_int_get (&_bytes_copied);
+	} while (!g_atomic_int_compare_and_exchange (&_bytes_copied, n, 0));
+	return n;
+}
+
 bool
 AudioBuffer::check_silence (pframes_t nframes, pframes_t& n) const
 {
@@ -68,8 +68,12 @@ gain_t* AudioDiskstream::_gain_buffer          = 0;
 
 AudioDiskstream::AudioDiskstream (Session &sess, const string &name, Diskstream::Flag flag)
 	: Diskstream(sess, name, flag)
+	, _sinc_varispeed (Config->get_sinc_varispeed ())
+	, _varispeed_active (false)
 	, channels (new ChannelList)
 {
+	Config->ParameterChanged.connect_same_thread (*this, boost::bind (&AudioDiskstream::parameter_changed, this, _1));
+
 	/* prevent any write sources from being created */
 
 	in_set_state = true;
@@ -83,8 +87,12 @@ AudioDiskstream::AudioDiskstream (Session &sess, const string &name, Diskstream:
 
 AudioDiskstream::AudioDiskstream (Session& sess, const XMLNode& node)
 	: Diskstream(sess, node)
+	, _sinc_varispeed (Config->get_sinc_varispeed ())
+	, _varispeed_active (false)
 	, channels (new ChannelList)
 {
+	Config->ParameterChanged.connect_same_thread (*this, boost::bind (&AudioDiskstream::parameter_changed, this, _1));
+
 	in_set_state = true;
 	init ();
 
@@ -608,6 +616,9 @@ AudioDiskstream::process (BufferSet& bufs, framepos_t transport_frame, pframes_t
 
 		if (rec_nframes == 0 && _actual_speed != 1.0) {
 			necessary_samples = (framecnt_t) ceil ((nframes * fabs (_actual_speed))) + 2;
+			if (_sinc_varispeed) {
+				necessary_samples += SincInterpolation::lookahead;
+			}
 		} else {
 			necessary_samples = nframes;
 		}
@@ -669,20 +680,43 @@ AudioDiskstream::process (BufferSet& bufs, framepos_t transport_frame, pframes_t
 
 		if (rec_nframes == 0 && _actual_speed != 1.0f && _actual_speed != -1.0f) {
 
-			interpolation.set_speed (_target_speed);
+			/* interpolate all channels at once, read-positions and
+			 * weights are shared by all channels */
+			const uint32_t n_chans = c->size ();
+			Sample** in  = (Sample**) alloca (n_chans * sizeof (Sample*));
+			Sample** out = (Sample**) alloca (n_chans * sizeof (Sample*));
+
+			n = 0;
+			for (chan = c->begin(); chan != c->end(); ++chan, ++n) {
+				in[n]  = (*chan)->current_playback_buffer;
+				out[n] = (*chan)->speed_buffer;
+			}
 
-			int channel = 0;
-			for (ChannelList::iterator chan = c->begin(); chan != c->end(); ++chan, ++channel) {
-				ChannelInfo* chaninfo (*chan);
+			if (!_varispeed_active) {
+				/* do not interpolate with data from before
+				 * varispeed was last used */
+				interpolation.reset ();
+				sinc_interpolation.reset ();
+				_varispeed_active = true;
+			}
 
-				playback_distance = interpolation.interpolate (
-					channel, nframes, chaninfo->current_playback_buffer, chaninfo->speed_buffer);
+			if (n_chans > 0) {
+				if (_sinc_varispeed) {
+					sinc_interpolation.set_speed (_target_speed);
+					playback_distance = sinc_interpolation.interpolate (nframes, n_chans, in, out);
+				} else {
+					interpolation.set_speed (_target_speed);
+					playback_distance = interpolation.interpolate (nframes, n_chans, in, out);
+				}
+			}
 
-				chaninfo->current_playback_buffer = chaninfo->speed_buffer;
+			for (chan = c->begin(); chan != c->end(); ++chan) {
+				(*chan)->current_playback_buffer = (*chan)->speed_buffer;
 			}
 
 		} else {
 			playback_distance = nframes;
+			_varispeed_active = false;
 		}
 
 		_speed = _target_speed;
@@ -739,11 +773,16 @@ AudioDiskstream::calculate_playback_distance (pframes_t nframes)
 	if (record_enabled()) {
 		playback_distance = nframes;
 	} else if (_actual_speed != 1.0f && _actual_speed != -1.0f) {
-		interpolation.set_speed (_target_speed);
 		boost::shared_ptr<ChannelList> c = channels.reader();
 		int channel = 0;
 		for (ChannelList::iterator chan = c->begin(); chan != c->end(); ++chan, ++channel) {
-			playback_distance = interpolation.interpolate (channel, nframes, NULL, NULL);
+			if (_sinc_varispeed) {
+				sinc_interpolation.set_speed (_target_speed);
+				playback_distance = sinc_interpolation.interpolate (channel, nframes, NULL, NULL);
+			} else {
+				interpolation.set_speed (_target_speed);
+				playback_distance = interpolation.interpolate (channel, nframes, NULL, NULL);
+			}
 		}
 	} else {
 		playback_distance = nframes;
@@ -756,6 +795,33 @@ AudioDiskstream::calculate_playback_distance (pframes_t nframes)
 	}
 }
 
+void
+AudioDiskstream::use_sinc_interpolation (bool yn)
+{
+	if (yn == _sinc_varispeed) {
+		return;
+	}
+
+	/* both compute the same playback-distance, continue at the current phase */
+	if (yn) {
+		sinc_interpolation.reset ();
+		sinc_interpolation.copy_phase (interpolation);
+	} else {
+		interpolation.copy_phase (sinc_interpolation);
+	}
+
+	_sinc_varispeed = yn;
+}
+
+void
+AudioDiskstream::parameter_changed (std::string const & p)
+{
+	if (p == "sinc-varispeed") {
+		Glib::Threads::Mutex::Lock lm (state_lock);
+		use_sinc_interpolation (Config->get_sinc_varispeed ());
+	}
+}
+
 /** Update various things including playback_sample, read pointer on each channel's playback_buf
  *  and write pointer on each channel's capture_buf.  Also wout whether the butler is needed.
  *  @return true if the butler is required.
@@ -927,6 +993,11 @@ AudioDiskstream::seek (framepos_t frame, bool complete_refill)
 	playback_sample = frame;
 	file_frame = frame;
 
+	/* the interpolators must not mix in data from before the seek */
+	interpolation.reset ();
+	sinc_interpolation.reset ();
+	_varispeed_active = false;
+
 	if (complete_refill) {
 		/* call _do_refill() to refill the entire buffer, using
 		   the largest reads possible.
@@ -2119,7 +2190,9 @@ AudioDiskstream::allocate_temporary_buffers ()
 	*/
 
 	double const sp = max (fabs (_actual_speed), 1.2);
-	framecnt_t required_wrap_size = (framecnt_t) ceil (_session.get_block_size() * sp) + 2;
+	framecnt_t required_wrap_size = (framecnt_t) ceil (_session.get_block_size() * sp) + 2 + SincInterpolation::lookahead;
+
+	interpolation.reserve (max (speed_buffer_size, (framecnt_t) _session.get_block_size()));
 
 	if (required_wrap_size > wrap_buffer_size) {
 
@@ -2192,6 +2265,9 @@ AudioDiskstream::add_channel_to (boost::shared_ptr<ChannelList> c, uint32_t how_
 		interpolation.add_channel_to (
 			_session.butler()->audio_diskstream_playback_buffer_size(),
 			speed_buffer_size);
+		sinc_interpolation.add_channel_to (
+			_session.butler()->audio_diskstream_playback_buffer_size(),
+			speed_buffer_size);
 	}
 
 	_n_channels.set(DataType::AUDIO, c->size());
@@ -2215,6 +2291,7 @@ AudioDiskstream::remove_channel_from (boost::shared_ptr<ChannelList> c, uint32_t
 		delete c->back();
 		c->pop_back();
 		interpolation.remove_channel_from ();
+		sinc_interpolation.remove_channel_from ();
 	}
 
 	_n_channels.set(DataType::AUDIO, c->size());
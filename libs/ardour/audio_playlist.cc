@@ -149,14 +149,6 @@ struct ReadSorter {
     }
 };
 
-/** A segment of region that needs to be read */
-struct Segment {
-	Segment (boost::shared_ptr<AudioRegion> r, Evoral::Range<framepos_t> a) : region (r), range (a) {}
-
-	boost::shared_ptr<AudioRegion> region; ///< the region
-	Evoral::Range<framepos_t> range;       ///< range of the region to read, in session frames
-};
-
 /** @param start Start position in session frames.
  *  @param cnt Number of frames to read.
  */
@@ -188,10 +180,87 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, fr
 
 	Playlist::RegionReadLock rl (this);
 
+	/* This will be a list of the bits of regions that we need to read */
+	Segments to_do;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_segment_lock);
+		append_segments (start, start + cnt - 1, to_do);
+	}
+
+	/* Now go backwards through the to_do list doing the actual reads */
+	for (Segments::reverse_iterator i = to_do.rbegin(); i != to_do.rend(); ++i) {
+		DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("\tPlaylist %1 read %2 @ %3 for %4, channel %5, buf @ %6 offset %7\n",
+								   name(), i->region->name(), i->range.from,
+								   i->range.to - i->range.from + 1, (int) chan_n,
+								   buf, i->range.from - start));
+		i->region->read_at (buf + i->range.from - start, mixdown_buffer, gain_buffer, i->range.from, i->range.to - i->range.from + 1, chan_n);
+	}
+
+	return cnt;
+}
+
+/** Find the parts of regions which are audible between @param start and @param end
+ *  (inclusive), and append them to @param segments. The segments are to be read in
+ *  reverse order: each one is either not covered by any of the segments before
+ *  it, or covered only by the fades of non-opaque regions.
+ */
+void
+AudioPlaylist::visible_segments (framepos_t start, framepos_t end, Segments& segments)
+{
+	Playlist::RegionReadLock rl (this);
+	Glib::Threads::Mutex::Lock lm (_segment_lock);
+	append_segments (start, end, segments);
+}
+
+void
+AudioPlaylist::append_segments (framepos_t start, framepos_t end, Segments& segments)
+{
+	/* Caller must hold region lock and _segment_lock */
+
+	for (framepos_t tile = start / segment_tile_frames; tile <= end / segment_tile_frames; ++tile) {
+
+		Segments const & s = segment_tile (tile);
+
+		for (Segments::const_iterator i = s.begin(); i != s.end(); ++i) {
+			Evoral::Range<framepos_t> r (max (i->range.from, start), min (i->range.to, end));
+			if (r.from <= r.to) {
+				segments.push_back (Segment (i->region, r));
+			}
+		}
+	}
+}
+
+AudioPlaylist::Segments const &
+AudioPlaylist::segment_tile (framepos_t tile)
+{
+	/* Caller must hold region lock and _segment_lock */
+
+	SegmentTiles::iterator t = _segment_tiles.find (tile);
+
+	if (t != _segment_tiles.end()) {
+		return t->second;
+	}
+
+	if (_segment_tiles.size() >= max_segment_tiles) {
+		_segment_tiles.clear ();
+	}
+
+	t = _segment_tiles.insert (make_pair (tile, Segments ())).first;
+	compute_segments (tile * segment_tile_frames, (tile + 1) * segment_tile_frames - 1, t->second);
+
+	return t->second;
+}
+
+void
+AudioPlaylist::compute_segments (framepos_t start, framepos_t end, Segments& to_do)
+{
+	/* Caller must hold region lock */
+
 	/* Find all the regions that are involved in the bit we are reading,
 	   and sort them by descending layer and ascending position.
 	*/
-	boost::shared_ptr<RegionList> all = regions_touched_locked (start, start + cnt - 1);
+	boost::shared_ptr<RegionList> all = regions_touched_locked (start, end);
 	all->sort (ReadSorter ());
 
 	/* This will be a list of the bits of our read range that we have
@@ -200,9 +269,6 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, fr
 	*/
 	Evoral::RangeList<framepos_t> done;
 
-	/* This will be a list of the bits of regions that we need to read */
-	list<Segment> to_do;
-
 	/* Now go through the `all' list filling in `to_do' and `done' */
 	for (RegionList::iterator i = all->begin(); i != all->end(); ++i) {
 		boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (*i);
@@ -216,7 +282,7 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, fr
 		*/
 		Evoral::Range<framepos_t> region_range = ar->range ();
 		region_range.from = max (region_range.from, start);
-		region_range.to = min (region_range.to, start + cnt - 1);
+		region_range.to = min (region_range.to, end);
 
 		/* ... and then remove the bits that are already done */
 
@@ -243,17 +309,15 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, fr
 			}
 		}
 	}
+}
 
-	/* Now go backwards through the to_do list doing the actual reads */
-	for (list<Segment>::reverse_iterator i = to_do.rbegin(); i != to_do.rend(); ++i) {
-		DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("\tPlaylist %1 read %2 @ %3 for %4, channel %5, buf @ %6 offset %7\n",
-								   name(), i->region->name(), i->range.from,
-								   i->range.to - i->range.from + 1, (int) chan_n,
-								   buf, i->range.from - start));
-		i->region->read_at (buf + i->range.from - start, mixdown_buffer, gain_buffer, i->range.from, i->range.to - i->range.from + 1, chan_n);
-	}
+void
+AudioPlaylist::layout_changed (framepos_t start, framepos_t end)
+{
+	Glib::Threads::Mutex::Lock lm (_segment_lock);
 
-	return cnt;
+	_segment_tiles.erase (_segment_tiles.lower_bound (start / segment_tile_frames),
+	                      _segment_tiles.upper_bound (end / segment_tile_frames));
 }
 
 void
@@ -24,6 +24,7 @@
 #include "pbd/gstdio_compat.h"
 #include <glibmm/miscutils.h>
 #include <glibmm/fileutils.h>
+#include <glibmm/threads.h>
 
 #include "pbd/error.h"
 #include "pbd/failed_constructor.h"
@@ -40,9 +41,15 @@ using namespace Vamp;
 using namespace PBD;
 using namespace ARDOUR;
 
+/* the VAMP plugin loader is not thread safe, and analysers are created
+   and destroyed by several threads (e.g. the Analyser's workers).
+*/
+static Glib::Threads::Mutex plugin_loader_lock;
+
 AudioAnalyser::AudioAnalyser (float sr, AnalysisPluginKey key)
 	: sample_rate (sr)
 	, plugin_key (key)
+	, _cancelled (0)
 {
 	/* create VAMP plugin and initialize */
 
@@ -54,6 +61,7 @@ AudioAnalyser::AudioAnalyser (float sr, AnalysisPluginKey key)
 
 AudioAnalyser::~AudioAnalyser ()
 {
+	Glib::Threads::Mutex::Lock lm (plugin_loader_lock);
 	delete plugin;
 }
 
@@ -62,6 +70,8 @@ AudioAnalyser::initialize_plugin (AnalysisPluginKey key, float sr)
 {
 	using namespace Vamp::HostExt;
 
+	Glib::Threads::Mutex::Lock lm (plugin_loader_lock);
+
 	PluginLoader* loader (PluginLoader::getInstance());
 
 	plugin = loader->loadPlugin (key, sr, PluginLoader::ADAPT_ALL_SAFE);
@@ -99,6 +109,12 @@ AudioAnalyser::reset ()
 	}
 }
 
+void
+AudioAnalyser::cancel ()
+{
+	g_atomic_int_set (&_cancelled, 1);
+}
+
 int
 AudioAnalyser::analyse (const string& path, Readable* src, uint32_t channel)
 {
@@ -118,6 +134,10 @@ AudioAnalyser::analyse (const string& path, Readable* src, uint32_t channel)
 
 		framecnt_t to_read;
 
+		if (g_atomic_int_get (&_cancelled)) {
+			goto out;
+		}
+
 		/* read from source */
 
 		to_read = min ((len - pos), (framecnt_t) bufsize);
@@ -30,6 +30,7 @@ using namespace PBD;
 RingBufferNPT<ThreadBuffers*>* BufferManager::thread_buffers = 0;
 std::list<ThreadBuffers*>* BufferManager::thread_buffers_list = 0;
 Glib::Threads::Mutex BufferManager::rb_mutex;
+Glib::Threads::Mutex BufferManager::alloc_mutex;
 
 using std::cerr;
 using std::endl;
@@ -79,7 +80,19 @@ BufferManager::ensure_buffers (ChanCount howmany, size_t custom)
 {
         /* this is protected by the audioengine's process lock: we do not  */
 
+	Glib::Threads::Mutex::Lock lm (alloc_mutex);
+
 	for (ThreadBufferList::iterator i = thread_buffers_list->begin(); i != thread_buffers_list->end(); ++i) {
 		(*i)->ensure_buffers (howmany, custom);
 	}
 }
+
+/** Reallocate the buffers of @param tbp (which must not be in use by any
+ *  other thread) from the calling thread, see ThreadBuffers::reallocate().
+ */
+void
+BufferManager::reallocate_thread_buffers (ThreadBuffers* tbp)
+{
+	Glib::Threads::Mutex::Lock lm (alloc_mutex);
+	tbp->reallocate ();
+}
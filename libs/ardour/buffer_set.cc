@@ -28,6 +28,7 @@
 #include "pbd/compose.h"
 #include "pbd/failed_constructor.h"
 
+#include "ardour/audio_buffer.h"
 #include "ardour/buffer.h"
 #include "ardour/buffer_set.h"
 #include "ardour/debug.h"
@@ -466,6 +467,28 @@ BufferSet::merge_from (const BufferSet& in, framecnt_t nframes)
 	}
 }
 
+/** Like merge_from(), but silent audio buffers of this set take over the
+ *  data of the corresponding buffer of @a in rather than mixing it in.
+ *  This leaves @a in with undefined contents, so it may only be used
+ *  when this set is the only consumer of @a in.
+ */
+void
+BufferSet::forward_from (BufferSet& in, framecnt_t nframes)
+{
+	for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+		BufferSet::iterator o = begin(*t);
+		for (BufferSet::iterator i = in.begin(*t); i != in.end(*t) && o != end (*t); ++i, ++o) {
+			if (*t == DataType::AUDIO && o->silent()) {
+				AudioBuffer& ab (static_cast<AudioBuffer&> (*o));
+				if (ab.swap_data (static_cast<AudioBuffer&> (*i))) {
+					continue;
+				}
+			}
+			o->merge_from (*i, nframes);
+		}
+	}
+}
+
 void
 BufferSet::silence (framecnt_t nframes, framecnt_t offset)
 {
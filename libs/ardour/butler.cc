@@ -34,6 +34,7 @@
 #include "ardour/session.h"
 #include "ardour/track.h"
 #include "ardour/auditioner.h"
+#include "ardour/utils.h"
 
 #include "pbd/i18n.h"
 
@@ -153,6 +154,7 @@ Butler::_thread_work (void* arg)
 {
 	SessionEvent::create_per_thread_pool ("butler events", 4096);
 	pthread_set_name (X_("butler"));
+	keep_thread_off_process_cpus ();
 	return ((Butler *) arg)->thread_work ();
 }
 
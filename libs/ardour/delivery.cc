@@ -235,6 +235,7 @@ Delivery::run (BufferSet& bufs, framepos_t start_frame, framepos_t end_frame, do
 
 	PortSet& ports (_output->ports());
 	gain_t tgain;
+	bool audio_copied = false;
 
 	if (ports.num_ports () == 0) {
 		goto out;
@@ -316,6 +317,7 @@ Delivery::run (BufferSet& bufs, framepos_t start_frame, framepos_t end_frame, do
 
 		if (bufs.count().n_audio() > 0) {
 			_output->copy_to_outputs (bufs, DataType::AUDIO, nframes, 0);
+			audio_copied = true;
 		}
 
 		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
@@ -336,6 +338,13 @@ Delivery::run (BufferSet& bufs, framepos_t start_frame, framepos_t end_frame, do
 
 		for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
 
+			if (*t == DataType::AUDIO && audio_copied && bufs.count().n_audio() <= outs.count().n_audio()) {
+				/* audio was copied 1:1 from bufs to the ports, so
+				   reading it back would not change anything.
+				*/
+				continue;
+			}
+
 			uint32_t n = 0;
 
 			for (BufferSet::iterator b = bufs.begin (*t); b != bufs.end (*t); ++b) {
@@ -330,6 +330,476 @@ Biquad::dB_at_freq (float freq) const
 	return std::min (120.f, std::max(-120.f, rv));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+BiquadCascade::BiquadCascade (double samplerate, uint32_t n_channels, uint32_t n_stages)
+	: _rate (samplerate)
+	, _n_channels (n_channels)
+	, _n_stages (std::max ((uint32_t)1, n_stages))
+	, _stride (std::max ((uint32_t)8, (n_channels + 7) & ~7))
+{
+	const size_t sz = sizeof (float) * _stride * _n_stages;
+	cache_aligned_malloc ((void**) &_a1, sz);
+	cache_aligned_malloc ((void**) &_a2, sz);
+	cache_aligned_malloc ((void**) &_b0, sz);
+	cache_aligned_malloc ((void**) &_b1, sz);
+	cache_aligned_malloc ((void**) &_b2, sz);
+	cache_aligned_malloc ((void**) &_z1, sz);
+	cache_aligned_malloc ((void**) &_z2, sz);
+	cache_aligned_malloc ((void**) &_x, sizeof (float) * _stride);
+	_ptr = new float*[std::max ((uint32_t)1, _n_channels)];
+
+	/* default: pass-thru */
+	::memset (_a1, 0, sz);
+	::memset (_a2, 0, sz);
+	::memset (_b1, 0, sz);
+	::memset (_b2, 0, sz);
+	for (uint32_t i = 0; i < _stride * _n_stages; ++i) {
+		_b0[i] = 1.f;
+	}
+	reset ();
+}
+
+BiquadCascade::~BiquadCascade ()
+{
+	cache_aligned_free (_a1);
+	cache_aligned_free (_a2);
+	cache_aligned_free (_b0);
+	cache_aligned_free (_b1);
+	cache_aligned_free (_b2);
+	cache_aligned_free (_z1);
+	cache_aligned_free (_z2);
+	cache_aligned_free (_x);
+	delete [] _ptr;
+}
+
+void
+BiquadCascade::reset ()
+{
+	::memset (_z1, 0, sizeof (float) * _stride * _n_stages);
+	::memset (_z2, 0, sizeof (float) * _stride * _n_stages);
+	::memset (_x, 0, sizeof (float) * _stride);
+}
+
+void
+BiquadCascade::compute (uint32_t stage, Biquad::Type t, double freq, double Q, double gain)
+{
+	double a1, a2, b0, b1, b2;
+	Biquad bq (_rate);
+	bq.compute (t, freq, Q, gain);
+	bq.coefficients (a1, a2, b0, b1, b2);
+	configure (stage, a1, a2, b0, b1, b2);
+}
+
+void
+BiquadCascade::configure (uint32_t stage, double a1, double a2, double b0, double b1, double b2)
+{
+	for (uint32_t c = 0; c < _n_channels; ++c) {
+		configure_channel (stage, c, a1, a2, b0, b1, b2);
+	}
+}
+
+void
+BiquadCascade::configure_channel (uint32_t stage, uint32_t chn, double a1, double a2, double b0, double b1, double b2)
+{
+	if (stage >= _n_stages || chn >= _n_channels) {
+		return;
+	}
+	const uint32_t i = stage * _stride + chn;
+	_a1[i] = a1;
+	_a2[i] = a2;
+	_b0[i] = b0;
+	_b1[i] = b1;
+	_b2[i] = b2;
+}
+
+void
+BiquadCascade::run (float** data, const uint32_t n_samples)
+{
+	const uint32_t nc = _n_channels;
+	const uint32_t ns = _n_stages;
+	const uint32_t stride = _stride;
+	float* const x = _x;
+
+	for (uint32_t i = 0; i < n_samples; ++i) {
+		for (uint32_t c = 0; c < nc; ++c) {
+			x[c] = data[c] ? data[c][i] : 0.f;
+		}
+
+		for (uint32_t s = 0; s < ns; ++s) {
+			const uint32_t o = s * stride;
+			float* const z1 = &_z1[o];
+			float* const z2 = &_z2[o];
+			float const* const a1 = &_a1[o];
+			float const* const a2 = &_a2[o];
+			float const* const b0 = &_b0[o];
+			float const* const b1 = &_b1[o];
+			float const* const b2 = &_b2[o];
+
+			/* no dependencies between channels: this loop is vectorized
+			 * by the compiler, stride is a multiple of the SIMD width */
+			for (uint32_t c = 0; c < stride; ++c) {
+				const float xn = x[c];
+				const float z  = b0[c] * xn + z1[c];
+				z1[c]          = b1[c] * xn - a1[c] * z + z2[c];
+				z2[c]          = b2[c] * xn - a2[c] * z;
+				x[c] = z;
+			}
+		}
+
+		for (uint32_t c = 0; c < nc; ++c) {
+			if (data[c]) {
+				data[c][i] = x[c];
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < stride * ns; ++i) {
+		if (!isfinite_local (_z1[i])) { _z1[i] = 0; }
+		if (!isfinite_local (_z2[i])) { _z2[i] = 0; }
+	}
+}
+
+void
+BiquadCascade::run_map (BufferSet* bufs, const ChanMapping& in, pframes_t n_samples, framecnt_t offset)
+{
+	for (uint32_t c = 0; c < _n_channels; ++c) {
+		bool valid;
+		const uint32_t idx = in.get (DataType::AUDIO, c, &valid);
+		if (valid && idx < bufs->count ().n_audio ()) {
+			_ptr[c] = bufs->get_audio (idx).data (offset);
+		} else {
+			_ptr[c] = 0;
+		}
+	}
+	run (_ptr, n_samples);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+FIRFilter::FIRFilter (uint32_t max_taps)
+	: _max_taps (std::max ((uint32_t)1, max_taps))
+	, _n_taps (1)
+	, _pos (0)
+	, _coeff (0)
+	, _hist (0)
+{
+	cache_aligned_malloc ((void**) &_coeff, sizeof (float) * _max_taps);
+	cache_aligned_malloc ((void**) &_hist, 2 * sizeof (float) * _max_taps);
+	::memset (_coeff, 0, sizeof (float) * _max_taps);
+	_coeff[0] = 1.f;
+	reset ();
+}
+
+FIRFilter::~FIRFilter ()
+{
+	cache_aligned_free (_coeff);
+	cache_aligned_free (_hist);
+}
+
+void
+FIRFilter::reset ()
+{
+	::memset (_hist, 0, 2 * sizeof (float) * _max_taps);
+	_pos = 0;
+}
+
+void
+FIRFilter::set_coefficients (float const* coeff, const uint32_t n_taps)
+{
+	_n_taps = std::max ((uint32_t)1, std::min (n_taps, _max_taps));
+	/* store in reverse order, so that run() is a plain dot-product */
+	for (uint32_t i = 0; i < _n_taps; ++i) {
+		_coeff[_n_taps - 1 - i] = i < n_taps ? coeff[i] : 0.f;
+	}
+	reset ();
+}
+
+void
+FIRFilter::run (float *data, const uint32_t n_samples)
+{
+	/* the history is stored twice, _hist[i] == _hist[i + n], so that the
+	 * last n samples are always available as contiguous array */
+	const uint32_t n = _n_taps;
+	float const* const c = _coeff;
+
+	for (uint32_t i = 0; i < n_samples; ++i) {
+		_hist[_pos] = _hist[_pos + n] = data[i];
+		float const* const h = &_hist[_pos + 1];
+		float y = 0;
+		for (uint32_t k = 0; k < n; ++k) {
+			y += c[k] * h[k];
+		}
+		data[i] = y;
+		if (++_pos == n) {
+			_pos = 0;
+		}
+	}
+}
+
+static uint32_t
+next_power_of_two (uint32_t v)
+{
+	uint32_t rv = 1;
+	while (rv < v) {
+		rv <<= 1;
+	}
+	return rv;
+}
+
+Convolver::Segment::Segment (uint32_t sz, uint32_t off, uint32_t np, float const* ir, uint32_t ir_len)
+	: size (sz)
+	, offset (off)
+	, n_part (np)
+	, cur (0)
+	, write_pos (0)
+{
+	const uint32_t n_bins = size + 1;
+
+	time_data = (float*) fftwf_malloc (sizeof (float) * 2 * size);
+	freq_data = (fftwf_complex*) fftwf_malloc (sizeof (fftwf_complex) * n_bins);
+	ir_freq   = (fftwf_complex*) fftwf_malloc (sizeof (fftwf_complex) * n_bins * n_part);
+	fdl       = (fftwf_complex*) fftwf_malloc (sizeof (fftwf_complex) * n_bins * n_part);
+
+	/* caller holds the fft_planner_lock */
+	fwd = fftwf_plan_dft_r2c_1d (2 * size, time_data, freq_data, FFTW_MEASURE);
+	inv = fftwf_plan_dft_c2r_1d (2 * size, freq_data, time_data, FFTW_MEASURE);
+
+	/* transform the IR partitions, include the 1 / N normalization of the inverse FFT */
+	const float norm = 1.f / (2.f * size);
+	for (uint32_t p = 0; p < n_part; ++p) {
+		const uint32_t start = offset + p * size;
+		for (uint32_t i = 0; i < size; ++i) {
+			time_data[i] = (start + i < ir_len) ? ir[start + i] * norm : 0.f;
+		}
+		::memset (&time_data[size], 0, sizeof (float) * size);
+		fftwf_execute (fwd);
+		::memcpy (ir_freq[p * n_bins], freq_data, sizeof (fftwf_complex) * n_bins);
+	}
+
+	reset ();
+}
+
+Convolver::Segment::~Segment ()
+{
+	/* caller holds the fft_planner_lock */
+	fftwf_destroy_plan (fwd);
+	fftwf_destroy_plan (inv);
+	fftwf_free (time_data);
+	fftwf_free (freq_data);
+	fftwf_free (ir_freq);
+	fftwf_free (fdl);
+}
+
+void
+Convolver::Segment::reset ()
+{
+	::memset (fdl, 0, sizeof (fftwf_complex) * (size + 1) * n_part);
+	cur = 0;
+}
+
+void
+Convolver::Segment::process (float const* hist, uint32_t hist_pos, uint32_t hist_mask, float* out, uint32_t out_mask)
+{
+	const uint32_t n_bins = size + 1;
+
+	/* overlap-save: transform the most recent 2 * size input samples */
+	const uint32_t start = hist_pos - 2 * size;
+	for (uint32_t i = 0; i < 2 * size; ++i) {
+		time_data[i] = hist[(start + i) & hist_mask];
+	}
+	fftwf_execute (fwd);
+	::memcpy (fdl[cur * n_bins], freq_data, sizeof (fftwf_complex) * n_bins);
+
+	/* complex multiply-accumulate the delay-line with the IR partitions */
+	float* const acc = (float*) freq_data;
+	::memset (acc, 0, sizeof (fftwf_complex) * n_bins);
+
+	for (uint32_t p = 0; p < n_part; ++p) {
+		const uint32_t slot = (cur + n_part - p) % n_part;
+		float const* const x = (float const*) fdl[slot * n_bins];
+		float const* const h = (float const*) ir_freq[p * n_bins];
+		for (uint32_t b = 0; b < 2 * n_bins; b += 2) {
+			acc[b]     += x[b] * h[b]     - x[b + 1] * h[b + 1];
+			acc[b + 1] += x[b] * h[b + 1] + x[b + 1] * h[b];
+		}
+	}
+
+	fftwf_execute (inv);
+
+	/* the 2nd half is the valid part of the circular convolution */
+	for (uint32_t i = 0; i < size; ++i) {
+		out[(write_pos + i) & out_mask] += time_data[size + i];
+	}
+
+	write_pos = (write_pos + size) & out_mask;
+	cur = (cur + 1) % n_part;
+}
+
+Convolver::Convolver (uint32_t block_size, bool uniform, uint32_t max_partition)
+	: _block_size (next_power_of_two (std::max ((uint32_t)16, std::min ((uint32_t)16384, block_size))))
+	, _uniform (uniform)
+	, _max_partition (std::max (_block_size, next_power_of_two (std::min ((uint32_t)65536, max_partition))))
+	, _ir_length (0)
+	, _head (_block_size)
+	, _hist (0)
+	, _hist_mask (0)
+	, _hist_pos (0)
+	, _out (0)
+	, _out_mask (0)
+	, _out_pos (0)
+	, _in_fill (0)
+	, _n_blocks (0)
+{
+}
+
+Convolver::~Convolver ()
+{
+	clear_segments ();
+}
+
+void
+Convolver::clear_segments ()
+{
+	{
+		Glib::Threads::Mutex::Lock lk (FFTSpectrum::fft_planner_lock);
+		for (std::vector<Segment*>::const_iterator i = _segments.begin (); i != _segments.end (); ++i) {
+			delete *i;
+		}
+	}
+	_segments.clear ();
+	cache_aligned_free (_hist);
+	cache_aligned_free (_out);
+	_hist = 0;
+	_out = 0;
+}
+
+uint32_t
+Convolver::n_partitions () const
+{
+	uint32_t rv = 0;
+	for (std::vector<Segment*>::const_iterator i = _segments.begin (); i != _segments.end (); ++i) {
+		rv += (*i)->n_part;
+	}
+	return rv;
+}
+
+void
+Convolver::set_ir (float const* ir, const uint32_t n_samples)
+{
+	clear_segments ();
+
+	_ir_length = n_samples;
+	_head.set_coefficients (ir, std::min (n_samples, _block_size));
+
+	/* A partition of size P that starts at offset D >= P can be computed
+	 * as soon as P input samples have been collected: the result is only
+	 * needed from that point in time onward.
+	 *
+	 * The first block_size taps are processed in the time-domain.
+	 * Non-uniform partitioning uses 3 partitions of every size:
+	 * B @ B, 4B @ 4B, 16B @ 16B, ... (size @ offset).
+	 */
+	uint32_t size   = _block_size;
+	uint32_t offset = _block_size;
+	uint32_t max_size = 0;
+	uint32_t max_end  = 0;
+
+	{
+		Glib::Threads::Mutex::Lock lk (FFTSpectrum::fft_planner_lock);
+		while (offset < n_samples) {
+			const bool grow = !_uniform && size * 4 <= _max_partition;
+			uint32_t n_part = (n_samples - offset + size - 1) / size;
+			if (grow) {
+				n_part = std::min ((uint32_t)3, n_part);
+			}
+			_segments.push_back (new Segment (size, offset, n_part, ir, n_samples));
+			max_size = std::max (max_size, size);
+			max_end  = std::max (max_end, offset + size);
+			offset  += n_part * size;
+			if (grow) {
+				size *= 4;
+			}
+		}
+	}
+
+	const uint32_t hist_size = next_power_of_two (2 * std::max (max_size, _block_size));
+	const uint32_t out_size  = next_power_of_two (std::max (max_end, _block_size));
+	cache_aligned_malloc ((void**) &_hist, sizeof (float) * hist_size);
+	cache_aligned_malloc ((void**) &_out, sizeof (float) * out_size);
+	_hist_mask = hist_size - 1;
+	_out_mask  = out_size - 1;
+
+	reset ();
+}
+
+void
+Convolver::reset ()
+{
+	_head.reset ();
+	if (_hist) {
+		::memset (_hist, 0, sizeof (float) * (_hist_mask + 1));
+	}
+	if (_out) {
+		::memset (_out, 0, sizeof (float) * (_out_mask + 1));
+	}
+	for (std::vector<Segment*>::const_iterator i = _segments.begin (); i != _segments.end (); ++i) {
+		(*i)->reset ();
+		(*i)->write_pos = (*i)->offset & _out_mask;
+	}
+	_hist_pos = 0;
+	_out_pos  = 0;
+	_in_fill  = 0;
+	_n_blocks = 0;
+}
+
+void
+Convolver::process_block ()
+{
+	++_n_blocks;
+	for (std::vector<Segment*>::const_iterator i = _segments.begin (); i != _segments.end (); ++i) {
+		const uint64_t blocks_per_part = (*i)->size / _block_size;
+		if (_n_blocks % blocks_per_part == 0) {
+			(*i)->process (_hist, _hist_pos, _hist_mask, _out, _out_mask);
+		}
+	}
+}
+
+void
+Convolver::run (float* data, const uint32_t n_samples)
+{
+	if (_segments.empty ()) {
+		_head.run (data, n_samples);
+		return;
+	}
+
+	uint32_t done = 0;
+	while (done < n_samples) {
+		const uint32_t n = std::min (n_samples - done, _block_size - _in_fill);
+		float* const d = &data[done];
+
+		for (uint32_t i = 0; i < n; ++i) {
+			_hist[(_hist_pos + i) & _hist_mask] = d[i];
+		}
+		_hist_pos = (_hist_pos + n) & _hist_mask;
+
+		_head.run (d, n);
+
+		for (uint32_t i = 0; i < n; ++i) {
+			const uint32_t p = (_out_pos + i) & _out_mask;
+			d[i] += _out[p];
+			_out[p] = 0;
+		}
+		_out_pos = (_out_pos + n) & _out_mask;
+
+		done += n;
+		_in_fill += n;
+		if (_in_fill == _block_size) {
+			_in_fill = 0;
+			process_block ();
+		}
+	}
+}
 
 Glib::Threads::Mutex FFTSpectrum::fft_planner_lock;
 
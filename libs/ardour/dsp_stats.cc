@@ -0,0 +1,172 @@
+/*
+    Copyright (C) 2017 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include <string.h>
+#include <math.h>
+
+#include <algorithm>
+
+#include "ardour/dsp_stats.h"
+
+using namespace ARDOUR;
+
+DSPStats::DSPStats ()
+	: _start (0)
+	, _seq (0)
+	, _reset (0)
+{
+	clear ();
+}
+
+void
+DSPStats::clear ()
+{
+	memset (&_data, 0, sizeof (Data));
+}
+
+int
+DSPStats::bin_index (cycles_t c)
+{
+	if (c < 4) {
+		return c;
+	}
+	int octave = 0;
+	uint64_t v = c;
+	while (v >= 8) {
+		v >>= 1;
+		++octave;
+	}
+	/* v is now 4..7, the MSB followed by two bits of sub-octave precision */
+	const int idx = 4 * (octave + 1) + (v & 3);
+	return idx < n_bins ? idx : n_bins - 1;
+}
+
+double
+DSPStats::bin_lower (int idx)
+{
+	if (idx < 4) {
+		return idx;
+	}
+	const int octave = idx / 4 - 1;
+	return ldexp (4 + (idx & 3), octave);
+}
+
+void
+DSPStats::add (cycles_t elapsed)
+{
+	/* odd sequence number: update in progress */
+	g_atomic_int_inc (&_seq);
+
+	if (g_atomic_int_compare_and_exchange (&_reset, 1, 0)) {
+		clear ();
+	}
+
+	if (_data.count == 0 || elapsed < _data.min) {
+		_data.min = elapsed;
+	}
+	if (elapsed > _data.max) {
+		_data.max = elapsed;
+	}
+	++_data.count;
+	_data.total += elapsed;
+	++_data.bins[bin_index (elapsed)];
+
+	g_atomic_int_inc (&_seq);
+}
+
+bool
+DSPStats::snapshot (Data& d) const
+{
+	for (int tries = 0; tries < 64; ++tries) {
+		const gint seq = g_atomic_int_get (&_seq);
+		if (seq & 1) {
+			continue;
+		}
+		memcpy (&d, &_data, sizeof (Data));
+		if (g_atomic_int_get (&_seq) == seq) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool
+DSPStats::get_stats (uint64_t& count, double& min, double& max, double& avg) const
+{
+	Data d;
+	if (!snapshot (d) || d.count == 0) {
+		return false;
+	}
+	const double cpu = cycles_per_usec ();
+	count = d.count;
+	min = d.min / cpu;
+	max = d.max / cpu;
+	avg = d.total / (double) d.count / cpu;
+	return true;
+}
+
+double
+DSPStats::percentile (double fraction) const
+{
+	Data d;
+	if (!snapshot (d) || d.count == 0) {
+		return 0;
+	}
+
+	const double target = std::max (0., std::min (1., fraction)) * d.count;
+	double cumulative = 0;
+	double rv = d.max;
+
+	for (int i = 0; i < n_bins; ++i) {
+		if (d.bins[i] == 0) {
+			continue;
+		}
+		if (cumulative + d.bins[i] >= target) {
+			/* interpolate linearly within the bin */
+			const double lower = bin_lower (i);
+			const double upper = (i + 1 < n_bins) ? bin_lower (i + 1) : d.max;
+			rv = lower + (upper - lower) * (target - cumulative) / d.bins[i];
+			break;
+		}
+		cumulative += d.bins[i];
+	}
+
+	rv = std::max ((double) d.min, std::min ((double) d.max, rv));
+	return rv / cycles_per_usec ();
+}
+
+double
+DSPStats::cycles_per_usec ()
+{
+	static double cpu = 0;
+
+	if (cpu == 0) {
+		/* calibrate the cycle counter against the monotonic clock */
+		const gint64 t0 = g_get_monotonic_time ();
+		const cycles_t c0 = get_cycles ();
+		gint64 t1;
+		do {
+			t1 = g_get_monotonic_time ();
+		} while (t1 - t0 < 5000);
+		const cycles_t c1 = get_cycles ();
+		const double rate = (c1 > c0) ? (c1 - c0) / (double) (t1 - t0) : 1.0;
+		cpu = rate > 0 ? rate : 1.0;
+	}
+	return cpu;
+}
@@ -36,12 +36,14 @@
 #include "audiographer/general/silence_trimmer.h"
 #include "audiographer/general/threader.h"
 #include "audiographer/sndfile/tmp_file.h"
+#include "audiographer/sndfile/tmp_file_mem.h"
 #include "audiographer/sndfile/tmp_file_rt.h"
 #include "audiographer/sndfile/tmp_file_sync.h"
 #include "audiographer/sndfile/sndfile_writer.h"
 
 #include "ardour/audioengine.h"
 #include "ardour/export_channel_configuration.h"
+#include "ardour/export_failed.h"
 #include "ardour/export_filename.h"
 #include "ardour/export_format_specification.h"
 #include "ardour/export_timespan.h"
@@ -59,8 +61,11 @@ namespace ARDOUR {
 ExportGraphBuilder::ExportGraphBuilder (Session const & session)
 	: session (session)
 	, thread_pool (hardware_concurrency())
+	, post_process_pool (hardware_concurrency())
+	, jobs_pending (0)
 {
 	process_buffer_frames = session.engine().samples_per_cycle();
+	memory_budget = (framecnt_t) Config->get_export_normalize_memory () * (1048576 / sizeof (Sample));
 }
 
 ExportGraphBuilder::~ExportGraphBuilder ()
@@ -72,31 +77,200 @@ ExportGraphBuilder::process (framecnt_t frames, bool last_cycle)
 {
 	assert(frames <= process_buffer_frames);
 
-	for (ChannelMap::iterator it = channels.begin(); it != channels.end(); ++it) {
-		Sample const * process_buffer = 0;
-		it->first->read (process_buffer, frames);
-		ConstProcessContext<Sample> context(process_buffer, frames, 1);
-		if (last_cycle) { context().set_flag (ProcessContext<Sample>::EndOfInput); }
-		it->second->process (context);
+	for (TimespanChannelMap::iterator t = channels.begin(); t != channels.end(); ++t) {
+		for (ChannelMap::iterator it = t->second.begin(); it != t->second.end(); ++it) {
+			Sample const * process_buffer = 0;
+			it->first->read (process_buffer, frames);
+			ConstProcessContext<Sample> context(process_buffer, frames, 1);
+			if (last_cycle) { context().set_flag (ProcessContext<Sample>::EndOfInput); }
+			it->second->process (context);
+		}
 	}
 
 	return 0;
 }
 
+/** Process all timespans which overlap the cycle starting at @param position.
+ *  Every channel is read once, and the part of the cycle that belongs to each
+ *  timespan is passed on to its graph. Graphs of different timespans are
+ *  processed concurrently. Each graph sees the end of its input once, in
+ *  the cycle which reaches the end of its timespan (with no data, if the
+ *  timespan is empty).
+ */
+int
+ExportGraphBuilder::process_timespans (framepos_t position, framecnt_t frames)
+{
+	assert(frames <= process_buffer_frames);
+
+	framepos_t const end = position + frames;
+
+	jobs.clear ();
+	channel_data.clear ();
+
+	for (TimespanChannelMap::iterator t = channels.begin(); t != channels.end(); ++t) {
+
+		framepos_t const ts_start = std::max (t->first->get_start (), position);
+		framepos_t const ts_end = std::min (t->first->get_end (), end);
+		bool const last_cycle = (t->first->get_end () <= end);
+
+		if (finished_timespans.find (t->first) != finished_timespans.end ()) {
+			continue;
+		}
+
+		/* a timespan with nothing in this cycle is skipped, unless it is
+		   empty and has yet to see the end of its input
+		*/
+		if (ts_start >= ts_end && !last_cycle) {
+			continue;
+		}
+
+		if (last_cycle) {
+			finished_timespans.insert (t->first);
+		}
+
+		for (ChannelMap::iterator it = t->second.begin(); it != t->second.end(); ++it) {
+			if (channel_data.find (it->first) == channel_data.end ()) {
+				Sample const * process_buffer = 0;
+				it->first->read (process_buffer, frames);
+				channel_data[it->first] = process_buffer;
+			}
+		}
+
+		TimespanJob job;
+		job.channels = &t->second;
+		job.offset = std::min (ts_start - position, (framepos_t) frames);
+		job.frames = std::max (ts_end - ts_start, (framepos_t) 0);
+		job.last_cycle = last_cycle;
+		jobs.push_back (job);
+	}
+
+	if (jobs.size () < 2) {
+		for (std::vector<TimespanJob>::const_iterator j = jobs.begin(); j != jobs.end(); ++j) {
+			process_timespan (*j);
+		}
+		return 0;
+	}
+
+	Glib::Threads::Mutex::Lock lm (jobs_lock);
+
+	job_error.clear ();
+	g_atomic_int_set (&jobs_pending, jobs.size ());
+
+	for (std::vector<TimespanJob>::const_iterator j = jobs.begin(); j != jobs.end(); ++j) {
+		thread_pool.push (sigc::bind (sigc::mem_fun (*this, &ExportGraphBuilder::run_timespan_job), *j));
+	}
+
+	wait_for_jobs ();
+	return 0;
+}
+
+void
+ExportGraphBuilder::process_timespan (TimespanJob const & job)
+{
+	for (ChannelMap::const_iterator it = job.channels->begin(); it != job.channels->end(); ++it) {
+		Sample const * process_buffer = channel_data.find (it->first)->second;
+		ConstProcessContext<Sample> context(process_buffer + job.offset, job.frames, 1);
+		if (job.last_cycle) { context().set_flag (ProcessContext<Sample>::EndOfInput); }
+		it->second->process (context);
+	}
+}
+
+void
+ExportGraphBuilder::run_timespan_job (TimespanJob const & job)
+{
+	try {
+		process_timespan (job);
+	} catch (std::exception const & e) {
+		job_failed (e);
+	}
+
+	job_finished ();
+}
+
+void
+ExportGraphBuilder::job_failed (std::exception const & e)
+{
+	Glib::Threads::Mutex::Lock lm (jobs_lock);
+	if (job_error.empty ()) {
+		job_error = e.what ();
+	}
+}
+
+void
+ExportGraphBuilder::job_finished ()
+{
+	if (g_atomic_int_dec_and_test (&jobs_pending)) {
+		Glib::Threads::Mutex::Lock lm (jobs_lock);
+		jobs_done.signal ();
+	}
+}
+
+/** Wait until all jobs pushed to a pool are done, jobs_lock must be held */
+void
+ExportGraphBuilder::wait_for_jobs ()
+{
+	while (g_atomic_int_get (&jobs_pending) != 0) {
+		jobs_done.wait (jobs_lock);
+	}
+
+	if (!job_error.empty ()) {
+		throw ExportFailed (job_error);
+	}
+}
+
 bool
 ExportGraphBuilder::post_process ()
 {
-	for (std::list<Intermediate *>::iterator it = intermediates.begin(); it != intermediates.end(); /* ++ in loop */) {
-		if ((*it)->process()) {
-			it = intermediates.erase (it);
-		} else {
-			++it;
+	if (intermediates.size () < 2) {
+		for (std::list<Intermediate *>::iterator it = intermediates.begin(); it != intermediates.end(); /* ++ in loop */) {
+			if ((*it)->process()) {
+				it = intermediates.erase (it);
+			} else {
+				++it;
+			}
+		}
+		return intermediates.empty();
+	}
+
+	/* Normalize all intermediates concurrently. Their Threaders use
+	 * thread_pool, so these jobs need a pool of their own.
+	 */
+	{
+		Glib::Threads::Mutex::Lock lm (jobs_lock);
+
+		job_error.clear ();
+		finished_intermediates.clear ();
+		g_atomic_int_set (&jobs_pending, intermediates.size ());
+
+		for (std::list<Intermediate *>::iterator it = intermediates.begin(); it != intermediates.end(); ++it) {
+			post_process_pool.push (sigc::bind (sigc::mem_fun (*this, &ExportGraphBuilder::run_post_process_job), *it));
 		}
+
+		wait_for_jobs ();
+	}
+
+	for (std::vector<Intermediate *>::const_iterator it = finished_intermediates.begin(); it != finished_intermediates.end(); ++it) {
+		intermediates.remove (*it);
 	}
 
 	return intermediates.empty();
 }
 
+void
+ExportGraphBuilder::run_post_process_job (Intermediate * intermediate)
+{
+	try {
+		if (intermediate->process ()) {
+			Glib::Threads::Mutex::Lock lm (jobs_lock);
+			finished_intermediates.push_back (intermediate);
+		}
+	} catch (std::exception const & e) {
+		job_failed (e);
+	}
+
+	job_finished ();
+}
+
 unsigned
 ExportGraphBuilder::get_postprocessing_cycle_count() const
 {
@@ -113,8 +287,10 @@ ExportGraphBuilder::reset ()
 	timespan.reset();
 	channel_configs.clear ();
 	channels.clear ();
+	finished_timespans.clear ();
 	intermediates.clear ();
 	analysis_map.clear();
+	memory_budget = (framecnt_t) Config->get_export_normalize_memory () * (1048576 / sizeof (Sample));
 	_realtime = false;
 }
 
@@ -202,7 +378,7 @@ ExportGraphBuilder::add_split_config (FileSpec const & config)
 	}
 
 	// No duplicate channel config found, create new one
-	channel_configs.push_back (new ChannelConfig (*this, config, channels));
+	channel_configs.push_back (new ChannelConfig (*this, config, channels[timespan]));
 }
 
 /* Encoder */
@@ -237,7 +413,9 @@ ExportGraphBuilder::Encoder::init (FileSpec const & new_config)
 void
 ExportGraphBuilder::Encoder::add_child (FileSpec const & new_config)
 {
-	filenames.push_back (new_config.filename);
+	/* resolve the path now, filenames may be shared by other timespans */
+	new_config.filename->set_channel_config (new_config.channel_config);
+	copy_paths.push_back (new_config.filename->get_path (config.format));
 }
 
 void
@@ -296,10 +474,9 @@ ExportGraphBuilder::Encoder::init_writer (boost::shared_ptr<AudioGrapher::Sndfil
 void
 ExportGraphBuilder::Encoder::copy_files (std::string orig_path)
 {
-	while (filenames.size()) {
-		ExportFilenamePtr & filename = filenames.front();
-		PBD::copy_file (orig_path, filename->get_path (config.format).c_str());
-		filenames.pop_front();
+	while (copy_paths.size()) {
+		PBD::copy_file (orig_path, copy_paths.front());
+		copy_paths.pop_front();
 	}
 }
 
@@ -449,7 +626,20 @@ ExportGraphBuilder::Intermediate::Intermediate (ExportGraphBuilder & parent, Fil
 	if (parent._realtime) {
 		tmp_file.reset (new TmpFileRt<float> (&tmpfile_path_buf[0], format, channels, config.format->sample_rate()));
 	} else {
-		tmp_file.reset (new TmpFileSync<float> (&tmpfile_path_buf[0], format, channels, config.format->sample_rate()));
+		/* keep as much of the data in memory as the budget allows,
+		 * only the remainder goes to disk. */
+		framecnt_t const session_rate = parent.session.nominal_frame_rate();
+		framecnt_t const sb = config.format->silence_beginning_at (parent.timespan->get_start(), session_rate);
+		framecnt_t const se = config.format->silence_end_at (parent.timespan->get_end(), session_rate);
+		framecnt_t const frames = std::ceil ((parent.timespan->get_length() + sb + se) * (double) config.format->sample_rate() / session_rate);
+		framecnt_t const in_memory = std::min ((frames + max_frames) * channels, parent.memory_budget);
+
+		if (in_memory > 0) {
+			parent.memory_budget -= in_memory;
+			tmp_file.reset (new TmpFileMem<float> (&tmpfile_path_buf[0], format, channels, config.format->sample_rate(), in_memory));
+		} else {
+			tmp_file.reset (new TmpFileSync<float> (&tmpfile_path_buf[0], format, channels, config.format->sample_rate()));
+		}
 	}
 
 	tmp_file->FileWritten.connect_same_thread (post_processing_connection,
@@ -548,6 +738,9 @@ ExportGraphBuilder::Intermediate::prepare_post_processing()
 		}
 	}
 	tmp_file->add_output (normalizer);
+
+	/* several timespans may end in the same cycle */
+	Glib::Threads::Mutex::Lock lm (parent.intermediates_lock);
 	parent.intermediates.push_back (this);
 }
 
@@ -706,6 +899,7 @@ ExportGraphBuilder::SilenceHandler::operator== (FileSpec const & other_config) c
 
 ExportGraphBuilder::ChannelConfig::ChannelConfig (ExportGraphBuilder & parent, FileSpec const & new_config, ChannelMap & channel_map)
 	: parent (parent)
+	, timespan (parent.timespan)
 {
 	typedef ExportChannelConfiguration::ChannelList ChannelList;
 
@@ -772,7 +966,7 @@ ExportGraphBuilder::ChannelConfig::remove_children (bool remove_out_files)
 bool
 ExportGraphBuilder::ChannelConfig::operator== (FileSpec const & other_config) const
 {
-	return config.channel_config == other_config.channel_config;
+	return config.channel_config == other_config.channel_config && timespan == parent.timespan;
 }
 
 } // namespace ARDOUR
@@ -112,6 +112,8 @@ ExportHandler::ExportHandler (Session & session)
   , graph_builder (new ExportGraphBuilder (session))
   , export_status (session.get_export_status ())
   , post_processing (false)
+  , single_pass (false)
+  , single_pass_end (0)
   , cue_tracknum (0)
   , cue_indexnum (0)
 {
@@ -160,7 +162,14 @@ ExportHandler::do_export ()
 	/* Start export */
 
 	Glib::Threads::Mutex::Lock l (export_status->lock());
-	start_timespan ();
+
+	single_pass = use_single_pass ();
+
+	if (single_pass) {
+		start_single_pass ();
+	} else {
+		start_timespan ();
+	}
 }
 
 void
@@ -206,6 +215,87 @@ ExportHandler::start_timespan ()
 	session.start_audio_export (process_position, realtime);
 }
 
+struct TimespanSortByStart {
+	bool operator() (ExportTimespanPtr const & a, ExportTimespanPtr const & b) const {
+		return a->get_start () < b->get_start ();
+	}
+};
+
+/** @return true if all timespans should be exported in a single pass over
+ *  the session, rather than one after the other. This saves locating and
+ *  re-reading the material for each timespan, which matters when exporting
+ *  many (possibly overlapping) ranges. Realtime export is always done one
+ *  timespan at a time.
+ */
+bool
+ExportHandler::use_single_pass () const
+{
+	if (!session.config.get_single_pass_export () || export_status->total_timespans < 2) {
+		return false;
+	}
+
+	for (ConfigMap::const_iterator it = config_map.begin(); it != config_map.end(); ++it) {
+		if (it->first->realtime ()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void
+ExportHandler::start_single_pass ()
+{
+	/* Register the file configurations of all timespans to the graph builder */
+
+	graph_builder->reset ();
+	single_pass_timespans.clear ();
+
+	for (ConfigMap::iterator it = config_map.begin(); it != config_map.end(); it = timespan_bounds.second) {
+
+		timespan_bounds = config_map.equal_range (it->first);
+		graph_builder->set_current_timespan (it->first);
+		handle_duplicate_format_extensions();
+
+		for (ConfigMap::iterator c = timespan_bounds.first; c != timespan_bounds.second; ++c) {
+			FileSpec & spec = c->second;
+			spec.filename->set_timespan (c->first);
+			graph_builder->add_config (spec, false);
+		}
+
+		single_pass_timespans.push_back (it->first);
+	}
+
+	std::sort (single_pass_timespans.begin(), single_pass_timespans.end(), TimespanSortByStart ());
+
+	framepos_t start = max_framepos;
+	single_pass_end = 0;
+
+	for (std::vector<ExportTimespanPtr>::const_iterator t = single_pass_timespans.begin(); t != single_pass_timespans.end(); ++t) {
+		start = std::min (start, (*t)->get_start ());
+		single_pass_end = std::max (single_pass_end, (*t)->get_end ());
+	}
+
+	/* finish_timespan () finishes everything up to the end of the bounds */
+	timespan_bounds = TimespanBounds (config_map.begin(), config_map.end());
+	current_timespan = single_pass_timespans.front ();
+
+	/* progress is that of the whole pass, export_status->timespan counts
+	   the timespans which have been started.
+	*/
+	export_status->timespan = 0;
+	export_status->total_frames = single_pass_end - start;
+	export_status->total_frames_current_timespan = single_pass_end - start;
+	export_status->processed_frames_current_timespan = 0;
+
+	/* start export */
+
+	post_processing = false;
+	session.ProcessExport.connect_same_thread (process_connection, boost::bind (&ExportHandler::process, this, _1));
+	process_position = start;
+	session.start_audio_export (process_position, false);
+}
+
 void
 ExportHandler::handle_duplicate_format_extensions()
 {
@@ -242,6 +332,9 @@ ExportHandler::process (framecnt_t frames)
 		}
 	} else {
 		Glib::Threads::Mutex::Lock l (export_status->lock());
+		if (single_pass) {
+			return process_single_pass (frames);
+		}
 		return process_timespan (frames);
 	}
 }
@@ -286,6 +379,46 @@ ExportHandler::process_timespan (framecnt_t frames)
 	return ret;
 }
 
+int
+ExportHandler::process_single_pass (framecnt_t frames)
+{
+	export_status->active_job = ExportStatus::Exporting;
+
+	bool const last_cycle = (process_position + frames >= single_pass_end);
+	framecnt_t const frames_to_read = last_cycle ? single_pass_end - process_position : frames;
+
+	if (last_cycle) {
+		export_status->stop = true;
+	}
+
+	while (export_status->timespan < single_pass_timespans.size () &&
+	       single_pass_timespans[export_status->timespan]->get_start () < process_position + frames_to_read) {
+		export_status->timespan_name = single_pass_timespans[export_status->timespan]->name ();
+		export_status->timespan++;
+	}
+
+	/* Do actual processing */
+	int ret = graph_builder->process_timespans (process_position, frames_to_read);
+
+	process_position += frames_to_read;
+	export_status->processed_frames += frames_to_read;
+	export_status->processed_frames_current_timespan += frames_to_read;
+
+	/* Start post-processing/normalizing if necessary */
+	if (last_cycle) {
+		post_processing = graph_builder->need_postprocessing ();
+		if (post_processing) {
+			export_status->total_postprocessing_cycles = graph_builder->get_postprocessing_cycle_count();
+			export_status->current_postprocessing_cycle = 0;
+		} else {
+			finish_timespan ();
+			return 0;
+		}
+	}
+
+	return ret;
+}
+
 int
 ExportHandler::post_process ()
 {
@@ -319,21 +452,24 @@ ExportHandler::finish_timespan ()
 
 	while (config_map.begin() != timespan_bounds.second) {
 
+		/* when exporting in a single pass, this finishes all timespans */
+		ExportTimespanPtr timespan = config_map.begin()->first;
 		ExportFormatSpecPtr fmt = config_map.begin()->second.format;
+		config_map.begin()->second.filename->set_timespan (timespan);
 		std::string filename = config_map.begin()->second.filename->get_path(fmt);
 		if (fmt->with_cue()) {
-			export_cd_marker_file (current_timespan, fmt, filename, CDMarkerCUE);
+			export_cd_marker_file (timespan, fmt, filename, CDMarkerCUE);
 		}
 
 		if (fmt->with_toc()) {
-			export_cd_marker_file (current_timespan, fmt, filename, CDMarkerTOC);
+			export_cd_marker_file (timespan, fmt, filename, CDMarkerTOC);
 		}
 
 		if (fmt->with_mp4chaps()) {
-			export_cd_marker_file (current_timespan, fmt, filename, MP4Chaps);
+			export_cd_marker_file (timespan, fmt, filename, MP4Chaps);
 		}
 
-		Session::Exported (current_timespan->name(), filename); /* EMIT SIGNAL */
+		Session::Exported (timespan->name(), filename); /* EMIT SIGNAL */
 
 		/* close file first, otherwise TagLib enounters an ERROR_SHARING_VIOLATION
 		 * The process cannot access the file because it is being used.
@@ -388,7 +524,7 @@ ExportHandler::finish_timespan ()
 			subs.insert (std::pair<char, std::string> ('G', metadata.genre ()));
 			subs.insert (std::pair<char, std::string> ('L', total_tracks.str ()));
 			subs.insert (std::pair<char, std::string> ('M', metadata.mixer ()));
-			subs.insert (std::pair<char, std::string> ('N', current_timespan->name())); // =?= config_map.begin()->first->name ()
+			subs.insert (std::pair<char, std::string> ('N', timespan->name()));
 			subs.insert (std::pair<char, std::string> ('O', metadata.composer ()));
 			subs.insert (std::pair<char, std::string> ('P', metadata.producer ()));
 			subs.insert (std::pair<char, std::string> ('S', metadata.disc_subtitle ()));
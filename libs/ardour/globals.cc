@@ -112,6 +112,7 @@
 #include "ardour/session_event.h"
 #include "ardour/source_factory.h"
 #include "ardour/uri_map.h"
+#include "ardour/utils.h"
 
 #include "audiographer/routines.h"
 
@@ -475,6 +476,11 @@ ARDOUR::init (bool use_windows_vst, bool try_optimization, const char* localedir
 		return false;
 	}
 
+	/* threads created from here on inherit this, except process threads
+	   which pin themselves (see Graph::main_thread())
+	*/
+	keep_thread_off_process_cpus ();
+
 	Config->set_use_windows_vst (use_windows_vst);
 #ifdef LXVST_SUPPORT
 	Config->set_use_lxvst(true);
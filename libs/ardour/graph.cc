@@ -21,6 +21,7 @@
 #include <cmath>
 
 #include "pbd/compose.h"
+#include "pbd/cpus.h"
 #include "pbd/debug_rt_alloc.h"
 #include "pbd/pthread_utils.h"
 
@@ -31,6 +32,7 @@
 #include "ardour/route.h"
 #include "ardour/process_thread.h"
 #include "ardour/audioengine.h"
+#include "ardour/utils.h"
 
 #include "pbd/i18n.h"
 
@@ -58,6 +60,8 @@ Graph::Graph (Session & session)
 	, _callback_start_sem ("graph_start", 0)
 	, _callback_done_sem ("graph_done", 0)
 	, _cleanup_sem ("graph_cleanup", 0)
+	, _thread_stats (max (hardware_concurrency (), 2U))
+	, _cycle (0)
 {
         pthread_mutex_init( &_trigger_mutex, NULL);
 
@@ -119,12 +123,12 @@ Graph::reset_thread_list ()
 
         _threads_active = true;
 
-	if (AudioEngine::instance()->create_process_thread (boost::bind (&Graph::main_thread, this)) != 0) {
+	if (AudioEngine::instance()->create_process_thread (boost::bind (&Graph::main_thread, this, 0)) != 0) {
 		throw failed_constructor ();
 	}
 
         for (uint32_t i = 1; i < num_threads; ++i) {
-		if (AudioEngine::instance()->create_process_thread (boost::bind (&Graph::helper_thread, this))) {
+		if (AudioEngine::instance()->create_process_thread (boost::bind (&Graph::helper_thread, this, i))) {
 			throw failed_constructor ();
 		}
         }
@@ -209,6 +213,8 @@ Graph::prep()
 
         chain = _current_chain;
 
+        g_atomic_int_inc (&_cycle);
+
         _graph_empty = true;
         for (i=_nodes_rt[chain].begin(); i!=_nodes_rt[chain].end(); i++) {
                 (*i)->prep( chain);
@@ -352,7 +358,7 @@ Graph::rechain (boost::shared_ptr<RouteList> routelist, GraphEdges const & edges
  *  @return true to quit, false to carry on.
  */
 bool
-Graph::run_one()
+Graph::run_one (GraphThreadStats* stats)
 {
         GraphNode* to_run;
 
@@ -397,7 +403,16 @@ Graph::run_one()
         }
         pthread_mutex_unlock (&_trigger_mutex);
 
+        if (stats) {
+                stats->node_start (g_atomic_int_get (&_cycle));
+        }
+
         to_run->process();
+
+        if (stats) {
+                stats->node_end ();
+        }
+
         to_run->finish (_current_chain);
 
         DEBUG_TRACE(DEBUG::ProcessThreads, string_compose ("%1 has finished run_one()\n", pthread_name()));
@@ -405,17 +420,47 @@ Graph::run_one()
         return !_threads_active;
 }
 
+GraphThreadStats*
+Graph::thread_stats (uint32_t n)
+{
+	if (n < _thread_stats.size ()) {
+		return &_thread_stats[n];
+	}
+	return 0;
+}
+
+/** Pin the @param n th process thread to its CPU (if so configured) and
+ *  get its buffers, allocated locally if it was pinned.
+ */
+void
+Graph::setup_thread (ProcessThread* pt, uint32_t n)
+{
+	const bool pinned = pin_process_thread (n);
+
+	suspend_rt_malloc_checks ();
+
+	pt->get_buffers ();
+
+	if (pinned) {
+		pt->reallocate_buffers ();
+	}
+
+	resume_rt_malloc_checks ();
+}
+
 void
-Graph::helper_thread()
+Graph::helper_thread (uint32_t n)
 {
 	suspend_rt_malloc_checks ();
 	ProcessThread* pt = new ProcessThread ();
 	resume_rt_malloc_checks ();
 
-	pt->get_buffers();
+	setup_thread (pt, n);
+
+	GraphThreadStats* stats = thread_stats (n);
 
 	while(1) {
-		if (run_one()) {
+		if (run_one (stats)) {
 			break;
 		}
 	}
@@ -426,13 +471,15 @@ Graph::helper_thread()
 
 /** Here's the main graph thread */
 void
-Graph::main_thread()
+Graph::main_thread (uint32_t n)
 {
 	suspend_rt_malloc_checks ();
 	ProcessThread* pt = new ProcessThread ();
 	resume_rt_malloc_checks ();
 
-	pt->get_buffers();
+	setup_thread (pt, n);
+
+	GraphThreadStats* stats = thread_stats (n);
 
 again:
 	_callback_start_sem.wait ();
@@ -454,7 +501,7 @@ again:
 	/* This loop will run forever */
 	while (1) {
 		DEBUG_TRACE(DEBUG::ProcessThreads, "main thread runs one graph node\n");
-		if (run_one()) {
+		if (run_one (stats)) {
 			break;
 		}
 	}
@@ -602,3 +649,37 @@ Graph::in_process_thread () const
 {
 	return AudioEngine::instance()->in_process_thread ();
 }
+
+GraphThreadStats::GraphThreadStats ()
+	: _migrations (0)
+	, _cpu (-1)
+	, _cycle (0)
+	, _start (0)
+	, _busy (0)
+{
+}
+
+void
+GraphThreadStats::node_start (gint cycle)
+{
+	if (cycle != _cycle) {
+		/* first node of a new cycle: the previous one is complete */
+		if (_busy > 0) {
+			_cycle_stats.add (_busy);
+		}
+		_busy = 0;
+		_cycle = cycle;
+	}
+
+	const int cpu = PBD::current_cpu ();
+	const int last = g_atomic_int_get (&_cpu);
+
+	if (cpu != last) {
+		if (last >= 0) {
+			g_atomic_int_inc (&_migrations);
+		}
+		g_atomic_int_set (&_cpu, cpu);
+	}
+
+	_start = get_cycles ();
+}
@@ -43,7 +43,9 @@ InternalReturn::run (BufferSet& bufs, framepos_t /*start_frame*/, framepos_t /*e
 	if (lm.locked ()) {
 		for (list<InternalSend*>::iterator i = _sends.begin(); i != _sends.end(); ++i) {
 			if ((*i)->active () && (!(*i)->source_route() || (*i)->source_route()->active())) {
-				bufs.merge_from ((*i)->get_buffers(), nframes);
+				/* nothing else reads a send's buffers, so their data
+				   may be passed on rather than copied */
+				bufs.forward_from ((*i)->get_buffers(), nframes);
 			}
 		}
 	}
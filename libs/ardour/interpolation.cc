@@ -18,7 +18,9 @@
 */
 
 #include <stdint.h>
+#include <string.h>
 #include <cstdio>
+#include <algorithm>
 
 #include "ardour/interpolation.h"
 #include "ardour/midi_buffer.h"
@@ -154,6 +156,314 @@ CubicInterpolation::interpolate (int channel, framecnt_t nframes, Sample *input,
 	return i;
 }
 
+void
+CubicInterpolation::reserve (framecnt_t nframes)
+{
+	if ((framecnt_t) _frac.size () >= nframes) {
+		return;
+	}
+	_idx.resize (nframes);
+	_prev.resize (nframes);
+	_frac.resize (nframes);
+}
+
+framecnt_t
+CubicInterpolation::interpolate (framecnt_t nframes, uint32_t n_channels, Sample** input, Sample** output)
+{
+	if (n_channels == 0) {
+		return 0;
+	}
+
+	if (nframes < 3 || !input || !output || nframes > (framecnt_t) _frac.size ()) {
+		framecnt_t rv = 0;
+		for (uint32_t c = 0; c < n_channels; ++c) {
+			rv = interpolate (c, nframes, input ? input[c] : 0, output ? output[c] : 0);
+		}
+		return rv;
+	}
+
+	double acceleration;
+
+	if (_speed != _target_speed) {
+		acceleration = _target_speed - _speed;
+	} else {
+		acceleration = 0.0;
+	}
+
+	double distance = phase[0];
+
+	/* compute read-positions and fractional parts once for all channels,
+	 * using the exact same arithmetic as the single channel version.
+	 */
+	int32_t* const idx  = &_idx[0];
+	int32_t* const prev = &_prev[0];
+	float*   const frac = &_frac[0];
+
+	const bool fake_inm1 = floor (distance) == 0.0;
+
+	for (framecnt_t outsample = 0; outsample < nframes; ++outsample) {
+
+		float f = floor (distance);
+		float fractional_phase_part = distance - f;
+
+		int32_t i = lrintf (f);
+
+		if (fractional_phase_part >= 1.0) {
+			fractional_phase_part -= 1.0;
+			++i;
+		}
+
+		idx[outsample]  = i;
+		frac[outsample] = fractional_phase_part;
+		prev[outsample] = outsample > 0 ? idx[outsample - 1] : -1;
+
+		distance += _speed + acceleration;
+	}
+
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		Sample const* const in = input[c];
+		Sample* const out = output[c];
+
+		Sample inm1;
+		if (fake_inm1) {
+			inm1 = in[0] - (in[1] - in[0]);
+		} else {
+			inm1 = in[-1];
+		}
+
+		for (framecnt_t outsample = 0; outsample < nframes; ++outsample) {
+			const int32_t i = idx[outsample];
+			const float fractional_phase_part = frac[outsample];
+
+			if (outsample > 0) {
+				inm1 = in[prev[outsample]];
+			}
+
+			out[outsample] = in[i] + 0.5f * fractional_phase_part * (in[i+1] - inm1 +
+					fractional_phase_part * (4.0f * in[i+1] + 2.0f * inm1 - 5.0f * in[i] - in[i+2] +
+						fractional_phase_part * (3.0f * (in[i] - in[i+1]) - inm1 + in[i+2])));
+		}
+	}
+
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		phase[c] = distance - floor(distance);
+	}
+
+	return floor (distance);
+}
+
+/* ****************************************************************************/
+
+namespace {
+
+/** windowed-sinc polyphase table, shared by all SincInterpolation instances */
+class SincTable {
+public:
+	enum {
+		taps   = SincInterpolation::taps,
+		phases = 256
+	};
+
+	SincTable ()
+	{
+		/* cut-off slightly below nyquist, to leave room for the
+		 * transition-band of the (short) kernel */
+		const double fc = 0.9;
+		const double half = taps / 2;
+
+		for (int r = 0; r <= phases; ++r) {
+			const double phi = r / (double) phases;
+			double sum = 0;
+			for (int k = 0; k < taps; ++k) {
+				const double x = (k - (half - 1)) - phi; // -half .. +half
+				const double s = x == 0 ? 1.0 : sin (M_PI * fc * x) / (M_PI * fc * x);
+				/* Blackman-Harris window */
+				const double w = 2.0 * M_PI * (x + half) / (2.0 * half);
+				const double win = 0.35875 - 0.48829 * cos (w) + 0.14128 * cos (2 * w) - 0.01168 * cos (3 * w);
+				_table[r * taps + k] = s * win;
+				sum += s * win;
+			}
+			/* normalize to unity gain at DC */
+			for (int k = 0; k < taps; ++k) {
+				_table[r * taps + k] /= sum;
+			}
+		}
+	}
+
+	float const* row (int r) const { return &_table[r * taps]; }
+
+private:
+	float _table[(phases + 1) * taps];
+};
+
+static const SincTable sinc_table;
+
+}
+
+SincInterpolation::SincInterpolation ()
+{
+}
+
+SincInterpolation::~SincInterpolation ()
+{
+	for (std::vector<Sample*>::const_iterator i = _history.begin (); i != _history.end (); ++i) {
+		delete [] *i;
+	}
+}
+
+void
+SincInterpolation::add_channel_to (int a, int b)
+{
+	Interpolation::add_channel_to (a, b);
+	Sample* h = new Sample[taps];
+	memset (h, 0, sizeof (Sample) * taps);
+	_history.push_back (h);
+}
+
+void
+SincInterpolation::remove_channel_from ()
+{
+	Interpolation::remove_channel_from ();
+	delete [] _history.back ();
+	_history.pop_back ();
+}
+
+void
+SincInterpolation::reset ()
+{
+	Interpolation::reset ();
+	for (std::vector<Sample*>::const_iterator i = _history.begin (); i != _history.end (); ++i) {
+		memset (*i, 0, sizeof (Sample) * taps);
+	}
+}
+
+framecnt_t
+SincInterpolation::interpolate (int channel, framecnt_t nframes, Sample* input, Sample* output)
+{
+	return process (channel, 1, nframes, &input, &output);
+}
+
+framecnt_t
+SincInterpolation::interpolate (framecnt_t nframes, uint32_t n_channels, Sample** input, Sample** output)
+{
+	if (n_channels == 0) {
+		return 0;
+	}
+	return process (0, n_channels, nframes, input, output);
+}
+
+/** keep the last `taps` samples which were consumed */
+static void
+update_history (Sample* hist, Sample const* in, framecnt_t consumed, int taps)
+{
+	if (consumed >= taps) {
+		memcpy (hist, &in[consumed - taps], sizeof (Sample) * taps);
+	} else if (consumed > 0) {
+		memmove (hist, &hist[consumed], sizeof (Sample) * (taps - consumed));
+		memcpy (&hist[taps - consumed], in, sizeof (Sample) * consumed);
+	}
+}
+
+framecnt_t
+SincInterpolation::process (uint32_t chn, uint32_t n_channels, framecnt_t nframes, Sample** input, Sample** output)
+{
+	const bool run = input && output && input[0] && output[0];
+
+	if (nframes < 3) {
+		/* same as CubicInterpolation: no interpolation possible */
+		if (run) {
+			for (uint32_t c = 0; c < n_channels; ++c) {
+				memcpy (output[c], input[c], sizeof (Sample) * nframes);
+				update_history (_history[chn + c], input[c], nframes, taps);
+			}
+		}
+		return nframes;
+	}
+
+	double acceleration;
+
+	if (_speed != _target_speed) {
+		acceleration = _target_speed - _speed;
+	} else {
+		acceleration = 0.0;
+	}
+
+	double distance = phase[chn];
+
+	if (!run) {
+		/* calculate play-distance only, identical to CubicInterpolation */
+		for (framecnt_t outsample = 0; outsample < nframes; ++outsample) {
+			distance += _speed + acceleration;
+		}
+		return floor (distance);
+	}
+
+	const int32_t chunk = sizeof (_coeff) / sizeof (Sample) / taps;
+	int32_t idx[chunk];
+
+	for (framecnt_t o = 0; o < nframes; o += chunk) {
+		const int32_t n = std::min ((framecnt_t) chunk, nframes - o);
+
+		/* compute read-positions and interpolate the kernel between
+		 * adjacent phases, once for all channels */
+		for (int32_t k = 0; k < n; ++k) {
+			const double f = floor (distance);
+			const float pp = (distance - f) * SincTable::phases;
+			const int32_t r = std::min ((int32_t) pp, (int32_t) SincTable::phases - 1);
+			const float w = pp - r;
+
+			float const* const t0 = sinc_table.row (r);
+			float const* const t1 = sinc_table.row (r + 1);
+			float* const cf = &_coeff[k * taps];
+			for (int j = 0; j < taps; ++j) {
+				cf[j] = t0[j] + w * (t1[j] - t0[j]);
+			}
+
+			idx[k] = (int32_t) f - (lookahead - 1);
+			distance += _speed + acceleration;
+		}
+
+		for (uint32_t c = 0; c < n_channels; ++c) {
+			Sample const* const in = input[c];
+			Sample const* const hist = _history[chn + c];
+			Sample* const out = &output[c][o];
+
+			for (int32_t k = 0; k < n; ++k) {
+				const int32_t first = idx[k];
+				float const* const cf = &_coeff[k * taps];
+				Sample const* x;
+				Sample edge[taps];
+
+				if (first >= 0) {
+					x = &in[first];
+				} else {
+					/* kernel overlaps previously consumed samples */
+					for (int j = 0; j < taps; ++j) {
+						const int32_t p = first + j;
+						edge[j] = p < 0 ? hist[taps + p] : in[p];
+					}
+					x = edge;
+				}
+
+				float acc = 0;
+				for (int j = 0; j < taps; ++j) {
+					acc += cf[j] * x[j];
+				}
+				out[k] = acc;
+			}
+		}
+	}
+
+	const framecnt_t consumed = floor (distance);
+
+	for (uint32_t c = 0; c < n_channels; ++c) {
+		update_history (_history[chn + c], input[c], consumed, taps);
+		phase[chn + c] = distance - floor (distance);
+	}
+
+	return consumed;
+}
+
 framecnt_t
 CubicMidiInterpolation::distance (framecnt_t nframes, bool roll)
 {
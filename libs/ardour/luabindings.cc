@@ -36,7 +36,9 @@
 #include "ardour/chan_mapping.h"
 #include "ardour/dB.h"
 #include "ardour/dsp_filter.h"
+#include "ardour/dsp_stats.h"
 #include "ardour/fluid_synth.h"
+#include "ardour/graph.h"
 #include "ardour/interthread_info.h"
 #include "ardour/lua_api.h"
 #include "ardour/luabindings.h"
@@ -169,6 +171,8 @@ CLASSKEYS(boost::shared_ptr<Evoral::ControlList>);
 CLASSKEYS(ARDOUR::LuaOSC::Address);
 CLASSKEYS(ARDOUR::Session);
 CLASSKEYS(ARDOUR::PeakMeter);
+CLASSKEYS(ARDOUR::DSPStats);
+CLASSKEYS(ARDOUR::GraphThreadStats);
 CLASSKEYS(ARDOUR::BufferSet);
 CLASSKEYS(ARDOUR::ChanMapping);
 CLASSKEYS(ARDOUR::FluidSynth);
@@ -457,6 +461,18 @@ LuaBindings::common (lua_State* L)
 		.addData ("id", &AudioRange::id)
 		.endClass ()
 
+		.beginClass <DSPStats> ("DSPStats")
+		.addRefFunction ("get_stats", &DSPStats::get_stats)
+		.addFunction ("percentile", &DSPStats::percentile)
+		.addFunction ("reset", &DSPStats::reset)
+		.endClass ()
+
+		.beginClass <GraphThreadStats> ("GraphThreadStats")
+		.addFunction ("cycle_stats", &GraphThreadStats::cycle_stats)
+		.addFunction ("migrations", &GraphThreadStats::migrations)
+		.addFunction ("cpu", &GraphThreadStats::cpu)
+		.endClass ()
+
 		.beginWSPtrClass <PluginInfo> ("PluginInfo")
 		.addVoidConstructor ()
 		.addData ("name", &PluginInfo::name, false)
@@ -709,6 +725,7 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("trim", &Route::trim)
 		.addFunction ("peak_meter", (boost::shared_ptr<PeakMeter> (Route::*)())&Route::peak_meter)
 		.addFunction ("set_meter_point", &Route::set_meter_point)
+		.addFunction ("dsp_stats", &Route::dsp_stats)
 		.endClass ()
 
 		.deriveWSPtrClass <Playlist, SessionObject> ("Playlist")
@@ -861,6 +878,7 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("active", &Processor::active)
 		.addFunction ("activate", &Processor::activate)
 		.addFunction ("deactivate", &Processor::deactivate)
+		.addFunction ("dsp_stats", &Processor::dsp_stats)
 		.endClass ()
 
 		.deriveWSPtrClass <IOProcessor, Processor> ("IOProcessor")
@@ -1424,6 +1442,9 @@ LuaBindings::common (lua_State* L)
 		.addFunction ("add_stateful_diff_command", &Session::add_stateful_diff_command)
 		.addFunction ("engine", (AudioEngine& (Session::*)())&Session::engine)
 		.addFunction ("get_block_size", &Session::get_block_size)
+		.addFunction ("set_count_buffer_copies", &Session::set_count_buffer_copies)
+		.addFunction ("buffer_bytes_copied", &Session::buffer_bytes_copied)
+		.addFunction ("process_thread_stats", &Session::process_thread_stats)
 		.addFunction ("worst_output_latency", &Session::worst_output_latency)
 		.addFunction ("worst_input_latency", &Session::worst_input_latency)
 		.addFunction ("worst_track_latency", &Session::worst_track_latency)
@@ -1592,6 +1613,31 @@ LuaBindings::dsp (lua_State* L)
 		.addFunction ("reset", &DSP::Biquad::reset)
 		.addFunction ("dB_at_freq", &DSP::Biquad::dB_at_freq)
 		.endClass ()
+		.beginClass <DSP::BiquadCascade> ("BiquadCascade")
+		.addConstructor <void (*) (double, uint32_t, uint32_t)> ()
+		.addFunction ("run_map", &DSP::BiquadCascade::run_map)
+		.addFunction ("compute", &DSP::BiquadCascade::compute)
+		.addFunction ("configure", &DSP::BiquadCascade::configure)
+		.addFunction ("configure_channel", &DSP::BiquadCascade::configure_channel)
+		.addFunction ("reset", &DSP::BiquadCascade::reset)
+		.addFunction ("n_channels", &DSP::BiquadCascade::n_channels)
+		.addFunction ("n_stages", &DSP::BiquadCascade::n_stages)
+		.endClass ()
+		.beginClass <DSP::FIRFilter> ("FIRFilter")
+		.addConstructor <void (*) (uint32_t)> ()
+		.addFunction ("set_coefficients", &DSP::FIRFilter::set_coefficients)
+		.addFunction ("run", &DSP::FIRFilter::run)
+		.addFunction ("reset", &DSP::FIRFilter::reset)
+		.endClass ()
+		.beginClass <DSP::Convolver> ("Convolver")
+		.addConstructor <void (*) (uint32_t, bool, uint32_t)> ()
+		.addFunction ("set_ir", &DSP::Convolver::set_ir)
+		.addFunction ("run", &DSP::Convolver::run)
+		.addFunction ("reset", &DSP::Convolver::reset)
+		.addFunction ("block_size", &DSP::Convolver::block_size)
+		.addFunction ("ir_length", &DSP::Convolver::ir_length)
+		.addFunction ("n_partitions", &DSP::Convolver::n_partitions)
+		.endClass ()
 		.beginClass <DSP::FFTSpectrum> ("FFTSpectrum")
 		.addConstructor <void (*) (uint32_t, double)> ()
 		.addFunction ("set_data_hann", &DSP::FFTSpectrum::set_data_hann)
@@ -55,6 +55,8 @@ LuaProc::LuaProc (AudioEngine& engine,
 	, lua (lua_newstate (&PBD::ReallocPool::lalloc, &_mempool))
 #endif
 	, _lua_dsp (0)
+	, _lua_in_map (0)
+	, _lua_out_map (0)
 	, _script (script)
 	, _lua_does_channelmapping (false)
 	, _lua_has_inline_display (false)
@@ -86,6 +88,8 @@ LuaProc::LuaProc (const LuaProc &other)
 	, lua (lua_newstate (&PBD::ReallocPool::lalloc, &_mempool))
 #endif
 	, _lua_dsp (0)
+	, _lua_in_map (0)
+	, _lua_out_map (0)
 	, _script (other.script ())
 	, _lua_does_channelmapping (false)
 	, _lua_has_inline_display (false)
@@ -121,6 +125,8 @@ LuaProc::~LuaProc () {
 				0.0001f * _stats_max[1]);
 	}
 #endif
+	delete (_lua_in_map);
+	delete (_lua_out_map);
 	lua.do_command ("collectgarbage();");
 	delete (_lua_dsp);
 	delete [] _control_data;
@@ -579,6 +585,16 @@ LuaProc::configure_io (ChanCount in, ChanCount out)
 	_configured_in = in;
 	_configured_out = out;
 
+	if (!_lua_does_channelmapping) {
+		lua_State* L = lua.getState ();
+		delete (_lua_in_map);
+		delete (_lua_out_map);
+		_lua_in_map = new luabridge::LuaRef (luabridge::newTable (L));
+		_lua_out_map = new luabridge::LuaRef (luabridge::newTable (L));
+		_in_map_data.assign (in.n_audio (), 0);
+		_out_map_data.assign (out.n_audio (), 0);
+	}
+
 	return true;
 }
 
@@ -624,64 +640,77 @@ LuaProc::connect_and_run (BufferSet& bufs,
 			BufferSet& scratch_bufs = _session.get_scratch_buffers (ChanCount (DataType::AUDIO, 1));
 
 			lua_State* L = lua.getState ();
-			luabridge::LuaRef in_map (luabridge::newTable (L));
-			luabridge::LuaRef out_map (luabridge::newTable (L));
+			luabridge::LuaRef& in_map (*_lua_in_map);
+			luabridge::LuaRef& out_map (*_lua_out_map);
 
 			const uint32_t audio_in = _configured_in.n_audio ();
 			const uint32_t audio_out = _configured_out.n_audio ();
 			const uint32_t midi_in = _configured_in.n_midi ();
 
+			/* passing a float* to lua allocates userdata, so only
+			 * update table entries for buffers which have changed */
 			for (uint32_t ap = 0; ap < audio_in; ++ap) {
 				bool valid;
 				const uint32_t buf_index = in.get(DataType::AUDIO, ap, &valid);
+				float* data;
 				if (valid) {
-					in_map[ap + 1] = bufs.get_audio (buf_index).data (offset);
+					data = bufs.get_audio (buf_index).data (offset);
 				} else {
-					in_map[ap + 1] = silent_bufs.get_audio (0).data (offset);
+					data = silent_bufs.get_audio (0).data (offset);
+				}
+				if (_in_map_data[ap] != data) {
+					in_map[ap + 1] = data;
+					_in_map_data[ap] = data;
 				}
 			}
 			for (uint32_t ap = 0; ap < audio_out; ++ap) {
 				bool valid;
 				const uint32_t buf_index = out.get(DataType::AUDIO, ap, &valid);
+				float* data;
 				if (valid) {
-					out_map[ap + 1] = bufs.get_audio (buf_index).data (offset);
+					data = bufs.get_audio (buf_index).data (offset);
 				} else {
-					out_map[ap + 1] = scratch_bufs.get_audio (0).data (offset);
+					data = scratch_bufs.get_audio (0).data (offset);
+				}
+				if (_out_map_data[ap] != data) {
+					out_map[ap + 1] = data;
+					_out_map_data[ap] = data;
 				}
 			}
 
-			luabridge::LuaRef lua_midi_src_tbl (luabridge::newTable (L));
-			int e = 1; // > 1 port, we merge events (unsorted)
-			for (uint32_t mp = 0; mp < midi_in; ++mp) {
-				bool valid;
-				const uint32_t idx = in.get(DataType::MIDI, mp, &valid);
-				if (valid) {
-					for (MidiBuffer::iterator m = bufs.get_midi(idx).begin();
-							m != bufs.get_midi(idx).end(); ++m, ++e) {
-						const Evoral::MIDIEvent<framepos_t> ev(*m, false);
-						luabridge::LuaRef lua_midi_data (luabridge::newTable (L));
-						const uint8_t* data = ev.buffer();
-						for (uint32_t i = 0; i < ev.size(); ++i) {
-							lua_midi_data [i + 1] = data[i];
+			if (_has_midi_input) {
+				luabridge::LuaRef lua_midi_src_tbl (luabridge::newTable (L));
+				int e = 1; // > 1 port, we merge events (unsorted)
+				for (uint32_t mp = 0; mp < midi_in; ++mp) {
+					bool valid;
+					const uint32_t idx = in.get(DataType::MIDI, mp, &valid);
+					if (valid) {
+						for (MidiBuffer::iterator m = bufs.get_midi(idx).begin();
+								m != bufs.get_midi(idx).end(); ++m, ++e) {
+							const Evoral::MIDIEvent<framepos_t> ev(*m, false);
+							luabridge::LuaRef lua_midi_data (luabridge::newTable (L));
+							const uint8_t* data = ev.buffer();
+							for (uint32_t i = 0; i < ev.size(); ++i) {
+								lua_midi_data [i + 1] = data[i];
+							}
+							luabridge::LuaRef lua_midi_event (luabridge::newTable (L));
+							lua_midi_event["time"] = 1 + (*m).time();
+							lua_midi_event["data"] = lua_midi_data;
+							lua_midi_event["bytes"] = data;
+							lua_midi_event["size"] = ev.size();
+							lua_midi_src_tbl[e] = lua_midi_event;
 						}
-						luabridge::LuaRef lua_midi_event (luabridge::newTable (L));
-						lua_midi_event["time"] = 1 + (*m).time();
-						lua_midi_event["data"] = lua_midi_data;
-						lua_midi_event["bytes"] = data;
-						lua_midi_event["size"] = ev.size();
-						lua_midi_src_tbl[e] = lua_midi_event;
 					}
 				}
-			}
 
-			if (_has_midi_input) {
 				// XXX TODO This needs a better solution than global namespace
 				luabridge::push (L, lua_midi_src_tbl);
 				lua_setglobal (L, "midiin");
 			}
 
-			luabridge::LuaRef lua_midi_sink_tbl (luabridge::newTable (L));
+			luabridge::LuaRef lua_midi_sink_tbl (L);
 			if (_has_midi_output) {
+				lua_midi_sink_tbl = luabridge::newTable (L);
 				luabridge::push (L, lua_midi_sink_tbl);
 				lua_setglobal (L, "midiout");
 			}
@@ -48,6 +48,8 @@ PeakMeter::PeakMeter (Session& s, const std::string& name)
 	_reset_max = true;
 	_bufcnt = 0;
 	_combined_peak = 0;
+	_snapshot = s.meter_snapshot();
+	_snapshot_slot = _snapshot->add_slot (0);
 }
 
 PeakMeter::~PeakMeter ()
@@ -67,6 +69,7 @@ PeakMeter::~PeakMeter ()
 		_peak_power.pop_back();
 		_max_peak_signal.pop_back();
 	}
+	_snapshot->remove_slot (_snapshot_slot);
 }
 
 
@@ -190,6 +193,8 @@ PeakMeter::run (BufferSet& bufs, framepos_t /*start_frame*/, framepos_t /*end_fr
 		_bufcnt = 0;
 	}
 
+	write_snapshot ();
+
 	_active = _pending_active;
 }
 
@@ -203,6 +208,7 @@ PeakMeter::reset ()
 			_peak_power[i] = -std::numeric_limits<float>::infinity();
 			_peak_buffer[i] = 0;
 		}
+		write_snapshot ();
 	}
 
 	// these are handled async just fine.
@@ -225,6 +231,7 @@ PeakMeter::reset_max ()
 		_max_peak_signal[i] = 0;
 		_peak_buffer[i] = 0;
 	}
+	write_snapshot ();
 }
 
 bool
@@ -293,6 +300,9 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 	assert(_peak_power.size() == limit);
 	assert(_max_peak_signal.size() == limit);
 
+	_levels.resize (limit);
+	_snapshot->resize_slot (_snapshot_slot, limit);
+
 	/* alloc/free other audio-only meter types. */
 	while (_kmeter.size() > n_audio) {
 		delete (_kmeter.back());
@@ -319,15 +329,73 @@ PeakMeter::set_max_channels (const ChanCount& chn)
 	reset_max();
 }
 
-/** To be driven by the Meter signal from IO.
- * Caller MUST hold its own processor_lock to prevent reconfiguration
+float
+PeakMeter::meter_level (uint32_t n, MeterType type)
+{
+	switch (type) {
+		case MeterPeak:
+		case MeterPeak0dB:
+		case MeterMaxPeak:
+		case MeterMCP:
+			break;
+		default:
+			if (type != _meter_type) {
+				/* not part of the snapshot */
+				return compute_level (n, type);
+			}
+			break;
+	}
+
+	MeterSnapshot::Level level;
+	float combined_peak;
+
+	if (type == MeterMCP) {
+		n = 0;
+	}
+
+	if (!_snapshot->read (_snapshot_slot, n, level, combined_peak)) {
+		return minus_infinity();
+	}
+
+	switch (type) {
+		case MeterPeak:
+		case MeterPeak0dB:
+			return level.peak;
+		case MeterMaxPeak:
+			return level.max_peak;
+		case MeterMCP:
+			return accurate_coefficient_to_dB (combined_peak);
+		default:
+			return level.level;
+	}
+}
+
+/** Publish the current levels to the session's MeterSnapshot.
+ * The level of the meter's own type is read (and hence reset) once
+ * per cycle, the snapshot holds it until the GUI fetched it.
+ */
+void
+PeakMeter::write_snapshot ()
+{
+	const uint32_t n_midi = current_meters.n_midi();
+
+	for (uint32_t n = 0; n < _levels.size(); ++n) {
+		_levels[n].peak = _peak_power[n];
+		_levels[n].max_peak = accurate_coefficient_to_dB (_max_peak_signal[n]);
+		_levels[n].level = compute_level (n, n < n_midi ? MeterPeak : _meter_type);
+	}
+
+	_snapshot->write (_snapshot_slot, _levels, _combined_peak);
+}
+
+/** Caller MUST hold its own processor_lock to prevent reconfiguration
  * of meter size during this call.
  */
 
 #define CHECKSIZE(MTR) (n < MTR.size() + n_midi && n >= n_midi)
 
 float
-PeakMeter::meter_level(uint32_t n, MeterType type) {
+PeakMeter::compute_level (uint32_t n, MeterType type) {
 	float mcptmp;
 	switch (type) {
 		case MeterKrms:
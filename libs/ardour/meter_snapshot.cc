@@ -0,0 +1,269 @@
+/*
+    Copyright (C) 2017 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include <algorithm>
+#include <cassert>
+
+#include "ardour/meter_snapshot.h"
+
+using namespace ARDOUR;
+
+uint32_t
+MeterSnapshot::Frame::n_channels (int slot) const
+{
+	if (slot < 0 || slot >= (int) _slots.size () || !_slots[slot].used) {
+		return 0;
+	}
+	return _slots[slot].n_channels;
+}
+
+MeterSnapshot::Level const&
+MeterSnapshot::Frame::level (int slot, uint32_t chn) const
+{
+	assert (chn < n_channels (slot));
+	return _levels[_slots[slot].offset + chn];
+}
+
+float
+MeterSnapshot::Frame::combined_peak (int slot) const
+{
+	if (slot < 0 || slot >= (int) _combined.size ()) {
+		return 0;
+	}
+	return _combined[slot];
+}
+
+MeterSnapshot::Layout::Layout (Layout const& other)
+	: slots (other.slots)
+	, back (other.back)
+	, front (other.front)
+	, back_level (other.back_level)
+	, back_combined (other.back_combined)
+	, front_combined (other.front_combined)
+	, seq (0)
+{
+}
+
+MeterSnapshot::MeterSnapshot ()
+	: _layout (new Layout)
+	, _serial (0)
+	, _reset_hold (0)
+	, _held (0)
+{
+}
+
+int
+MeterSnapshot::add_slot (uint32_t n_channels)
+{
+	RCUWriter<Layout> writer (_layout);
+	boost::shared_ptr<Layout> l = writer.get_copy ();
+	std::vector<Slot> const prev (l->slots);
+
+	int slot = 0;
+	while (slot < (int) l->slots.size () && l->slots[slot].used) {
+		++slot;
+	}
+	if (slot == (int) l->slots.size ()) {
+		l->slots.push_back (Slot ());
+	}
+
+	l->slots[slot].used = true;
+	l->slots[slot].n_channels = n_channels;
+	relayout (*l, prev);
+	return slot;
+}
+
+void
+MeterSnapshot::resize_slot (int slot, uint32_t n_channels)
+{
+	RCUWriter<Layout> writer (_layout);
+	boost::shared_ptr<Layout> l = writer.get_copy ();
+
+	if (slot < 0 || slot >= (int) l->slots.size () || l->slots[slot].n_channels == n_channels) {
+		return;
+	}
+
+	std::vector<Slot> const prev (l->slots);
+	l->slots[slot].n_channels = n_channels;
+	relayout (*l, prev);
+}
+
+void
+MeterSnapshot::remove_slot (int slot)
+{
+	RCUWriter<Layout> writer (_layout);
+	boost::shared_ptr<Layout> l = writer.get_copy ();
+
+	if (slot < 0 || slot >= (int) l->slots.size ()) {
+		return;
+	}
+
+	std::vector<Slot> const prev (l->slots);
+	l->slots[slot].used = false;
+	l->slots[slot].n_channels = 0;
+	relayout (*l, prev);
+}
+
+/** pack all slots, keeping the data of channels which were present in @param prev */
+void
+MeterSnapshot::relayout (Layout& l, std::vector<Slot> const& prev)
+{
+	Levels back;
+	Levels front;
+	std::vector<float> back_level;
+	uint32_t offset = 0;
+
+	for (size_t i = 0; i < l.slots.size (); ++i) {
+		Slot& s (l.slots[i]);
+		s.offset = offset;
+		if (!s.used) {
+			continue;
+		}
+		const uint32_t keep = (i < prev.size () && prev[i].used) ? std::min (prev[i].n_channels, s.n_channels) : 0;
+		for (uint32_t c = 0; c < s.n_channels; ++c) {
+			if (c < keep) {
+				back.push_back (l.back[prev[i].offset + c]);
+				front.push_back (l.front[prev[i].offset + c]);
+				back_level.push_back (l.back_level[prev[i].offset + c]);
+			} else {
+				back.push_back (Level ());
+				front.push_back (Level ());
+				back_level.push_back (-std::numeric_limits<float>::infinity ());
+			}
+		}
+		offset += s.n_channels;
+	}
+
+	l.back.swap (back);
+	l.front.swap (front);
+	l.back_level.swap (back_level);
+
+	l.back_combined.resize (l.slots.size (), 0);
+	l.front_combined.resize (l.slots.size (), 0);
+	for (size_t i = 0; i < l.slots.size (); ++i) {
+		if (!l.slots[i].used || i >= prev.size () || !prev[i].used) {
+			l.back_combined[i] = 0;
+			l.front_combined[i] = 0;
+		}
+	}
+}
+
+void
+MeterSnapshot::write (int slot, Levels const& levels, float combined_peak)
+{
+	boost::shared_ptr<Layout> l = _layout.reader ();
+
+	if (slot < 0 || slot >= (int) l->slots.size ()) {
+		return;
+	}
+
+	Slot const& s (l->slots[slot]);
+	const uint32_t n = std::min (s.n_channels, (uint32_t) levels.size ());
+
+	for (uint32_t c = 0; c < n; ++c) {
+		Level& b (l->back[s.offset + c]);
+		b.peak = levels[c].peak;
+		b.max_peak = levels[c].max_peak;
+		b.level = std::max (b.level, levels[c].level);
+		l->back_level[s.offset + c] = levels[c].level;
+	}
+
+	l->back_combined[slot] = combined_peak;
+}
+
+void
+MeterSnapshot::publish (framecnt_t nframes, framecnt_t max_hold)
+{
+	boost::shared_ptr<Layout> l = _layout.reader ();
+
+	/* odd sequence number: update in progress */
+	g_atomic_int_inc (&l->seq);
+	std::copy (l->back.begin (), l->back.end (), l->front.begin ());
+	std::copy (l->back_combined.begin (), l->back_combined.end (), l->front_combined.begin ());
+	g_atomic_int_inc (&l->seq);
+
+	g_atomic_int_inc (&_serial);
+
+	/* start a new hold period with the most recent cycle,
+	 * which the reader that asked for it has not seen, yet.
+	 */
+	const bool requested = g_atomic_int_compare_and_exchange (&_reset_hold, 1, 0);
+	_held += nframes;
+
+	if (requested || _held >= max_hold) {
+		for (size_t i = 0; i < l->back.size (); ++i) {
+			l->back[i].level = l->back_level[i];
+		}
+		_held = 0;
+	}
+}
+
+bool
+MeterSnapshot::fetch (Frame& f, bool reset_hold) const
+{
+	boost::shared_ptr<Layout> l = _layout.reader ();
+
+	for (int tries = 0; tries < 64; ++tries) {
+		const guint serial = g_atomic_int_get (&_serial);
+		if (f._serial == serial && f._layout == l.get ()) {
+			return true;
+		}
+		const gint seq = g_atomic_int_get (&l->seq);
+		if (seq & 1) {
+			continue;
+		}
+		f._slots = l->slots;
+		f._levels = l->front;
+		f._combined = l->front_combined;
+		if (g_atomic_int_get (&l->seq) == seq) {
+			f._serial = serial;
+			f._layout = l.get ();
+			if (reset_hold) {
+				g_atomic_int_set (&_reset_hold, 1);
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+bool
+MeterSnapshot::read (int slot, uint32_t chn, Level& level, float& combined_peak) const
+{
+	boost::shared_ptr<Layout> l = _layout.reader ();
+
+	if (slot < 0 || slot >= (int) l->slots.size () || chn >= l->slots[slot].n_channels) {
+		return false;
+	}
+
+	const uint32_t idx = l->slots[slot].offset + chn;
+
+	for (int tries = 0; tries < 64; ++tries) {
+		const gint seq = g_atomic_int_get (&l->seq);
+		if (seq & 1) {
+			continue;
+		}
+		level = l->front[idx];
+		combined_peak = l->front_combined[slot];
+		if (g_atomic_int_get (&l->seq) == seq) {
+			return true;
+		}
+	}
+	return false;
+}
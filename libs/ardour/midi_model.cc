@@ -137,6 +137,18 @@ MidiModel::DiffCommand::DiffCommand(boost::shared_ptr<MidiModel> m, const std::s
 	assert(_model);
 }
 
+size_t
+MidiModel::DiffCommand::memory_use () const
+{
+	return sizeof (DiffCommand) + _name.capacity ();
+}
+
+/* approximate size of a list node, and of a shared object
+ * including its shared_ptr control block
+ */
+#define LIST_NODE_SIZE(T) (sizeof (T) + 2 * sizeof (void*))
+#define SHARED_SIZE(T) (sizeof (T) + 4 * sizeof (void*))
+
 MidiModel::NoteDiffCommand::NoteDiffCommand (boost::shared_ptr<MidiModel> m, const XMLNode& node)
 	: DiffCommand (m, "")
 {
@@ -330,6 +342,7 @@ MidiModel::NoteDiffCommand::operator() ()
 		}
 	}
 
+	notes_changed ();
 	_model->ContentsChanged(); /* EMIT SIGNAL */
 }
 
@@ -440,9 +453,35 @@ MidiModel::NoteDiffCommand::undo ()
 		}
 	}
 
+	notes_changed ();
 	_model->ContentsChanged(); /* EMIT SIGNAL */
 }
 
+/** Tell the model's users which notes this command touched */
+void
+MidiModel::NoteDiffCommand::notes_changed () const
+{
+	if (_model->insert_merge_policy() != InsertMergeRelax) {
+		/* adding notes may have modified others, without
+		 * recording it in this command.
+		 */
+		return;
+	}
+
+	set<NotePtr> notes (side_effect_removals);
+
+	notes.insert (_added_notes.begin(), _added_notes.end());
+	notes.insert (_removed_notes.begin(), _removed_notes.end());
+
+	for (ChangeList::const_iterator i = _changes.begin(); i != _changes.end(); ++i) {
+		if (i->note) {
+			notes.insert (i->note);
+		}
+	}
+
+	_model->NotesChanged (notes); /* EMIT SIGNAL */
+}
+
 XMLNode&
 MidiModel::NoteDiffCommand::marshal_note(const NotePtr note)
 {
@@ -719,6 +758,15 @@ MidiModel::NoteDiffCommand::set_state (const XMLNode& diff_command, int /*versio
 	return 0;
 }
 
+size_t
+MidiModel::NoteDiffCommand::memory_use () const
+{
+	return DiffCommand::memory_use () + sizeof (NoteDiffCommand) - sizeof (DiffCommand)
+		+ _changes.size () * LIST_NODE_SIZE (NoteChange)
+		+ (_added_notes.size () + _removed_notes.size ()) * (LIST_NODE_SIZE (NotePtr) + SHARED_SIZE (Evoral::Note<TimeType>))
+		+ side_effect_removals.size () * (sizeof (NotePtr) + 4 * sizeof (void*) + SHARED_SIZE (Evoral::Note<TimeType>));
+}
+
 XMLNode&
 MidiModel::NoteDiffCommand::get_state ()
 {
@@ -942,6 +990,14 @@ MidiModel::SysExDiffCommand::set_state (const XMLNode& diff_command, int /*versi
 	return 0;
 }
 
+size_t
+MidiModel::SysExDiffCommand::memory_use () const
+{
+	return DiffCommand::memory_use () + sizeof (SysExDiffCommand) - sizeof (DiffCommand)
+		+ _changes.size () * LIST_NODE_SIZE (Change)
+		+ _removed.size () * (LIST_NODE_SIZE (SysExPtr) + SHARED_SIZE (Evoral::Event<TimeType>));
+}
+
 XMLNode&
 MidiModel::SysExDiffCommand::get_state ()
 {
@@ -1367,6 +1423,14 @@ MidiModel::PatchChangeDiffCommand::set_state (const XMLNode& diff_command, int /
 	return 0;
 }
 
+size_t
+MidiModel::PatchChangeDiffCommand::memory_use () const
+{
+	return DiffCommand::memory_use () + sizeof (PatchChangeDiffCommand) - sizeof (DiffCommand)
+		+ _changes.size () * LIST_NODE_SIZE (Change)
+		+ (_added.size () + _removed.size ()) * (LIST_NODE_SIZE (PatchChangePtr) + SHARED_SIZE (Evoral::PatchChange<TimeType>));
+}
+
 XMLNode &
 MidiModel::PatchChangeDiffCommand::get_state ()
 {
@@ -28,6 +28,7 @@
 
 #include "ardour/beats_frames_converter.h"
 #include "ardour/debug.h"
+#include "ardour/midi_channel_filter.h"
 #include "ardour/midi_model.h"
 #include "ardour/midi_playlist.h"
 #include "ardour/midi_region.h"
@@ -46,6 +47,7 @@ MidiPlaylist::MidiPlaylist (Session& session, const XMLNode& node, bool hidden)
 	: Playlist (session, node, DataType::MIDI, hidden)
 	, _note_mode(Sustained)
 	, _read_end(0)
+	, _render_generation(0)
 {
 #ifndef NDEBUG
 	XMLProperty const * prop = node.property("type");
@@ -65,6 +67,7 @@ MidiPlaylist::MidiPlaylist (Session& session, string name, bool hidden)
 	: Playlist (session, name, DataType::MIDI, hidden)
 	, _note_mode(Sustained)
 	, _read_end(0)
+	, _render_generation(0)
 {
 }
 
@@ -72,6 +75,7 @@ MidiPlaylist::MidiPlaylist (boost::shared_ptr<const MidiPlaylist> other, string
 	: Playlist (other, name, hidden)
 	, _note_mode(other->_note_mode)
 	, _read_end(0)
+	, _render_generation(0)
 {
 }
 
@@ -83,6 +87,7 @@ MidiPlaylist::MidiPlaylist (boost::shared_ptr<const MidiPlaylist> other,
 	: Playlist (other, start, dur, name, hidden)
 	, _note_mode(other->_note_mode)
 	, _read_end(0)
+	, _render_generation(0)
 {
 }
 
@@ -90,6 +95,23 @@ MidiPlaylist::~MidiPlaylist ()
 {
 }
 
+void
+MidiPlaylist::update_after_tempo_map_change ()
+{
+	/* rendered event times depend on the tempo map */
+	invalidate_rendered (0);
+	Playlist::update_after_tempo_map_change ();
+}
+
+void
+MidiPlaylist::set_note_mode (NoteMode m)
+{
+	if (m != _note_mode) {
+		_note_mode = m;
+		invalidate_rendered (0);
+	}
+}
+
 template<typename Time>
 struct EventsSortByTimeAndType {
     bool operator() (Evoral::Event<Time>* a, Evoral::Event<Time>* b) {
@@ -131,7 +153,8 @@ MidiPlaylist::read (Evoral::EventSink<framepos_t>& dst,
 	const framepos_t                         end = start + dur - 1;
 	std::vector< boost::shared_ptr<Region> > regs;
 	std::vector< boost::shared_ptr<Region> > ended;
-	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
+	boost::shared_ptr<RegionList> touched = regions_touched_locked (start, end);
+	for (RegionList::iterator i = touched->begin(); i != touched->end(); ++i) {
 		switch ((*i)->coverage (start, end)) {
 		case Evoral::OverlapStart:
 		case Evoral::OverlapInternal:
@@ -195,7 +218,11 @@ MidiPlaylist::read (Evoral::EventSink<framepos_t>& dst,
 		                                                    mr->name(), start, dur, 
 		                                                    (loop_range ? loop_range->from : -1),
 		                                                    (loop_range ? loop_range->to : -1)));
-		mr->read_at (tgt, start, dur, loop_range, chan_n, _note_mode, &tracker->tracker, filter);
+		boost::shared_ptr<RenderedRegion> rr = rendered (mr);
+		{
+			Glib::Threads::Mutex::Lock lm (_render_lock);
+			read_rendered (*rr, tgt, start, end, loop_range, &tracker->tracker, filter);
+		}
 		DEBUG_TRACE (DEBUG::MidiPlaylistIO,
 		             string_compose ("\tPost-read: %1 active notes\n", tracker->tracker.on()));
 
@@ -239,6 +266,139 @@ MidiPlaylist::read (Evoral::EventSink<framepos_t>& dst,
 	return dur;
 }
 
+uint32_t
+MidiPlaylist::RenderedRegion::write (framepos_t time, Evoral::EventType type, uint32_t size, const uint8_t* buf)
+{
+	if (size == 0) {
+		return 0;
+	}
+
+	Entry e;
+	e.time   = time;
+	e.type   = type;
+	e.size   = size;
+	e.offset = data.size ();
+
+	events.push_back (e);
+	data.insert (data.end (), buf, buf + size);
+	return size;
+}
+
+struct RenderedEntryTimeCmp {
+	template<typename Entry>
+	bool operator() (Entry const& e, framepos_t t) const { return e.time < t; }
+};
+
+static void
+mark_stale (boost::shared_ptr<gint> stale)
+{
+	g_atomic_int_set (stale.get (), 1);
+}
+
+/** Return the rendered events of a region, rendering them if necessary.
+ *  Caller must not hold _render_lock: rendering reads the source, and
+ *  the source emits the signals which mark a rendering stale while it
+ *  holds its own lock.
+ */
+boost::shared_ptr<MidiPlaylist::RenderedRegion>
+MidiPlaylist::rendered (boost::shared_ptr<MidiRegion> mr)
+{
+	int generation;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_render_lock);
+		RenderCache::iterator i = _render_cache.find (mr.get ());
+
+		if (i != _render_cache.end () && !g_atomic_int_get (i->second->stale.get ())) {
+			return i->second;
+		}
+
+		generation = _render_generation;
+	}
+
+	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("	render %1 (%2 .. %3)\n", mr->name(), mr->position(), mr->last_frame()));
+
+	boost::shared_ptr<RenderedRegion> rr (new RenderedRegion);
+	MidiStateTracker                  tracker;
+
+	/* re-render after edits, including those made while rendering */
+	boost::shared_ptr<MidiSource> src = mr->midi_source (0);
+	src->ModelChanged.connect_same_thread (rr->connections, boost::bind (&mark_stale, rr->stale));
+	if (src->model ()) {
+		src->model ()->ContentsChanged.connect_same_thread (rr->connections, boost::bind (&mark_stale, rr->stale));
+	}
+
+	mr->read_at (*rr, mr->position (), mr->length (), 0, 0, _note_mode, &tracker, 0);
+	tracker.resolve_notes (*rr, mr->last_frame ());
+
+	{
+		Glib::Threads::Mutex::Lock lm (_render_lock);
+
+		/* only keep it if the region was not invalidated meanwhile */
+		if (generation == _render_generation) {
+			_render_cache[mr.get ()] = rr;
+		}
+	}
+
+	return rr;
+}
+
+/** Write rendered events in [start, end] to @param dst.
+ *  Caller must hold _render_lock.
+ */
+void
+MidiPlaylist::read_rendered (RenderedRegion const&          rr,
+                             Evoral::EventSink<framepos_t>& dst,
+                             framepos_t                     start,
+                             framepos_t                     end,
+                             Evoral::Range<framepos_t>*     loop_range,
+                             MidiStateTracker*              tracker,
+                             MidiChannelFilter*             filter)
+{
+	vector<RenderedRegion::Entry>::const_iterator e = lower_bound (rr.events.begin (), rr.events.end (), start, RenderedEntryTimeCmp ());
+
+	for (; e != rr.events.end () && e->time <= end; ++e) {
+		const uint8_t* buf = &rr.data[e->offset];
+
+		if (filter) {
+			/* the filter may modify the event (channel map) */
+			_render_scratch.assign (buf, buf + e->size);
+			if (filter->filter (&_render_scratch[0], e->size)) {
+				continue;
+			}
+			buf = &_render_scratch[0];
+		}
+
+		dst.write (loop_range ? loop_range->squish (e->time) : e->time, e->type, e->size, buf);
+
+		if (tracker) {
+			tracker->track (buf);
+		}
+	}
+}
+
+/** Drop the rendered events of @param region, or of all regions if it is 0 */
+void
+MidiPlaylist::invalidate_rendered (Region* region)
+{
+	Glib::Threads::Mutex::Lock lm (_render_lock);
+
+	++_render_generation;
+
+	if (region) {
+		_render_cache.erase (region);
+	} else {
+		_render_cache.clear ();
+	}
+}
+
+bool
+MidiPlaylist::region_changed (const PBD::PropertyChange& what_changed, boost::shared_ptr<Region> region)
+{
+	invalidate_rendered (region.get ());
+	return Playlist::region_changed (what_changed, region);
+}
+
 void
 MidiPlaylist::region_edited(boost::shared_ptr<Region>         region,
                             const MidiModel::NoteDiffCommand* cmd)
@@ -290,6 +450,7 @@ MidiPlaylist::remove_dependents (boost::shared_ptr<Region> region)
 {
 	/* MIDI regions have no dependents (crossfades) but we might be tracking notes */
 	_note_trackers.erase(region.get());
+	invalidate_rendered (region.get ());
 }
 
 int
@@ -20,6 +20,7 @@
 #include <stdint.h>
 #include <set>
 #include <algorithm>
+#include <iterator>
 #include <string>
 
 #include <boost/lexical_cast.hpp>
@@ -320,6 +321,7 @@ Playlist::init (bool hide)
 	_capture_insertion_underway = false;
 	_combine_ops = 0;
 	_end_space = 0;
+	g_atomic_int_set (&_region_index_dirty, 1);
 
 	_session.history().BeginUndoRedo.connect_same_thread (*this, boost::bind (&Playlist::begin_undo, this));
 	_session.history().EndUndoRedo.connect_same_thread (*this, boost::bind (&Playlist::end_undo, this));
@@ -574,6 +576,13 @@ Playlist::flush_notifications (bool from_undo)
 
 	in_flush = true;
 
+	/* if regions were only moved or trimmed, only those parts of the
+	   playlist which they overlap (before or after the change) need
+	   to be relayered.
+	*/
+	const bool bounds_only = !pending_bounds.empty() && pending_removes.empty() && pending_adds.empty() &&
+		!pending_contents_change && !pending_layering;
+
 	if (!pending_bounds.empty() || !pending_removes.empty() || !pending_adds.empty()) {
 		regions_changed = true;
 	}
@@ -591,12 +600,7 @@ Playlist::flush_notifications (bool from_undo)
 	// RegionSortByLayer cmp;
 	// pending_bounds.sort (cmp);
 
-	list<Evoral::Range<framepos_t> > crossfade_ranges;
-
-	for (RegionList::iterator r = pending_bounds.begin(); r != pending_bounds.end(); ++r) {
-		crossfade_ranges.push_back ((*r)->last_range ());
-		crossfade_ranges.push_back ((*r)->range ());
-	}
+	list<Evoral::Range<framepos_t> > crossfade_ranges (pending_bounds_ranges);
 
 	for (s = pending_removes.begin(); s != pending_removes.end(); ++s) {
 		crossfade_ranges.push_back ((*s)->range ());
@@ -627,7 +631,11 @@ Playlist::flush_notifications (bool from_undo)
 	}
 
 	if ((regions_changed && !in_set_state) || pending_layering) {
-		relayer ();
+		if (bounds_only) {
+			relayer (crossfade_ranges);
+		} else {
+			relayer ();
+		}
 	}
 
 	coalesce_and_check_crossfades (crossfade_ranges);
@@ -654,6 +662,7 @@ Playlist::flush_notifications (bool from_undo)
 	 pending_adds.clear ();
 	 pending_removes.clear ();
 	 pending_bounds.clear ();
+	 pending_bounds_ranges.clear ();
 	 pending_range_moves.clear ();
 	 pending_region_extensions.clear ();
 	 pending_contents_change = false;
@@ -752,6 +761,8 @@ Playlist::flush_notifications (bool from_undo)
 
 	 regions.insert (upper_bound (regions.begin(), regions.end(), region, cmp), region);
 	 all_regions.insert (region);
+	 invalidate_region_index ();
+	 layout_changed (region->position(), region->last_frame());
 
 	 possibly_splice_unlocked (position, region->length(), region);
 
@@ -812,6 +823,8 @@ Playlist::flush_notifications (bool from_undo)
 			 framecnt_t distance = (*i)->length();
 
 			 regions.erase (i);
+			 drop_region_index ();
+			 layout_changed (pos, pos + distance - 1);
 
 			 possibly_splice_unlocked (pos, -distance);
 
@@ -1642,14 +1655,25 @@ Playlist::region_bounds_changed (const PropertyChange& what_changed, boost::shar
 			 possibly_splice (region->last_position() + region->last_length(), delta, region);
 		 }
 
+		 list<Evoral::Range<framepos_t> > xf;
+		 Evoral::Range<framepos_t> merged (0, 0);
+
+		 xf.push_back (Evoral::Range<framepos_t> (region->last_range()));
+		 xf.push_back (Evoral::Range<framepos_t> (region->range()));
+
+		 if (region->merged_bounds_range (merged)) {
+			 xf.push_back (merged);
+		 }
+
 		 if (holding_state ()) {
+			 /* the region may change again before we flush, so
+			    note the ranges it affected now.
+			 */
 			 pending_bounds.push_back (region);
+			 pending_bounds_ranges.insert (pending_bounds_ranges.end(), xf.begin(), xf.end());
 		 } else {
 			 notify_contents_changed ();
-			 relayer ();
-			 list<Evoral::Range<framepos_t> > xf;
-			 xf.push_back (Evoral::Range<framepos_t> (region->last_range()));
-			 xf.push_back (Evoral::Range<framepos_t> (region->range()));
+			 relayer (xf);
 			 coalesce_and_check_crossfades (xf);
 		 }
 	 }
@@ -1664,6 +1688,20 @@ Playlist::region_bounds_changed (const PropertyChange& what_changed, boost::shar
 		 return;
 	 }
 
+	 if (what_changed.contains (Properties::position) || what_changed.contains (Properties::length)) {
+		 move_in_region_index (region);
+	 }
+
+	 Evoral::Range<framepos_t> merged (0, 0);
+
+	 if (region->merged_bounds_range (merged)) {
+		 layout_changed (min (merged.from, min (region->last_position(), region->position())),
+		                 max (merged.to, max (region->last_range().to, region->range().to)));
+	 } else {
+		 layout_changed (min (region->last_position(), region->position()),
+		                 max (region->last_range().to, region->range().to));
+	 }
+
 	 /* this makes a virtual call to the right kind of playlist ... */
 
 	 region_changed (what_changed, region);
@@ -1803,15 +1841,7 @@ Playlist::regions_at (framepos_t frame)
  Playlist::count_regions_at (framepos_t frame) const
  {
 	 RegionReadLock rlock (const_cast<Playlist*>(this));
-	 uint32_t cnt = 0;
-
-	 for (RegionList::const_iterator i = regions.begin(); i != regions.end(); ++i) {
-		 if ((*i)->covers (frame)) {
-			 cnt++;
-		 }
-	 }
-
-	 return cnt;
+	 return const_cast<Playlist*>(this)->find_regions_at (frame)->size ();
  }
 
  boost::shared_ptr<Region>
@@ -1868,8 +1898,15 @@ Playlist::find_regions_at (framepos_t frame)
 	/* Caller must hold lock */
 
 	boost::shared_ptr<RegionList> rlist (new RegionList);
+	RegionList candidates;
 
-	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
+	{
+		Glib::Threads::Mutex::Lock lm (_region_index_lock);
+		update_region_index ();
+		_region_index.find_overlapping (frame, frame, back_inserter (candidates));
+	}
+
+	for (RegionList::iterator i = candidates.begin(); i != candidates.end(); ++i) {
 		if ((*i)->covers (frame)) {
 			rlist->push_back (*i);
 		}
@@ -1878,13 +1915,89 @@ Playlist::find_regions_at (framepos_t frame)
 	return rlist;
 }
 
+/** Empty the region index, releasing its references to regions, and
+ *  have it rebuilt on the next query.
+ */
+void
+Playlist::drop_region_index () const
+{
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+	_region_index.clear ();
+	g_atomic_int_set (&_region_index_dirty, 1);
+}
+
+void
+Playlist::region_bounds_pending (boost::shared_ptr<Region> region)
+{
+	/* the region's bounds have changed, but it will not tell us
+	   until its property changes are resumed; don't let queries in
+	   the meantime use its old bounds.
+	*/
+	move_in_region_index (region);
+
+	Evoral::Range<framepos_t> merged (0, 0);
+
+	if (region->merged_bounds_range (merged)) {
+		layout_changed (min (merged.from, region->position()), max (merged.to, region->last_frame()));
+	} else {
+		layout_changed (region->position(), region->last_frame());
+	}
+}
+
+/** Move @param region to its current bounds within the region index */
+void
+Playlist::move_in_region_index (boost::shared_ptr<Region> region) const
+{
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+
+	if (g_atomic_int_get (&_region_index_dirty)) {
+		/* it will be rebuilt anyway */
+		return;
+	}
+
+	/* the index has the region where it was before this change, which
+	   is either where it is now (a trim at the end) or where it was
+	   last.
+	*/
+	if (!_region_index.move (region, region->position(), region->first_frame(), region->last_frame()) &&
+	    !_region_index.move (region, region->last_position(), region->first_frame(), region->last_frame())) {
+		invalidate_region_index ();
+	}
+}
+
+void
+Playlist::update_region_index () const
+{
+	/* Caller must hold region lock and _region_index_lock */
+
+	if (!g_atomic_int_compare_and_exchange (&_region_index_dirty, 1, 0)) {
+		return;
+	}
+
+	_region_index.clear ();
+	_region_index.reserve (regions.size ());
+
+	for (RegionList::const_iterator i = regions.begin(); i != regions.end(); ++i) {
+		_region_index.add ((*i)->first_frame(), (*i)->last_frame(), *i);
+	}
+
+	_region_index.build ();
+}
+
 boost::shared_ptr<RegionList>
 Playlist::regions_with_start_within (Evoral::Range<framepos_t> range)
 {
 	RegionReadLock rlock (this);
 	boost::shared_ptr<RegionList> rlist (new RegionList);
+	RegionList candidates;
 
-	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
+	{
+		Glib::Threads::Mutex::Lock lm (_region_index_lock);
+		update_region_index ();
+		_region_index.find_starting_within (range.from, range.to, back_inserter (candidates));
+	}
+
+	for (RegionList::iterator i = candidates.begin(); i != candidates.end(); ++i) {
 		if ((*i)->first_frame() >= range.from && (*i)->first_frame() <= range.to) {
 			rlist->push_back (*i);
 		}
@@ -1898,8 +2011,15 @@ Playlist::regions_with_end_within (Evoral::Range<framepos_t> range)
 {
 	RegionReadLock rlock (this);
 	boost::shared_ptr<RegionList> rlist (new RegionList);
+	RegionList candidates;
 
-	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
+	{
+		Glib::Threads::Mutex::Lock lm (_region_index_lock);
+		update_region_index ();
+		_region_index.find_overlapping (range.from, range.to, back_inserter (candidates));
+	}
+
+	for (RegionList::iterator i = candidates.begin(); i != candidates.end(); ++i) {
 		if ((*i)->last_frame() >= range.from && (*i)->last_frame() <= range.to) {
 			rlist->push_back (*i);
 		}
@@ -1923,8 +2043,15 @@ boost::shared_ptr<RegionList>
 Playlist::regions_touched_locked (framepos_t start, framepos_t end)
 {
 	boost::shared_ptr<RegionList> rlist (new RegionList);
+	RegionList candidates;
 
-	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
+	{
+		Glib::Threads::Mutex::Lock lm (_region_index_lock);
+		update_region_index ();
+		_region_index.find_overlapping (start, end, back_inserter (candidates));
+	}
+
+	for (RegionList::iterator i = candidates.begin(); i != candidates.end(); ++i) {
 		if ((*i)->coverage (start, end) != Evoral::OverlapNone) {
 			rlist->push_back (*i);
 		}
@@ -2000,6 +2127,26 @@ Playlist::find_next_region (framepos_t frame, RegionPoint point, int dir)
 	boost::shared_ptr<Region> ret;
 	framepos_t closest = max_framepos;
 
+	if (point == Start) {
+		/* the index is ordered by region start */
+		Glib::Threads::Mutex::Lock lm (_region_index_lock);
+		update_region_index ();
+
+		boost::shared_ptr<Region> const * r;
+
+		if (dir == 1) {
+			r = _region_index.first_starting_after (frame);
+		} else {
+			r = _region_index.last_starting_before (frame);
+		}
+
+		if (r) {
+			ret = *r;
+		}
+
+		return ret;
+	}
+
 	bool end_iter = false;
 
 	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
@@ -2479,6 +2626,188 @@ Playlist::relayer ()
 		return;
 	}
 
+	/* Sort our regions into layering index order (for manual layering) or position order (for later is higher)*/
+	RegionList copy = regions.rlist();
+	switch (Config->get_layer_model()) {
+		case LaterHigher:
+			copy.sort (LaterHigherSort ());
+			break;
+		case Manual:
+			copy.sort (RelayerSort ());
+			break;
+	}
+
+	DEBUG_TRACE (DEBUG::Layering, "relayer() using:\n");
+	for (RegionList::iterator i = copy.begin(); i != copy.end(); ++i) {
+		DEBUG_TRACE (DEBUG::Layering, string_compose ("\t%1 %2\n", (*i)->name(), (*i)->layering_index()));
+	}
+
+	assign_layers (copy);
+
+	/* It's a little tricky to know when we could avoid calling this; e.g. if we are
+	   relayering because we just removed the only region on the top layer, nothing will
+	   appear to have changed, but the StreamView must still sort itself out.  We could
+	   probably keep a note of the top layer last time we relayered, and check that,
+	   but premature optimisation &c...
+	*/
+	notify_layering_changed ();
+
+	/* This relayer() may have been called as a result of a region removal, in which
+	   case we need to setup layering indices to account for the one that has just
+	   gone away.
+	*/
+	setup_layering_indices (copy);
+
+	layout_changed (0, max_framepos);
+}
+
+/** Recompute layers of the regions overlapping any of @param ranges, and of all
+ *  regions which overlap those (and so on).  The layer of a region depends only
+ *  on the regions that it overlaps, so this gives the same result as relayer()
+ *  as long as no regions have been added or removed.
+ */
+void
+Playlist::relayer (list<Evoral::Range<framepos_t> > const & ranges)
+{
+	if (in_set_state) {
+		return;
+	}
+
+	set<boost::shared_ptr<Region> > affected;
+	vector<pair<framepos_t, framepos_t> > spans;
+	RegionList copy;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_region_index_lock);
+		update_region_index ();
+
+		for (list<Evoral::Range<framepos_t> >::const_iterator r = ranges.begin(); r != ranges.end(); ++r) {
+
+			if (r->to < r->from) {
+				continue;
+			}
+
+			/* grow [lo, hi] until no more regions overlap its ends; only
+			   the parts that were added since the last pass need to be searched.
+			*/
+			framepos_t lo = r->from;
+			framepos_t hi = r->to;
+			RegionList found;
+
+			_region_index.find_overlapping (lo, hi, back_inserter (found));
+
+			while (!found.empty()) {
+				framepos_t new_lo = lo;
+				framepos_t new_hi = hi;
+
+				for (RegionList::iterator i = found.begin(); i != found.end(); ++i) {
+					if (affected.insert (*i).second) {
+						new_lo = min (new_lo, (*i)->first_frame());
+						new_hi = max (new_hi, (*i)->last_frame());
+					}
+				}
+
+				found.clear ();
+
+				if (new_lo < lo) {
+					_region_index.find_overlapping (new_lo, lo - 1, back_inserter (found));
+					lo = new_lo;
+				}
+				if (new_hi > hi) {
+					_region_index.find_overlapping (hi + 1, new_hi, back_inserter (found));
+					hi = new_hi;
+				}
+			}
+
+			if (lo <= hi) {
+				spans.push_back (make_pair (lo, hi));
+			}
+		}
+
+		if (spans.empty()) {
+			return;
+		}
+
+		/* every region overlapping one of the spans is in its cluster, and
+		   clusters do not overlap each other, so fetching the regions of
+		   the merged spans in turn gives them in index order, which is the
+		   order of the region list. Keeping that order means that regions
+		   at the same position are layered as relayer() would layer them.
+		*/
+		sort (spans.begin(), spans.end());
+
+		vector<pair<framepos_t, framepos_t> >::iterator s = spans.begin();
+		pair<framepos_t, framepos_t> span = *s;
+
+		for (++s; s != spans.end(); ++s) {
+			if (s->first <= span.second) {
+				span.second = max (span.second, s->second);
+			} else {
+				_region_index.find_overlapping (span.first, span.second, back_inserter (copy));
+				span = *s;
+			}
+		}
+
+		_region_index.find_overlapping (span.first, span.second, back_inserter (copy));
+	}
+
+	if (copy.empty()) {
+		return;
+	}
+
+	const framepos_t start = spans.front().first;
+	framepos_t end = 0;
+	for (vector<pair<framepos_t, framepos_t> >::const_iterator s = spans.begin(); s != spans.end(); ++s) {
+		end = max (end, s->second);
+	}
+
+	/* the layering indices that the cluster had, in order, to hand
+	   out again below.
+	*/
+	vector<uint64_t> indices;
+	if (Config->get_layer_model() == LaterHigher) {
+		indices.reserve (copy.size());
+		for (RegionList::const_iterator i = copy.begin(); i != copy.end(); ++i) {
+			indices.push_back ((*i)->layering_index());
+		}
+		sort (indices.begin(), indices.end());
+	}
+
+	switch (Config->get_layer_model()) {
+		case LaterHigher:
+			copy.sort (LaterHigherSort ());
+			break;
+		case Manual:
+			copy.sort (RelayerSort ());
+			break;
+	}
+
+	DEBUG_TRACE (DEBUG::Layering, string_compose ("relayer() %1 of %2 regions between %3 and %4\n", copy.size(), regions.size(), start, end));
+
+	assign_layers (copy);
+
+	notify_layering_changed ();
+
+	if (Config->get_layer_model() == LaterHigher) {
+		/* layering indices follow position order; only the order within
+		   the cluster can have changed, and the regions outside it do
+		   not overlap any of it.
+		*/
+		vector<uint64_t>::const_iterator j = indices.begin();
+		for (RegionList::const_iterator i = copy.begin(); i != copy.end(); ++i, ++j) {
+			(*i)->set_layering_index (*j);
+		}
+	}
+
+	layout_changed (start, end);
+}
+
+/** Put each of @param sorted on the lowest layer above all of the regions before
+ *  it in the list which it overlaps.
+ */
+void
+Playlist::assign_layers (RegionList const & sorted)
+{
 	/* Build up a new list of regions on each layer, stored in a set of lists
 	   each of which represent some period of time on some layer.  The idea
 	   is to avoid having to search the entire region list to establish whether
@@ -2487,10 +2816,10 @@ Playlist::relayer ()
 	/* how many pieces to divide this playlist's time up into */
 	int const divisions = 512;
 
-	/* find the start and end positions of the regions on this playlist */
+	/* find the start and end positions of the regions */
 	framepos_t start = INT64_MAX;
 	framepos_t end = 0;
-	for (RegionList::const_iterator i = regions.begin(); i != regions.end(); ++i) {
+	for (RegionList::const_iterator i = sorted.begin(); i != sorted.end(); ++i) {
 		start = min (start, (*i)->position());
 		end = max (end, (*i)->position() + (*i)->length());
 	}
@@ -2501,23 +2830,7 @@ Playlist::relayer ()
 	vector<vector<RegionList> > layers;
 	layers.push_back (vector<RegionList> (divisions));
 
-	/* Sort our regions into layering index order (for manual layering) or position order (for later is higher)*/
-	RegionList copy = regions.rlist();
-	switch (Config->get_layer_model()) {
-		case LaterHigher:
-			copy.sort (LaterHigherSort ());
-			break;
-		case Manual:
-			copy.sort (RelayerSort ());
-			break;
-	}
-
-	DEBUG_TRACE (DEBUG::Layering, "relayer() using:\n");
-	for (RegionList::iterator i = copy.begin(); i != copy.end(); ++i) {
-		DEBUG_TRACE (DEBUG::Layering, string_compose ("\t%1 %2\n", (*i)->name(), (*i)->layering_index()));
-	}
-
-	for (RegionList::iterator i = copy.begin(); i != copy.end(); ++i) {
+	for (RegionList::const_iterator i = sorted.begin(); i != sorted.end(); ++i) {
 
 		/* find the time divisions that this region covers; if there are no regions on the list,
 		   division_size will equal 0 and in this case we'll just say that
@@ -2579,20 +2892,6 @@ Playlist::relayer ()
 
 		(*i)->set_layer (j);
 	}
-
-	/* It's a little tricky to know when we could avoid calling this; e.g. if we are
-	   relayering because we just removed the only region on the top layer, nothing will
-	   appear to have changed, but the StreamView must still sort itself out.  We could
-	   probably keep a note of the top layer last time we relayered, and check that,
-	   but premature optimisation &c...
-	*/
-	notify_layering_changed ();
-
-	/* This relayer() may have been called as a result of a region removal, in which
-	   case we need to setup layering indices to account for the one that has just
-	   gone away.
-	*/
-	setup_layering_indices (copy);
 }
 
 void
@@ -2944,14 +3243,8 @@ Playlist::foreach_region (boost::function<void(boost::shared_ptr<Region>)> s)
 bool
 Playlist::has_region_at (framepos_t const p) const
 {
-	RegionReadLock (const_cast<Playlist *> (this));
-
-	RegionList::const_iterator i = regions.begin ();
-	while (i != regions.end() && !(*i)->covers (p)) {
-		++i;
-	}
-
-	return (i != regions.end());
+	RegionReadLock rlock (const_cast<Playlist *> (this));
+	return !const_cast<Playlist*>(this)->find_regions_at (p)->empty ();
 }
 
 /** Look from a session frame time and find the start time of the next region
@@ -68,6 +68,15 @@ ProcessThread::drop_buffers ()
         _private_thread_buffers.set (0);
 }
 
+/** Reallocate this thread's buffers from this thread, see ThreadBuffers::reallocate() */
+void
+ProcessThread::reallocate_buffers ()
+{
+        ThreadBuffers* tb = _private_thread_buffers.get();
+        assert (tb);
+        BufferManager::reallocate_thread_buffers (tb);
+}
+
 BufferSet&
 ProcessThread::get_silent_buffers (ChanCount count)
 {
@@ -22,12 +22,17 @@
 
 #include <rubberband/RubberBandStretcher.h>
 
+#include <glibmm/threadpool.h>
+#include <glibmm/threads.h>
+
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 
 #include "ardour/audioregion.h"
 #include "ardour/audiosource.h"
 #include "ardour/pitch.h"
 #include "ardour/progress.h"
+#include "ardour/region_factory.h"
 #include "ardour/session.h"
 #include "ardour/stretch.h"
 #include "ardour/types.h"
@@ -52,7 +57,10 @@ RBStretch::RBStretch (Session& s, TimeFXRequest& req)
 RBEffect::RBEffect (Session& s, TimeFXRequest& req)
 	: Filter (s)
 	, tsr (req)
-
+	, _stretch (1.0)
+	, _shift (1.0)
+	, _read_start (0)
+	, _read_duration (0)
 {
 
 }
@@ -61,33 +69,153 @@ RBEffect::~RBEffect ()
 {
 }
 
+namespace {
+
+/** Progress of a single effect, which is run by a worker thread.
+ *  It is read by the thread which runs all the effects.
+ */
+class EffectProgress : public Progress
+{
+  public:
+	EffectProgress () : _progress (0) {}
+	float progress () const { return g_atomic_int_get (&_progress) / 10000.0f; }
+
+  private:
+	void set_overall_progress (float p) { g_atomic_int_set (&_progress, (gint) floor (p * 10000.0f)); }
+	mutable gint _progress;
+};
+
+}
+
+struct RBEffect::Jobs {
+	Glib::Threads::Mutex lock;
+	Glib::Threads::Cond  done;
+	gint                 pending;
+};
+
 int
 RBEffect::run (boost::shared_ptr<Region> r, Progress* progress)
 {
-	boost::shared_ptr<AudioRegion> region = boost::dynamic_pointer_cast<AudioRegion> (r);
+	int ret = prepare (r);
+
+	if (ret == 0) {
+		ret = stretch (progress);
+	}
+
+	return complete (ret);
+}
+
+int
+RBEffect::run (vector<RBEffect*> const & fx, vector<boost::shared_ptr<Region> > const & regions, Progress* progress)
+{
+	assert (fx.size() == regions.size());
+
+	uint32_t const n = fx.size();
+	vector<int> ret (n, -1);
+	vector<EffectProgress> fx_progress (n);
+
+	/* sources are created here, one effect after the other */
+
+	Jobs jobs;
+	jobs.pending = 0;
+
+	for (uint32_t i = 0; i < n; ++i) {
+		ret[i] = fx[i]->prepare (regions[i]);
+		if (ret[i] == 0) {
+			++jobs.pending;
+		}
+	}
+
+	if (progress) {
+		progress->set_progress (0);
+	}
+
+	if (jobs.pending > 0) {
+		Glib::ThreadPool pool (min (hardware_concurrency(), (uint32_t) jobs.pending));
+		Glib::Threads::Mutex::Lock lm (jobs.lock);
+
+		for (uint32_t i = 0; i < n; ++i) {
+			if (ret[i] == 0) {
+				pool.push (sigc::bind (sigc::mem_fun (*fx[i], &RBEffect::stretch_job), &fx_progress[i], &ret[i], &jobs));
+			}
+		}
+
+		while (g_atomic_int_get (&jobs.pending) > 0) {
+			jobs.done.wait_until (jobs.lock, g_get_monotonic_time() + G_TIME_SPAN_SECOND / 10);
+
+			if (progress) {
+				float total = 0;
+				for (uint32_t i = 0; i < n; ++i) {
+					total += fx_progress[i].progress();
+				}
+				progress->set_progress (total / n);
+			}
+		}
+	}
+
+	/* and regions, too */
+
+	int rv = 0;
+
+	for (uint32_t i = 0; i < n; ++i) {
+		if (fx[i]->complete (ret[i])) {
+			rv = -1;
+		}
+	}
+
+	if (rv) {
+		/* all or nothing */
+		for (uint32_t i = 0; i < n; ++i) {
+			fx[i]->discard ();
+		}
+	}
+
+	return rv;
+}
+
+/** Drop our results, and the sources that we created for them */
+void
+RBEffect::discard ()
+{
+	for (vector<boost::shared_ptr<Region> >::iterator x = results.begin(); x != results.end(); ++x) {
+		RegionFactory::map_remove (*x);
+	}
+
+	results.clear ();
+
+	for (SourceList::iterator si = _nsrcs.begin(); si != _nsrcs.end(); ++si) {
+		(*si)->mark_for_remove ();
+	}
+}
+
+void
+RBEffect::stretch_job (Progress* progress, int* ret, Jobs* jobs)
+{
+	*ret = stretch (progress);
 
-	if (!region) {
+	if (g_atomic_int_dec_and_test (&jobs->pending)) {
+		Glib::Threads::Mutex::Lock lm (jobs->lock);
+		jobs->done.signal ();
+	}
+}
+
+int
+RBEffect::prepare (boost::shared_ptr<Region> r)
+{
+	_region = boost::dynamic_pointer_cast<AudioRegion> (r);
+
+	if (!_region) {
 		error << "RBEffect::run() passed a non-audio region! WTF?" << endmsg;
 		return -1;
 	}
 
-	SourceList nsrcs;
-	int ret = -1;
-	const framecnt_t bufsize = 256;
-	gain_t* gain_buffer = 0;
-	Sample** buffers = 0;
-	char suffix[32];
-	string new_name;
-	string::size_type at;
-	boost::shared_ptr<AudioRegion> result;
-
-	cerr << "RBEffect: source region: position = " << region->position()
-	     << ", start = " << region->start()
-	     << ", length = " << region->length()
-	     << ", ancestral_start = " << region->ancestral_start()
-	     << ", ancestral_length = " << region->ancestral_length()
-	     << ", stretch " << region->stretch()
-	     << ", shift " << region->shift() << endl;
+	cerr << "RBEffect: source region: position = " << _region->position()
+	     << ", start = " << _region->start()
+	     << ", length = " << _region->length()
+	     << ", ancestral_start = " << _region->ancestral_start()
+	     << ", ancestral_length = " << _region->ancestral_length()
+	     << ", stretch " << _region->stretch()
+	     << ", shift " << _region->shift() << endl;
 
 	/*
 	   We have two cases to consider:
@@ -144,56 +272,71 @@ RBEffect::run (boost::shared_ptr<Region> r, Progress* progress)
 	   I hope this is clear.
 	*/
 
-	double stretch = region->stretch() * tsr.time_fraction;
-	double shift = region->shift() * tsr.pitch_fraction;
-
-	framecnt_t read_start = region->ancestral_start() +
-		framecnt_t(region->start() / (double)region->stretch());
+	_stretch = _region->stretch() * tsr.time_fraction;
+	_shift = _region->shift() * tsr.pitch_fraction;
 
-	framecnt_t read_duration =
-		framecnt_t(region->length() / (double)region->stretch());
+	_read_start = _region->ancestral_start() +
+		framecnt_t(_region->start() / (double)_region->stretch());
 
-	uint32_t channels = region->n_channels();
+	_read_duration =
+		framecnt_t(_region->length() / (double)_region->stretch());
 
-	RubberBandStretcher stretcher
-		(session.frame_rate(), channels,
-		 (RubberBandStretcher::Options) tsr.opts, stretch, shift);
-
-	progress->set_progress (0);
 	tsr.done = false;
 
-	stretcher.setExpectedInputDuration(read_duration);
-	stretcher.setDebugLevel(1);
-
 	/* the name doesn't need to be super-precise, but allow for 2 fractional
 	   digits just to disambiguate close but not identical FX
 	*/
 
-	if (stretch == 1.0) {
-		snprintf (suffix, sizeof (suffix), "@%d", (int) floor (shift * 100.0f));
-	} else if (shift == 1.0) {
-		snprintf (suffix, sizeof (suffix), "@%d", (int) floor (stretch * 100.0f));
+	char suffix[32];
+
+	if (_stretch == 1.0) {
+		snprintf (suffix, sizeof (suffix), "@%d", (int) floor (_shift * 100.0f));
+	} else if (_shift == 1.0) {
+		snprintf (suffix, sizeof (suffix), "@%d", (int) floor (_stretch * 100.0f));
 	} else {
 		snprintf (suffix, sizeof (suffix), "@%d-%d",
-			  (int) floor (stretch * 100.0f),
-			  (int) floor (shift * 100.0f));
+			  (int) floor (_stretch * 100.0f),
+			  (int) floor (_shift * 100.0f));
 	}
 
+	_suffix = suffix;
+
 	/* create new sources */
 
+	if (make_new_sources (_region, _nsrcs, _suffix)) {
+		return -1;
+	}
+
+	return 0;
+}
+
+int
+RBEffect::stretch (Progress* progress)
+{
+	const framecnt_t bufsize = 256;
+	uint32_t channels = _region->n_channels();
+
+	RubberBandStretcher stretcher
+		(session.frame_rate(), channels,
+		 (RubberBandStretcher::Options) tsr.opts, _stretch, _shift);
+
+	if (progress) {
+		progress->set_progress (0);
+	}
+
+	stretcher.setExpectedInputDuration(_read_duration);
+	stretcher.setDebugLevel(1);
+
 	framepos_t pos   = 0;
 	framecnt_t avail = 0;
 	framecnt_t done  = 0;
 
-	if (make_new_sources (region, nsrcs, suffix)) {
-		goto out;
-	}
-
-	gain_buffer = new gain_t[bufsize];
-	buffers = new float *[channels];
+	vector<gain_t> gain_buffer (bufsize);
+	vector<Sample> data (channels * bufsize);
+	vector<float*> buffers (channels);
 
 	for (uint32_t i = 0; i < channels; ++i) {
-		buffers[i] = new float[bufsize];
+		buffers[i] = &data[i * bufsize];
 	}
 
 	/* we read from the master (original) sources for the region,
@@ -203,23 +346,23 @@ RBEffect::run (boost::shared_ptr<Region> r, Progress* progress)
 	/* study first, process afterwards. */
 
 	try {
-		while (pos < read_duration && !tsr.cancel) {
+		while (pos < _read_duration && !tsr.cancel) {
 
 			framecnt_t this_read = 0;
 
 			for (uint32_t i = 0; i < channels; ++i) {
 
 				framepos_t this_time;
-				this_time = min(bufsize, read_duration - pos);
+				this_time = min(bufsize, _read_duration - pos);
 
 				framepos_t this_position;
-				this_position = read_start + pos -
-					region->start() + region->position();
+				this_position = _read_start + pos -
+					_region->start() + _region->position();
 
-				this_read = region->master_read_at
+				this_read = _region->master_read_at
 					(buffers[i],
 					 buffers[i],
-					 gain_buffer,
+					 &gain_buffer[0],
 					 this_position,
 					 this_time,
 					 i);
@@ -227,39 +370,41 @@ RBEffect::run (boost::shared_ptr<Region> r, Progress* progress)
 				if (this_read != this_time) {
 					error << string_compose
 						(_("tempoize: error reading data from %1 at %2 (wanted %3, got %4)"),
-						 region->name(), this_position, this_time, this_read) << endmsg;
-					goto out;
+						 _region->name(), this_position, this_time, this_read) << endmsg;
+					return -1;
 				}
 			}
 
 			pos += this_read;
 			done += this_read;
 
-			progress->set_progress (((float) done / read_duration) * 0.25);
+			if (progress) {
+				progress->set_progress (((float) done / _read_duration) * 0.25);
+			}
 
-			stretcher.study(buffers, this_read, pos == read_duration);
+			stretcher.study(&buffers[0], this_read, pos == _read_duration);
 		}
 
 		done = 0;
 		pos = 0;
 
-		while (pos < read_duration && !tsr.cancel) {
+		while (pos < _read_duration && !tsr.cancel) {
 
 			framecnt_t this_read = 0;
 
 			for (uint32_t i = 0; i < channels; ++i) {
 
 				framepos_t this_time;
-				this_time = min(bufsize, read_duration - pos);
+				this_time = min(bufsize, _read_duration - pos);
 
 				framepos_t this_position;
-				this_position = read_start + pos -
-					region->start() + region->position();
+				this_position = _read_start + pos -
+					_region->start() + _region->position();
 
-				this_read = region->master_read_at
+				this_read = _region->master_read_at
 					(buffers[i],
 					 buffers[i],
-					 gain_buffer,
+					 &gain_buffer[0],
 					 this_position,
 					 this_time,
 					 i);
@@ -267,17 +412,19 @@ RBEffect::run (boost::shared_ptr<Region> r, Progress* progress)
 				if (this_read != this_time) {
 					error << string_compose
 						(_("tempoize: error reading data from %1 at %2 (wanted %3, got %4)"),
-						 region->name(), pos + region->position(), this_time, this_read) << endmsg;
-					goto out;
+						 _region->name(), pos + _region->position(), this_time, this_read) << endmsg;
+					return -1;
 				}
 			}
 
 			pos += this_read;
 			done += this_read;
 
-			progress->set_progress (0.25 + ((float) done / read_duration) * 0.75);
+			if (progress) {
+				progress->set_progress (0.25 + ((float) done / _read_duration) * 0.75);
+			}
 
-			stretcher.process(buffers, this_read, pos == read_duration);
+			stretcher.process(&buffers[0], this_read, pos == _read_duration);
 
 			framecnt_t avail = 0;
 
@@ -285,18 +432,18 @@ RBEffect::run (boost::shared_ptr<Region> r, Progress* progress)
 
 				this_read = min (bufsize, avail);
 
-				stretcher.retrieve(buffers, this_read);
+				stretcher.retrieve(&buffers[0], this_read);
 
-				for (uint32_t i = 0; i < nsrcs.size(); ++i) {
+				for (uint32_t i = 0; i < _nsrcs.size(); ++i) {
 
-					boost::shared_ptr<AudioSource> asrc = boost::dynamic_pointer_cast<AudioSource>(nsrcs[i]);
+					boost::shared_ptr<AudioSource> asrc = boost::dynamic_pointer_cast<AudioSource>(_nsrcs[i]);
 					if (!asrc) {
 						continue;
 					}
 
 					if (asrc->write(buffers[i], this_read) != this_read) {
-						error << string_compose (_("error writing tempo-adjusted data to %1"), nsrcs[i]->name()) << endmsg;
-						goto out;
+						error << string_compose (_("error writing tempo-adjusted data to %1"), _nsrcs[i]->name()) << endmsg;
+						return -1;
 					}
 				}
 			}
@@ -306,19 +453,19 @@ RBEffect::run (boost::shared_ptr<Region> r, Progress* progress)
 
 			framecnt_t this_read = min (bufsize, avail);
 
-			stretcher.retrieve(buffers, this_read);
+			stretcher.retrieve(&buffers[0], this_read);
 
-			for (uint32_t i = 0; i < nsrcs.size(); ++i) {
+			for (uint32_t i = 0; i < _nsrcs.size(); ++i) {
 
-				boost::shared_ptr<AudioSource> asrc = boost::dynamic_pointer_cast<AudioSource>(nsrcs[i]);
+				boost::shared_ptr<AudioSource> asrc = boost::dynamic_pointer_cast<AudioSource>(_nsrcs[i]);
 				if (!asrc) {
 					continue;
 				}
 
 				if (asrc->write(buffers[i], this_read) !=
 				    this_read) {
-					error << string_compose (_("error writing tempo-adjusted data to %1"), nsrcs[i]->name()) << endmsg;
-					goto out;
+					error << string_compose (_("error writing tempo-adjusted data to %1"), _nsrcs[i]->name()) << endmsg;
+					return -1;
 				}
 			}
 		}
@@ -326,67 +473,59 @@ RBEffect::run (boost::shared_ptr<Region> r, Progress* progress)
 	} catch (runtime_error& err) {
 		error << string_compose (_("programming error: %1"), X_("timefx code failure")) << endmsg;
 		error << err.what() << endmsg;
-		goto out;
+		return -1;
 	}
 
-	new_name = region->name();
-	at = new_name.find ('@');
-
-	// remove any existing stretch indicator
-
-	if (at != string::npos && at > 2) {
-		new_name = new_name.substr (0, at - 1);
-	}
+	return 0;
+}
 
-	new_name += suffix;
+int
+RBEffect::complete (int ret)
+{
+	if (ret == 0) {
+		string new_name = _region->name();
+		string::size_type at = new_name.find ('@');
 
-	ret = finish (region, nsrcs, new_name);
+		// remove any existing stretch indicator
 
-	/* now reset ancestral data for each new region */
+		if (at != string::npos && at > 2) {
+			new_name = new_name.substr (0, at - 1);
+		}
 
-	for (vector<boost::shared_ptr<Region> >::iterator x = results.begin(); x != results.end(); ++x) {
+		new_name += _suffix;
 
-		(*x)->set_ancestral_data (read_start,
-					  read_duration,
-					  stretch,
-					  shift);
-		(*x)->set_master_sources (region->master_sources());
-		/* multiply the old (possibly previously stretched) region length by the extra
-		   stretch this time around to get its new length. this is a non-music based edit atm.
-		*/
-		(*x)->set_length ((*x)->length() * tsr.time_fraction, 0);
-	}
+		ret = finish (_region, _nsrcs, new_name);
 
-	/* stretch region gain envelope */
-	/* XXX: assuming we've only processed one input region into one result here */
+		/* now reset ancestral data for each new region */
 
-	if (tsr.time_fraction != 1) {
-		result = boost::dynamic_pointer_cast<AudioRegion> (results.front());
-		assert (result);
-		result->envelope()->x_scale (tsr.time_fraction);
-	}
+		for (vector<boost::shared_ptr<Region> >::iterator x = results.begin(); x != results.end(); ++x) {
 
-  out:
+			(*x)->set_ancestral_data (_read_start,
+						  _read_duration,
+						  _stretch,
+						  _shift);
+			(*x)->set_master_sources (_region->master_sources());
+			/* multiply the old (possibly previously stretched) region length by the extra
+			   stretch this time around to get its new length. this is a non-music based edit atm.
+			*/
+			(*x)->set_length ((*x)->length() * tsr.time_fraction, 0);
+		}
 
-	delete [] gain_buffer;
+		/* stretch region gain envelope */
+		/* XXX: assuming we've only processed one input region into one result here */
 
-	if (buffers) {
-		for (uint32_t i = 0; i < channels; ++i) {
-			delete [] buffers[i];
+		if (tsr.time_fraction != 1 && !results.empty()) {
+			boost::shared_ptr<AudioRegion> result = boost::dynamic_pointer_cast<AudioRegion> (results.front());
+			assert (result);
+			result->envelope()->x_scale (tsr.time_fraction);
 		}
-		delete [] buffers;
 	}
 
 	if (ret || tsr.cancel) {
-		for (SourceList::iterator si = nsrcs.begin(); si != nsrcs.end(); ++si) {
+		for (SourceList::iterator si = _nsrcs.begin(); si != _nsrcs.end(); ++si) {
 			(*si)->mark_for_remove ();
 		}
 	}
 
 	return ret;
 }
-
-
-
-
-
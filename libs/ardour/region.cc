@@ -242,6 +242,9 @@ Region::Region (Session& s, framepos_t start, framecnt_t length, const string& n
 	, REGION_DEFAULT_STATE(start,length)
 	, _last_length (length)
 	, _last_position (0)
+	, _merged_first (0)
+	, _merged_last (0)
+	, _bounds_merged (false)
 	, _first_edit (EditChangesNothing)
 	, _layer (0)
 {
@@ -257,6 +260,9 @@ Region::Region (const SourceList& srcs)
 	, REGION_DEFAULT_STATE(0,0)
 	, _last_length (0)
 	, _last_position (0)
+	, _merged_first (0)
+	, _merged_last (0)
+	, _bounds_merged (false)
 	, _first_edit (EditChangesNothing)
 	, _layer (0)
 {
@@ -277,6 +283,9 @@ Region::Region (boost::shared_ptr<const Region> other)
 	, REGION_COPY_STATE (other)
 	, _last_length (other->_last_length)
 	, _last_position(other->_last_position) \
+	, _merged_first (0)
+	, _merged_last (0)
+	, _bounds_merged (false)
 	, _first_edit (EditChangesNothing)
 	, _layer (other->_layer)
 {
@@ -339,6 +348,9 @@ Region::Region (boost::shared_ptr<const Region> other, frameoffset_t offset, con
 	, REGION_COPY_STATE (other)
 	, _last_length (other->_last_length)
 	, _last_position(other->_last_position) \
+	, _merged_first (0)
+	, _merged_last (0)
+	, _bounds_merged (false)
 	, _first_edit (EditChangesNothing)
 	, _layer (other->_layer)
 {
@@ -386,6 +398,9 @@ Region::Region (boost::shared_ptr<const Region> other, const SourceList& srcs)
 	, REGION_COPY_STATE (other)
 	, _last_length (other->_last_length)
 	, _last_position (other->_last_position)
+	, _merged_first (0)
+	, _merged_last (0)
+	, _bounds_merged (false)
 	, _first_edit (EditChangesID)
 	, _layer (other->_layer)
 {
@@ -473,6 +488,7 @@ Region::set_length_internal (framecnt_t len, const int32_t sub_num)
 {
 	_last_length = _length;
 	_length = len;
+	bounds_changed ();
 }
 
 void
@@ -689,6 +705,8 @@ Region::set_position_internal (framepos_t pos, bool allow_bbt_recompute, const i
 			_last_length = _length;
 			_length = max_framepos - _position;
 		}
+
+		bounds_changed ();
 	}
 }
 
@@ -1355,11 +1373,53 @@ Region::_set_state (const XMLNode& node, int /*version*/, PropertyChange& what_c
 void
 Region::suspend_property_changes ()
 {
+	if (!property_changes_suspended ()) {
+		_merged_first = _position;
+		_merged_last = last_frame ();
+		_bounds_merged = false;
+	}
+
 	Stateful::suspend_property_changes ();
 	_last_length = _length;
 	_last_position = _position;
 }
 
+/** Called after the position or length has changed */
+void
+Region::bounds_changed ()
+{
+	if (!property_changes_suspended ()) {
+		return;
+	}
+
+	/* the change will not be sent until property changes are resumed,
+	   and then last_range() will only describe the last step; keep
+	   track of all the extents we cover until then. Our playlist must
+	   not go on using our old bounds in the meantime.
+	*/
+
+	_merged_first = min (_merged_first, _position.val());
+	_merged_last = max (_merged_last, last_frame ());
+	_bounds_merged = true;
+
+	boost::shared_ptr<Playlist> pl (playlist());
+
+	if (pl) {
+		pl->region_bounds_pending (shared_from_this ());
+	}
+}
+
+bool
+Region::merged_bounds_range (Evoral::Range<framepos_t>& range) const
+{
+	if (!_bounds_merged) {
+		return false;
+	}
+
+	range = Evoral::Range<framepos_t> (_merged_first, _merged_last);
+	return true;
+}
+
 void
 Region::mid_thaw (const PropertyChange& what_changed)
 {
@@ -1392,6 +1452,9 @@ Region::send_change (const PropertyChange& what_changed)
 		} catch (...) {
 			/* no shared_ptr available, relax; */
 		}
+
+		/* any merged bounds changes have now been sent */
+		_bounds_merged = false;
 	}
 }
 
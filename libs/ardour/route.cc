@@ -313,6 +313,8 @@ Route::process_output_buffers (BufferSet& bufs,
 		return;
 	}
 
+	_dsp_stats.start ();
+
 	_mute_control->automation_run (start_frame, nframes);
 
 	/* figure out if we're going to use gain automation */
@@ -447,13 +449,18 @@ Route::process_output_buffers (BufferSet& bufs,
 					_initial_delay + latency, longest_session_latency - latency);
 		}
 
+		DSPStats& stats ((*i)->dsp_stats ());
+		stats.start ();
 		(*i)->run (bufs, start_frame - latency, end_frame - latency, speed, nframes, *i != _processors.back());
+		stats.update ();
 		bufs.set_count ((*i)->output_streams());
 
 		if ((*i)->active ()) {
 			latency += (*i)->signal_latency ();
 		}
 	}
+
+	_dsp_stats.update ();
 }
 
 void
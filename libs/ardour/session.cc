@@ -74,6 +74,7 @@
 #include "ardour/gain_control.h"
 #include "ardour/graph.h"
 #include "ardour/luabindings.h"
+#include "ardour/meter_snapshot.h"
 #include "ardour/midiport_manager.h"
 #include "ardour/scene_changer.h"
 #include "ardour/midi_patch_manager.h"
@@ -180,6 +181,7 @@ Session::Session (AudioEngine &eng,
 	, _session_range_end_is_free (true)
 	, _slave (0)
 	, _silent (false)
+	, _buffer_bytes_copied (0)
 	, _transport_speed (0)
 	, _default_transport_speed (1.0)
 	, _last_transport_speed (0)
@@ -317,6 +319,7 @@ Session::Session (AudioEngine &eng,
 	, _midi_ports (0)
 	, _mmc (0)
 	, _vca_manager (new VCAManager (*this))
+	, _meter_snapshot (new MeterSnapshot)
 {
 	uint32_t sr = 0;
 
@@ -752,6 +755,7 @@ Session::destroy ()
 	pthread_mutex_destroy (&_auto_connect_mutex);
 
 	delete _scene_changer; _scene_changer = 0;
+	_meter_snapshot.reset ();
 	delete midi_control_ui; midi_control_ui = 0;
 
 	delete _mmc; _mmc = 0;
@@ -4622,6 +4626,8 @@ Session::remove_source (boost::weak_ptr<Source> src)
 		return;
 	}
 
+	Analyser::cancel (source);
+
 	{
 		Glib::Threads::Mutex::Lock lm (source_lock);
 
@@ -6140,6 +6146,23 @@ Session::get_mix_buffers (ChanCount count)
 	return ProcessThread::get_mix_buffers (count);
 }
 
+GraphThreadStats*
+Session::process_thread_stats (uint32_t n)
+{
+	if (!_process_graph) {
+		return 0;
+	}
+	return _process_graph->thread_stats (n);
+}
+
+void
+Session::set_count_buffer_copies (bool yn)
+{
+	AudioBuffer::set_count_copies (yn);
+	AudioBuffer::reset_bytes_copied ();
+	_buffer_bytes_copied = 0;
+}
+
 uint32_t
 Session::ntracks () const
 {
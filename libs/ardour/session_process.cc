@@ -27,12 +27,14 @@
 
 #include <glibmm/threads.h>
 
+#include "ardour/audio_buffer.h"
 #include "ardour/audioengine.h"
 #include "ardour/auditioner.h"
 #include "ardour/butler.h"
 #include "ardour/cycle_timer.h"
 #include "ardour/debug.h"
 #include "ardour/graph.h"
+#include "ardour/meter_snapshot.h"
 #include "ardour/port.h"
 #include "ardour/process_thread.h"
 #include "ardour/scene_changer.h"
@@ -75,6 +77,9 @@ Session::process (pframes_t nframes)
 
 	(this->*process_function) (nframes);
 
+	/* all meters ran, make their levels available to the GUI */
+	_meter_snapshot->publish (nframes, nominal_frame_rate () / 10);
+
 	/* realtime-safe meter-position and processor-order changes
 	 *
 	 * ideally this would be done in
@@ -100,6 +105,10 @@ Session::process (pframes_t nframes)
 
 	_engine.main_thread()->drop_buffers ();
 
+	if (AudioBuffer::count_copies ()) {
+		_buffer_bytes_copied = AudioBuffer::reset_bytes_copied ();
+	}
+
 	/* deliver MIDI clock. Note that we need to use the transport frame
 	 * position at the start of process(), not the value at the end of
 	 * it. We may already have ticked() because of a transport state
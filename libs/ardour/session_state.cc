@@ -189,6 +189,7 @@ Session::pre_engine_init (string fullpath)
 	last_rr_session_dir = session_dirs.begin();
 
 	set_history_depth (Config->get_history_depth());
+	set_history_memory_budget (Config->get_history_memory_budget());
 
         /* default: assume simple stereo speaker configuration */
 
@@ -3927,6 +3928,8 @@ Session::config_changed (std::string p, bool ours)
 		setup_fpu ();
 	} else if (p == "history-depth") {
 		set_history_depth (Config->get_history_depth());
+	} else if (p == "history-memory-budget") {
+		set_history_memory_budget (Config->get_history_memory_budget());
 	} else if (p == "remote-model") {
 		/* XXX DO SOMETHING HERE TO TELL THE GUI THAT WE NEED
 		   TO SET REMOTE ID'S
@@ -3972,6 +3975,12 @@ Session::set_history_depth (uint32_t d)
 	_history.set_depth (d);
 }
 
+void
+Session::set_history_memory_budget (uint32_t mb)
+{
+	_history.set_memory_budget ((size_t) mb * 1048576);
+}
+
 int
 Session::load_diskstreams_2X (XMLNode const & node, int)
 {
@@ -242,22 +242,16 @@ SMFSource::read_unlocked (const Lock&                    lock,
 	const uint64_t start_ticks = converter.from(start).to_ticks();
 	DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked: start in ticks %1\n", start_ticks));
 
+	/* Events are kept in memory sorted by time, seeking is a binary search.
+	 * A contiguous read resumes at the first event that was not delivered
+	 * by the previous read.
+	 */
 	if (_smf_last_read_end == 0 || start != _smf_last_read_end) {
 		DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked: seek to %1\n", start));
-		Evoral::SMF::seek_to_start();
-		while (time < start_ticks) {
-			gint ignored;
-
-			ret = read_event(&ev_delta_t, &ev_size, &ev_buffer, &ignored);
-			if (ret == -1) { // EOF
-				_smf_last_read_end = start + duration;
-				return duration;
-			}
-			time += ev_delta_t; // accumulate delta time
-		}
+		time = Evoral::SMF::seek_to_time (start_ticks);
 	} else {
-		DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked: set time to %1\n", _smf_last_read_time));
-		time = _smf_last_read_time;
+		DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked: resume at %1\n", _smf_last_read_time));
+		time = Evoral::SMF::seek_to_time (_smf_last_read_time);
 	}
 
 	_smf_last_read_end = start + duration;
@@ -267,6 +261,7 @@ SMFSource::read_unlocked (const Lock&                    lock,
 
 		ret = read_event(&ev_delta_t, &ev_size, &ev_buffer, &ignored);
 		if (ret == -1) { // EOF
+			_smf_last_read_time = time + 1;
 			break;
 		}
 
@@ -282,8 +277,6 @@ SMFSource::read_unlocked (const Lock&                    lock,
 		DEBUG_TRACE (DEBUG::MidiSourceIO, string_compose ("SMF read_unlocked delta %1, time %2, buf[0] %3, type %4\n",
 								  ev_delta_t, time, ev_buffer[0], ev_type));
 
-		assert(time >= start_ticks);
-
 		/* Note that we add on the source start time (in session frames) here so that ev_frame_time
 		   is in session frames.
 		*/
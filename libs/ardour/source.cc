@@ -34,6 +34,7 @@
 #include "pbd/pthread_utils.h"
 #include "pbd/enumwriter.h"
 
+#include "ardour/analyser.h"
 #include "ardour/debug.h"
 #include "ardour/profile.h"
 #include "ardour/session.h"
@@ -226,6 +227,8 @@ Source::get_transients_path () const
 	s = id().to_s();
 	s += '.';
 	s += TransientDetector::operational_identifier();
+	s += '.';
+	s += Analyser::transient_parameters ();
 	parts.push_back (s);
 
 	return Glib::build_filename (parts);
@@ -0,0 +1,110 @@
+#include <vector>
+
+#include "ardour/analysis_queue.h"
+
+#include "analysis_queue_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (AnalysisQueueTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+typedef boost::shared_ptr<int> Ptr;
+
+static vector<Ptr>
+make (int n)
+{
+	vector<Ptr> v;
+	for (int i = 0; i < n; ++i) {
+		v.push_back (Ptr (new int (i)));
+	}
+	return v;
+}
+
+void
+AnalysisQueueTest::orderTest ()
+{
+	vector<Ptr> v = make (5);
+	AnalysisQueue<int> q;
+
+	CPPUNIT_ASSERT (q.empty ());
+	CPPUNIT_ASSERT (!q.pop ());
+
+	for (int i = 0; i < 5; ++i) {
+		CPPUNIT_ASSERT (q.push (v[i]));
+	}
+
+	/* queued only once */
+	CPPUNIT_ASSERT (!q.push (v[2]));
+
+	/* prioritized ones first, in the order of prioritization */
+	CPPUNIT_ASSERT (q.prioritize (v[3]));
+	CPPUNIT_ASSERT (q.prioritize (v[1]));
+	CPPUNIT_ASSERT (q.prioritize (v[3]));
+	CPPUNIT_ASSERT (!q.push (v[3]));
+
+	CPPUNIT_ASSERT_EQUAL (3, *q.pop ());
+	CPPUNIT_ASSERT_EQUAL (1, *q.pop ());
+
+	/* then the others in the order in which they were queued */
+	CPPUNIT_ASSERT_EQUAL (0, *q.pop ());
+	CPPUNIT_ASSERT_EQUAL (2, *q.pop ());
+
+	/* a priority source queued meanwhile still goes first */
+	CPPUNIT_ASSERT (q.push (v[0]));
+	CPPUNIT_ASSERT (q.prioritize (v[0]));
+	CPPUNIT_ASSERT_EQUAL (0, *q.pop ());
+	CPPUNIT_ASSERT_EQUAL (4, *q.pop ());
+
+	CPPUNIT_ASSERT (q.empty ());
+	CPPUNIT_ASSERT (!q.prioritize (v[4]));
+}
+
+void
+AnalysisQueueTest::removeTest ()
+{
+	vector<Ptr> v = make (4);
+	AnalysisQueue<int> q;
+
+	for (int i = 0; i < 4; ++i) {
+		q.push (v[i]);
+	}
+	q.prioritize (v[2]);
+
+	CPPUNIT_ASSERT (q.remove (v[2]));
+	CPPUNIT_ASSERT (q.remove (v[0]));
+	CPPUNIT_ASSERT (!q.remove (v[0]));
+	CPPUNIT_ASSERT (!q.contains (v[2]));
+	CPPUNIT_ASSERT (q.contains (v[1]));
+
+	CPPUNIT_ASSERT_EQUAL (1, *q.pop ());
+	CPPUNIT_ASSERT_EQUAL (3, *q.pop ());
+	CPPUNIT_ASSERT (q.empty ());
+
+	/* it can be queued again after removal */
+	CPPUNIT_ASSERT (q.push (v[2]));
+	q.clear ();
+	CPPUNIT_ASSERT (q.empty ());
+	CPPUNIT_ASSERT (!q.contains (v[2]));
+}
+
+void
+AnalysisQueueTest::expiredTest ()
+{
+	vector<Ptr> v = make (3);
+	AnalysisQueue<int> q;
+
+	for (int i = 0; i < 3; ++i) {
+		q.push (v[i]);
+	}
+	q.prioritize (v[1]);
+
+	/* the queue does not keep its objects alive */
+	CPPUNIT_ASSERT_EQUAL (1L, v[0].use_count ());
+	v[0].reset ();
+	v[1].reset ();
+
+	CPPUNIT_ASSERT_EQUAL (2, *q.pop ());
+	CPPUNIT_ASSERT (!q.pop ());
+	CPPUNIT_ASSERT (q.empty ());
+}
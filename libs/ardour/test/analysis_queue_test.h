@@ -0,0 +1,16 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class AnalysisQueueTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (AnalysisQueueTest);
+	CPPUNIT_TEST (orderTest);
+	CPPUNIT_TEST (removeTest);
+	CPPUNIT_TEST (expiredTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void orderTest ();
+	void removeTest ();
+	void expiredTest ();
+};
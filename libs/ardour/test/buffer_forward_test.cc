@@ -0,0 +1,104 @@
+#include "ardour/audio_buffer.h"
+#include "ardour/buffer_set.h"
+
+#include "buffer_forward_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (BufferForwardTest);
+
+using namespace ARDOUR;
+
+static void
+fill (AudioBuffer& b, Sample v, framecnt_t n)
+{
+	Sample* d = b.data ();
+	for (framecnt_t i = 0; i < n; ++i) {
+		d[i] = v;
+	}
+}
+
+void
+BufferForwardTest::swapTest ()
+{
+	AudioBuffer a (64);
+	AudioBuffer b (64);
+	AudioBuffer c (128);
+
+	fill (a, 1, 64);
+	fill (b, 2, 64);
+
+	const Sample* da = a.data ();
+	const Sample* db = b.data ();
+
+	CPPUNIT_ASSERT (a.swap_data (b));
+	CPPUNIT_ASSERT (a.data () == db);
+	CPPUNIT_ASSERT (b.data () == da);
+	CPPUNIT_ASSERT_EQUAL (Sample (2), a.data ()[63]);
+
+	/* different capacity */
+	CPPUNIT_ASSERT (!a.swap_data (c));
+	CPPUNIT_ASSERT (a.data () == db);
+
+	/* buffers which do not own their data */
+	AudioBuffer d (0);
+	Sample ext[64];
+	d.set_data (ext, 64);
+	CPPUNIT_ASSERT (!a.swap_data (d));
+	CPPUNIT_ASSERT (d.data () == ext);
+}
+
+void
+BufferForwardTest::forwardTest ()
+{
+	const framecnt_t n = 64;
+
+	BufferSet src;
+	BufferSet dst;
+	src.ensure_buffers (DataType::AUDIO, 2, n);
+	dst.ensure_buffers (DataType::AUDIO, 2, n);
+	src.set_count (ChanCount (DataType::AUDIO, 2));
+	dst.set_count (ChanCount (DataType::AUDIO, 2));
+
+	fill (src.get_audio (0), 1, n);
+	fill (src.get_audio (1), 2, n);
+
+	/* the first destination buffer is silent and takes over the data,
+	   the second one has data of its own, so the source is mixed in.
+	*/
+	dst.get_audio (0).clear ();
+	fill (dst.get_audio (1), 3, n);
+
+	const Sample* s0 = src.get_audio (0).data ();
+	const Sample* d1 = dst.get_audio (1).data ();
+
+	dst.forward_from (src, n);
+
+	CPPUNIT_ASSERT (dst.get_audio (0).data () == s0);
+	CPPUNIT_ASSERT (dst.get_audio (1).data () == d1);
+
+	for (framecnt_t i = 0; i < n; ++i) {
+		CPPUNIT_ASSERT_EQUAL (Sample (1), dst.get_audio (0).data ()[i]);
+		CPPUNIT_ASSERT_EQUAL (Sample (5), dst.get_audio (1).data ()[i]);
+	}
+}
+
+void
+BufferForwardTest::countTest ()
+{
+	AudioBuffer a (64);
+	AudioBuffer b (64);
+
+	AudioBuffer::set_count_copies (true);
+	AudioBuffer::reset_bytes_copied ();
+
+	a.read_from (b, 64);
+	a.accumulate_from (b, 32);
+	a.swap_data (b);
+
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) (96 * sizeof (Sample)), AudioBuffer::reset_bytes_copied ());
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 0, AudioBuffer::reset_bytes_copied ());
+
+	AudioBuffer::set_count_copies (false);
+
+	a.read_from (b, 64);
+	CPPUNIT_ASSERT_EQUAL ((uint32_t) 0, AudioBuffer::reset_bytes_copied ());
+}
@@ -0,0 +1,16 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class BufferForwardTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (BufferForwardTest);
+	CPPUNIT_TEST (swapTest);
+	CPPUNIT_TEST (forwardTest);
+	CPPUNIT_TEST (countTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void swapTest ();
+	void forwardTest ();
+	void countTest ();
+};
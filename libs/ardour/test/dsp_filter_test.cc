@@ -0,0 +1,135 @@
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "ardour/dsp_filter.h"
+
+#include "dsp_filter_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (DSPFilterTest);
+
+using namespace std;
+using namespace ARDOUR::DSP;
+
+static float
+random_sample ()
+{
+	return (float) random () / RAND_MAX - .5f;
+}
+
+/* reference: direct-form convolution */
+static void
+convolve (vector<float> const& ir, vector<float> const& in, vector<float>& out)
+{
+	out.assign (in.size (), 0.f);
+	for (size_t n = 0; n < in.size (); ++n) {
+		double acc = 0;
+		for (size_t k = 0; k < ir.size () && k <= n; ++k) {
+			acc += ir[k] * in[n - k];
+		}
+		out[n] = acc;
+	}
+}
+
+void
+DSPFilterTest::firTest ()
+{
+	vector<float> ir (37);
+	vector<float> data (1000);
+	vector<float> ref;
+
+	for (size_t i = 0; i < ir.size (); ++i) {
+		ir[i] = random_sample ();
+	}
+	for (size_t i = 0; i < data.size (); ++i) {
+		data[i] = random_sample ();
+	}
+	convolve (ir, data, ref);
+
+	FIRFilter fir (64);
+	fir.set_coefficients (&ir[0], ir.size ());
+	/* odd sized chunks */
+	fir.run (&data[0], 100);
+	fir.run (&data[100], 13);
+	fir.run (&data[113], 887);
+
+	for (size_t i = 0; i < data.size (); ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (ref[i], data[i], 1e-5);
+	}
+}
+
+void
+DSPFilterTest::biquadCascadeTest ()
+{
+	const uint32_t n_chn = 5;
+	const uint32_t n_samples = 512;
+
+	BiquadCascade bc (48000, n_chn, 2);
+	bc.compute (0, Biquad::LowPass, 1000, .7, 0);
+	bc.compute (1, Biquad::Peaking, 300, 1, 6);
+	bc.configure_channel (1, 3, 0, 0, .5, 0, 0);
+
+	vector<vector<float> > data (n_chn, vector<float> (n_samples));
+	float* ptr[n_chn];
+	for (uint32_t c = 0; c < n_chn; ++c) {
+		for (uint32_t i = 0; i < n_samples; ++i) {
+			data[c][i] = random_sample ();
+		}
+		ptr[c] = &data[c][0];
+	}
+	vector<vector<float> > ref (data);
+
+	bc.run (ptr, n_samples);
+
+	for (uint32_t c = 0; c < n_chn; ++c) {
+		Biquad s0 (48000);
+		Biquad s1 (48000);
+		s0.compute (Biquad::LowPass, 1000, .7, 0);
+		if (c == 3) {
+			s1.configure (0, 0, .5, 0, 0);
+		} else {
+			s1.compute (Biquad::Peaking, 300, 1, 6);
+		}
+		s0.run (&ref[c][0], n_samples);
+		s1.run (&ref[c][0], n_samples);
+		for (uint32_t i = 0; i < n_samples; ++i) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (ref[c][i], data[c][i], 1e-4);
+		}
+	}
+}
+
+void
+DSPFilterTest::convolverTest ()
+{
+	vector<float> ir (3000);
+	vector<float> in (6000);
+	vector<float> ref;
+
+	for (size_t i = 0; i < ir.size (); ++i) {
+		ir[i] = random_sample () * expf (i / -800.f);
+	}
+	for (size_t i = 0; i < in.size (); ++i) {
+		in[i] = random_sample ();
+	}
+	convolve (ir, in, ref);
+
+	const uint32_t chunks[] = { 1, 7, 64, 33, 100, 5 };
+
+	for (int uniform = 0; uniform < 2; ++uniform) {
+		Convolver cv (32, uniform, 512);
+		cv.set_ir (&ir[0], ir.size ());
+		CPPUNIT_ASSERT_EQUAL ((uint32_t) ir.size (), cv.ir_length ());
+
+		vector<float> data (in);
+		size_t pos = 0;
+		for (int i = 0; pos < data.size (); ++i) {
+			const uint32_t n = min ((size_t) chunks[i % 6], data.size () - pos);
+			cv.run (&data[pos], n);
+			pos += n;
+		}
+
+		for (size_t i = 0; i < data.size (); ++i) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (ref[i], data[i], 1e-4);
+		}
+	}
+}
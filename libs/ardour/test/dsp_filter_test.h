@@ -0,0 +1,16 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class DSPFilterTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (DSPFilterTest);
+	CPPUNIT_TEST (firTest);
+	CPPUNIT_TEST (biquadCascadeTest);
+	CPPUNIT_TEST (convolverTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void firTest ();
+	void biquadCascadeTest ();
+	void convolverTest ();
+};
@@ -0,0 +1,70 @@
+#include "ardour/dsp_stats.h"
+
+#include "dsp_stats_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (DSPStatsTest);
+
+using namespace ARDOUR;
+
+void
+DSPStatsTest::basicTest ()
+{
+	DSPStats stats;
+	uint64_t count;
+	double min, max, avg;
+
+	CPPUNIT_ASSERT (!stats.get_stats (count, min, max, avg));
+
+	stats.add (1000);
+	stats.add (2000);
+	stats.add (6000);
+
+	const double cpu = DSPStats::cycles_per_usec ();
+
+	CPPUNIT_ASSERT (stats.get_stats (count, min, max, avg));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 3, count);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (1000 / cpu, min, 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (6000 / cpu, max, 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (3000 / cpu, avg, 1e-6);
+}
+
+void
+DSPStatsTest::percentileTest ()
+{
+	DSPStats stats;
+
+	for (int i = 1; i <= 1000; ++i) {
+		stats.add (i * 100);
+	}
+
+	const double cpu = DSPStats::cycles_per_usec ();
+	const double p50 = stats.percentile (.5) * cpu;
+	const double p99 = stats.percentile (.99) * cpu;
+
+	/* histogram bins are a quarter octave wide */
+	CPPUNIT_ASSERT (p50 > 50000 * 0.8 && p50 < 50000 * 1.2);
+	CPPUNIT_ASSERT (p99 > 99000 * 0.8 && p99 <= 100000 + 1e-6);
+	CPPUNIT_ASSERT (p50 < p99);
+
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (100, stats.percentile (0) * cpu, 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (100000, stats.percentile (1) * cpu, 1e-6);
+}
+
+void
+DSPStatsTest::resetTest ()
+{
+	DSPStats stats;
+	uint64_t count;
+	double min, max, avg;
+
+	stats.add (5000);
+	stats.reset ();
+
+	/* reset is performed by the writer */
+	CPPUNIT_ASSERT (stats.get_stats (count, min, max, avg));
+
+	stats.add (100);
+	CPPUNIT_ASSERT (stats.get_stats (count, min, max, avg));
+	CPPUNIT_ASSERT_EQUAL ((uint64_t) 1, count);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (max, min, 1e-9);
+}
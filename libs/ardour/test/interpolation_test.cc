@@ -170,3 +170,80 @@ InterpolationTest::cubicInterpolationTest ()
 		CPPUNIT_ASSERT_EQUAL (1.0f, output[i]);
 	}
 }
+
+void
+InterpolationTest::cubicMultiChannelTest ()
+{
+	/* multi-channel interpolation must be identical to single channel */
+	CubicInterpolation multi;
+	multi.add_channel_to (NUM_SAMPLES, NUM_SAMPLES);
+	multi.add_channel_to (NUM_SAMPLES, NUM_SAMPLES);
+	multi.reserve (1024);
+
+	for (int i = 0; i < NUM_SAMPLES; ++i) {
+		input[i] = sinf (i * 0.05f) + 0.3f * sinf (i * 0.7f);
+	}
+
+	Sample multi_out[2][1024];
+	const double speeds[] = { 0.37, 1.7, 0.999, 3.3 };
+
+	framecnt_t pos = 0;
+	for (int n = 0; n < 40; ++n) {
+		cubic.set_speed (speeds[n % 4]);
+		cubic.set_target_speed (speeds[n % 4] * 1.01);
+		multi.set_speed (speeds[n % 4]);
+		multi.set_target_speed (speeds[n % 4] * 1.01);
+
+		framecnt_t result = cubic.interpolate (0, 1024, input + pos, output);
+
+		Sample* in[2] = { input + pos, input + pos };
+		Sample* out[2] = { multi_out[0], multi_out[1] };
+		CPPUNIT_ASSERT_EQUAL (result, multi.interpolate (1024, 2, in, out));
+
+		for (int i = 0; i < 1024; ++i) {
+			CPPUNIT_ASSERT_EQUAL (output[i], multi_out[0][i]);
+			CPPUNIT_ASSERT_EQUAL (output[i], multi_out[1][i]);
+		}
+		pos += result;
+	}
+}
+
+void
+InterpolationTest::sincInterpolationTest ()
+{
+	SincInterpolation sinc;
+	sinc.add_channel_to (NUM_SAMPLES, NUM_SAMPLES);
+
+	const double w0 = 0.05;
+	const double w1 = 0.7;
+	for (int i = 0; i < NUM_SAMPLES; ++i) {
+		input[i] = sin (i * w0) + 0.3 * sin (i * w1);
+	}
+
+	framecnt_t pos = 0;
+	double phase = 0;
+
+	for (int n = 0; n < 40; ++n) {
+		const double speed = (n % 2) ? 0.73 : 1.31;
+		sinc.set_speed (speed);
+
+		framecnt_t result = sinc.interpolate (0, 512, input + pos, output);
+
+		double d = phase;
+		for (int i = 0; i < 512; ++i) {
+			const double x = pos + d;
+			d += speed;
+			if (n == 0 && i < SincInterpolation::taps) {
+				/* no history, yet */
+				continue;
+			}
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (sin (x * w0) + 0.3 * sin (x * w1), output[i], 1e-3);
+		}
+
+		/* playback distance must match CubicInterpolation */
+		CPPUNIT_ASSERT_EQUAL ((framecnt_t) floor (d), result);
+
+		pos += result;
+		phase = d - floor (d);
+	}
+}
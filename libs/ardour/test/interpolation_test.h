@@ -27,6 +27,8 @@ class InterpolationTest : public CppUnit::TestFixture
 	CPPUNIT_TEST_SUITE(InterpolationTest);
 	CPPUNIT_TEST(cubicInterpolationTest);
 	CPPUNIT_TEST(linearInterpolationTest);
+	CPPUNIT_TEST(cubicMultiChannelTest);
+	CPPUNIT_TEST(sincInterpolationTest);
 	CPPUNIT_TEST_SUITE_END();
 
 #define NUM_SAMPLES 1000000
@@ -58,4 +60,6 @@ class InterpolationTest : public CppUnit::TestFixture
 
 	void linearInterpolationTest();
 	void cubicInterpolationTest();
+	void cubicMultiChannelTest();
+	void sincInterpolationTest();
 };
@@ -0,0 +1,175 @@
+#include <stdlib.h>
+#include <iterator>
+#include <vector>
+
+#include "ardour/interval_index.h"
+
+#include "interval_index_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (IntervalIndexTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+void
+IntervalIndexTest::basicTest ()
+{
+	IntervalIndex<int> index;
+	vector<int> r;
+
+	index.build ();
+	index.find_overlapping (0, 100, back_inserter (r));
+	CPPUNIT_ASSERT (r.empty ());
+	CPPUNIT_ASSERT (index.first_starting_after (0) == 0);
+	CPPUNIT_ASSERT (index.last_starting_before (0) == 0);
+
+	/* added out of order, with two items starting at 10 */
+	index.add (50, 59, 3);
+	index.add (10, 19, 1);
+	index.add (10, 99, 2);
+	index.add (0, 4, 0);
+	index.add (70, 69, 4); /* empty */
+	index.build ();
+
+	index.find_overlapping (15, 15, back_inserter (r));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 2, r.size ());
+	CPPUNIT_ASSERT_EQUAL (1, r[0]);
+	CPPUNIT_ASSERT_EQUAL (2, r[1]);
+
+	r.clear ();
+	index.find_overlapping (60, 80, back_inserter (r));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 1, r.size ());
+	CPPUNIT_ASSERT_EQUAL (2, r[0]);
+
+	/* closed intervals */
+	r.clear ();
+	index.find_overlapping (4, 10, back_inserter (r));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3, r.size ());
+
+	/* reversed range */
+	r.clear ();
+	index.find_overlapping (20, 10, back_inserter (r));
+	CPPUNIT_ASSERT (r.empty ());
+
+	r.clear ();
+	index.find_starting_within (10, 50, back_inserter (r));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3, r.size ());
+
+	CPPUNIT_ASSERT_EQUAL (1, *index.first_starting_after (0));
+	CPPUNIT_ASSERT_EQUAL (3, *index.first_starting_after (10));
+	CPPUNIT_ASSERT (index.first_starting_after (70) == 0);
+	CPPUNIT_ASSERT_EQUAL (1, *index.last_starting_before (50));
+	CPPUNIT_ASSERT_EQUAL (0, *index.last_starting_before (10));
+	CPPUNIT_ASSERT (index.last_starting_before (0) == 0);
+}
+
+/** compare against a linear search */
+void
+IntervalIndexTest::randomTest ()
+{
+	srand (42);
+
+	for (int n = 1; n <= 4096; n *= 4) {
+		IntervalIndex<int> index;
+		vector<framepos_t> first;
+		vector<framepos_t> last;
+
+		for (int i = 0; i < n; ++i) {
+			first.push_back (rand () % 100000);
+			last.push_back (first.back () + rand () % 5000);
+			index.add (first.back (), last.back (), i);
+		}
+		index.build ();
+
+		for (int q = 0; q < 200; ++q) {
+			const framepos_t start = rand () % 110000 - 5000;
+			const framepos_t end = start + rand () % 2000;
+
+			vector<int> r;
+			index.find_overlapping (start, end, back_inserter (r));
+
+			size_t expected = 0;
+			for (int i = 0; i < n; ++i) {
+				if (first[i] <= end && last[i] >= start) {
+					++expected;
+				}
+			}
+			CPPUNIT_ASSERT_EQUAL (expected, r.size ());
+
+			for (size_t i = 0; i < r.size (); ++i) {
+				CPPUNIT_ASSERT (first[r[i]] <= end && last[r[i]] >= start);
+				if (i > 0) {
+					CPPUNIT_ASSERT (first[r[i-1]] <= first[r[i]]);
+				}
+			}
+		}
+	}
+}
+
+/** move items around and compare against a linear search */
+void
+IntervalIndexTest::moveTest ()
+{
+	srand (17);
+
+	const int n = 500;
+	IntervalIndex<int> index;
+	vector<framepos_t> first;
+	vector<framepos_t> last;
+
+	for (int i = 0; i < n; ++i) {
+		first.push_back (rand () % 100000);
+		last.push_back (first.back () + rand () % 5000);
+		index.add (first.back (), last.back (), i);
+	}
+	index.build ();
+
+	/* not where it is said to start */
+	CPPUNIT_ASSERT (!index.move (0, first[0] + 1, 0, 10));
+
+	for (int m = 0; m < 1000; ++m) {
+		const int i = rand () % n;
+		const framepos_t f = (m % 10) ? rand () % 100000 : first[i];
+		const framepos_t l = f + rand () % 5000;
+
+		CPPUNIT_ASSERT (index.move (i, first[i], f, l));
+		first[i] = f;
+		last[i] = l;
+
+		const framepos_t start = rand () % 110000 - 5000;
+		const framepos_t end = start + rand () % 2000;
+
+		vector<int> r;
+		index.find_overlapping (start, end, back_inserter (r));
+
+		size_t expected = 0;
+		for (int j = 0; j < n; ++j) {
+			if (first[j] <= end && last[j] >= start) {
+				++expected;
+			}
+		}
+		CPPUNIT_ASSERT_EQUAL (expected, r.size ());
+
+		for (size_t j = 0; j < r.size (); ++j) {
+			CPPUNIT_ASSERT (first[r[j]] <= end && last[r[j]] >= start);
+			if (j > 0) {
+				CPPUNIT_ASSERT (first[r[j-1]] <= first[r[j]]);
+			}
+		}
+	}
+
+	/* a moved item goes after others starting at the same place */
+	IntervalIndex<int> small;
+	small.add (10, 20, 0);
+	small.add (10, 30, 1);
+	small.add (40, 50, 2);
+	small.build ();
+	CPPUNIT_ASSERT (small.move (2, 40, 10, 15));
+
+	vector<int> r;
+	small.find_starting_within (10, 10, back_inserter (r));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 3, r.size ());
+	CPPUNIT_ASSERT_EQUAL (0, r[0]);
+	CPPUNIT_ASSERT_EQUAL (1, r[1]);
+	CPPUNIT_ASSERT_EQUAL (2, r[2]);
+}
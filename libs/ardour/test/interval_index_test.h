@@ -0,0 +1,16 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class IntervalIndexTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (IntervalIndexTest);
+	CPPUNIT_TEST (basicTest);
+	CPPUNIT_TEST (randomTest);
+	CPPUNIT_TEST (moveTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void basicTest ();
+	void randomTest ();
+	void moveTest ();
+};
@@ -0,0 +1,125 @@
+#include "ardour/meter_snapshot.h"
+
+#include "meter_snapshot_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MeterSnapshotTest);
+
+using namespace ARDOUR;
+
+static MeterSnapshot::Levels
+make_levels (uint32_t n, float peak, float level)
+{
+	MeterSnapshot::Levels l (n);
+	for (uint32_t c = 0; c < n; ++c) {
+		l[c].peak = peak + c;
+		l[c].level = level + c;
+		l[c].max_peak = peak + c + 1;
+	}
+	return l;
+}
+
+void
+MeterSnapshotTest::publishTest ()
+{
+	MeterSnapshot snapshot;
+	MeterSnapshot::Frame frame;
+
+	const int a = snapshot.add_slot (2);
+	const int b = snapshot.add_slot (1);
+	CPPUNIT_ASSERT (a != b);
+
+	snapshot.write (a, make_levels (2, -10, -20), .5);
+	snapshot.write (b, make_levels (1, -3, -6), .25);
+
+	/* nothing is visible until the cycle was published */
+	CPPUNIT_ASSERT (snapshot.fetch (frame));
+	CPPUNIT_ASSERT_EQUAL (2U, frame.n_channels (a));
+	CPPUNIT_ASSERT (frame.level (a, 0).peak < -1000);
+	CPPUNIT_ASSERT_EQUAL (0.f, frame.combined_peak (a));
+
+	snapshot.publish (64, 48000);
+	CPPUNIT_ASSERT (snapshot.fetch (frame));
+	CPPUNIT_ASSERT_EQUAL (snapshot.serial (), frame.serial ());
+	CPPUNIT_ASSERT_EQUAL (-10.f, frame.level (a, 0).peak);
+	CPPUNIT_ASSERT_EQUAL (-9.f, frame.level (a, 1).peak);
+	CPPUNIT_ASSERT_EQUAL (-19.f, frame.level (a, 1).level);
+	CPPUNIT_ASSERT_EQUAL (-8.f, frame.level (a, 1).max_peak);
+	CPPUNIT_ASSERT_EQUAL (.5f, frame.combined_peak (a));
+	CPPUNIT_ASSERT_EQUAL (1U, frame.n_channels (b));
+	CPPUNIT_ASSERT_EQUAL (-3.f, frame.level (b, 0).peak);
+	CPPUNIT_ASSERT_EQUAL (.25f, frame.combined_peak (b));
+
+	MeterSnapshot::Level level;
+	float combined;
+	CPPUNIT_ASSERT (snapshot.read (b, 0, level, combined));
+	CPPUNIT_ASSERT_EQUAL (-6.f, level.level);
+	CPPUNIT_ASSERT_EQUAL (.25f, combined);
+	CPPUNIT_ASSERT (!snapshot.read (b, 1, level, combined));
+	CPPUNIT_ASSERT (!snapshot.read (7, 0, level, combined));
+}
+
+void
+MeterSnapshotTest::holdTest ()
+{
+	MeterSnapshot snapshot;
+	MeterSnapshot::Frame frame;
+
+	const int a = snapshot.add_slot (1);
+
+	/* the level is held at its maximum until a reader resets it */
+	snapshot.write (a, make_levels (1, 0, -5), 0);
+	snapshot.publish (64, 48000);
+	snapshot.write (a, make_levels (1, 0, -30), 0);
+	snapshot.publish (64, 48000);
+	CPPUNIT_ASSERT (snapshot.fetch (frame, true));
+	CPPUNIT_ASSERT_EQUAL (-5.f, frame.level (a, 0).level);
+
+	/* the next hold period starts with the first cycle after the fetch */
+	snapshot.write (a, make_levels (1, 0, -20), 0);
+	snapshot.publish (64, 48000);
+	snapshot.write (a, make_levels (1, 0, -40), 0);
+	snapshot.publish (64, 48000);
+	CPPUNIT_ASSERT (snapshot.fetch (frame));
+	CPPUNIT_ASSERT_EQUAL (-20.f, frame.level (a, 0).level);
+
+	/* without a reader the hold expires after max_hold frames */
+	snapshot.write (a, make_levels (1, 0, -50), 0);
+	snapshot.publish (100, 100);
+	snapshot.write (a, make_levels (1, 0, -60), 0);
+	snapshot.publish (10, 100);
+	CPPUNIT_ASSERT (snapshot.fetch (frame));
+	CPPUNIT_ASSERT_EQUAL (-50.f, frame.level (a, 0).level);
+}
+
+void
+MeterSnapshotTest::layoutTest ()
+{
+	MeterSnapshot snapshot;
+	MeterSnapshot::Frame frame;
+
+	const int a = snapshot.add_slot (1);
+	const int b = snapshot.add_slot (2);
+	snapshot.write (a, make_levels (1, -1, -1), 0);
+	snapshot.write (b, make_levels (2, -2, -2), 0);
+	snapshot.publish (64, 48000);
+
+	/* resizing keeps the levels of existing channels */
+	snapshot.resize_slot (a, 3);
+	CPPUNIT_ASSERT (snapshot.fetch (frame));
+	CPPUNIT_ASSERT_EQUAL (3U, frame.n_channels (a));
+	CPPUNIT_ASSERT_EQUAL (-1.f, frame.level (a, 0).peak);
+	CPPUNIT_ASSERT (frame.level (a, 2).peak < -1000);
+	CPPUNIT_ASSERT_EQUAL (-1.f, frame.level (b, 1).peak);
+
+	/* removed slots are re-used */
+	snapshot.remove_slot (a);
+	CPPUNIT_ASSERT (snapshot.fetch (frame));
+	CPPUNIT_ASSERT_EQUAL (0U, frame.n_channels (a));
+	CPPUNIT_ASSERT_EQUAL (-2.f, frame.level (b, 0).peak);
+
+	const int c = snapshot.add_slot (1);
+	CPPUNIT_ASSERT_EQUAL (a, c);
+	CPPUNIT_ASSERT (snapshot.fetch (frame));
+	CPPUNIT_ASSERT (frame.level (c, 0).peak < -1000);
+	CPPUNIT_ASSERT_EQUAL (0.f, frame.combined_peak (c));
+}
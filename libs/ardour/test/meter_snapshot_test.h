@@ -0,0 +1,16 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MeterSnapshotTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (MeterSnapshotTest);
+	CPPUNIT_TEST (publishTest);
+	CPPUNIT_TEST (holdTest);
+	CPPUNIT_TEST (layoutTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void publishTest ();
+	void holdTest ();
+	void layoutTest ();
+};
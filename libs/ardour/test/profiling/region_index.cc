@@ -0,0 +1,157 @@
+#include <stdlib.h>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <vector>
+
+#include <glib.h>
+
+#include "ardour/interval_index.h"
+
+using namespace std;
+using namespace ARDOUR;
+
+/* Compare a linear scan of a position-sorted list, as Playlist used to
+ * do, with IntervalIndex for the queries that common edit operations
+ * make, at various playlist sizes.
+ */
+
+struct Interval {
+	Interval (framepos_t f, framepos_t l, int i) : first (f), last (l), id (i) {}
+	framepos_t first;
+	framepos_t last;
+	int id;
+};
+
+typedef list<Interval> Intervals;
+
+static Intervals
+make_intervals (int n)
+{
+	Intervals l;
+	framepos_t pos = 0;
+
+	/* dialogue-style: short regions, mostly back to back, some overlaps */
+	for (int i = 0; i < n; ++i) {
+		const framepos_t len = 4800 + rand () % 96000;
+		l.push_back (Interval (pos, pos + len - 1, i));
+		pos += len - rand () % 4800;
+	}
+
+	return l;
+}
+
+static void
+rebuild (IntervalIndex<int>& index, Intervals const & l)
+{
+	index.clear ();
+	index.reserve (l.size ());
+	for (Intervals::const_iterator i = l.begin(); i != l.end(); ++i) {
+		index.add (i->first, i->last, i->id);
+	}
+	index.build ();
+}
+
+static void
+run (int n)
+{
+	const int queries = 1000;
+	Intervals l = make_intervals (n);
+	const framepos_t extent = l.back().last;
+	vector<framepos_t> where;
+
+	for (int q = 0; q < queries; ++q) {
+		where.push_back ((framepos_t) ((double) rand () / RAND_MAX * extent));
+	}
+
+	IntervalIndex<int> index;
+	size_t found_linear = 0;
+	size_t found_index = 0;
+
+	/* regions_at () / regions_touched () as used by split, trim and
+	 * the playlist read cover computation.
+	 */
+	gint64 t0 = g_get_monotonic_time ();
+	for (int q = 0; q < queries; ++q) {
+		const framepos_t s = where[q];
+		const framepos_t e = s + 1024;
+		for (Intervals::const_iterator i = l.begin(); i != l.end(); ++i) {
+			if (i->first <= e && i->last >= s) {
+				++found_linear;
+			}
+		}
+	}
+	gint64 t1 = g_get_monotonic_time ();
+
+	rebuild (index, l);
+	gint64 t2 = g_get_monotonic_time ();
+
+	for (int q = 0; q < queries; ++q) {
+		vector<int> r;
+		index.find_overlapping (where[q], where[q] + 1024, back_inserter (r));
+		found_index += r.size ();
+	}
+	gint64 t3 = g_get_monotonic_time ();
+
+	/* find_next_region (Start) as used by region navigation */
+	size_t next_linear = 0;
+	size_t next_index = 0;
+
+	gint64 t4 = g_get_monotonic_time ();
+	for (int q = 0; q < queries; ++q) {
+		for (Intervals::const_iterator i = l.begin(); i != l.end(); ++i) {
+			if (i->first > where[q]) {
+				next_linear += i->id;
+				break;
+			}
+		}
+	}
+	gint64 t5 = g_get_monotonic_time ();
+	for (int q = 0; q < queries; ++q) {
+		int const * r = index.first_starting_after (where[q]);
+		if (r) {
+			next_index += *r;
+		}
+	}
+	gint64 t6 = g_get_monotonic_time ();
+
+	/* an edit (move one region), followed by a query */
+	const int edits = 100;
+	gint64 t7 = g_get_monotonic_time ();
+	for (int e = 0; e < edits; ++e) {
+		Intervals::iterator i = l.begin();
+		advance (i, rand () % n);
+		i->first += 480;
+		i->last += 480;
+		rebuild (index, l);
+		vector<int> r;
+		index.find_overlapping (i->first, i->last, back_inserter (r));
+	}
+	gint64 t8 = g_get_monotonic_time ();
+
+	if (found_linear != found_index || next_linear != next_index) {
+		cerr << "ERROR: results differ\n";
+		exit (EXIT_FAILURE);
+	}
+
+	cout << n << " regions:"
+	     << " range query: linear " << (t1 - t0) / (double) queries << " us"
+	     << ", index " << (t3 - t2) / (double) queries << " us"
+	     << " (build " << (t2 - t1) << " us)"
+	     << "; next region: linear " << (t5 - t4) / (double) queries << " us"
+	     << ", index " << (t6 - t5) / (double) queries << " us"
+	     << "; edit + rebuild + query " << (t8 - t7) / (double) edits << " us"
+	     << endl;
+}
+
+int
+main (int argc, char* argv[])
+{
+	srand (1);
+
+	run (1000);
+	run (10000);
+	run (100000);
+
+	return 0;
+}
@@ -0,0 +1,84 @@
+/*
+    Copyright (C) 2017 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <vector>
+
+#include "ardour/audioregion.h"
+#include "ardour/audiosource.h"
+#include "ardour/stretch.h"
+#include "ardour/timefx_request.h"
+#include "rb_effect_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (RBEffectTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+static vector<Sample>
+read_result (boost::shared_ptr<Region> r)
+{
+	boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (r);
+	CPPUNIT_ASSERT (ar);
+
+	vector<Sample> buf (ar->length ());
+	CPPUNIT_ASSERT_EQUAL (ar->length (), ar->audio_source ()->read (&buf[0], ar->start (), ar->length ()));
+	return buf;
+}
+
+/** Stretching several regions at once must give the same results as
+ *  stretching them one after the other.
+ */
+void
+RBEffectTest::parallelTest ()
+{
+	TimeFXRequest request;
+	request.time_fraction = 1.5;
+	request.pitch_fraction = 1.0;
+
+	_ar[0]->set_length (2048);
+	_ar[1]->set_length (4096);
+	_ar[2]->set_length (1000);
+
+	vector<boost::shared_ptr<Region> > regions;
+	vector<RBEffect*> fx;
+	vector<vector<Sample> > serial;
+
+	for (int i = 0; i < 3; ++i) {
+		RBStretch stretch (*_session, request);
+		CPPUNIT_ASSERT_EQUAL (0, stretch.run (_r[i]));
+		CPPUNIT_ASSERT_EQUAL ((size_t) 1, stretch.results.size ());
+		serial.push_back (read_result (stretch.results.front ()));
+
+		regions.push_back (_r[i]);
+		fx.push_back (new RBStretch (*_session, request));
+	}
+
+	CPPUNIT_ASSERT_EQUAL (0, RBEffect::run (fx, regions));
+
+	for (int i = 0; i < 3; ++i) {
+		CPPUNIT_ASSERT_EQUAL ((size_t) 1, fx[i]->results.size ());
+
+		vector<Sample> const parallel = read_result (fx[i]->results.front ());
+		CPPUNIT_ASSERT_EQUAL (serial[i].size (), parallel.size ());
+		for (size_t s = 0; s < parallel.size (); ++s) {
+			CPPUNIT_ASSERT_EQUAL (serial[i][s], parallel[s]);
+		}
+
+		delete fx[i];
+	}
+}
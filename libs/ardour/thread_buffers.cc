@@ -90,6 +90,38 @@ ThreadBuffers::ensure_buffers (ChanCount howmany, size_t custom)
 	allocate_pan_automation_buffers (audio_buffer_size, howmany.n_audio(), false);
 }
 
+static void
+reallocate_buffer_set (BufferSet*& bufs)
+{
+	BufferSet* n = new BufferSet;
+
+	for (DataType::iterator t = DataType::begin(); t != DataType::end(); ++t) {
+		const size_t count = bufs->available().get (*t);
+		if (count > 0) {
+			n->ensure_buffers (*t, count, bufs->buffer_capacity (*t));
+		}
+	}
+
+	n->set_count (bufs->count ());
+
+	delete bufs;
+	bufs = n;
+}
+
+/** Allocate all buffer sets again, with the same number and size of buffers,
+ *  from the calling thread. With a first-touch memory policy (the default on
+ *  Linux) this moves them to memory local to the CPU that the thread runs on.
+ */
+void
+ThreadBuffers::reallocate ()
+{
+	reallocate_buffer_set (silent_buffers);
+	reallocate_buffer_set (scratch_buffers);
+	reallocate_buffer_set (noinplace_buffers);
+	reallocate_buffer_set (route_buffers);
+	reallocate_buffer_set (mix_buffers);
+}
+
 void
 ThreadBuffers::allocate_pan_automation_buffers (framecnt_t nframes, uint32_t howmany, bool force)
 {
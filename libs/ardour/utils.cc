@@ -32,6 +32,7 @@
 #include <cstring>
 #include <cerrno>
 #include <iostream>
+#include <algorithm>
 #include <sys/types.h>
 #include <sys/time.h>
 #include <fcntl.h>
@@ -46,6 +47,7 @@
 #include <glibmm/miscutils.h>
 #include <glibmm/fileutils.h>
 
+#include "pbd/compose.h"
 #include "pbd/cpus.h"
 #include "pbd/error.h"
 #include "pbd/stacktrace.h"
@@ -739,6 +741,64 @@ ARDOUR::how_many_dsp_threads ()
         return num_threads;
 }
 
+std::vector<uint32_t>
+ARDOUR::process_thread_cpus ()
+{
+	std::vector<uint32_t> cpus = PBD::parse_cpu_list (Config->get_process_thread_cpus ());
+	const uint32_t num_cpu = hardware_concurrency ();
+
+	/* ignore CPUs which do not exist */
+	while (!cpus.empty() && num_cpu > 0 && cpus.back() >= num_cpu) {
+		cpus.pop_back ();
+	}
+
+	return cpus;
+}
+
+bool
+ARDOUR::pin_process_thread (uint32_t n)
+{
+	std::vector<uint32_t> cpus = process_thread_cpus ();
+
+	if (cpus.empty()) {
+		return false;
+	}
+
+	/* one CPU per thread, sharing CPUs if there are more threads than CPUs */
+	std::vector<uint32_t> cpu (1, cpus[n % cpus.size()]);
+
+	if (PBD::set_thread_cpu_affinity (cpu)) {
+		warning << string_compose (_("Cannot pin process thread to CPU %1"), cpu.front()) << endmsg;
+		return false;
+	}
+
+	return true;
+}
+
+void
+ARDOUR::keep_thread_off_process_cpus ()
+{
+	std::vector<uint32_t> reserved = process_thread_cpus ();
+
+	if (reserved.empty()) {
+		return;
+	}
+
+	std::vector<uint32_t> others;
+	const uint32_t num_cpu = hardware_concurrency ();
+
+	for (uint32_t c = 0; c < num_cpu; ++c) {
+		if (!std::binary_search (reserved.begin(), reserved.end(), c)) {
+			others.push_back (c);
+		}
+	}
+
+	/* if all CPUs are reserved, there is nothing to keep the thread off */
+	if (!others.empty()) {
+		PBD::set_thread_cpu_affinity (others);
+	}
+}
+
 double
 ARDOUR::gain_to_slider_position_with_max (double g, double max_gain)
 {
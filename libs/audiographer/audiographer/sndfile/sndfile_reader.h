@@ -29,7 +29,7 @@ class SndfileReader
 	 *  Note that the data read is output to the outputs, as well as read into the context
 	 *  \return number of frames read
 	 */
-	framecnt_t read (ProcessContext<T> & context)
+	virtual framecnt_t read (ProcessContext<T> & context)
 	{
 		if (throw_level (ThrowStrict) && context.channels() != channels() ) {
 			throw Exception (*this, boost::str (boost::format
@@ -0,0 +1,122 @@
+#ifndef AUDIOGRAPHER_TMP_FILE_MEM_H
+#define AUDIOGRAPHER_TMP_FILE_MEM_H
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <glib.h>
+#include "pbd/gstdio_compat.h"
+
+#include "sndfile_writer.h"
+#include "sndfile_reader.h"
+#include "tmp_file.h"
+
+namespace AudioGrapher
+{
+
+/** A temporary file which keeps its data in memory, as long as it fits.
+ *  Up to \a max_samples samples are held in a buffer which is allocated
+ *  up front, only data beyond that is written to (and later read back from)
+ *  the file on disk. The file is deleted after this class is destructed.
+ */
+template<typename T = DefaultSampleType>
+class TmpFileMem
+	: public TmpFile<T>
+{
+  public:
+
+	/// \a filename_template must match the requirements for mkstemp, i.e. end in "XXXXXX"
+	TmpFileMem (char * filename_template, int format, ChannelCount channels, framecnt_t samplerate, framecnt_t max_samples)
+		: SndfileHandle (g_mkstemp(filename_template), true, SndfileBase::ReadWrite, format, channels, samplerate)
+		, filename (filename_template)
+		, max_samples (max_samples)
+		, read_pos (0)
+	{
+		buffer.reserve (max_samples);
+	}
+
+	TmpFileMem (int format, ChannelCount channels, framecnt_t samplerate, framecnt_t max_samples)
+		: SndfileHandle (fileno (tmpfile()), true, SndfileBase::ReadWrite, format, channels, samplerate)
+		, max_samples (max_samples)
+		, read_pos (0)
+	{
+		buffer.reserve (max_samples);
+	}
+
+	~TmpFileMem()
+	{
+		/* explicitly close first, some OS (yes I'm looking at you windows)
+		 * cannot delete files that are still open
+		 */
+		if (!filename.empty()) {
+			SndfileBase::close();
+			std::remove(filename.c_str());
+		}
+	}
+
+	/// Number of samples kept in memory
+	framecnt_t samples_in_memory () const { return buffer.size (); }
+
+	void process (ProcessContext<T> const & c)
+	{
+		/* once data went to the file, the rest has to follow it */
+		if (SndfileWriter<T>::frames_written == (framecnt_t) buffer.size ()
+		    && (framecnt_t) buffer.size () + c.frames () <= max_samples) {
+			buffer.insert (buffer.end (), c.data (), c.data () + c.frames ());
+			SndfileWriter<T>::frames_written += c.frames ();
+			if (c.has_flag(ProcessContext<T>::EndOfInput)) {
+				SndfileWriter<T>::FileWritten (SndfileWriter<T>::path);
+			}
+		} else {
+			SndfileWriter<T>::process (c);
+		}
+
+		if (c.has_flag(ProcessContext<T>::EndOfInput)) {
+			TmpFile<T>::FileFlushed ();
+		}
+	}
+
+	using Sink<T>::process;
+
+	/** Read data into buffer in \a context, the data in memory first,
+	 *  followed by whatever was written to the file.
+	 *  The file needs to be seek()ed to its start before reading.
+	 *  \return number of frames read
+	 */
+	framecnt_t read (ProcessContext<T> & context)
+	{
+		framecnt_t const in_memory = (framecnt_t) buffer.size () - read_pos;
+		framecnt_t const from_memory = std::min (context.frames (), in_memory);
+
+		if (from_memory > 0) {
+			std::copy (&buffer[read_pos], &buffer[read_pos] + from_memory, context.data ());
+			read_pos += from_memory;
+		}
+
+		framecnt_t frames_read = from_memory;
+
+		if (frames_read < context.frames () && SndfileWriter<T>::frames_written > (framecnt_t) buffer.size ()) {
+			frames_read += SndfileHandle::read (context.data () + from_memory, context.frames () - from_memory);
+		}
+
+		ProcessContext<T> c_out = context.beginning (frames_read);
+
+		if (frames_read < context.frames()) {
+			c_out.set_flag (ProcessContext<T>::EndOfInput);
+		}
+		this->output (c_out);
+		return frames_read;
+	}
+
+  private:
+	std::string    filename;
+	framecnt_t     max_samples;
+	framecnt_t     read_pos;
+	std::vector<T> buffer;
+};
+
+} // namespace
+
+#endif // AUDIOGRAPHER_TMP_FILE_MEM_H
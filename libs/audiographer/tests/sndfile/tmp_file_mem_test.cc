@@ -0,0 +1,87 @@
+#include "tests/utils.h"
+#include "audiographer/sndfile/tmp_file_mem.h"
+
+using namespace AudioGrapher;
+
+class TmpFileMemTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE (TmpFileMemTest);
+  CPPUNIT_TEST (testInMemory);
+  CPPUNIT_TEST (testSpill);
+  CPPUNIT_TEST_SUITE_END ();
+
+  public:
+	void setUp()
+	{
+		frames = 128;
+		random_data = TestUtils::init_random_data(frames);
+	}
+
+	void tearDown()
+	{
+		delete [] random_data;
+	}
+
+	void testInMemory()
+	{
+		uint32_t channels = 2;
+		file.reset (new TmpFileMem<float>(SF_FORMAT_WAV | SF_FORMAT_FLOAT, channels, 44100, frames));
+		AllocatingProcessContext<float> c (random_data, frames, channels);
+		c.set_flag (ProcessContext<float>::EndOfInput);
+		file->process (c);
+
+		CPPUNIT_ASSERT_EQUAL (frames, file->samples_in_memory ());
+		CPPUNIT_ASSERT_EQUAL (frames, file->get_frames_written ());
+
+		TypeUtils<float>::zero_fill (c.data (), c.frames());
+
+		file->seek (0, SEEK_SET);
+		CPPUNIT_ASSERT_EQUAL (frames, file->read (c));
+		CPPUNIT_ASSERT (TestUtils::array_equals (random_data, c.data(), c.frames()));
+	}
+
+	void testSpill()
+	{
+		uint32_t channels = 2;
+		framecnt_t half = frames / 2;
+		file.reset (new TmpFileMem<float>(SF_FORMAT_WAV | SF_FORMAT_FLOAT, channels, 44100, half));
+
+		/* the first half fits into memory, the second one has to go to the file */
+		ConstProcessContext<float> c1 (random_data, half, channels);
+		file->process (c1);
+		ConstProcessContext<float> c2 (random_data + half, half, channels);
+		c2().set_flag (ProcessContext<float>::EndOfInput);
+		file->process (c2);
+
+		CPPUNIT_ASSERT_EQUAL (half, file->samples_in_memory ());
+		CPPUNIT_ASSERT_EQUAL (frames, file->get_frames_written ());
+
+		/* read in chunks which do not line up with the memory boundary */
+		float * data = new float[frames];
+		TypeUtils<float>::zero_fill (data, frames);
+		file->seek (0, SEEK_SET);
+
+		framecnt_t pos = 0;
+		framecnt_t const chunk = 24;
+		while (true) {
+			ProcessContext<float> c (data + pos, std::min (chunk, frames - pos), channels);
+			framecnt_t read = file->read (c);
+			pos += read;
+			if (read < chunk || pos == frames) {
+				break;
+			}
+		}
+
+		CPPUNIT_ASSERT_EQUAL (frames, pos);
+		CPPUNIT_ASSERT (TestUtils::array_equals (random_data, data, frames));
+		delete [] data;
+	}
+
+  private:
+	boost::shared_ptr<TmpFileMem<float> > file;
+
+	float * random_data;
+	framecnt_t frames;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION (TmpFileMemTest);
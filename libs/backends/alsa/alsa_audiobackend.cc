@@ -1407,6 +1407,9 @@ AlsaAudioBackend::register_system_audio_ports()
 		//ap->set_pretty_name ("")
 		_system_outputs.push_back (ap);
 	}
+
+	_capture_buffers.resize (_system_inputs.size ());
+	_playback_buffers.resize (_system_outputs.size ());
 	return 0;
 }
 
@@ -1911,11 +1914,21 @@ AlsaAudioBackend::main_process_thread ()
 				clock1 = g_get_monotonic_time();
 				no_proc_errors = 0;
 
+				/* native float, non-interleaved devices are used in-place,
+				 * the capture area is only released after processing */
 				_pcmi->capt_init (_samples_per_period);
+				const bool capt_direct = !_system_inputs.empty () && _pcmi->capt_direct (0);
 				for (std::vector<AlsaPort*>::const_iterator it = _system_inputs.begin (); it != _system_inputs.end (); ++it, ++i) {
-					_pcmi->capt_chan (i, (float*)((*it)->get_buffer(_samples_per_period)), _samples_per_period);
+					if (capt_direct) {
+						static_cast<AlsaAudioPort*>(*it)->set_external_buffer (const_cast<float*> (_pcmi->capt_direct (i)));
+					} else {
+						_capture_buffers[i] = (float*)((*it)->get_buffer(_samples_per_period));
+					}
+				}
+				if (!capt_direct) {
+					_pcmi->capt_chans (&_capture_buffers[0], _system_inputs.size (), _samples_per_period);
+					_pcmi->capt_done (_samples_per_period);
 				}
-				_pcmi->capt_done (_samples_per_period);
 
 				/* de-queue incoming midi*/
 				i = 0;
@@ -1941,6 +1954,9 @@ AlsaAudioBackend::main_process_thread ()
 				/* call engine process callback */
 				_last_process_start = g_get_monotonic_time();
 				if (engine.process_callback (_samples_per_period)) {
+					for (std::vector<AlsaPort*>::const_iterator it = _system_inputs.begin (); it != _system_inputs.end (); ++it) {
+						static_cast<AlsaAudioPort*>(*it)->set_external_buffer (0);
+					}
 					_pcmi->pcm_stop ();
 					_active = false;
 					return 0;
@@ -1965,13 +1981,31 @@ AlsaAudioBackend::main_process_thread ()
 				/* write back audio */
 				i = 0;
 				_pcmi->play_init (_samples_per_period);
-				for (std::vector<AlsaPort*>::const_iterator it = _system_outputs.begin (); it != _system_outputs.end (); ++it, ++i) {
-					_pcmi->play_chan (i, (const float*)(*it)->get_buffer (_samples_per_period), _samples_per_period);
-				}
-				for (; i < _pcmi->nplay (); ++i) {
-					_pcmi->clear_chan (i, _samples_per_period);
+				if (!_system_outputs.empty () && _pcmi->play_direct (0)) {
+					/* mix connections directly into the device's buffer */
+					for (std::vector<AlsaPort*>::const_iterator it = _system_outputs.begin (); it != _system_outputs.end (); ++it, ++i) {
+						AlsaAudioPort* ap = static_cast<AlsaAudioPort*>(*it);
+						ap->set_external_buffer (_pcmi->play_direct (i));
+						ap->get_buffer (_samples_per_period);
+						ap->set_external_buffer (0);
+					}
+					for (; i < _pcmi->nplay (); ++i) {
+						_pcmi->clear_chan (i, _samples_per_period);
+					}
+				} else {
+					for (std::vector<AlsaPort*>::const_iterator it = _system_outputs.begin (); it != _system_outputs.end (); ++it, ++i) {
+						_playback_buffers[i] = (const float*)(*it)->get_buffer (_samples_per_period);
+					}
+					_pcmi->play_chans (&_playback_buffers[0], _system_outputs.size (), _samples_per_period);
 				}
 				_pcmi->play_done (_samples_per_period);
+
+				if (capt_direct) {
+					for (std::vector<AlsaPort*>::const_iterator it = _system_inputs.begin (); it != _system_inputs.end (); ++it) {
+						static_cast<AlsaAudioPort*>(*it)->set_external_buffer (0);
+					}
+					_pcmi->capt_done (_samples_per_period);
+				}
 				nr -= _samples_per_period;
 				_processed_samples += _samples_per_period;
 
@@ -2256,6 +2290,7 @@ bool AlsaPort::is_physically_connected () const
 
 AlsaAudioPort::AlsaAudioPort (AlsaAudioBackend &b, const std::string& name, PortFlags flags)
 	: AlsaPort (b, name, flags)
+	, _ext_buffer (0)
 {
 	memset (_buffer, 0, sizeof (_buffer));
 	mlock(_buffer, sizeof (_buffer));
@@ -2269,11 +2304,11 @@ void* AlsaAudioPort::get_buffer (pframes_t n_samples)
 		const std::set<AlsaPort *>& connections = get_connections ();
 		std::set<AlsaPort*>::const_iterator it = connections.begin ();
 		if (it == connections.end ()) {
-			memset (_buffer, 0, n_samples * sizeof (Sample));
+			memset (buffer (), 0, n_samples * sizeof (Sample));
 		} else {
 			AlsaAudioPort const * source = static_cast<const AlsaAudioPort*>(*it);
 			assert (source && source->is_output ());
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
+			memcpy (buffer (), source->const_buffer (), n_samples * sizeof (Sample));
 			while (++it != connections.end ()) {
 				source = static_cast<const AlsaAudioPort*>(*it);
 				assert (source && source->is_output ());
@@ -2285,7 +2320,7 @@ void* AlsaAudioPort::get_buffer (pframes_t n_samples)
 			}
 		}
 	}
-	return _buffer;
+	return buffer ();
 }
 
 
@@ -133,12 +133,16 @@ class AlsaAudioPort : public AlsaPort {
 
 		DataType type () const { return DataType::AUDIO; };
 
-		Sample* buffer () { return _buffer; }
-		const Sample* const_buffer () const { return _buffer; }
+		Sample* buffer () { return _ext_buffer ? _ext_buffer : _buffer; }
+		const Sample* const_buffer () const { return _ext_buffer ? _ext_buffer : _buffer; }
 		void* get_buffer (pframes_t nframes);
 
+		/* use device memory (mmap area) instead of the port's own buffer, NULL to reset */
+		void set_external_buffer (Sample* b) { _ext_buffer = b; }
+
 	private:
 		Sample _buffer[8192];
+		Sample* _ext_buffer;
 }; // class AlsaAudioPort
 
 class AlsaMidiPort : public AlsaPort {
@@ -410,6 +414,10 @@ class AlsaAudioBackend : public AudioBackend {
 		std::vector<AlsaPort *> _system_midi_in;
 		std::vector<AlsaPort *> _system_midi_out;
 
+		/* per-cycle port buffer pointers, passed to Alsa_pcmi */
+		std::vector<float *> _capture_buffers;
+		std::vector<const float *> _playback_buffers;
+
 		struct SortByPortName
 		{
 			bool operator ()(const AlsaPort* lhs, const AlsaPort* rhs) const
@@ -67,6 +67,12 @@ Alsa_pcmi::Alsa_pcmi (
 	, _synced (false)
 	, _play_npfd (0)
 	, _capt_npfd (0)
+	, _play_ssize (0)
+	, _capt_ssize (0)
+	, _play_packed (false)
+	, _capt_packed (false)
+	, _play_multi_func (0)
+	, _capt_multi_func (0)
 {
 	const char *p;
 
@@ -285,6 +291,11 @@ int Alsa_pcmi::play_init (snd_pcm_uframes_t len)
 	{
 		_play_ptr [i] = (char *) a->addr + ((a->first + a->step * _play_offs) >> 3);
 	}
+	_play_packed = _play_multi_func && (_play_step == (int)(_play_nchan * _play_ssize));
+	for (i = 1; _play_packed && i < _play_nchan; i++)
+	{
+		if (_play_ptr [i] != _play_ptr [0] + i * _play_ssize) _play_packed = false;
+	}
 
 	return len;
 }
@@ -310,6 +321,11 @@ int Alsa_pcmi::capt_init (snd_pcm_uframes_t len)
 	{
 		_capt_ptr [i] = (char *) a->addr + ((a->first + a->step * _capt_offs) >> 3);
 	}
+	_capt_packed = _capt_multi_func && (_capt_step == (int)(_capt_nchan * _capt_ssize));
+	for (i = 1; _capt_packed && i < _capt_nchan; i++)
+	{
+		if (_capt_ptr [i] != _capt_ptr [0] + i * _capt_ssize) _capt_packed = false;
+	}
 
 	return len;
 }
@@ -333,6 +349,62 @@ void Alsa_pcmi::capt_chan  (int chan, float *dst, int len, int step)
 }
 
 
+// Convert 'nchan' channels at once. Channels beyond 'nchan' are silenced.
+// When the device uses a packed interleaved layout, whole frames are converted
+// in blocks of BLKFRM, so that the mmap area is read sequentially just once.
+
+void Alsa_pcmi::play_chans (const float *const *src, int nchan, int len)
+{
+	unsigned int  i;
+	const float  *s [MAXCHAN];
+
+	if (_play_packed && _play_nchan > 1)
+	{
+		for (i = 0; i < _play_nchan; i++) s [i] = ((int) i < nchan) ? src [i] : 0;
+		(this->*Alsa_pcmi::_play_multi_func)(s, _play_ptr [0], len);
+		for (i = 0; i < _play_nchan; i++) _play_ptr [i] += len * _play_step;
+		return;
+	}
+	for (i = 0; i < _play_nchan; i++)
+	{
+		if ((int) i < nchan) play_chan (i, src [i], len);
+		else clear_chan (i, len);
+	}
+}
+
+
+void Alsa_pcmi::capt_chans (float *const *dst, int nchan, int len)
+{
+	unsigned int  i;
+
+	if (nchan > (int) _capt_nchan) nchan = _capt_nchan;
+	if (_capt_packed && nchan > 1)
+	{
+		(this->*Alsa_pcmi::_capt_multi_func)(_capt_ptr [0], dst, nchan, len);
+		for (i = 0; i < _capt_nchan; i++) _capt_ptr [i] += len * _capt_step;
+		return;
+	}
+	for (i = 0; i < (unsigned int) nchan; i++) capt_chan (i, dst [i], len);
+}
+
+
+// Non-interleaved native float devices can be accessed in place, without
+// any conversion. These return 0 if that is not possible.
+
+float *Alsa_pcmi::play_direct (int chan) const
+{
+	if (_play_multi_func != &Alsa_pcmi::play_multi_float || _play_step != (int) sizeof (float)) return 0;
+	return (float *) _play_ptr [chan];
+}
+
+
+const float *Alsa_pcmi::capt_direct (int chan) const
+{
+	if (_capt_multi_func != &Alsa_pcmi::capt_multi_float || _capt_step != (int) sizeof (float)) return 0;
+	return (const float *) _capt_ptr [chan];
+}
+
+
 int Alsa_pcmi::play_done (int len)
 {
 	if (!_play_handle) return 0;
@@ -488,11 +560,13 @@ void Alsa_pcmi::initialise (const char *play_name, const char *capt_name, const
 			case SND_PCM_FORMAT_FLOAT_LE:
 				_clear_func = &Alsa_pcmi::clear_32;
 				_play_func  = &Alsa_pcmi::play_float;
+				_play_multi_func = &Alsa_pcmi::play_multi_float;
 				break;
 
 			case SND_PCM_FORMAT_S32_LE:
 				_clear_func = &Alsa_pcmi::clear_32;
 				_play_func  = &Alsa_pcmi::play_32;
+				_play_multi_func = &Alsa_pcmi::play_multi_32;
 				break;
 
 			case SND_PCM_FORMAT_S32_BE:
@@ -503,6 +577,7 @@ void Alsa_pcmi::initialise (const char *play_name, const char *capt_name, const
 			case SND_PCM_FORMAT_S24_3LE:
 				_clear_func = &Alsa_pcmi::clear_24;
 				_play_func  = &Alsa_pcmi::play_24;
+				_play_multi_func = &Alsa_pcmi::play_multi_24;
 				break;
 
 			case SND_PCM_FORMAT_S24_3BE:
@@ -513,6 +588,7 @@ void Alsa_pcmi::initialise (const char *play_name, const char *capt_name, const
 			case SND_PCM_FORMAT_S16_LE:
 				_clear_func = &Alsa_pcmi::clear_16;
 				_play_func  = &Alsa_pcmi::play_16;
+				_play_multi_func = &Alsa_pcmi::play_multi_16;
 				break;
 
 			case SND_PCM_FORMAT_S16_BE:
@@ -536,6 +612,7 @@ void Alsa_pcmi::initialise (const char *play_name, const char *capt_name, const
 			case SND_PCM_FORMAT_S32_BE:
 				_clear_func = &Alsa_pcmi::clear_32;
 				_play_func  = &Alsa_pcmi::play_32;
+				_play_multi_func = &Alsa_pcmi::play_multi_32;
 				break;
 
 			case SND_PCM_FORMAT_S24_3LE:
@@ -546,6 +623,7 @@ void Alsa_pcmi::initialise (const char *play_name, const char *capt_name, const
 			case SND_PCM_FORMAT_S24_3BE:
 				_clear_func = &Alsa_pcmi::clear_24;
 				_play_func  = &Alsa_pcmi::play_24;
+				_play_multi_func = &Alsa_pcmi::play_multi_24;
 				break;
 
 			case SND_PCM_FORMAT_S16_LE:
@@ -556,6 +634,7 @@ void Alsa_pcmi::initialise (const char *play_name, const char *capt_name, const
 			case SND_PCM_FORMAT_S16_BE:
 				_clear_func = &Alsa_pcmi::clear_16;
 				_play_func  = &Alsa_pcmi::play_16;
+				_play_multi_func = &Alsa_pcmi::play_multi_16;
 				break;
 
 			default:
@@ -567,6 +646,7 @@ void Alsa_pcmi::initialise (const char *play_name, const char *capt_name, const
 #error "System byte order is undefined or not supported"
 #endif
 
+		_play_ssize = snd_pcm_format_physical_width (_play_format) >> 3;
 		_play_npfd = snd_pcm_poll_descriptors_count (_play_handle);
 	}
 
@@ -601,10 +681,12 @@ void Alsa_pcmi::initialise (const char *play_name, const char *capt_name, const
 		{
 			case SND_PCM_FORMAT_FLOAT_LE:
 				_capt_func  = &Alsa_pcmi::capt_float;
+				_capt_multi_func = &Alsa_pcmi::capt_multi_float;
 				break;
 
 			case SND_PCM_FORMAT_S32_LE:
 				_capt_func  = &Alsa_pcmi::capt_32;
+				_capt_multi_func = &Alsa_pcmi::capt_multi_32;
 				break;
 
 			case SND_PCM_FORMAT_S32_BE:
@@ -613,6 +695,7 @@ void Alsa_pcmi::initialise (const char *play_name, const char *capt_name, const
 
 			case SND_PCM_FORMAT_S24_3LE:
 				_capt_func  = &Alsa_pcmi::capt_24;
+				_capt_multi_func = &Alsa_pcmi::capt_multi_24;
 				break;
 
 			case SND_PCM_FORMAT_S24_3BE:
@@ -621,6 +704,7 @@ void Alsa_pcmi::initialise (const char *play_name, const char *capt_name, const
 
 			case SND_PCM_FORMAT_S16_LE:
 				_capt_func  = &Alsa_pcmi::capt_16;
+				_capt_multi_func = &Alsa_pcmi::capt_multi_16;
 				break;
 
 			case SND_PCM_FORMAT_S16_BE:
@@ -641,6 +725,7 @@ void Alsa_pcmi::initialise (const char *play_name, const char *capt_name, const
 
 			case SND_PCM_FORMAT_S32_BE:
 				_capt_func  = &Alsa_pcmi::capt_32;
+				_capt_multi_func = &Alsa_pcmi::capt_multi_32;
 				break;
 
 			case SND_PCM_FORMAT_S24_3LE:
@@ -649,6 +734,7 @@ void Alsa_pcmi::initialise (const char *play_name, const char *capt_name, const
 
 			case SND_PCM_FORMAT_S24_3BE:
 				_capt_func  = &Alsa_pcmi::capt_24;
+				_capt_multi_func = &Alsa_pcmi::capt_multi_24;
 				break;
 
 			case SND_PCM_FORMAT_S16_LE:
@@ -657,6 +743,7 @@ void Alsa_pcmi::initialise (const char *play_name, const char *capt_name, const
 
 			case SND_PCM_FORMAT_S16_BE:
 				_capt_func  = &Alsa_pcmi::capt_16;
+				_capt_multi_func = &Alsa_pcmi::capt_multi_16;
 				break;
 
 			default:
@@ -668,6 +755,7 @@ void Alsa_pcmi::initialise (const char *play_name, const char *capt_name, const
 #error "System byte order is undefined or not supported"
 #endif
 
+		_capt_ssize = snd_pcm_format_physical_width (_capt_format) >> 3;
 		_capt_npfd = snd_pcm_poll_descriptors_count (_capt_handle);
 	}
 
@@ -1151,3 +1239,241 @@ const char *Alsa_pcmi::capt_float (const char *src, float *dst, int nfrm, int st
 	}
 	return src;
 }
+
+
+// Multichannel kernels for packed interleaved layouts --------------------------------
+//
+// A block of BLKFRM frames is (de)interleaved via _blk, so that the conversion
+// itself runs over contiguous samples and can be vectorized by the compiler.
+// Results are identical to the per-channel functions above.
+
+
+void Alsa_pcmi::gather_block (const float *const *src, int nfrm)
+{
+	const int nchan = _play_nchan;
+
+	for (int c = 0; c < nchan; c++)
+	{
+		const float *s = src [c];
+		float       *d = _blk + c;
+		if (s)
+		{
+			for (int k = 0; k < nfrm; k++) d [k * nchan] = s [k];
+		}
+		else
+		{
+			for (int k = 0; k < nfrm; k++) d [k * nchan] = 0.f;
+		}
+	}
+}
+
+void Alsa_pcmi::scatter_block (float *const *dst, int nchan, int nfrm)
+{
+	for (int c = 0; c < nchan; c++)
+	{
+		const float *s = _blk + c;
+		float       *d = dst [c];
+		for (int k = 0; k < nfrm; k++) d [k] = s [k * nchan];
+	}
+}
+
+
+char *Alsa_pcmi::play_multi_float (const float *const *src, char *dst, int nfrm)
+{
+	const int nchan = _play_nchan;
+	const float *s [MAXCHAN];
+
+	for (int f = 0; f < nfrm; f += BLKFRM)
+	{
+		const int n = (nfrm - f < BLKFRM) ? nfrm - f : BLKFRM;
+		for (int c = 0; c < nchan; c++) s [c] = src [c] ? src [c] + f : 0;
+		gather_block (s, n);
+		for (int k = 0; k < n; k++)
+		{
+			memcpy (dst, _blk + k * nchan, nchan * sizeof (float));
+			dst += _play_step;
+		}
+	}
+	return dst;
+}
+
+char *Alsa_pcmi::play_multi_32 (const float *const *src, char *dst, int nfrm)
+{
+	const int nchan = _play_nchan;
+	const float *s [MAXCHAN];
+
+	for (int f = 0; f < nfrm; f += BLKFRM)
+	{
+		const int n = (nfrm - f < BLKFRM) ? nfrm - f : BLKFRM;
+		for (int c = 0; c < nchan; c++) s [c] = src [c] ? src [c] + f : 0;
+		gather_block (s, n);
+		for (int k = 0; k < n; k++)
+		{
+			const float *b = _blk + k * nchan;
+			int         *d = (int *) dst;
+			for (int c = 0; c < nchan; c++)
+			{
+				float x = b [c];
+				x = (x >  1) ?  1.f : x;
+				x = (x < -1) ? -1.f : x;
+				d [c] = ((int)((float) 0x007fffff * x)) << 8;
+			}
+			dst += _play_step;
+		}
+	}
+	return dst;
+}
+
+char *Alsa_pcmi::play_multi_24 (const float *const *src, char *dst, int nfrm)
+{
+	const int nchan = _play_nchan;
+	const float *s [MAXCHAN];
+	int          v [MAXCHAN];
+
+	for (int f = 0; f < nfrm; f += BLKFRM)
+	{
+		const int n = (nfrm - f < BLKFRM) ? nfrm - f : BLKFRM;
+		for (int c = 0; c < nchan; c++) s [c] = src [c] ? src [c] + f : 0;
+		gather_block (s, n);
+		for (int k = 0; k < n; k++)
+		{
+			const float *b = _blk + k * nchan;
+			char        *d = dst;
+			for (int c = 0; c < nchan; c++)
+			{
+				float x = b [c];
+				x = (x >  1) ?  1.f : x;
+				x = (x < -1) ? -1.f : x;
+				v [c] = (int)((float) 0x007fffff * x);
+			}
+			for (int c = 0; c < nchan; c++, d += 3)
+			{
+				d [0] = v [c];
+				d [1] = v [c] >> 8;
+				d [2] = v [c] >> 16;
+			}
+			dst += _play_step;
+		}
+	}
+	return dst;
+}
+
+char *Alsa_pcmi::play_multi_16 (const float *const *src, char *dst, int nfrm)
+{
+	const int nchan = _play_nchan;
+	const float *s [MAXCHAN];
+
+	for (int f = 0; f < nfrm; f += BLKFRM)
+	{
+		const int n = (nfrm - f < BLKFRM) ? nfrm - f : BLKFRM;
+		for (int c = 0; c < nchan; c++) s [c] = src [c] ? src [c] + f : 0;
+		gather_block (s, n);
+		for (int k = 0; k < n; k++)
+		{
+			const float *b = _blk + k * nchan;
+			short int   *d = (short int *) dst;
+			for (int c = 0; c < nchan; c++)
+			{
+				float x = b [c];
+				x = (x >  1) ?  1.f : x;
+				x = (x < -1) ? -1.f : x;
+				d [c] = (short int)((float) 0x7fff * x);
+			}
+			dst += _play_step;
+		}
+	}
+	return dst;
+}
+
+
+const char *Alsa_pcmi::capt_multi_float (const char *src, float *const *dst, int nchan, int nfrm)
+{
+	float *d [MAXCHAN];
+
+	for (int f = 0; f < nfrm; f += BLKFRM)
+	{
+		const int n = (nfrm - f < BLKFRM) ? nfrm - f : BLKFRM;
+		for (int k = 0; k < n; k++)
+		{
+			memcpy (_blk + k * nchan, src, nchan * sizeof (float));
+			src += _capt_step;
+		}
+		for (int c = 0; c < nchan; c++) d [c] = dst [c] + f;
+		scatter_block (d, nchan, n);
+	}
+	return src;
+}
+
+const char *Alsa_pcmi::capt_multi_32 (const char *src, float *const *dst, int nchan, int nfrm)
+{
+	float *d [MAXCHAN];
+
+	for (int f = 0; f < nfrm; f += BLKFRM)
+	{
+		const int n = (nfrm - f < BLKFRM) ? nfrm - f : BLKFRM;
+		for (int k = 0; k < n; k++)
+		{
+			const int *s = (const int *) src;
+			float     *b = _blk + k * nchan;
+			for (int c = 0; c < nchan; c++)
+			{
+				b [c] = (float) s [c] / (float) 0x7fffff00;
+			}
+			src += _capt_step;
+		}
+		for (int c = 0; c < nchan; c++) d [c] = dst [c] + f;
+		scatter_block (d, nchan, n);
+	}
+	return src;
+}
+
+const char *Alsa_pcmi::capt_multi_24 (const char *src, float *const *dst, int nchan, int nfrm)
+{
+	float *d [MAXCHAN];
+
+	for (int f = 0; f < nfrm; f += BLKFRM)
+	{
+		const int n = (nfrm - f < BLKFRM) ? nfrm - f : BLKFRM;
+		for (int k = 0; k < n; k++)
+		{
+			const char *s = src;
+			float      *b = _blk + k * nchan;
+			for (int c = 0; c < nchan; c++, s += 3)
+			{
+				int v;
+				v  = (s [0] & 0xFF);
+				v += (s [1] & 0xFF) << 8;
+				v += (s [2] & 0xFF) << 16;
+				if (v & 0x00800000) v -= 0x01000000;
+				b [c] = (float) v / (float) 0x007fffff;
+			}
+			src += _capt_step;
+		}
+		for (int c = 0; c < nchan; c++) d [c] = dst [c] + f;
+		scatter_block (d, nchan, n);
+	}
+	return src;
+}
+
+const char *Alsa_pcmi::capt_multi_16 (const char *src, float *const *dst, int nchan, int nfrm)
+{
+	float *d [MAXCHAN];
+
+	for (int f = 0; f < nfrm; f += BLKFRM)
+	{
+		const int n = (nfrm - f < BLKFRM) ? nfrm - f : BLKFRM;
+		for (int k = 0; k < n; k++)
+		{
+			const short int *s = (const short int *) src;
+			float           *b = _blk + k * nchan;
+			for (int c = 0; c < nchan; c++)
+			{
+				b [c] = (float) s [c] / (float) 0x7fff;
+			}
+			src += _capt_step;
+		}
+		for (int c = 0; c < nchan; c++) d [c] = dst [c] + f;
+		scatter_block (d, nchan, n);
+	}
+	return src;
+}
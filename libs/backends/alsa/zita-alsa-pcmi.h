@@ -73,10 +73,14 @@ public:
 	int play_init (snd_pcm_uframes_t len);
 	void clear_chan (int chan, int len);
 	void play_chan (int chan, const float *src, int len, int step = 1);
+	void play_chans (const float *const *src, int nchan, int len);
+	float *play_direct (int chan) const;
 	int play_done (int len);
 
 	int capt_init (snd_pcm_uframes_t len);
 	void capt_chan (int chan, float *dst, int len, int step = 1);
+	void capt_chans (float *const *dst, int nchan, int len);
+	const float *capt_direct (int chan) const;
 	int capt_done (int len);
 
 	int play_avail (void)
@@ -122,8 +126,10 @@ private:
 	typedef char *(Alsa_pcmi::*clear_function)(char *, int);
 	typedef char *(Alsa_pcmi::*play_function)(const float *, char *, int, int);
 	typedef const char *(Alsa_pcmi::*capt_function) (const char *, float *, int, int);
+	typedef char *(Alsa_pcmi::*play_multi_function)(const float *const *, char *, int);
+	typedef const char *(Alsa_pcmi::*capt_multi_function) (const char *, float *const *, int, int);
 
-	enum { MAXPFD = 16, MAXCHAN = 128 };
+	enum { MAXPFD = 16, MAXCHAN = 128, BLKFRM = 16 };
 
 	void initialise (const char *play_name, const char *capt_name, const char *ctrl_name);
 	int set_hwpar (snd_pcm_t *handle, snd_pcm_hw_params_t *hwpar, const char *sname, unsigned int nfrag, unsigned int *nchan);
@@ -151,6 +157,19 @@ private:
 	const char *capt_24swap (const char *src, float *dst, int nfrm, int step);
 	const char *capt_16swap (const char *src, float *dst, int nfrm, int step);
 
+	void gather_block (const float *const *src, int nfrm);
+	void scatter_block (float *const *dst, int nchan, int nfrm);
+
+	char *play_multi_float (const float *const *src, char *dst, int nfrm);
+	char *play_multi_32 (const float *const *src, char *dst, int nfrm);
+	char *play_multi_24 (const float *const *src, char *dst, int nfrm);
+	char *play_multi_16 (const float *const *src, char *dst, int nfrm);
+
+	const char *capt_multi_float (const char *src, float *const *dst, int nchan, int nfrm);
+	const char *capt_multi_32 (const char *src, float *const *dst, int nchan, int nfrm);
+	const char *capt_multi_24 (const char *src, float *const *dst, int nchan, int nfrm);
+	const char *capt_multi_16 (const char *src, float *const *dst, int nchan, int nfrm);
+
 	unsigned int           _fsamp;
 	snd_pcm_uframes_t      _fsize;
 	unsigned int           _play_nfrag;
@@ -180,11 +199,18 @@ private:
 	snd_pcm_uframes_t      _play_offs;
 	int                    _play_step;
 	int                    _capt_step;
+	int                    _play_ssize;
+	int                    _capt_ssize;
+	bool                   _play_packed;
+	bool                   _capt_packed;
 	char                  *_play_ptr [MAXCHAN];
 	const char            *_capt_ptr [MAXCHAN];
 	clear_function         _clear_func;
 	play_function          _play_func;
 	capt_function          _capt_func;
+	play_multi_function    _play_multi_func;
+	capt_multi_function    _capt_multi_func;
+	float                  _blk [BLKFRM * MAXCHAN];
 	void                  *_dummy [16];
 };
 
@@ -267,11 +267,11 @@ Box::add (Item* i)
 }
 
 void
-Box::child_changed ()
+Box::child_changed (Item* i)
 {
 	/* catch visibility and size changes */
 
-	Item::child_changed ();
+	Item::child_changed (i);
 	reposition_children ();
 }
 
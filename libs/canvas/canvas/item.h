@@ -201,7 +201,7 @@ public:
 	void raise_child_to_top (Item *);
 	void raise_child (Item *, int);
 	void lower_child_to_bottom (Item *);
-	virtual void child_changed ();
+	virtual void child_changed (Item*);
 
 	static int default_items_per_cell;
 
@@ -291,6 +291,7 @@ protected:
 	void clear_items (bool with_delete);
 
 	void ensure_lut () const;
+	void lut_child_added (Item*);
 	mutable LookupTable* _lut;
 	/* our items, from lowest to highest in the stack */
 	std::list<Item*> _items;
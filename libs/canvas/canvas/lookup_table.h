@@ -21,7 +21,10 @@
 #define __CANVAS_LOOKUP_TABLE_H__
 
 #include <vector>
+#include <stdint.h>
 #include <boost/multi_array.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 
 #include "canvas/visibility.h"
 #include "canvas/types.h"
@@ -42,6 +45,14 @@ public:
     virtual std::vector<Item*> items_at_point (Duple const &) const = 0;
     virtual bool has_item_at_point (Duple const & point) const = 0;
 
+    /* changes to the children of our item; tables which do not
+       keep any state of their own may ignore these.
+    */
+    virtual void child_added (Item*) {}
+    virtual void child_removed (Item*) {}
+    virtual void child_changed (Item*) {}
+    virtual void restacked () {}
+
 protected:
 
     Item const & _item;
@@ -57,6 +68,74 @@ public:
     bool has_item_at_point (Duple const & point) const;
 };
 
+/** A lookup table which keeps the bounding boxes of our item's children
+ *  in a hierarchical grid, and follows changes to them.
+ *
+ *  Level n of the grid has square cells of (base_cell_size << n) units.
+ *  Each child is kept in exactly one cell: the one containing the top-left
+ *  corner of its bounding box, on the finest level whose cells are at
+ *  least as large as the box. A query thus only has to look at the cells
+ *  which cover the area of interest (plus one row and column before it)
+ *  on each level, and adding, moving or removing a child is cheap.
+ *
+ *  Changed children are put back into the grid when the table is next
+ *  queried.
+ */
+class LIBCANVAS_API SpatialLookupTable : public LookupTable
+{
+public:
+	SpatialLookupTable (Item const &);
+
+	std::vector<Item*> get (Rect const &);
+	std::vector<Item*> items_at_point (Duple const &) const;
+	bool has_item_at_point (Duple const & point) const;
+
+	void child_added (Item*);
+	void child_removed (Item*);
+	void child_changed (Item*);
+	void restacked ();
+
+	static const Coord base_cell_size;
+
+private:
+	typedef std::pair<int64_t, int64_t> CellKey;
+
+	struct Entry {
+		Entry (Item* i) : item (i), level (not_indexed), order (0) {}
+		Item* item;
+		int level;
+		CellKey cell;
+		Rect bbox; ///< in our item's coordinates
+		uint64_t order;
+	};
+
+	static const int not_indexed = -1;
+	static const int unbounded = -2;
+
+	typedef std::vector<Entry*> Cell;
+	typedef boost::unordered_map<CellKey, Cell> Level;
+	typedef boost::unordered_map<Item*, Entry> Entries;
+	typedef std::vector<Entry const *> Found;
+
+	void update () const;
+	void insert (Entry&) const;
+	void erase (Entry&) const;
+	void find (Rect const &, Found&) const;
+	bool window_to_item (Rect const &, Rect&) const;
+
+	static CellKey cell_key (Coord x, Coord y, Coord size);
+	static void add_overlapping (Cell const &, Rect const &, Found&);
+
+	mutable Entries _entries;
+	mutable std::vector<Level> _levels;
+	/** children whose bounding boxes are too large for any level */
+	mutable Cell _unbounded;
+	/** children which need to be put back into the grid */
+	mutable boost::unordered_set<Item*> _dirty;
+	/** true if the stacking order of the children has changed */
+	mutable bool _restacked;
+};
+
 class LIBCANVAS_API OptimizingLookupTable : public LookupTable
 {
 public:
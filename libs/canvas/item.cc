@@ -280,8 +280,10 @@ Item::set_position (Duple p)
 
 
 		if (_parent) {
-			_parent->child_changed ();
+			_parent->child_changed (this);
 		}
+	} else if (_parent && _parent->_lut) {
+		_parent->_lut->child_changed (this);
 	}
 }
 
@@ -378,7 +380,7 @@ Item::propagate_show_hide ()
 	/* bounding box may have changed while we were hidden */
 
 	if (_parent) {
-		_parent->child_changed ();
+		_parent->child_changed (this);
 	}
 
 	_canvas->item_shown_or_hidden (this);
@@ -626,8 +628,11 @@ Item::end_change ()
 		_canvas->item_changed (this, _pre_change_bounding_box);
 
 		if (_parent) {
-			_parent->child_changed ();
+			_parent->child_changed (this);
 		}
+	} else if (_parent && _parent->_lut) {
+		/* our parent's lookup table must follow us even while we are hidden */
+		_parent->_lut->child_changed (this);
 	}
 }
 
@@ -863,7 +868,7 @@ Item::add (Item* i)
 
 	_items.push_back (i);
 	i->reparent (this);
-	invalidate_lut ();
+	lut_child_added (i);
 	_bounding_box_dirty = true;
 }
 
@@ -874,7 +879,7 @@ Item::add_front (Item* i)
 
 	_items.push_front (i);
 	i->reparent (this);
-	invalidate_lut ();
+	lut_child_added (i);
 	_bounding_box_dirty = true;
 }
 
@@ -900,7 +905,9 @@ Item::remove (Item* i)
 
 	i->unparent ();
 	_items.remove (i);
-	invalidate_lut ();
+	if (_lut) {
+		_lut->child_removed (i);
+	}
 	_bounding_box_dirty = true;
 
 	end_change ();
@@ -957,7 +964,9 @@ Item::raise_child_to_top (Item* i)
 	_items.remove (i);
 	_items.push_back (i);
 
-	invalidate_lut ();
+	if (_lut) {
+		_lut->restacked ();
+	}
         redraw ();
 }
 
@@ -976,7 +985,9 @@ Item::raise_child (Item* i, int levels)
 	}
 
 	_items.insert (j, i);
-	invalidate_lut ();
+	if (_lut) {
+		_lut->restacked ();
+	}
         redraw ();
 }
 
@@ -990,15 +1001,39 @@ Item::lower_child_to_bottom (Item* i)
 	}
 	_items.remove (i);
 	_items.push_front (i);
-	invalidate_lut ();
+	if (_lut) {
+		_lut->restacked ();
+	}
         redraw ();
 }
 
+/** Groups with more than default_items_per_cell children keep them in a
+ *  SpatialLookupTable, smaller ones are simply scanned.
+ */
 void
 Item::ensure_lut () const
 {
 	if (!_lut) {
-		_lut = new DumbLookupTable (*this);
+		if (_items.size () > (size_t) default_items_per_cell) {
+			_lut = new SpatialLookupTable (*this);
+		} else {
+			_lut = new DumbLookupTable (*this);
+		}
+	}
+}
+
+void
+Item::lut_child_added (Item* i)
+{
+	if (!_lut) {
+		return;
+	}
+
+	if (_items.size () == (size_t) default_items_per_cell + 1) {
+		/* time to switch to a SpatialLookupTable */
+		invalidate_lut ();
+	} else {
+		_lut->child_added (i);
 	}
 }
 
@@ -1010,13 +1045,16 @@ Item::invalidate_lut () const
 }
 
 void
-Item::child_changed ()
+Item::child_changed (Item* i)
 {
-	invalidate_lut ();
+	if (_lut) {
+		_lut->child_changed (i);
+	}
+
 	_bounding_box_dirty = true;
 
 	if (_parent) {
-		_parent->child_changed ();
+		_parent->child_changed (this);
 	}
 }
 
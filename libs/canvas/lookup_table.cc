@@ -17,6 +17,9 @@
     Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 */
 
+#include <algorithm>
+#include <cmath>
+
 #include "canvas/item.h"
 #include "canvas/lookup_table.h"
 
@@ -103,6 +106,330 @@ DumbLookupTable::has_item_at_point (Duple const & point) const
 	return false;
 }
 
+Coord const SpatialLookupTable::base_cell_size = 64;
+
+/* cells are at most base_cell_size << (max_levels - 1) units wide; larger
+   items are kept in a list of their own, and checked by every query.
+*/
+static const int max_levels = 40;
+
+/* coordinates beyond this are clamped when finding a cell, which keeps
+   cell indices within range and still finds every overlapping child.
+*/
+static const Coord max_cell_coord = 1e15;
+
+SpatialLookupTable::SpatialLookupTable (Item const & item)
+	: LookupTable (item)
+	, _restacked (true)
+{
+	list<Item*> const & items = _item.items ();
+
+	for (list<Item*>::const_iterator i = items.begin(); i != items.end(); ++i) {
+		_entries.insert (make_pair (*i, Entry (*i)));
+		_dirty.insert (*i);
+	}
+}
+
+void
+SpatialLookupTable::child_added (Item* item)
+{
+	_entries.insert (make_pair (item, Entry (item)));
+	_dirty.insert (item);
+	_restacked = true;
+}
+
+void
+SpatialLookupTable::child_removed (Item* item)
+{
+	/* item may be in the middle of deletion: do not ask it for anything */
+
+	Entries::iterator e = _entries.find (item);
+
+	if (e == _entries.end ()) {
+		return;
+	}
+
+	erase (e->second);
+	_entries.erase (e);
+	_dirty.erase (item);
+}
+
+void
+SpatialLookupTable::child_changed (Item* item)
+{
+	if (_entries.find (item) != _entries.end ()) {
+		_dirty.insert (item);
+	}
+}
+
+void
+SpatialLookupTable::restacked ()
+{
+	_restacked = true;
+}
+
+SpatialLookupTable::CellKey
+SpatialLookupTable::cell_key (Coord x, Coord y, Coord size)
+{
+	x = max (-max_cell_coord, min (max_cell_coord, x));
+	y = max (-max_cell_coord, min (max_cell_coord, y));
+
+	return CellKey ((int64_t) floor (x / size), (int64_t) floor (y / size));
+}
+
+void
+SpatialLookupTable::insert (Entry& e) const
+{
+	Coord const extent = max (e.bbox.width (), e.bbox.height ());
+	Coord size = base_cell_size;
+	int level = 0;
+
+	while (size < extent && level < max_levels - 1) {
+		size *= 2;
+		++level;
+	}
+
+	if (size < extent) {
+		e.level = unbounded;
+		_unbounded.push_back (&e);
+		return;
+	}
+
+	if ((int) _levels.size () <= level) {
+		_levels.resize (level + 1);
+	}
+
+	e.level = level;
+	e.cell = cell_key (e.bbox.x0, e.bbox.y0, size);
+	_levels[level][e.cell].push_back (&e);
+}
+
+void
+SpatialLookupTable::erase (Entry& e) const
+{
+	Cell* cell = 0;
+	Level::iterator c;
+
+	if (e.level == unbounded) {
+		cell = &_unbounded;
+	} else if (e.level != not_indexed) {
+		c = _levels[e.level].find (e.cell);
+		if (c != _levels[e.level].end ()) {
+			cell = &c->second;
+		}
+	}
+
+	if (cell) {
+		Cell::iterator i = std::find (cell->begin (), cell->end (), &e);
+		if (i != cell->end ()) {
+			*i = cell->back ();
+			cell->pop_back ();
+		}
+		if (cell->empty () && e.level != unbounded) {
+			_levels[e.level].erase (c);
+		}
+	}
+
+	e.level = not_indexed;
+}
+
+/** Put changed children back into the grid, and renumber all children
+ *  after their stacking order has changed.
+ */
+void
+SpatialLookupTable::update () const
+{
+	for (boost::unordered_set<Item*>::const_iterator i = _dirty.begin(); i != _dirty.end(); ++i) {
+
+		Entries::iterator e = _entries.find (*i);
+
+		if (e == _entries.end ()) {
+			continue;
+		}
+
+		erase (e->second);
+
+		boost::optional<Rect> item_bbox = (*i)->bounding_box ();
+
+		if (!item_bbox) {
+			continue;
+		}
+
+		e->second.bbox = (*i)->item_to_parent (item_bbox.get ());
+		insert (e->second);
+	}
+
+	_dirty.clear ();
+
+	if (_restacked) {
+		list<Item*> const & items = _item.items ();
+		uint64_t n = 0;
+
+		for (list<Item*>::const_iterator i = items.begin(); i != items.end(); ++i) {
+			Entries::iterator e = _entries.find (*i);
+			if (e != _entries.end ()) {
+				e->second.order = n++;
+			}
+		}
+
+		_restacked = false;
+	}
+}
+
+void
+SpatialLookupTable::add_overlapping (Cell const & cell, Rect const & area, Found& found)
+{
+	for (Cell::const_iterator i = cell.begin(); i != cell.end(); ++i) {
+		if ((*i)->bbox.intersection (area)) {
+			found.push_back (*i);
+		}
+	}
+}
+
+struct EntrySortByOrder {
+	template<typename E>
+	bool operator() (E const * a, E const * b) const {
+		return a->order < b->order;
+	}
+};
+
+/** Find the children whose bounding boxes overlap @param area, in our
+ *  item's coordinates, and sort them from lowest to highest in the stack.
+ */
+void
+SpatialLookupTable::find (Rect const & area, Found& found) const
+{
+	update ();
+
+	Coord size = base_cell_size;
+
+	for (vector<Level>::const_iterator l = _levels.begin(); l != _levels.end(); ++l, size *= 2) {
+
+		if (l->empty ()) {
+			continue;
+		}
+
+		/* a child in the previous column or row may still reach into the area */
+		CellKey const c0 = cell_key (area.x0 - size, area.y0 - size, size);
+		CellKey const c1 = cell_key (area.x1, area.y1, size);
+
+		if ((double) (c1.first - c0.first + 1) * (double) (c1.second - c0.second + 1) > l->size ()) {
+			/* fewer occupied cells than cells in the area */
+			for (Level::const_iterator c = l->begin(); c != l->end(); ++c) {
+				add_overlapping (c->second, area, found);
+			}
+			continue;
+		}
+
+		for (int64_t x = c0.first; x <= c1.first; ++x) {
+			for (int64_t y = c0.second; y <= c1.second; ++y) {
+				Level::const_iterator c = l->find (CellKey (x, y));
+				if (c != l->end ()) {
+					add_overlapping (c->second, area, found);
+				}
+			}
+		}
+	}
+
+	add_overlapping (_unbounded, area, found);
+
+	std::sort (found.begin (), found.end (), EntrySortByOrder ());
+}
+
+/** Convert @param area from window coordinates to those of our item, in
+ *  which the children's bounding boxes are kept.
+ *  @return false if there are no children.
+ */
+bool
+SpatialLookupTable::window_to_item (Rect const & area, Rect& r) const
+{
+	list<Item*> const & items = _item.items ();
+
+	if (items.empty ()) {
+		return false;
+	}
+
+	/* go via one of the children, because scrolling applies to them
+	   but not necessarily to our item itself.
+	*/
+	Item const * child = items.front ();
+	r = child->item_to_parent (child->window_to_item (area));
+
+	/* DumbLookupTable compares rounded window coordinates */
+	r = r.expand (1);
+
+	return true;
+}
+
+vector<Item *>
+SpatialLookupTable::get (Rect const & area)
+{
+	vector<Item *> vitems;
+	Rect r;
+
+	if (!window_to_item (area, r)) {
+		return vitems;
+	}
+
+	Found found;
+	find (r, found);
+
+	vitems.reserve (found.size ());
+
+	for (Found::const_iterator i = found.begin(); i != found.end(); ++i) {
+		vitems.push_back ((*i)->item);
+	}
+
+	return vitems;
+}
+
+vector<Item *>
+SpatialLookupTable::items_at_point (Duple const & point) const
+{
+	/* Point is in window coordinate system */
+
+	vector<Item *> vitems;
+	Rect r;
+
+	if (!window_to_item (Rect (point.x, point.y, point.x, point.y), r)) {
+		return vitems;
+	}
+
+	Found found;
+	find (r, found);
+
+	for (Found::const_iterator i = found.begin(); i != found.end(); ++i) {
+		if ((*i)->item->covers (point)) {
+			vitems.push_back ((*i)->item);
+		}
+	}
+
+	return vitems;
+}
+
+bool
+SpatialLookupTable::has_item_at_point (Duple const & point) const
+{
+	/* Point is in window coordinate system */
+
+	Rect r;
+
+	if (!window_to_item (Rect (point.x, point.y, point.x, point.y), r)) {
+		return false;
+	}
+
+	Found found;
+	find (r, found);
+
+	for (Found::const_iterator i = found.begin(); i != found.end(); ++i) {
+		if ((*i)->item->visible () && (*i)->item->covers (point)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 OptimizingLookupTable::OptimizingLookupTable (Item const & item, int items_per_cell)
 	: LookupTable (item)
 	, _items_per_cell (items_per_cell)
@@ -0,0 +1,125 @@
+#include "canvas/lookup_table.h"
+#include "canvas/types.h"
+#include "canvas/rectangle.h"
+#include "canvas/canvas.h"
+#include "spatial_lookup_table.h"
+
+using namespace std;
+using namespace ArdourCanvas;
+
+CPPUNIT_TEST_SUITE_REGISTRATION (SpatialLookupTableTest);
+
+/* N x N rectangles of 8x8 on a 16 unit grid; query areas whose edges are
+   at least 4 units away from any rectangle give the same results from
+   both kinds of table.
+*/
+static int const N = 64;
+
+static void
+make_grid (ImageCanvas& canvas)
+{
+	for (int x = 0; x < N; ++x) {
+		for (int y = 0; y < N; ++y) {
+			Rectangle* r = new Rectangle (canvas.root());
+			r->set_outline_width (0);
+			r->set (Rect (x * 16, y * 16, x * 16 + 8, y * 16 + 8));
+		}
+	}
+}
+
+static void
+compare (Item& item, Rect const & area)
+{
+	DumbLookupTable dumb (item);
+	SpatialLookupTable spatial (item);
+
+	CPPUNIT_ASSERT (dumb.get (area) == spatial.get (area));
+}
+
+void
+SpatialLookupTableTest::get ()
+{
+	ImageCanvas canvas;
+	make_grid (canvas);
+
+	SpatialLookupTable table (*canvas.root());
+
+	CPPUNIT_ASSERT (table.get (Rect (-4, -4, 12, 12)).size() == 1);
+	CPPUNIT_ASSERT (table.get (Rect (12, 12, 60, 28)).size() == 3);
+	CPPUNIT_ASSERT (table.get (Rect (-100, -100, -50, -50)).empty ());
+
+	compare (*canvas.root(), Rect (12, 12, 60, 28));
+	compare (*canvas.root(), Rect (-4, -4, N * 16, N * 16));
+	compare (*canvas.root(), Rect (300, -4, COORD_MAX, 76));
+
+	vector<Item*> items = table.items_at_point (Duple (20, 36));
+	CPPUNIT_ASSERT (items.size() == 1);
+	CPPUNIT_ASSERT (table.has_item_at_point (Duple (20, 36)));
+	CPPUNIT_ASSERT (!table.has_item_at_point (Duple (28, 36)));
+}
+
+/** Check that the table the canvas uses follows items as they are moved,
+ *  resized, added and removed.
+ */
+void
+SpatialLookupTableTest::follow_changes ()
+{
+	ImageCanvas canvas;
+	make_grid (canvas);
+
+	Item* root = canvas.root ();
+	root->ensure_lut ();
+	CPPUNIT_ASSERT (dynamic_cast<SpatialLookupTable*> (root->_lut));
+
+	Rect const area (12, 12, 60, 28);
+	CPPUNIT_ASSERT (root->_lut->get (area).size() == 3);
+
+	/* move the first rectangle into the area */
+	Item* first = root->items().front ();
+	first->set_position (Duple (64, 16));
+	CPPUNIT_ASSERT (root->_lut->get (area).size() == 3);
+	CPPUNIT_ASSERT (root->_lut->get (Rect (60, 12, 76, 28)).size() == 2);
+	CPPUNIT_ASSERT (root->_lut->get (Rect (-4, -4, 12, 12)).empty ());
+
+	/* grow it to cover the whole grid */
+	Rectangle* r = dynamic_cast<Rectangle*> (first);
+	r->set (Rect (-64, -16, N * 16, N * 16));
+	CPPUNIT_ASSERT (root->_lut->get (Rect (-4, -4, 12, 12)).size() == 1);
+
+	/* and remove it */
+	delete first;
+	CPPUNIT_ASSERT (root->_lut->get (Rect (-4, -4, 12, 12)).empty ());
+
+	Rectangle* added = new Rectangle (root, Rect (-8, -8, 0, 0));
+	added->set_outline_width (0);
+	CPPUNIT_ASSERT (root->_lut->get (Rect (-12, -12, -4, -4)).size() == 1);
+
+	compare (*root, Rect (-12, -12, N * 16, N * 16));
+}
+
+/** Check that SpatialLookupTable::get() returns things in the same order
+ *  as they are in the owning group, also after restacking.
+ */
+void
+SpatialLookupTableTest::check_ordering ()
+{
+	ImageCanvas canvas;
+	make_grid (canvas);
+
+	Item* root = canvas.root ();
+	Rect const area (-4, -4, 44, 44);
+
+	root->ensure_lut ();
+	vector<Item*> items = root->_lut->get (area);
+	CPPUNIT_ASSERT (items.size() == 9);
+
+	items.front()->raise_to_top ();
+	items.back()->lower_to_bottom ();
+
+	vector<Item*> lut_items = root->_lut->get (area);
+	CPPUNIT_ASSERT (lut_items.size() == 9);
+	CPPUNIT_ASSERT (lut_items.front() == items.back());
+	CPPUNIT_ASSERT (lut_items.back() == items.front());
+
+	compare (*root, area);
+}
@@ -0,0 +1,16 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class SpatialLookupTableTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (SpatialLookupTableTest);
+	CPPUNIT_TEST (get);
+	CPPUNIT_TEST (follow_changes);
+	CPPUNIT_TEST (check_ordering);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void get ();
+	void follow_changes ();
+	void check_ordering ();
+};
@@ -220,6 +220,53 @@ SMF::seek_to_start() const
 	}
 }
 
+/** Seek to the first event at or after the given time.
+ *
+ * libsmf keeps all events of the track in memory, sorted by their absolute
+ * time, so this is a binary search rather than re-reading from the start.
+ *
+ * \return the absolute time (in SMF ticks) of the event preceding the new
+ * position (0 if there is none): the delta time returned by the next
+ * read_event() is relative to it.
+ */
+uint64_t
+SMF::seek_to_time(uint64_t ticks) const
+{
+	Glib::Threads::Mutex::Lock lm (_smf_lock);
+
+	if (!_smf_track) {
+		cerr << "WARNING: SMF seek_to_time() with no track" << endl;
+		return 0;
+	}
+
+	const size_t n_events = _smf_track->number_of_events;
+
+	/* event numbers are 1-based; find the first event with time >= ticks */
+	size_t lo = 1;
+	size_t hi = n_events + 1;
+	while (lo < hi) {
+		const size_t mid = lo + (hi - lo) / 2;
+		if (smf_track_get_event_by_number (_smf_track, mid)->time_pulses < ticks) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	if (lo > n_events) {
+		/* end of track */
+		_smf_track->next_event_number = 0;
+	} else {
+		_smf_track->next_event_number = lo;
+		_smf_track->time_of_next_event = smf_track_get_event_by_number (_smf_track, lo)->time_pulses;
+	}
+
+	if (lo > 1) {
+		return smf_track_get_event_by_number (_smf_track, lo - 1)->time_pulses;
+	}
+	return 0;
+}
+
 /** Read an event from the current position in file.
  *
  * File position MUST be at the beginning of a delta time, or this will die very messily.
@@ -1,5 +1,8 @@
 #include "SMFTest.hpp"
 
+#include <algorithm>
+#include <vector>
+
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
 
@@ -68,3 +71,47 @@ SMFTest::takeFiveTest ()
 	                Evoral::Beats::ticks_at_rate(time, smf.ppqn()));
 	CPPUNIT_ASSERT(!seq->empty());
 }
+
+void
+SMFTest::seekTest ()
+{
+	TestSMF smf;
+	string testdata_path;
+	CPPUNIT_ASSERT (find_file (test_search_path (), "TakeFive.mid", testdata_path));
+	smf.open(testdata_path);
+	CPPUNIT_ASSERT(!smf.is_empty());
+
+	/* absolute time of every event, read sequentially */
+	vector<uint64_t> times;
+	uint64_t time = 0;
+	uint32_t delta_t = 0;
+	uint32_t size    = 0;
+	uint8_t* buf     = NULL;
+
+	smf.seek_to_start();
+	while (smf.read_event(&delta_t, &size, &buf) >= 0) {
+		time += delta_t;
+		times.push_back (time);
+	}
+	CPPUNIT_ASSERT(times.size() > 2);
+
+	const uint64_t end = times.back();
+	for (uint64_t t = 0; t <= end + 1; t += std::max ((uint64_t) 1, end / 97)) {
+		const uint64_t base = smf.seek_to_time (t);
+		const vector<uint64_t>::const_iterator i = lower_bound (times.begin(), times.end(), t);
+
+		int ret = smf.read_event(&delta_t, &size, &buf);
+		if (i == times.end()) {
+			CPPUNIT_ASSERT_EQUAL (-1, ret);
+			continue;
+		}
+		CPPUNIT_ASSERT(ret >= 0);
+		CPPUNIT_ASSERT_EQUAL (i == times.begin() ? (uint64_t) 0 : *(i - 1), base);
+		CPPUNIT_ASSERT_EQUAL (*i, base + delta_t);
+	}
+
+	smf.seek_to_time (end + 1);
+	CPPUNIT_ASSERT_EQUAL (-1, smf.read_event(&delta_t, &size, &buf));
+
+	free (buf);
+}
@@ -22,8 +22,13 @@
 #include "libpbd-config.h"
 #endif
 
+#include <algorithm>
+#include <cstdlib>
+
 #ifdef __linux__
 #include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
 #elif defined(__APPLE__) || defined(__FreeBSD__)
 #include <stddef.h>
 #include <sys/types.h>
@@ -62,3 +67,97 @@ hardware_concurrency()
         return 0;
 #endif
 }
+
+std::vector<uint32_t>
+PBD::parse_cpu_list (std::string const & str)
+{
+	std::vector<uint32_t> cpus;
+	std::string::size_type pos = 0;
+
+	while (pos < str.length()) {
+
+		std::string::size_type comma = str.find (',', pos);
+		if (comma == std::string::npos) {
+			comma = str.length();
+		}
+
+		const std::string item = str.substr (pos, comma - pos);
+		pos = comma + 1;
+
+		if (item.find_first_not_of (" \t") == std::string::npos) {
+			continue;
+		}
+
+		char* end;
+		const long first = strtol (item.c_str(), &end, 10);
+		long last = first;
+
+		while (*end == ' ' || *end == '\t') {
+			++end;
+		}
+		if (*end == '-') {
+			last = strtol (end + 1, &end, 10);
+			while (*end == ' ' || *end == '\t') {
+				++end;
+			}
+		}
+
+		if (*end != '\0' || first < 0 || last < first || last > 4095) {
+			return std::vector<uint32_t> ();
+		}
+
+		for (long c = first; c <= last; ++c) {
+			cpus.push_back (c);
+		}
+	}
+
+	std::sort (cpus.begin(), cpus.end());
+	cpus.erase (std::unique (cpus.begin(), cpus.end()), cpus.end());
+
+	return cpus;
+}
+
+int
+PBD::set_thread_cpu_affinity (std::vector<uint32_t> const & cpus)
+{
+	if (cpus.empty()) {
+		return -1;
+	}
+
+#if defined(__linux__) && defined(CPU_SET)
+	cpu_set_t set;
+	CPU_ZERO (&set);
+	for (std::vector<uint32_t>::const_iterator i = cpus.begin(); i != cpus.end(); ++i) {
+		if (*i < CPU_SETSIZE) {
+			CPU_SET (*i, &set);
+		}
+	}
+	return pthread_setaffinity_np (pthread_self (), sizeof (set), &set) == 0 ? 0 : -1;
+#elif defined(PLATFORM_WINDOWS)
+	DWORD_PTR mask = 0;
+	for (std::vector<uint32_t>::const_iterator i = cpus.begin(); i != cpus.end(); ++i) {
+		if (*i < sizeof (DWORD_PTR) * 8) {
+			mask |= ((DWORD_PTR) 1) << *i;
+		}
+	}
+	if (mask == 0) {
+		return -1;
+	}
+	return SetThreadAffinityMask (GetCurrentThread (), mask) != 0 ? 0 : -1;
+#else
+	/* no way to pin threads to a CPU (e.g. OS X only supports affinity hints) */
+	return -1;
+#endif
+}
+
+int
+PBD::current_cpu ()
+{
+#if defined(__linux__) && defined(CPU_SET)
+	return sched_getcpu ();
+#elif defined(PLATFORM_WINDOWS) && (_WIN32_WINNT >= 0x0600)
+	return GetCurrentProcessorNumber ();
+#else
+	return -1;
+#endif
+}
@@ -0,0 +1,68 @@
+/*
+    Copyright (C) 2017 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include <algorithm>
+
+#include "pbd/memento_command.h"
+
+MementoStatePool::LastStates MementoStatePool::_last;
+size_t MementoStatePool::_prune_size = 64;
+Glib::Threads::Mutex MementoStatePool::_lock;
+
+MementoStatePool::State
+MementoStatePool::share (XMLNode* node, bool& shared)
+{
+	std::string key = node->name ();
+	XMLProperty const * prop = node->property ("id");
+	if (prop) {
+		key += ':';
+		key += prop->value ();
+	}
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	LastStates::iterator i = _last.find (key);
+
+	if (i != _last.end ()) {
+		State last (i->second.lock ());
+		if (last && *last == *node) {
+			delete node;
+			shared = true;
+			return last;
+		}
+	}
+
+	State state (node);
+	shared = false;
+	_last[key] = state;
+
+	if (_last.size () > _prune_size) {
+		/* forget objects whose states are no longer held by any command */
+		for (LastStates::iterator i = _last.begin (); i != _last.end (); ) {
+			if (i->second.expired ()) {
+				_last.erase (i++);
+			} else {
+				++i;
+			}
+		}
+		_prune_size = std::max ((size_t) 64, 2 * _last.size ());
+	}
+
+	return state;
+}
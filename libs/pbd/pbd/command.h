@@ -49,6 +49,13 @@ public:
 		return false;
 	}
 
+	/** @return approximate number of bytes held by this command,
+	 * used to keep the undo history within its memory budget.
+	 */
+	virtual size_t memory_use () const {
+		return sizeof (Command) + _name.capacity ();
+	}
+
 protected:
 	Command() {}
 	Command(const std::string& name) : _name(name) {}
@@ -22,9 +22,29 @@
 #define __libpbd_cpus_h__
 
 #include <stdint.h>
+#include <string>
+#include <vector>
 
 #include "pbd/libpbd_visibility.h"
 
 LIBPBD_API extern uint32_t hardware_concurrency ();
 
+namespace PBD {
+
+/** Parse a list of CPU numbers and ranges, e.g. "2,4-7".
+ *  @return the CPUs in ascending order, without duplicates; empty if
+ *  the list is empty or not valid.
+ */
+LIBPBD_API extern std::vector<uint32_t> parse_cpu_list (std::string const &);
+
+/** Restrict the calling thread to run on the given CPUs only.
+ *  @return 0 on success, -1 on error or if not supported on this platform.
+ */
+LIBPBD_API extern int set_thread_cpu_affinity (std::vector<uint32_t> const &);
+
+/** @return the CPU that the calling thread is running on, or -1 if unknown */
+LIBPBD_API extern int current_cpu ();
+
+}
+
 #endif /* __libpbd_cpus_h__ */
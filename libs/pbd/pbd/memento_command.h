@@ -22,6 +22,11 @@
 #define __lib_pbd_memento_command_h__
 
 #include <iostream>
+#include <map>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <glibmm/threads.h>
 
 #include "pbd/libpbd_visibility.h"
 #include "pbd/command.h"
@@ -95,6 +100,33 @@ private:
 	PBD::ScopedConnection _object_death_connection;
 };
 
+/** Shares the XML states of MementoCommands.
+ *
+ * Successive edits of the same object usually produce a "before" state
+ * identical to the "after" state of the previous command, and the states
+ * of a no-op edit are equal. Rather than each keeping its own copy, the
+ * commands share a single immutable node.
+ */
+class LIBPBD_API MementoStatePool
+{
+public:
+	typedef boost::shared_ptr<XMLNode const> State;
+
+	/** Take ownership of @param node.
+	 * @param shared set to true if an identical state was already held,
+	 * in which case @param node is deleted and that state is returned.
+	 */
+	static State share (XMLNode* node, bool& shared);
+
+private:
+	/* most recent state per object, keyed by node name and ID */
+	typedef std::map<std::string, boost::weak_ptr<XMLNode const> > LastStates;
+
+	static LastStates _last;
+	static size_t _prune_size;
+	static Glib::Threads::Mutex _lock;
+};
+
 /** This command class is initialized with before and after mementos
  * (from Stateful::get_state()), so undo becomes restoring the before
  * memento, and redo is restoring the after memento.
@@ -104,23 +136,23 @@ class LIBPBD_TEMPLATE_API MementoCommand : public Command
 {
 public:
 	MementoCommand (obj_T& a_object, XMLNode* a_before, XMLNode* a_after)
-		: _binder (new SimpleMementoCommandBinder<obj_T> (a_object)), before (a_before), after (a_after)
+		: _binder (new SimpleMementoCommandBinder<obj_T> (a_object))
 	{
+		set_states (a_before, a_after);
 		/* The binder's object died, so we must die */
 		_binder->DropReferences.connect_same_thread (_binder_death_connection, boost::bind (&MementoCommand::binder_dying, this));
 	}
 
 	MementoCommand (MementoCommandBinder<obj_T>* b, XMLNode* a_before, XMLNode* a_after)
-		: _binder (b), before (a_before), after (a_after)
+		: _binder (b)
 	{
+		set_states (a_before, a_after);
 		/* The binder's object died, so we must die */
 		_binder->DropReferences.connect_same_thread (_binder_death_connection, boost::bind (&MementoCommand::binder_dying, this));
 	}
 
 	~MementoCommand () {
 		drop_references ();
-		delete before;
-		delete after;
 		delete _binder;
 	}
 
@@ -166,11 +198,38 @@ public:
 		return *node;
 	}
 
+	size_t memory_use () const {
+		return sizeof (*this) + _name.capacity () + _state_size;
+	}
+
 protected:
 	MementoCommandBinder<obj_T>* _binder;
-	XMLNode* before;
-	XMLNode* after;
+	MementoStatePool::State before;
+	MementoStatePool::State after;
+	size_t _state_size;
 	PBD::ScopedConnection _binder_death_connection;
+
+private:
+	void set_states (XMLNode* a_before, XMLNode* a_after) {
+		bool shared;
+
+		/* a state shared with other commands is counted by each of
+		 * them, so that it remains accounted for as long as any
+		 * of them is kept.
+		 */
+		_state_size = 0;
+
+		if (a_before) {
+			before = MementoStatePool::share (a_before, shared);
+			_state_size += before->memory_use ();
+		}
+		if (a_after) {
+			after = MementoStatePool::share (a_after, shared);
+			if (after != before) {
+				_state_size += after->memory_use ();
+			}
+		}
+	}
 };
 
 #endif // __lib_pbd_memento_h__
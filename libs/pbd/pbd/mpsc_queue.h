@@ -0,0 +1,149 @@
+/*
+    Copyright (C) 2017 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __libpbd_mpsc_queue_h__
+#define __libpbd_mpsc_queue_h__
+
+#include <glib.h>
+
+#include "pbd/libpbd_visibility.h"
+
+namespace PBD {
+
+/** Bounded multi-producer, single-consumer FIFO.
+ *
+ * Any number of threads may write() concurrently without taking a lock;
+ * a single thread (e.g. the process thread) reads. Each slot carries a
+ * sequence number which tells the producers whether it is free and the
+ * consumer whether it has been filled (D. Vyukov's bounded queue).
+ *
+ * Elements are copied in and out, so T should be a small POD type.
+ */
+template<class T>
+class /*LIBPBD_API*/ MPSCQueue
+{
+  public:
+	MPSCQueue (guint sz) {
+		guint power_of_two;
+		for (power_of_two = 1; 1U<<power_of_two < sz; power_of_two++) {}
+		size = 1<<power_of_two;
+		size_mask = size - 1;
+		cells = new Cell[size];
+		reset ();
+	}
+
+	~MPSCQueue () {
+		delete [] cells;
+	}
+
+	void reset () {
+		/* !!! NOT THREAD SAFE !!! */
+		for (guint i = 0; i < size; ++i) {
+			g_atomic_int_set (&cells[i].seq, i);
+		}
+		g_atomic_int_set (&write_pos, 0);
+		g_atomic_int_set (&read_pos, 0);
+	}
+
+	guint bufsize () const { return size; }
+
+	/* any thread */
+
+	/** @return false if the queue is full */
+	bool write (T const& src) {
+		guint pos = g_atomic_int_get (&write_pos);
+		Cell* c;
+
+		for (;;) {
+			c = &cells[pos & size_mask];
+			const gint dif = (gint) ((guint) g_atomic_int_get (&c->seq) - pos);
+
+			if (dif == 0) {
+				/* slot is free, try to claim it */
+				if (g_atomic_int_compare_and_exchange (&write_pos, (gint) pos, (gint) (pos + 1))) {
+					break;
+				}
+			} else if (dif < 0) {
+				/* slot has not been read yet: full */
+				return false;
+			}
+			/* someone else was faster */
+			pos = g_atomic_int_get (&write_pos);
+		}
+
+		c->data = src;
+		/* publish */
+		g_atomic_int_set (&c->seq, (gint) (pos + 1));
+		return true;
+	}
+
+	/** approximate number of queued elements */
+	guint read_space () const {
+		return (guint) g_atomic_int_get (&write_pos) - (guint) g_atomic_int_get (&read_pos);
+	}
+
+	/* consumer thread only */
+
+	/** @return the @param n th readable element, or 0 if there are not
+	 * that many (completely written) elements.
+	 */
+	T* peek (guint n = 0) {
+		const guint pos = (guint) g_atomic_int_get (&read_pos) + n;
+		Cell* c = &cells[pos & size_mask];
+		if ((guint) g_atomic_int_get (&c->seq) != pos + 1) {
+			return 0;
+		}
+		return &c->data;
+	}
+
+	/** release @param n elements, which must have been peek()ed */
+	void increment_read_idx (guint n = 1) {
+		guint pos = g_atomic_int_get (&read_pos);
+		for (guint i = 0; i < n; ++i, ++pos) {
+			g_atomic_int_set (&cells[pos & size_mask].seq, (gint) (pos + size));
+		}
+		g_atomic_int_set (&read_pos, (gint) pos);
+	}
+
+	bool read (T& dst) {
+		T* p = peek ();
+		if (!p) {
+			return false;
+		}
+		dst = *p;
+		increment_read_idx ();
+		return true;
+	}
+
+  private:
+	struct Cell {
+		gint seq;
+		T    data;
+	};
+
+	Cell*         cells;
+	guint         size;
+	guint         size_mask;
+	gint          write_pos;
+	gint          read_pos;
+};
+
+} // namespace PBD
+
+#endif /* __libpbd_mpsc_queue_h__ */
@@ -129,6 +129,8 @@ public:
 
 	bool changed () const { return _have_old; }
 
+	size_t memory_use () const { return sizeof (*this); }
+
 	void invert () {
 		T const tmp = _current;
 		_current = _old;
@@ -300,6 +302,10 @@ public:
 		return new Property<std::string> (this->property_id(), _old, _current);
 	}
 
+	size_t memory_use () const {
+		return sizeof (*this) + _old.capacity () + _current.capacity ();
+	}
+
 	std::string & operator= (std::string const& v) {
 		this->set (v);
 		return this->_current;
@@ -148,6 +148,11 @@ public:
 
 	virtual PropertyBase* clone () const = 0;
 
+	/** @return approximate number of bytes used by this property,
+	 *  including its record of changes.
+	 */
+	virtual size_t memory_use () const { return sizeof (PropertyBase); }
+
 	/** Set this property's current state from another */
 	virtual void apply_changes (PropertyBase const *) = 0;
 
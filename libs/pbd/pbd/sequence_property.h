@@ -133,6 +133,13 @@ class /*LIBPBD_API*/ SequenceProperty : public PropertyBase
 		return !_changes.added.empty() || !_changes.removed.empty();
 	}
 
+	size_t memory_use () const {
+		/* container nodes: the value plus about three pointers */
+		return sizeof (*this)
+			+ (_val.size() + _changes.added.size() + _changes.removed.size())
+			* (sizeof (typename Container::value_type) + 3 * sizeof (void*));
+	}
+
 	void clear_changes () {
 		_changes.added.clear ();
 		_changes.removed.clear ();
@@ -49,6 +49,8 @@ public:
 
 	bool empty () const;
 
+	size_t memory_use () const;
+
 private:
 	boost::weak_ptr<Stateful> _object; ///< the object in question
         PBD::PropertyList* _changes; ///< property changes to execute this command
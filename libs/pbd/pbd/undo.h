@@ -57,6 +57,8 @@ class LIBPBD_API UndoTransaction : public Command
 
 	XMLNode &get_state();
 
+	size_t memory_use () const;
+
 	void set_timestamp (struct timeval &t) {
 		_timestamp = t;
 	}
@@ -108,6 +110,15 @@ class LIBPBD_API UndoHistory : public PBD::ScopedConnectionList
 
 	void set_depth (uint32_t);
 
+	/** Limit the (approximate) memory used by the undo list to @param bytes,
+	 * discarding the oldest transactions as necessary. 0 means no limit.
+	 */
+	void set_memory_budget (size_t bytes);
+	size_t memory_budget () const { return _memory_budget; }
+
+	/** @return approximate number of bytes used by the undo and redo lists */
+	size_t memory_use () const { return _memory_use; }
+
 	PBD::Signal0<void> Changed;
 	PBD::Signal0<void> BeginUndoRedo;
 	PBD::Signal0<void> EndUndoRedo;
@@ -115,10 +126,17 @@ class LIBPBD_API UndoHistory : public PBD::ScopedConnectionList
   private:
 	bool _clearing;
 	uint32_t _depth;
+	size_t _memory_budget;
+	size_t _memory_use;
 	std::list<UndoTransaction*> UndoList;
 	std::list<UndoTransaction*> RedoList;
 
+	/* memory use of each transaction, as accounted when it was added */
+	std::map<UndoTransaction const *, size_t> _transaction_memory;
+
 	void remove (UndoTransaction*);
+	void forget (UndoTransaction const *);
+	void trim_to_budget ();
 };
 
 
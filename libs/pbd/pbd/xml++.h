@@ -101,6 +101,13 @@ public:
 
 	XMLNode& operator= (const XMLNode& other);
 
+	/** deep comparison of name, content, properties (in order) and children */
+	bool operator== (const XMLNode& other) const;
+	bool operator!= (const XMLNode& other) const { return !(*this == other); }
+
+	/** @return approximate number of bytes used by this node and its children */
+	size_t memory_use () const;
+
 	const std::string& name() const { return _name; }
 
 	bool          is_content() const { return _is_content; }
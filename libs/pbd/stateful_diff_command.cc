@@ -122,3 +122,16 @@ StatefulDiffCommand::empty () const
 {
 	return _changes->empty();
 }
+
+size_t
+StatefulDiffCommand::memory_use () const
+{
+	size_t sz = sizeof (StatefulDiffCommand) + _name.capacity () + sizeof (PropertyList);
+
+	for (PropertyList::const_iterator i = _changes->begin(); i != _changes->end(); ++i) {
+		/* map node: the value plus about four pointers */
+		sz += sizeof (PropertyList::value_type) + 4 * sizeof (void*) + i->second->memory_use ();
+	}
+
+	return sz;
+}
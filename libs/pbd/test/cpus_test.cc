@@ -0,0 +1,37 @@
+#include <cstdio>
+
+#include "cpus_test.h"
+#include "pbd/cpus.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (CPUsTest);
+
+using namespace std;
+
+static string
+to_string (vector<uint32_t> const & v)
+{
+	string s;
+	for (vector<uint32_t>::const_iterator i = v.begin(); i != v.end(); ++i) {
+		char buf[16];
+		snprintf (buf, sizeof (buf), "%s%u", s.empty() ? "" : " ", *i);
+		s += buf;
+	}
+	return s;
+}
+
+void
+CPUsTest::testParseCPUList ()
+{
+	CPPUNIT_ASSERT_EQUAL (string (""), to_string (PBD::parse_cpu_list ("")));
+	CPPUNIT_ASSERT_EQUAL (string ("3"), to_string (PBD::parse_cpu_list ("3")));
+	CPPUNIT_ASSERT_EQUAL (string ("0 1 2 3"), to_string (PBD::parse_cpu_list ("0-3")));
+	CPPUNIT_ASSERT_EQUAL (string ("2 4 5 6 7"), to_string (PBD::parse_cpu_list ("2,4-7")));
+	CPPUNIT_ASSERT_EQUAL (string ("1 2 5"), to_string (PBD::parse_cpu_list (" 5 , 1-2,2 ")));
+
+	/* invalid lists */
+	CPPUNIT_ASSERT (PBD::parse_cpu_list ("a").empty ());
+	CPPUNIT_ASSERT (PBD::parse_cpu_list ("1,x").empty ());
+	CPPUNIT_ASSERT (PBD::parse_cpu_list ("4-2").empty ());
+	CPPUNIT_ASSERT (PBD::parse_cpu_list ("-1").empty ());
+	CPPUNIT_ASSERT (PBD::parse_cpu_list ("1-").empty ());
+}
@@ -0,0 +1,13 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class CPUsTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (CPUsTest);
+	CPPUNIT_TEST (testParseCPUList);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	CPUsTest () { }
+	void testParseCPUList ();
+};
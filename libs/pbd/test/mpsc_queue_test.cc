@@ -0,0 +1,103 @@
+#include <pthread.h>
+#include <sched.h>
+#include <vector>
+
+#include "mpsc_queue_test.h"
+#include "pbd/mpsc_queue.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MPSCQueueTest);
+
+using namespace std;
+
+struct Item {
+	int producer;
+	int n;
+};
+
+void
+MPSCQueueTest::testBasic ()
+{
+	PBD::MPSCQueue<Item> q (5);
+	CPPUNIT_ASSERT_EQUAL (8U, q.bufsize ());
+	CPPUNIT_ASSERT (q.peek () == 0);
+
+	Item it;
+	for (int i = 0; i < 8; ++i) {
+		it.producer = 0;
+		it.n = i;
+		CPPUNIT_ASSERT (q.write (it));
+	}
+	/* full */
+	CPPUNIT_ASSERT (!q.write (it));
+	CPPUNIT_ASSERT_EQUAL (8U, q.read_space ());
+
+	CPPUNIT_ASSERT (q.peek (7) != 0);
+	CPPUNIT_ASSERT (q.peek (8) == 0);
+	CPPUNIT_ASSERT_EQUAL (3, q.peek (3)->n);
+
+	q.increment_read_idx (2);
+	CPPUNIT_ASSERT_EQUAL (2, q.peek ()->n);
+
+	/* wrap around */
+	for (int i = 8; i < 100; ++i) {
+		it.n = i;
+		CPPUNIT_ASSERT (q.write (it));
+		Item out;
+		CPPUNIT_ASSERT (q.read (out));
+		CPPUNIT_ASSERT_EQUAL (i - 6, out.n);
+	}
+	CPPUNIT_ASSERT_EQUAL (6U, q.read_space ());
+}
+
+static const int n_producers = 4;
+static const int n_items = 20000;
+
+static void*
+produce (void* arg)
+{
+	pair<PBD::MPSCQueue<Item>*, int>* p = (pair<PBD::MPSCQueue<Item>*, int>*) arg;
+	Item it;
+	it.producer = p->second;
+	for (it.n = 0; it.n < n_items; ) {
+		if (p->first->write (it)) {
+			++it.n;
+		} else {
+			sched_yield ();
+		}
+	}
+	return 0;
+}
+
+void
+MPSCQueueTest::testThreads ()
+{
+	PBD::MPSCQueue<Item> q (256);
+	pthread_t threads[n_producers];
+	pair<PBD::MPSCQueue<Item>*, int> args[n_producers];
+
+	for (int i = 0; i < n_producers; ++i) {
+		args[i] = make_pair (&q, i);
+		pthread_create (&threads[i], 0, produce, &args[i]);
+	}
+
+	/* every producer's items must arrive complete and in order */
+	vector<int> next (n_producers, 0);
+	int received = 0;
+
+	while (received < n_producers * n_items) {
+		Item it;
+		if (!q.read (it)) {
+			sched_yield ();
+			continue;
+		}
+		CPPUNIT_ASSERT (it.producer >= 0 && it.producer < n_producers);
+		CPPUNIT_ASSERT_EQUAL (next[it.producer], it.n);
+		++next[it.producer];
+		++received;
+	}
+
+	for (int i = 0; i < n_producers; ++i) {
+		pthread_join (threads[i], 0);
+	}
+	CPPUNIT_ASSERT (q.peek () == 0);
+}
@@ -0,0 +1,114 @@
+#include <stdlib.h>
+#include <string>
+
+#include "undo_test.h"
+#include "pbd/memento_command.h"
+#include "pbd/statefuldestructible.h"
+#include "pbd/undo.h"
+#include "pbd/xml++.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (UndoTest);
+
+using namespace std;
+using namespace PBD;
+
+namespace {
+
+/* an object with a large state, like an automation list */
+class Thing : public StatefulDestructible
+{
+public:
+	Thing () : value (0) {}
+	~Thing () { drop_references (); }
+
+	XMLNode& get_state () {
+		XMLNode* node = new XMLNode ("Thing");
+		node->add_property ("id", id().to_s());
+		node->add_property ("value", (long) value);
+		node->add_child ("Events")->add_content (string (4096, 'x'));
+		return *node;
+	}
+
+	int set_state (XMLNode const & node, int) {
+		XMLProperty const * prop = node.property ("value");
+		if (prop) {
+			value = atoi (prop->value().c_str());
+		}
+		return 0;
+	}
+
+	int value;
+};
+
+UndoTransaction*
+change (Thing& thing, int value)
+{
+	XMLNode& before = thing.get_state ();
+	thing.value = value;
+	UndoTransaction* ut = new UndoTransaction;
+	ut->add_command (new MementoCommand<Thing> (thing, &before, &thing.get_state ()));
+	return ut;
+}
+
+}
+
+void
+UndoTest::testSharedStates ()
+{
+	Thing thing;
+	UndoHistory history;
+
+	history.add (change (thing, 1));
+	size_t const first = history.memory_use ();
+
+	/* the "before" state of the second change is the "after" state of
+	 * the first one; it is stored once but accounted to both commands.
+	 */
+	history.add (change (thing, 2));
+	size_t const second = history.memory_use () - first;
+	CPPUNIT_ASSERT (second > first * 3 / 4 && second < first * 5 / 4);
+
+	/* dropping the first change must leave the shared state accounted */
+	history.set_memory_budget (second);
+	CPPUNIT_ASSERT_EQUAL (1UL, history.undo_depth ());
+	CPPUNIT_ASSERT_EQUAL (second, history.memory_use ());
+	CPPUNIT_ASSERT (history.memory_use () > 2 * 4096);
+
+	history.set_memory_budget (0);
+	history.add (change (thing, 3));
+	history.undo (2);
+	CPPUNIT_ASSERT_EQUAL (1, thing.value);
+	history.redo (1);
+	CPPUNIT_ASSERT_EQUAL (2, thing.value);
+	history.undo (1);
+	CPPUNIT_ASSERT_EQUAL (1, thing.value);
+	history.redo (2);
+	CPPUNIT_ASSERT_EQUAL (3, thing.value);
+}
+
+void
+UndoTest::testMemoryBudget ()
+{
+	Thing thing;
+	UndoHistory history;
+
+	for (int i = 1; i <= 100; ++i) {
+		history.add (change (thing, i));
+	}
+	CPPUNIT_ASSERT_EQUAL (100UL, history.undo_depth ());
+
+	size_t const per_change = history.memory_use () / 100;
+
+	history.set_memory_budget (per_change * 10);
+	CPPUNIT_ASSERT (history.memory_use () <= per_change * 10);
+	CPPUNIT_ASSERT (history.undo_depth () >= 8 && history.undo_depth () <= 10);
+
+	history.add (change (thing, 101));
+	CPPUNIT_ASSERT (history.memory_use () <= per_change * 10);
+
+	/* the newest change can always be undone */
+	history.set_memory_budget (1);
+	CPPUNIT_ASSERT_EQUAL (1UL, history.undo_depth ());
+	history.undo (1);
+	CPPUNIT_ASSERT_EQUAL (100, thing.value);
+}
@@ -0,0 +1,14 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class UndoTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (UndoTest);
+	CPPUNIT_TEST (testSharedStates);
+	CPPUNIT_TEST (testMemoryBudget);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void testSharedStates ();
+	void testMemoryBudget ();
+};
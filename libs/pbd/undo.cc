@@ -18,6 +18,7 @@
     $Id$
 */
 
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <time.h>
@@ -150,6 +151,18 @@ XMLNode &UndoTransaction::get_state()
     return *node;
 }
 
+size_t
+UndoTransaction::memory_use () const
+{
+	size_t sz = sizeof (UndoTransaction) + _name.capacity ();
+
+	for (list<Command*>::const_iterator i = actions.begin(); i != actions.end(); ++i) {
+		sz += (*i)->memory_use () + 2 * sizeof (void*);
+	}
+
+	return sz;
+}
+
 class UndoRedoSignaller {
 public:
     UndoRedoSignaller (UndoHistory& uh)
@@ -168,6 +181,8 @@ UndoHistory::UndoHistory ()
 {
 	_clearing = false;
 	_depth = 0;
+	_memory_budget = 0;
+	_memory_use = 0;
 }
 
 void
@@ -190,11 +205,48 @@ UndoHistory::set_depth (uint32_t d)
 		while (cnt--) {
 			ut = UndoList.front();
 			UndoList.pop_front ();
+			forget (ut);
 			delete ut;
 		}
 	}
 }
 
+void
+UndoHistory::set_memory_budget (size_t bytes)
+{
+	_memory_budget = bytes;
+	trim_to_budget ();
+}
+
+/** Stop accounting for a transaction which is about to be deleted */
+void
+UndoHistory::forget (UndoTransaction const * ut)
+{
+	std::map<UndoTransaction const *, size_t>::iterator i = _transaction_memory.find (ut);
+
+	if (i != _transaction_memory.end()) {
+		_memory_use -= std::min (_memory_use, i->second);
+		_transaction_memory.erase (i);
+	}
+}
+
+void
+UndoHistory::trim_to_budget ()
+{
+	if (_memory_budget == 0) {
+		return;
+	}
+
+	/* always keep the most recent transaction */
+
+	while (_memory_use > _memory_budget && UndoList.size() > 1) {
+		UndoTransaction* ut = UndoList.front ();
+		UndoList.pop_front ();
+		forget (ut);
+		delete ut;
+	}
+}
+
 void
 UndoHistory::add (UndoTransaction* const ut)
 {
@@ -215,19 +267,28 @@ UndoHistory::add (UndoTransaction* const ut)
 			UndoTransaction* ut;
 			ut = UndoList.front ();
 			UndoList.pop_front ();
+			forget (ut);
 			delete ut;
 		}
 	}
 
 	UndoList.push_back (ut);
+
+	const size_t sz = ut->memory_use ();
+	_transaction_memory[ut] = sz;
+	_memory_use += sz;
+
 	/* Adding a transacrion makes the redo list meaningless. */
 	_clearing = true;
 	for (std::list<UndoTransaction*>::iterator i = RedoList.begin(); i != RedoList.end(); ++i) {
+		forget (*i);
                 delete *i;
         }
 	RedoList.clear ();
 	_clearing = false;
 
+	trim_to_budget ();
+
 	/* we are now owners of the transaction and must delete it when finished with it */
 
 	Changed (); /* EMIT SIGNAL */
@@ -242,6 +303,7 @@ UndoHistory::remove (UndoTransaction* const ut)
 
 	UndoList.remove (ut);
 	RedoList.remove (ut);
+	forget (ut);
 
 	Changed (); /* EMIT SIGNAL */
 }
@@ -302,6 +364,7 @@ UndoHistory::clear_redo ()
 {
 	_clearing = true;
         for (std::list<UndoTransaction*>::iterator i = RedoList.begin(); i != RedoList.end(); ++i) {
+		forget (*i);
                 delete *i;
         }
 	RedoList.clear ();
@@ -316,6 +379,7 @@ UndoHistory::clear_undo ()
 {
 	_clearing = true;
         for (std::list<UndoTransaction*>::iterator i = UndoList.begin(); i != UndoList.end(); ++i) {
+		forget (*i);
                 delete *i;
         }
 	UndoList.clear ();
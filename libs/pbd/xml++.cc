@@ -289,6 +289,54 @@ XMLNode::operator= (const XMLNode& from)
 	return *this;
 }
 
+bool
+XMLNode::operator== (const XMLNode& other) const
+{
+	if (this == &other) {
+		return true;
+	}
+
+	if (_name != other._name || _is_content != other._is_content || _content != other._content) {
+		return false;
+	}
+
+	if (_proplist.size() != other._proplist.size() || _children.size() != other._children.size()) {
+		return false;
+	}
+
+	for (XMLPropertyConstIterator a = _proplist.begin(), b = other._proplist.begin(); a != _proplist.end(); ++a, ++b) {
+		if ((*a)->name() != (*b)->name() || (*a)->value() != (*b)->value()) {
+			return false;
+		}
+	}
+
+	for (XMLNodeConstIterator a = _children.begin(), b = other._children.begin(); a != _children.end(); ++a, ++b) {
+		if (**a != **b) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+size_t
+XMLNode::memory_use () const
+{
+	size_t sz = sizeof (XMLNode) + _name.capacity() + _content.capacity();
+
+	for (XMLPropertyConstIterator i = _proplist.begin(); i != _proplist.end(); ++i) {
+		/* the property, its entry in the list and in the map */
+		sz += sizeof (XMLProperty) + (*i)->name().capacity() + (*i)->value().capacity();
+		sz += sizeof (XMLProperty*) + sizeof (XMLPropertyMap::value_type) + 4 * sizeof (void*);
+	}
+
+	for (XMLNodeConstIterator i = _children.begin(); i != _children.end(); ++i) {
+		sz += sizeof (XMLNode*) + (*i)->memory_use ();
+	}
+
+	return sz;
+}
+
 const string&
 XMLNode::set_content(const string& c)
 {
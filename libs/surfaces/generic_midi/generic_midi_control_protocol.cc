@@ -48,6 +48,7 @@
 #include "midicontrollable.h"
 #include "midifunction.h"
 #include "midiaction.h"
+#include "mididispatch.h"
 
 using namespace ARDOUR;
 using namespace PBD;
@@ -67,6 +68,8 @@ GenericMidiControlProtocol::GenericMidiControlProtocol (Session& s)
 	_input_port = boost::dynamic_pointer_cast<AsyncMIDIPort> (s.midi_input_port ());
 	_output_port = boost::dynamic_pointer_cast<AsyncMIDIPort> (s.midi_output_port ());
 
+	_dispatch_table = new MIDIDispatchTable (*_input_port->parser());
+
 	_input_bundle.reset (new ARDOUR::Bundle (_("Generic MIDI Control In"), true));
 	_output_bundle.reset (new ARDOUR::Bundle (_("Generic MIDI Control Out"), false));
 
@@ -125,6 +128,7 @@ GenericMidiControlProtocol::~GenericMidiControlProtocol ()
 {
 	drop_all ();
 	tear_down_gui ();
+	delete _dispatch_table;
 }
 
 list<boost::shared_ptr<ARDOUR::Bundle> >
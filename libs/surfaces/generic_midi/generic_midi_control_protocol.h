@@ -46,6 +46,7 @@ namespace MIDI {
 class MIDIControllable;
 class MIDIFunction;
 class MIDIAction;
+class MIDIDispatchTable;
 
 class GenericMidiControlProtocol : public ARDOUR::ControlProtocol {
   public:
@@ -79,6 +80,9 @@ class GenericMidiControlProtocol : public ARDOUR::ControlProtocol {
 
 	void check_used_event (int, int);
 
+	/** routes incoming messages to bindings, see MIDIControllable::bind_midi() */
+	MIDIDispatchTable& dispatch_table () { return *_dispatch_table; }
+
 	std::string current_binding() const { return _current_binding; }
 
 	struct MapInfo {
@@ -120,6 +124,8 @@ class GenericMidiControlProtocol : public ARDOUR::ControlProtocol {
 	void _send_feedback ();
 	void  send_feedback ();
 
+	MIDIDispatchTable* _dispatch_table;
+
 	typedef std::list<MIDIControllable*> MIDIControllables;
 	MIDIControllables controllables;
 
@@ -108,6 +108,9 @@ MIDIControllable::midi_forget ()
 	   our existing event + type information.
 	*/
 
+	if (_surface) {
+		_surface->dispatch_table().remove (this);
+	}
 	midi_sense_connection[0].disconnect ();
 	midi_sense_connection[1].disconnect ();
 	midi_learn_connection.disconnect ();
@@ -562,42 +565,44 @@ MIDIControllable::bind_midi (channel_t chn, eventType ev, MIDI::byte additional)
 	control_additional = additional;
 
 	int chn_i = chn;
+	MIDIDispatchTable& table (_surface->dispatch_table());
+
 	switch (ev) {
 	case MIDI::off:
-		_parser.channel_note_off[chn_i].connect_same_thread (midi_sense_connection[0], boost::bind (&MIDIControllable::midi_sense_note_off, this, _1, _2));
+		table.add (this, chn, MIDI::off, additional);
 
 		/* if this is a togglee, connect to noteOn as well,
 		   and we'll toggle back and forth between the two.
 		*/
 
 		if (_momentary) {
-			_parser.channel_note_on[chn_i].connect_same_thread (midi_sense_connection[1], boost::bind (&MIDIControllable::midi_sense_note_on, this, _1, _2));
+			table.add (this, chn, MIDI::on, additional);
 		}
 
 		_control_description = "MIDI control: NoteOff";
 		break;
 
 	case MIDI::on:
-		_parser.channel_note_on[chn_i].connect_same_thread (midi_sense_connection[0], boost::bind (&MIDIControllable::midi_sense_note_on, this, _1, _2));
+		table.add (this, chn, MIDI::on, additional);
 		if (_momentary) {
-			_parser.channel_note_off[chn_i].connect_same_thread (midi_sense_connection[1], boost::bind (&MIDIControllable::midi_sense_note_off, this, _1, _2));
+			table.add (this, chn, MIDI::off, additional);
 		}
 		_control_description = "MIDI control: NoteOn";
 		break;
 
 	case MIDI::controller:
-		_parser.channel_controller[chn_i].connect_same_thread (midi_sense_connection[0], boost::bind (&MIDIControllable::midi_sense_controller, this, _1, _2));
+		table.add (this, chn, MIDI::controller, additional);
 		snprintf (buf, sizeof (buf), "MIDI control: Controller %d", control_additional);
 		_control_description = buf;
 		break;
 
 	case MIDI::program:
-		_parser.channel_program_change[chn_i].connect_same_thread (midi_sense_connection[0], boost::bind (&MIDIControllable::midi_sense_program_change, this, _1, _2));
+		table.add (this, chn, MIDI::program, additional);
 		_control_description = "MIDI control: ProgramChange";
 		break;
 
 	case MIDI::pitchbend:
-		_parser.channel_pitchbend[chn_i].connect_same_thread (midi_sense_connection[0], boost::bind (&MIDIControllable::midi_sense_pitchbend, this, _1, _2));
+		table.add (this, chn, MIDI::pitchbend, additional);
 		_control_description = "MIDI control: Pitchbend";
 		break;
 
@@ -30,6 +30,8 @@
 
 #include "ardour/types.h"
 
+#include "mididispatch.h"
+
 namespace ARDOUR {
 	class ControllableDescriptor;
 }
@@ -45,7 +47,7 @@ namespace ARDOUR {
 	class AsyncMIDIPort;
 }
 
-class MIDIControllable : public PBD::Stateful
+class MIDIControllable : public PBD::Stateful, public MIDIDispatchTarget
 {
   public:
         MIDIControllable (GenericMidiControlProtocol *, MIDI::Parser&, PBD::Controllable&, bool momentary);
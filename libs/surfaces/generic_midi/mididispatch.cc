@@ -0,0 +1,225 @@
+/*
+    Copyright (C) 2017 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include <algorithm>
+
+#include "midi++/parser.h"
+
+#include "mididispatch.h"
+
+using namespace MIDI;
+
+MIDIDispatchTable::MIDIDispatchTable (Parser& p)
+	: n_bindings (0)
+{
+	for (int i = 0; i < n_rows; ++i) {
+		rows[i] = 0;
+	}
+
+	/* incoming MIDI is parsed by Ardour's MidiUI event loop/thread, and
+	 * bindings execute in that context, so use connect_same_thread()
+	 */
+
+	for (int chn = 0; chn < 16; ++chn) {
+		p.channel_note_on[chn].connect_same_thread (parser_connections, boost::bind (&MIDIDispatchTable::note_on, this, _1, _2, chn));
+		p.channel_note_off[chn].connect_same_thread (parser_connections, boost::bind (&MIDIDispatchTable::note_off, this, _1, _2, chn));
+		p.channel_controller[chn].connect_same_thread (parser_connections, boost::bind (&MIDIDispatchTable::controller, this, _1, _2, chn));
+		p.channel_program_change[chn].connect_same_thread (parser_connections, boost::bind (&MIDIDispatchTable::program_change, this, _1, _2, chn));
+		p.channel_pitchbend[chn].connect_same_thread (parser_connections, boost::bind (&MIDIDispatchTable::pitchbend, this, _1, _2, chn));
+	}
+}
+
+MIDIDispatchTable::~MIDIDispatchTable ()
+{
+	parser_connections.drop_connections ();
+
+	for (int i = 0; i < n_rows; ++i) {
+		delete [] rows[i];
+	}
+}
+
+int
+MIDIDispatchTable::key (eventType ev, channel_t chn, MIDI::byte additional)
+{
+	const int type = ((ev & 0xf0) >> 4) - 8;
+
+	if (type < 0 || type > 6) {
+		return -1;
+	}
+	if (ev == MIDI::pitchbend) {
+		additional = 0;
+	}
+	return ((type * 16) + (chn & 0xf)) * 128 + (additional & 0x7f);
+}
+
+void
+MIDIDispatchTable::add (MIDIDispatchTarget* t, channel_t chn, eventType ev, MIDI::byte additional)
+{
+	const int k = key (ev, chn, additional);
+
+	if (k < 0) {
+		return;
+	}
+
+	Glib::Threads::Mutex::Lock lm (lock);
+
+	Targets*& row (rows[k / 128]);
+
+	if (!row) {
+		row = new Targets[128];
+	}
+
+	Targets& targets (row[k % 128]);
+
+	if (std::find (targets.begin(), targets.end(), t) != targets.end()) {
+		return;
+	}
+
+	targets.push_back (t);
+	keys[t].push_back (k);
+	++n_bindings;
+}
+
+void
+MIDIDispatchTable::remove (MIDIDispatchTarget* t)
+{
+	Glib::Threads::Mutex::Lock lm (lock);
+
+	Keys::iterator i = keys.find (t);
+
+	if (i == keys.end()) {
+		return;
+	}
+
+	for (std::vector<int>::const_iterator k = i->second.begin(); k != i->second.end(); ++k) {
+		Targets& targets (rows[*k / 128][*k % 128]);
+		Targets::iterator x = std::find (targets.begin(), targets.end(), t);
+		if (x != targets.end()) {
+			targets.erase (x);
+			--n_bindings;
+		}
+	}
+
+	keys.erase (i);
+}
+
+size_t
+MIDIDispatchTable::size () const
+{
+	Glib::Threads::Mutex::Lock lm (lock);
+	return n_bindings;
+}
+
+bool
+MIDIDispatchTable::lookup (int k)
+{
+	Glib::Threads::Mutex::Lock lm (lock);
+
+	Targets* row = rows[k / 128];
+
+	if (!row || row[k % 128].empty()) {
+		return false;
+	}
+
+	/* handlers may add or remove bindings (e.g. bank changes), so
+	 * work on a copy and re-check each target before calling it.
+	 * The copy re-uses its storage, no allocation after the first few
+	 * messages.
+	 */
+	current = row[k % 128];
+	return true;
+}
+
+bool
+MIDIDispatchTable::bound (MIDIDispatchTarget* t, int k) const
+{
+	Glib::Threads::Mutex::Lock lm (lock);
+	Targets const& targets (rows[k / 128][k % 128]);
+	return std::find (targets.begin(), targets.end(), t) != targets.end();
+}
+
+void
+MIDIDispatchTable::note_on (Parser& p, EventTwoBytes* tb, int chn)
+{
+	const int k = key (MIDI::on, chn, tb->note_number);
+	if (!lookup (k)) {
+		return;
+	}
+	for (Targets::const_iterator t = current.begin(); t != current.end(); ++t) {
+		if (bound (*t, k)) {
+			(*t)->midi_sense_note_on (p, tb);
+		}
+	}
+}
+
+void
+MIDIDispatchTable::note_off (Parser& p, EventTwoBytes* tb, int chn)
+{
+	const int k = key (MIDI::off, chn, tb->note_number);
+	if (!lookup (k)) {
+		return;
+	}
+	for (Targets::const_iterator t = current.begin(); t != current.end(); ++t) {
+		if (bound (*t, k)) {
+			(*t)->midi_sense_note_off (p, tb);
+		}
+	}
+}
+
+void
+MIDIDispatchTable::controller (Parser& p, EventTwoBytes* tb, int chn)
+{
+	const int k = key (MIDI::controller, chn, tb->controller_number);
+	if (!lookup (k)) {
+		return;
+	}
+	for (Targets::const_iterator t = current.begin(); t != current.end(); ++t) {
+		if (bound (*t, k)) {
+			(*t)->midi_sense_controller (p, tb);
+		}
+	}
+}
+
+void
+MIDIDispatchTable::program_change (Parser& p, MIDI::byte b, int chn)
+{
+	const int k = key (MIDI::program, chn, b);
+	if (!lookup (k)) {
+		return;
+	}
+	for (Targets::const_iterator t = current.begin(); t != current.end(); ++t) {
+		if (bound (*t, k)) {
+			(*t)->midi_sense_program_change (p, b);
+		}
+	}
+}
+
+void
+MIDIDispatchTable::pitchbend (Parser& p, pitchbend_t pb, int chn)
+{
+	const int k = key (MIDI::pitchbend, chn, 0);
+	if (!lookup (k)) {
+		return;
+	}
+	for (Targets::const_iterator t = current.begin(); t != current.end(); ++t) {
+		if (bound (*t, k)) {
+			(*t)->midi_sense_pitchbend (p, pb);
+		}
+	}
+}
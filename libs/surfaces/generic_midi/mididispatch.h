@@ -0,0 +1,103 @@
+/*
+    Copyright (C) 2017 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __gm_mididispatch_h__
+#define __gm_mididispatch_h__
+
+#include <map>
+#include <vector>
+
+#include <glibmm/threads.h>
+
+#include "midi++/types.h"
+#include "pbd/signals.h"
+
+namespace MIDI {
+	class Parser;
+}
+
+/** Something that can be bound to incoming channel messages */
+class MIDIDispatchTarget
+{
+  public:
+	virtual ~MIDIDispatchTarget () {}
+
+	virtual void midi_sense_note_on (MIDI::Parser&, MIDI::EventTwoBytes*) {}
+	virtual void midi_sense_note_off (MIDI::Parser&, MIDI::EventTwoBytes*) {}
+	virtual void midi_sense_controller (MIDI::Parser&, MIDI::EventTwoBytes*) {}
+	virtual void midi_sense_program_change (MIDI::Parser&, MIDI::byte) {}
+	virtual void midi_sense_pitchbend (MIDI::Parser&, MIDI::pitchbend_t) {}
+};
+
+/** Routes channel messages from a parser to the targets bound to them.
+ *
+ * Instead of every binding connecting to the parser's per-channel signals
+ * (and every binding on a channel being called for every message on that
+ * channel), the table connects once and looks up the bindings for
+ * (message type, channel, note/controller/program) directly.
+ *
+ * Targets may be added and removed from any thread; dispatch happens in
+ * the thread that runs the parser (the MIDI UI).
+ */
+class MIDIDispatchTable
+{
+  public:
+	MIDIDispatchTable (MIDI::Parser&);
+	~MIDIDispatchTable ();
+
+	/** bind @param t to the given message. For pitchbend @param additional is ignored.
+	 * Only note on/off, controller, program change and pitchbend are supported.
+	 */
+	void add (MIDIDispatchTarget* t, MIDI::channel_t, MIDI::eventType, MIDI::byte additional);
+	/** remove all bindings of @param t */
+	void remove (MIDIDispatchTarget* t);
+
+	/** number of bindings (a target may have more than one) */
+	size_t size () const;
+
+  private:
+	typedef std::vector<MIDIDispatchTarget*> Targets;
+
+	/* 7 channel message types x 16 channels, each with 128 values */
+	static const int n_rows = 7 * 16;
+	Targets* rows[n_rows];
+
+	/* keys of each target, for removal */
+	typedef std::map<MIDIDispatchTarget*, std::vector<int> > Keys;
+	Keys keys;
+
+	mutable Glib::Threads::Mutex lock;
+	size_t n_bindings;
+
+	Targets current; // targets of the message being dispatched, MIDI UI thread only
+
+	PBD::ScopedConnectionList parser_connections;
+
+	static int key (MIDI::eventType, MIDI::channel_t, MIDI::byte);
+	bool lookup (int key);
+	bool bound (MIDIDispatchTarget*, int key) const;
+
+	void note_on (MIDI::Parser&, MIDI::EventTwoBytes*, int chn);
+	void note_off (MIDI::Parser&, MIDI::EventTwoBytes*, int chn);
+	void controller (MIDI::Parser&, MIDI::EventTwoBytes*, int chn);
+	void program_change (MIDI::Parser&, MIDI::byte, int chn);
+	void pitchbend (MIDI::Parser&, MIDI::pitchbend_t, int chn);
+};
+
+#endif // __gm_mididispatch_h__
@@ -26,7 +26,8 @@
 using namespace MIDI;
 
 MIDIInvokable::MIDIInvokable (MIDI::Parser& p)
-	: _parser (p)
+	: _ui (0)
+	, _parser (p)
 {
 	data_size = 0;
 	data = 0;
@@ -34,6 +35,9 @@ MIDIInvokable::MIDIInvokable (MIDI::Parser& p)
 
 MIDIInvokable::~MIDIInvokable ()
 {
+	if (_ui) {
+		_ui->dispatch_table().remove (this);
+	}
 	delete [] data;
 }
 
@@ -122,32 +126,25 @@ MIDIInvokable::bind_midi (channel_t chn, eventType ev, MIDI::byte additional)
 {
 	midi_sense_connection[0].disconnect ();
 	midi_sense_connection[1].disconnect ();
+	_ui->dispatch_table().remove (this);
 
 	control_type = ev;
 	control_channel = chn;
 	control_additional = additional;
 
-	int chn_i = chn;
+	/* channel messages are routed by the surface's dispatch table, sysex
+	   and raw data are matched here.
 
-	/* incoming MIDI is parsed by Ardour' MidiUI event loop/thread, and we want our handlers to execute in that context, so we use
+	   incoming MIDI is parsed by Ardour' MidiUI event loop/thread, and we want our handlers to execute in that context, so we use
 	   Signal::connect_same_thread() here.
 	*/
 
 	switch (ev) {
 	case MIDI::off:
-		_parser.channel_note_off[chn_i].connect_same_thread (midi_sense_connection[0], boost::bind (&MIDIInvokable::midi_sense_note_off, this, _1, _2));
-		break;
-
 	case MIDI::on:
-		_parser.channel_note_on[chn_i].connect_same_thread (midi_sense_connection[0], boost::bind (&MIDIInvokable::midi_sense_note_on, this, _1, _2));
-		break;
-
 	case MIDI::controller:
-		_parser.channel_controller[chn_i].connect_same_thread (midi_sense_connection[0], boost::bind (&MIDIInvokable::midi_sense_controller, this, _1, _2));
-		break;
-
 	case MIDI::program:
-		_parser.channel_program_change[chn_i].connect_same_thread (midi_sense_connection[0], boost::bind (&MIDIInvokable::midi_sense_program_change, this, _1, _2));
+		_ui->dispatch_table().add (this, chn, ev, additional);
 		break;
 
 	case MIDI::sysex:
@@ -162,4 +159,3 @@ MIDIInvokable::bind_midi (channel_t chn, eventType ev, MIDI::byte additional)
 		break;
 	}
 }
-
@@ -29,6 +29,8 @@
 
 #include "ardour/types.h"
 
+#include "mididispatch.h"
+
 namespace MIDI {
 	class Channel;
 	class Parser;
@@ -36,7 +38,7 @@ namespace MIDI {
 
 class GenericMidiControlProtocol;
 
-class MIDIInvokable : public PBD::Stateful
+class MIDIInvokable : public PBD::Stateful, public MIDIDispatchTarget
 {
   public:
 	MIDIInvokable (MIDI::Parser&);
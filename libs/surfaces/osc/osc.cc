@@ -40,6 +40,7 @@
 #include "ardour/midi_track.h"
 #include "ardour/monitor_control.h"
 #include "ardour/dB.h"
+#include "ardour/dsp_stats.h"
 #include "ardour/filesystem_paths.h"
 #include "ardour/panner.h"
 #include "ardour/plugin.h"
@@ -56,6 +57,7 @@
 #include "osc_controllable.h"
 #include "osc_route_observer.h"
 #include "osc_global_observer.h"
+#include "osc_feedback.h"
 #include "pbd/i18n.h"
 
 using namespace ARDOUR;
@@ -372,6 +374,12 @@ OSC::stop ()
 			delete so;
 		}
 	}
+	// send what the observers left behind, then drop the queues
+	for (FeedbackQueues::iterator x = feedback_queues.begin(); x != feedback_queues.end(); ++x) {
+		x->second->flush (true);
+		delete x->second;
+	}
+	feedback_queues.clear ();
 
 	return 0;
 }
@@ -404,6 +412,9 @@ OSC::register_callbacks()
 		REGISTER_CALLBACK (serv, "/set_surface/bank_size", "i", set_surface_bank_size);
 		REGISTER_CALLBACK (serv, "/set_surface/gainmode", "i", set_surface_gainmode);
 		REGISTER_CALLBACK (serv, "/set_surface/strip_types", "i", set_surface_strip_types);
+		REGISTER_CALLBACK (serv, "/set_surface/feedback_rate", "f", set_surface_feedback_rate);
+		REGISTER_CALLBACK (serv, "/set_surface/feedback_threshold", "f", set_surface_feedback_threshold);
+		REGISTER_CALLBACK (serv, "/feedback/stats", "", feedback_stats);
 		REGISTER_CALLBACK (serv, "/refresh", "", refresh_surface);
 		REGISTER_CALLBACK (serv, "/refresh", "f", refresh_surface);
 		REGISTER_CALLBACK (serv, "/strip/list", "", routes_list);
@@ -593,6 +604,8 @@ OSC::register_callbacks()
 		REGISTER_CALLBACK (serv, "/strip/plugin/parameter", "iiif", route_plugin_parameter);
 		// prints to cerr only
 		REGISTER_CALLBACK (serv, "/strip/plugin/parameter/print", "iii", route_plugin_parameter_print);
+		REGISTER_CALLBACK (serv, "/strip/dsp_stats", "i", route_dsp_stats);
+		REGISTER_CALLBACK (serv, "/strip/plugin/dsp_stats", "ii", route_plugin_dsp_stats);
 		REGISTER_CALLBACK (serv, "/strip/send/gain", "iif", route_set_send_gain_dB);
 		REGISTER_CALLBACK (serv, "/strip/send/fader", "iif", route_set_send_fader);
 		REGISTER_CALLBACK (serv, "/strip/send/enable", "iif", route_set_send_enable);
@@ -682,7 +695,7 @@ OSC::listen_to_route (boost::shared_ptr<Stripable> strip, lo_address addr)
 
 	OSCSurface *s = get_surface(addr);
 	uint32_t ssid = get_sid (strip, addr);
-	OSCRouteObserver* o = new OSCRouteObserver (strip, addr, ssid, s->gainmode, s->feedback);
+	OSCRouteObserver* o = new OSCRouteObserver (strip, addr, feedback_for (addr), ssid, s->gainmode, s->feedback);
 	route_observers.push_back (o);
 
 	strip->DropReferences.connect (*this, MISSING_INVALIDATOR, boost::bind (&OSC::route_lost, this, boost::weak_ptr<Stripable> (strip)), this);
@@ -1280,6 +1293,53 @@ OSC::set_surface (uint32_t b_size, uint32_t strips, uint32_t fb, uint32_t gm, lo
 	return 0;
 }
 
+int
+OSC::set_surface_feedback_rate (float hz, lo_message msg)
+{
+	feedback_for (get_address (msg)).set_max_rate (std::max (0.f, hz));
+	return 0;
+}
+
+int
+OSC::set_surface_feedback_threshold (float delta, lo_message msg)
+{
+	feedback_for (get_address (msg)).set_threshold (std::max (0.f, delta));
+	return 0;
+}
+
+/* reply: messages bundles bytes, sent to this client since the queue was created */
+int
+OSC::feedback_stats (lo_message msg)
+{
+	OSCFeedback& fb (feedback_for (get_address (msg)));
+
+	lo_message reply = lo_message_new ();
+	lo_message_add_int64 (reply, fb.messages_sent ());
+	lo_message_add_int64 (reply, fb.bundles_sent ());
+	lo_message_add_int64 (reply, fb.bytes_sent ());
+
+	lo_send_message (get_address (msg), "/feedback/stats", reply);
+
+	lo_message_free (reply);
+	return 0;
+}
+
+OSCFeedback&
+OSC::feedback_for (lo_address addr)
+{
+	char* rurl = lo_address_get_url (addr);
+	string url = rurl;
+	free (rurl);
+
+	FeedbackQueues::iterator i = feedback_queues.find (url);
+	if (i != feedback_queues.end ()) {
+		return *i->second;
+	}
+	OSCFeedback* fb = new OSCFeedback (addr);
+	feedback_queues.insert (make_pair (url, fb));
+	return *fb;
+}
+
 int
 OSC::set_surface_bank_size (uint32_t bs, lo_message msg)
 {
@@ -2722,6 +2782,71 @@ OSC::route_plugin_parameter_print (int ssid, int piid, int par, lo_message msg)
 	return 0;
 }
 
+int
+OSC::route_dsp_stats (int ssid, lo_message msg)
+{
+	if (!session) {
+		return -1;
+	}
+	boost::shared_ptr<Route> r = boost::dynamic_pointer_cast<Route> (get_strip (ssid, get_address (msg)));
+
+	if (!r) {
+		return -1;
+	}
+
+	send_dsp_stats ("/strip/dsp_stats", r->dsp_stats (), ssid, -1, msg);
+	return 0;
+}
+
+int
+OSC::route_plugin_dsp_stats (int ssid, int piid, lo_message msg)
+{
+	if (!session) {
+		return -1;
+	}
+	boost::shared_ptr<Route> r = boost::dynamic_pointer_cast<Route> (get_strip (ssid, get_address (msg)));
+
+	if (!r) {
+		PBD::error << "OSC: Invalid Remote Control ID '" << ssid << "'" << endmsg;
+		return -1;
+	}
+
+	boost::shared_ptr<Processor> redi = r->nth_plugin (piid);
+
+	if (!redi) {
+		PBD::error << "OSC: cannot find plugin # " << piid << " for RID '" << ssid << "'" << endmsg;
+		return -1;
+	}
+
+	send_dsp_stats ("/strip/plugin/dsp_stats", redi->dsp_stats (), ssid, piid, msg);
+	return 0;
+}
+
+/* reply: ssid [piid] count min avg max p99, times in microseconds */
+void
+OSC::send_dsp_stats (const char* path, DSPStats& stats, int ssid, int piid, lo_message msg)
+{
+	uint64_t count = 0;
+	double min = 0, max = 0, avg = 0;
+
+	stats.get_stats (count, min, max, avg);
+
+	lo_message reply = lo_message_new ();
+	lo_message_add_int32 (reply, ssid);
+	if (piid >= 0) {
+		lo_message_add_int32 (reply, piid);
+	}
+	lo_message_add_int64 (reply, count);
+	lo_message_add_float (reply, min);
+	lo_message_add_float (reply, avg);
+	lo_message_add_float (reply, max);
+	lo_message_add_float (reply, stats.percentile (.99));
+
+	lo_send_message (get_address (msg), path, reply);
+
+	lo_message_free (reply);
+}
+
 // select
 
 int
@@ -3067,6 +3192,9 @@ OSC::periodic (void)
 			so->tick();
 		}
 	}
+	for (FeedbackQueues::iterator x = feedback_queues.begin(); x != feedback_queues.end(); ++x) {
+		x->second->flush ();
+	}
 	return true;
 }
 
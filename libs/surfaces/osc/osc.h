@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 #include <bitset>
+#include <map>
 
 #include <sys/time.h>
 #include <pthread.h>
@@ -45,10 +46,12 @@ class OSCControllable;
 class OSCRouteObserver;
 class OSCGlobalObserver;
 class OSCSelectObserver;
+class OSCFeedback;
 
 namespace ARDOUR {
 class Session;
 class Route;
+class DSPStats;
 }
 
 /* this is mostly a placeholder because I suspect that at some
@@ -235,6 +238,7 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	PATH_CALLBACK_MSG(transport_speed);
 	PATH_CALLBACK_MSG(record_enabled);
 	PATH_CALLBACK_MSG(refresh_surface);
+	PATH_CALLBACK_MSG(feedback_stats);
 	PATH_CALLBACK_MSG(bank_up);
 	PATH_CALLBACK_MSG(bank_down);
 
@@ -348,6 +352,8 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	PATH_CALLBACK1_MSG(set_surface_strip_types,i);
 	PATH_CALLBACK1_MSG(set_surface_feedback,i);
 	PATH_CALLBACK1_MSG(set_surface_gainmode,i);
+	PATH_CALLBACK1_MSG(set_surface_feedback_rate,f);
+	PATH_CALLBACK1_MSG(set_surface_feedback_threshold,f);
 	PATH_CALLBACK1_MSG(sel_recenable,i);
 	PATH_CALLBACK1_MSG(sel_recsafe,i);
 	PATH_CALLBACK1_MSG(sel_mute,i);
@@ -373,6 +379,7 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	PATH_CALLBACK1_MSG(sel_eq_enable,f);
 	PATH_CALLBACK1_MSG(sel_eq_hpf,f);
 	PATH_CALLBACK1_MSG(sel_expand,i);
+	PATH_CALLBACK1_MSG(route_dsp_stats,i);
 
 #define PATH_CALLBACK2(name,arg1type,arg2type)			\
         static int _ ## name (const char *path, const char *types, lo_arg **argv, int argc, void *data, void *user_data) { \
@@ -454,6 +461,7 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	PATH_CALLBACK3(route_set_send_enable,i,i,f);
 	PATH_CALLBACK4(route_plugin_parameter,i,i,i,f);
 	PATH_CALLBACK3(route_plugin_parameter_print,i,i,i);
+	PATH_CALLBACK2_MSG(route_plugin_dsp_stats,i,i);
 
 	int route_mute (int rid, int yn, lo_message msg);
 	int route_solo (int rid, int yn, lo_message msg);
@@ -479,6 +487,9 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	int route_set_send_enable (int rid, int sid, float val, lo_message msg);
 	int route_plugin_parameter (int rid, int piid,int par, float val, lo_message msg);
 	int route_plugin_parameter_print (int rid, int piid,int par, lo_message msg);
+	int route_dsp_stats (int ssid, lo_message msg);
+	int route_plugin_dsp_stats (int ssid, int piid, lo_message msg);
+	void send_dsp_stats (const char* path, ARDOUR::DSPStats&, int ssid, int piid, lo_message msg);
 
 	//banking functions
 	int set_bank (uint32_t bank_start, lo_message msg);
@@ -490,6 +501,9 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	int set_surface_strip_types (uint32_t st, lo_message msg);
 	int set_surface_feedback (uint32_t fb, lo_message msg);
 	int set_surface_gainmode (uint32_t gm, lo_message msg);
+	int set_surface_feedback_rate (float hz, lo_message msg);
+	int set_surface_feedback_threshold (float delta, lo_message msg);
+	int feedback_stats (lo_message msg);
 	int refresh_surface (lo_message msg);
 
 	int master_set_gain (float dB);
@@ -561,6 +575,11 @@ class OSC : public ARDOUR::ControlProtocol, public AbstractUI<OSCUIRequest>
 	typedef std::list<OSCGlobalObserver*> GlobalObservers;
 	GlobalObservers global_observers;
 
+	/* per client feedback queues, by URL */
+	typedef std::map<std::string, OSCFeedback*> FeedbackQueues;
+	FeedbackQueues feedback_queues;
+	OSCFeedback& feedback_for (lo_address addr);
+
 	void debugmsg (const char *prefix, const char *path, const char* types, lo_arg **argv, int argc);
 
 	static OSC* _instance;
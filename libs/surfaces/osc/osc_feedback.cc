@@ -0,0 +1,188 @@
+/*
+    Copyright (C) 2017 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include <cmath>
+#include <glib.h>
+
+#include "osc_feedback.h"
+
+using namespace std;
+
+/* keep bundles below the common ethernet MTU, to avoid IP fragmentation */
+static const size_t max_bundle_size = 1400;
+
+OSCFeedback::OSCFeedback (lo_address a)
+	: n_dirty (0)
+	, max_rate (0)
+	, threshold (0)
+	, last_flush (0)
+	, n_messages (0)
+	, n_bundles (0)
+	, n_bytes (0)
+{
+	addr = lo_address_new (lo_address_get_hostname(a) , lo_address_get_port(a));
+}
+
+OSCFeedback::~OSCFeedback ()
+{
+	lo_address_free (addr);
+}
+
+OSCFeedback::Value&
+OSCFeedback::value (string const& path, bool has_id, int32_t id)
+{
+	Value& v (values[Key (path, has_id, id)]);
+	if (!v.dirty) {
+		v.dirty = true;
+		++n_dirty;
+	}
+	return v;
+}
+
+void
+OSCFeedback::queue_float (Key const& key, float val, bool thresholded)
+{
+	if (thresholded && threshold > 0) {
+		Values::iterator i = values.find (key);
+		if (i != values.end() && i->second.sent && i->second.type == 'f' && fabsf (val - i->second.sent_f) < threshold) {
+			/* drop a pending value that is back within the threshold, too */
+			if (i->second.dirty) {
+				i->second.dirty = false;
+				--n_dirty;
+			}
+			return;
+		}
+	}
+	Value& v (value (key.path, key.has_id, key.id));
+	v.type = 'f';
+	v.f = val;
+}
+
+void
+OSCFeedback::queue_float (string const& path, float val, bool thresholded)
+{
+	queue_float (Key (path, false, 0), val, thresholded);
+}
+
+void
+OSCFeedback::queue_float (string const& path, int32_t id, float val, bool thresholded)
+{
+	queue_float (Key (path, true, id), val, thresholded);
+}
+
+void
+OSCFeedback::queue_int (string const& path, int32_t val)
+{
+	Value& v (value (path, false, 0));
+	v.type = 'i';
+	v.i = val;
+}
+
+void
+OSCFeedback::queue_int (string const& path, int32_t id, int32_t val)
+{
+	Value& v (value (path, true, id));
+	v.type = 'i';
+	v.i = val;
+}
+
+void
+OSCFeedback::queue_string (string const& path, string const& val)
+{
+	Value& v (value (path, false, 0));
+	v.type = 's';
+	v.s = val;
+}
+
+void
+OSCFeedback::queue_string (string const& path, int32_t id, string const& val)
+{
+	Value& v (value (path, true, id));
+	v.type = 's';
+	v.s = val;
+}
+
+void
+OSCFeedback::flush (bool force)
+{
+	if (n_dirty == 0) {
+		return;
+	}
+
+	const int64_t now = g_get_monotonic_time ();
+	if (!force && max_rate > 0 && (now - last_flush) < 1e6 / max_rate) {
+		return;
+	}
+	last_flush = now;
+
+	lo_bundle bundle = 0;
+	size_t bundle_size = 0;
+
+	for (Values::iterator i = values.begin(); i != values.end() && n_dirty > 0; ++i) {
+		Value& v (i->second);
+		if (!v.dirty) {
+			continue;
+		}
+
+		lo_message msg = lo_message_new ();
+		if (i->first.has_id) {
+			lo_message_add_int32 (msg, i->first.id);
+		}
+		switch (v.type) {
+			case 'i':
+				lo_message_add_int32 (msg, v.i);
+				break;
+			case 's':
+				lo_message_add_string (msg, v.s.c_str());
+				break;
+			default:
+				lo_message_add_float (msg, v.f);
+				v.sent_f = v.f;
+				v.sent = true;
+				break;
+		}
+		v.dirty = false;
+		--n_dirty;
+
+		const size_t len = lo_message_length (msg, i->first.path.c_str());
+
+		if (bundle && bundle_size + len > max_bundle_size) {
+			lo_send_bundle (addr, bundle);
+			lo_bundle_free_messages (bundle);
+			bundle = 0;
+		}
+		if (!bundle) {
+			bundle = lo_bundle_new (LO_TT_IMMEDIATE);
+			bundle_size = 16; // "#bundle\0" + timetag
+			n_bytes += bundle_size;
+			++n_bundles;
+		}
+
+		/* the path remains valid until the bundle is sent (it's the map key) */
+		lo_bundle_add_message (bundle, i->first.path.c_str(), msg);
+		bundle_size += len + 4; // element size
+		n_bytes += len + 4;
+		++n_messages;
+	}
+
+	if (bundle) {
+		lo_send_bundle (addr, bundle);
+		lo_bundle_free_messages (bundle);
+	}
+}
@@ -0,0 +1,117 @@
+/*
+    Copyright (C) 2017 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __osc_oscfeedback_h__
+#define __osc_oscfeedback_h__
+
+#include <map>
+#include <string>
+#include <stdint.h>
+#include <lo/lo.h>
+
+/** Feedback output queue for a single OSC client.
+ *
+ * Observers queue values instead of sending messages directly. A queued
+ * value replaces any pending value for the same path (and strip id).
+ * flush() sends all pending values as OSC bundles, at most max_rate
+ * times per second.
+ *
+ * Continuous values (meters) can be queued with a delta threshold: they
+ * are only sent if they differ from the previously sent value by more
+ * than the threshold.
+ */
+class OSCFeedback
+{
+  public:
+	OSCFeedback (lo_address addr);
+	~OSCFeedback ();
+
+	lo_address address () const { return addr; }
+
+	/* without strip id (id part of the path, or global) */
+	void queue_float (std::string const& path, float val, bool thresholded = false);
+	void queue_int (std::string const& path, int32_t val);
+	void queue_string (std::string const& path, std::string const& val);
+
+	/* with strip id as first argument */
+	void queue_float (std::string const& path, int32_t id, float val, bool thresholded = false);
+	void queue_int (std::string const& path, int32_t id, int32_t val);
+	void queue_string (std::string const& path, int32_t id, std::string const& val);
+
+	/** send pending values, if due
+	 * @param force ignore the rate limit
+	 */
+	void flush (bool force = false);
+
+	/** max bundles per second, 0: no limit (flush on every call) */
+	void set_max_rate (float hz) { max_rate = hz; }
+	float get_max_rate () const { return max_rate; }
+
+	/** minimum change of thresholded values */
+	void set_threshold (float t) { threshold = t; }
+	float get_threshold () const { return threshold; }
+
+	uint64_t messages_sent () const { return n_messages; }
+	uint64_t bundles_sent () const { return n_bundles; }
+	uint64_t bytes_sent () const { return n_bytes; }
+	void reset_stats () { n_messages = n_bundles = n_bytes = 0; }
+
+  private:
+	struct Key {
+		Key (std::string const& p, bool h, int32_t i) : path (p), has_id (h), id (i) {}
+		std::string path;
+		bool has_id;
+		int32_t id;
+		bool operator< (Key const& other) const {
+			if (id != other.id) { return id < other.id; }
+			if (has_id != other.has_id) { return has_id < other.has_id; }
+			return path < other.path;
+		}
+	};
+
+	struct Value {
+		Value () : type ('f'), f (0), i (0), dirty (false), sent (false), sent_f (0) {}
+		char type;
+		float f;
+		int32_t i;
+		std::string s;
+		bool dirty;
+		bool sent;     // sent_f is valid
+		float sent_f;  // last sent float, for thresholding
+	};
+
+	typedef std::map<Key, Value> Values;
+
+	Value& value (std::string const& path, bool has_id, int32_t id);
+	void queue_float (Key const&, float, bool);
+
+	lo_address addr;
+	Values values;
+	uint32_t n_dirty;
+
+	float max_rate;
+	float threshold;
+	int64_t last_flush;
+
+	uint64_t n_messages;
+	uint64_t n_bundles;
+	uint64_t n_bytes;
+};
+
+#endif /* __osc_oscfeedback_h__ */
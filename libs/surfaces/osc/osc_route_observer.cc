@@ -27,6 +27,7 @@
 
 #include "osc.h"
 #include "osc_route_observer.h"
+#include "osc_feedback.h"
 
 #include "pbd/i18n.h"
 
@@ -35,8 +36,9 @@ using namespace PBD;
 using namespace ARDOUR;
 using namespace ArdourSurface;
 
-OSCRouteObserver::OSCRouteObserver (boost::shared_ptr<Stripable> s, lo_address a, uint32_t ss, uint32_t gm, std::bitset<32> fb)
+OSCRouteObserver::OSCRouteObserver (boost::shared_ptr<Stripable> s, lo_address a, OSCFeedback& q, uint32_t ss, uint32_t gm, std::bitset<32> fb)
 	: _strip (s)
+	,queue (q)
 	,ssid (ss)
 	,gainmode (gm)
 	,feedback (fb)
@@ -152,45 +154,23 @@ OSCRouteObserver::tick ()
 		}
 		if (now_meter < -120) now_meter = -193;
 		if (_last_meter != now_meter) {
-			if (feedback[7] || feedback[8]) {
-				string path = "/strip/meter";
-				lo_message msg = lo_message_new ();
-				if (feedback[2]) {
-					path = set_path (path);
-				} else {
-					lo_message_add_int32 (msg, ssid);
-				}
-				if (gainmode && feedback[7]) {
-					lo_message_add_float (msg, ((now_meter + 94) / 100));
-					lo_send_message (addr, path.c_str(), msg);
-				} else if ((!gainmode) && feedback[7]) {
-					lo_message_add_float (msg, now_meter);
-					lo_send_message (addr, path.c_str(), msg);
-				} else if (feedback[8]) {
-					uint32_t ledlvl = (uint32_t)(((now_meter + 54) / 3.75)-1);
-					uint16_t ledbits = ~(0xfff<<ledlvl);
-					lo_message_add_int32 (msg, ledbits);
-					lo_send_message (addr, path.c_str(), msg);
-				}
-				lo_message_free (msg);
+			if (gainmode && feedback[7]) {
+				queue_float ("/strip/meter", (now_meter + 94) / 100, true);
+			} else if ((!gainmode) && feedback[7]) {
+				queue_float ("/strip/meter", now_meter, true);
+			} else if (feedback[8]) {
+				uint32_t ledlvl = (uint32_t)(((now_meter + 54) / 3.75)-1);
+				uint16_t ledbits = ~(0xfff<<ledlvl);
+				queue_int ("/strip/meter", ledbits);
 			}
 			if (feedback[9]) {
-				string path = "/strip/signal";
-				lo_message msg = lo_message_new ();
-				if (feedback[2]) {
-					path = set_path (path);
-				} else {
-					lo_message_add_int32 (msg, ssid);
-				}
 				float signal;
 				if (now_meter < -40) {
 					signal = 0;
 				} else {
 					signal = 1;
 				}
-				lo_message_add_float (msg, signal);
-				lo_send_message (addr, path.c_str(), msg);
-				lo_message_free (msg);
+				queue_float ("/strip/signal", signal, true);
 			}
 		}
 		_last_meter = now_meter;
@@ -229,34 +209,18 @@ OSCRouteObserver::name_changed (const PBD::PropertyChange& what_changed)
 void
 OSCRouteObserver::send_change_message (string path, boost::shared_ptr<Controllable> controllable)
 {
-	lo_message msg = lo_message_new ();
-
-	if (feedback[2]) {
-		path = set_path (path);
-	} else {
-		lo_message_add_int32 (msg, ssid);
-	}
 	float val = controllable->get_value();
-	lo_message_add_float (msg, (float) controllable->internal_to_interface (val));
-
-	lo_send_message (addr, path.c_str(), msg);
-	lo_message_free (msg);
+	queue_float (path, (float) controllable->internal_to_interface (val));
 }
 
 void
 OSCRouteObserver::text_with_id (string path, uint32_t id, string name)
 {
-	lo_message msg = lo_message_new ();
 	if (feedback[2]) {
-		path = set_path (path);
+		queue.queue_string (set_path (path), name);
 	} else {
-		lo_message_add_int32 (msg, id);
+		queue.queue_string (path, id, name);
 	}
-
-	lo_message_add_string (msg, name.c_str());
-
-	lo_send_message (addr, path.c_str(), msg);
-	lo_message_free (msg);
 }
 
 void
@@ -278,27 +242,8 @@ OSCRouteObserver::send_monitor_status (boost::shared_ptr<Controllable> controlla
 			input = 0;
 	}
 
-	lo_message msg = lo_message_new ();
-	string path = "/strip/monitor_input";
-	if (feedback[2]) {
-		path = set_path (path);
-	} else {
-		lo_message_add_int32 (msg, ssid);
-	}
-	lo_message_add_int32 (msg, (float) input);
-	lo_send_message (addr, path.c_str(), msg);
-	lo_message_free (msg);
-
-	msg = lo_message_new ();
-	path = "/strip/monitor_disk";
-	if (feedback[2]) {
-		path = set_path (path);
-	} else {
-		lo_message_add_int32 (msg, ssid);
-	}
-	lo_message_add_int32 (msg, (float) disk);
-	lo_send_message (addr, path.c_str(), msg);
-	lo_message_free (msg);
+	queue_int ("/strip/monitor_input", input);
+	queue_int ("/strip/monitor_disk", disk);
 
 }
 
@@ -310,45 +255,23 @@ OSCRouteObserver::send_trim_message (string path, boost::shared_ptr<Controllable
 		trim_timeout = 8;
 	}
 
-	lo_message msg = lo_message_new ();
-
-	if (feedback[2]) {
-		path = set_path (path);
-	} else {
-		lo_message_add_int32 (msg, ssid);
-	}
-
-	lo_message_add_float (msg, (float) accurate_coefficient_to_dB (controllable->get_value()));
-
-	lo_send_message (addr, path.c_str(), msg);
-	lo_message_free (msg);
+	queue_float (path, (float) accurate_coefficient_to_dB (controllable->get_value()));
 }
 
 void
 OSCRouteObserver::send_gain_message (string path, boost::shared_ptr<Controllable> controllable)
 {
-	lo_message msg = lo_message_new ();
-
-	if (feedback[2]) {
-		path = set_path (path);
-	} else {
-		lo_message_add_int32 (msg, ssid);
-	}
-
 	if (gainmode) {
-		lo_message_add_float (msg, gain_to_slider_position (controllable->get_value()));
+		queue_float (path, gain_to_slider_position (controllable->get_value()));
 		text_with_id ("/strip/name", ssid, string_compose ("%1%2%3", std::fixed, std::setprecision(2), accurate_coefficient_to_dB (controllable->get_value())));
 		gain_timeout = 8;
 	} else {
 		if (controllable->get_value() < 1e-15) {
-			lo_message_add_float (msg, -200);
+			queue_float (path, -200);
 		} else {
-			lo_message_add_float (msg, accurate_coefficient_to_dB (controllable->get_value()));
+			queue_float (path, accurate_coefficient_to_dB (controllable->get_value()));
 		}
 	}
-
-	lo_send_message (addr, path.c_str(), msg);
-	lo_message_free (msg);
 }
 
 string
@@ -363,17 +286,27 @@ OSCRouteObserver::set_path (string path)
 void
 OSCRouteObserver::clear_strip (string path, float val)
 {
-	lo_message msg = lo_message_new ();
+	queue_float (path, val);
+}
+
+void
+OSCRouteObserver::queue_float (string path, float val, bool thresholded)
+{
 	if (feedback[2]) {
-		path = set_path (path);
+		queue.queue_float (set_path (path), val, thresholded);
 	} else {
-		lo_message_add_int32 (msg, ssid);
+		queue.queue_float (path, ssid, val, thresholded);
 	}
-	lo_message_add_float (msg, val);
-
-	lo_send_message (addr, path.c_str(), msg);
-	lo_message_free (msg);
+}
 
+void
+OSCRouteObserver::queue_int (string path, int32_t val)
+{
+	if (feedback[2]) {
+		queue.queue_int (set_path (path), val);
+	} else {
+		queue.queue_int (path, ssid, val);
+	}
 }
 
 void
@@ -381,17 +314,7 @@ OSCRouteObserver::send_select_status (const PropertyChange& what)
 {
 	if (what == PropertyChange(ARDOUR::Properties::selected)) {
 		if (_strip) {
-			string path = "/strip/select";
-
-			lo_message msg = lo_message_new ();
-			if (feedback[2]) {
-				path = set_path (path);
-			} else {
-				lo_message_add_int32 (msg, ssid);
-			}
-			lo_message_add_float (msg, _strip->is_selected());
-			lo_send_message (addr, path.c_str(), msg);
-			lo_message_free (msg);
+			queue_float ("/strip/select", _strip->is_selected());
 		}
 	}
 }
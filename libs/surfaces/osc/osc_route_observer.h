@@ -30,11 +30,13 @@
 #include "pbd/stateful.h"
 #include "ardour/types.h"
 
+class OSCFeedback;
+
 class OSCRouteObserver
 {
 
   public:
-	OSCRouteObserver (boost::shared_ptr<ARDOUR::Stripable>, lo_address addr, uint32_t sid, uint32_t gainmode, std::bitset<32> feedback);
+	OSCRouteObserver (boost::shared_ptr<ARDOUR::Stripable>, lo_address addr, OSCFeedback& queue, uint32_t sid, uint32_t gainmode, std::bitset<32> feedback);
 	~OSCRouteObserver ();
 
 	boost::shared_ptr<ARDOUR::Stripable> strip () const { return _strip; }
@@ -48,6 +50,7 @@ class OSCRouteObserver
 	PBD::ScopedConnectionList strip_connections;
 
 	lo_address addr;
+	OSCFeedback& queue;
 	std::string path;
 	uint32_t ssid;
 	uint32_t gainmode;
@@ -65,6 +68,8 @@ class OSCRouteObserver
 	void send_trim_message (std::string path, boost::shared_ptr<PBD::Controllable> controllable);
 	std::string set_path (std::string path);
 	void clear_strip (std::string path, float val);
+	void queue_float (std::string path, float val, bool thresholded = false);
+	void queue_int (std::string path, int32_t val);
 };
 
 #endif /* __osc_oscrouteobserver_h__ */
@@ -24,6 +24,11 @@
 
 #include "TruePeak.h"
 
+#if defined(__SSE__) || defined(USE_XMMINTRIN)
+#include <xmmintrin.h>
+#define TRUEPEAK_SSE
+#endif
+
 namespace TruePeakMeter {
 
 static double sinc (double x)
@@ -68,11 +73,21 @@ Resampler_table::Resampler_table (double fr, unsigned int hl, unsigned int np)
 		}
 		p += hl;
 	}
+
+	_rtab = new float [hl * (np + 1)];
+	for (j = 0; j <= np; j++)
+	{
+		for (i = 0; i < hl; i++)
+		{
+			_rtab [j * hl + i] = _ctab [j * hl + hl - i - 1];
+		}
+	}
 }
 
 Resampler_table::~Resampler_table (void)
 {
 	delete[] _ctab;
+	delete[] _rtab;
 }
 
 Resampler_table *
@@ -153,10 +168,68 @@ gcd (unsigned int a, unsigned int b)
 	return 1;
 }
 
+#ifdef TRUEPEAK_SSE
+/* Mono interpolation, the same sum as in Resampler::process() but
+ * vectorized over the filter taps. q2 and c2 run forwards here, c2
+ * being a row of the reversed table.
+ */
+static float
+interpolate_sse (float const *q1, float const *c1, float const *q2, float const *c2, unsigned int hl)
+{
+	__m128 s = _mm_setzero_ps ();
+	unsigned int i = 0;
+
+	for (; i + 4 <= hl; i += 4)
+	{
+		s = _mm_add_ps (s, _mm_mul_ps (_mm_loadu_ps (q1 + i), _mm_loadu_ps (c1 + i)));
+		s = _mm_add_ps (s, _mm_mul_ps (_mm_loadu_ps (q2 + i), _mm_loadu_ps (c2 + i)));
+	}
+
+	float v[4];
+	_mm_storeu_ps (v, s);
+	float r = 1e-20f + ((v[0] + v[1]) + (v[2] + v[3]));
+
+	for (; i < hl; i++)
+	{
+		r += q1 [i] * c1 [i] + q2 [i] * c2 [i];
+	}
+	return r - 1e-20f;
+}
+
+static float
+peak_sse (float const *b, int n)
+{
+	const __m128 sign = _mm_set1_ps (-0.f);
+	__m128 m = _mm_setzero_ps ();
+	int i = 0;
+
+	for (; i + 4 <= n; i += 4)
+	{
+		/* NaN is ignored, the same as in the scalar loop */
+		m = _mm_max_ps (_mm_andnot_ps (sign, _mm_loadu_ps (b + i)), m);
+	}
+
+	float v[4];
+	_mm_storeu_ps (v, m);
+	float x = 0;
+	for (int k = 0; k < 4; k++)
+	{
+		if (v[k] > x) x = v[k];
+	}
+	for (; i < n; i++)
+	{
+		const float a = fabsf (b [i]);
+		if (a > x) x = a;
+	}
+	return x;
+}
+#endif
+
 Resampler::Resampler (void)
 	: _table (0)
 	, _nchan (0)
 	, _buff  (0)
+	, _simd  (true)
 {
 	reset ();
 }
@@ -317,6 +390,13 @@ Resampler::process (void)
 				{
 					float *c1 = _table->_ctab + hl * ph;
 					float *c2 = _table->_ctab + hl * (np - ph);
+#ifdef TRUEPEAK_SSE
+					if (_simd && _nchan == 1)
+					{
+						*out_data++ = interpolate_sse (p1, c1, p2 - hl, _table->_rtab + hl * (np - ph), hl);
+					}
+					else
+#endif
 					for (c = 0; c < _nchan; c++)
 					{
 						float *q1 = p1 + c;
@@ -369,6 +449,7 @@ TruePeakdsp::TruePeakdsp (void)
 	, _p (0)
 	, _res (true)
 	, _buf (NULL)
+	, _simd (true)
 {
 }
 
@@ -389,6 +470,12 @@ TruePeakdsp::process (float const *d, int n)
 	float x = 0;
 	float v;
 	float *b = _buf;
+#ifdef TRUEPEAK_SSE
+	if (_simd) {
+		x = peak_sse (_buf, n * 4);
+		n = 0;
+	}
+#endif
 	while (n--) {
 		v = fabsf(*b++);
 		if (v > x) x = v;
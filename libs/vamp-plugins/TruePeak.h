@@ -53,6 +53,7 @@ private:
 	Resampler_table     *_next;
 	unsigned int         _refc;
 	float               *_ctab;
+	float               *_rtab; // _ctab with each row reversed
 	double               _fr;
 	unsigned int         _hl;
 	unsigned int         _np;
@@ -90,6 +91,9 @@ public:
 	double inpdist (void) const;
 	int    process (void);
 
+	/* interpolate using SIMD instructions, if available (mono only) */
+	void   use_simd (bool yn) { _simd = yn; }
+
 	unsigned int         inp_count;
 	unsigned int         out_count;
 	float const         *inp_data;
@@ -108,6 +112,7 @@ private:
 	unsigned int         _phase;
 	unsigned int         _pstep;
 	float               *_buff;
+	bool                 _simd;
 	void                *_dummy [8];
 };
 
@@ -125,6 +130,9 @@ public:
 
 	bool init (float fsamp);
 
+	/* use SIMD instructions if available, enabled by default */
+	void use_simd (bool yn) { _simd = yn; _src.use_simd (yn); }
+
 private:
 
 	float      _m;
@@ -132,6 +140,7 @@ private:
 	bool       _res;
 	bool       _res_peak;
 	float     *_buf;
+	bool       _simd;
 	Resampler  _src;
 };
 
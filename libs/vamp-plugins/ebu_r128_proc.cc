@@ -24,6 +24,11 @@
 #include <math.h>
 #include "ebu_r128_proc.h"
 
+#if defined(__SSE__) || defined(USE_XMMINTRIN)
+#include <xmmintrin.h>
+#define EBU_R128_SSE
+#endif
+
 #ifdef COMPILER_MSVC
 #include <float.h>
 // C99 'isfinite()' is not available in MSVC.
@@ -161,7 +166,9 @@ void Ebu_r128_hist::calc_range (float *v0, float *v1, float *th)
 
 
 
-Ebu_r128_proc::Ebu_r128_proc (void)
+Ebu_r128_proc::Ebu_r128_proc (void) :
+    _simd (true),
+    _nchan (0)
 {
     reset ();
 }
@@ -317,6 +324,18 @@ float Ebu_r128_proc::detect_process (int nfram)
     Ebu_r128_fst *S;
 
     si = 0;
+#ifdef EBU_R128_SSE
+    if (_simd && _nchan > 1)
+    {
+	// Four channels at a time, each one in its own lane. The
+	// operations per channel are the same as below, and so is
+	// the order in which the channels are summed.
+	float sv [MAXCH + 3];
+	for (i = 0; i < _nchan; i += 4) detect_process_sse (i, nfram, sv + i);
+	for (i = 0; i < _nchan; i++) si += _chan_gain [i] * sv [i];
+	return si;
+    }
+#endif
     for (i = 0, S = _fst; i < _nchan; i++, S++)
     {
 	z1 = S->_z1;
@@ -345,4 +364,78 @@ float Ebu_r128_proc::detect_process (int nfram)
     return si;
 }
 
+
+void Ebu_r128_proc::detect_process_sse (int chan, int nfram, float *sj)
+{
+#ifdef EBU_R128_SSE
+    int   i, j, n;
+    float const *p [4];
+    float z [4][4];
+    float s [4];
+    __m128 x, y, z1, z2, z3, z4, sv;
+
+    n = _nchan - chan;
+    if (n > 4) n = 4;
+
+    // Unused lanes process a copy of the first channel.
+    for (i = 0; i < 4; i++)
+    {
+	Ebu_r128_fst *S = _fst + chan + (i < n ? i : 0);
+	p [i] = _ipp [chan + (i < n ? i : 0)];
+	z [0][i] = S->_z1;
+	z [1][i] = S->_z2;
+	z [2][i] = S->_z3;
+	z [3][i] = S->_z4;
+    }
+
+    const __m128 a0 = _mm_set1_ps (_a0);
+    const __m128 a1 = _mm_set1_ps (_a1);
+    const __m128 a2 = _mm_set1_ps (_a2);
+    const __m128 b1 = _mm_set1_ps (_b1);
+    const __m128 b2 = _mm_set1_ps (_b2);
+    const __m128 c3 = _mm_set1_ps (_c3);
+    const __m128 c4 = _mm_set1_ps (_c4);
+    const __m128 dn = _mm_set1_ps (1e-15f);
+
+    z1 = _mm_loadu_ps (z [0]);
+    z2 = _mm_loadu_ps (z [1]);
+    z3 = _mm_loadu_ps (z [2]);
+    z4 = _mm_loadu_ps (z [3]);
+    sv = _mm_setzero_ps ();
+
+    for (j = 0; j < nfram; j++)
+    {
+	x = _mm_set_ps (p [3][j], p [2][j], p [1][j], p [0][j]);
+	x = _mm_sub_ps (x, _mm_mul_ps (b1, z1));
+	x = _mm_sub_ps (x, _mm_mul_ps (b2, z2));
+	x = _mm_add_ps (x, dn);
+	y = _mm_add_ps (_mm_mul_ps (a0, x), _mm_mul_ps (a1, z1));
+	y = _mm_add_ps (y, _mm_mul_ps (a2, z2));
+	y = _mm_sub_ps (y, _mm_mul_ps (c3, z3));
+	y = _mm_sub_ps (y, _mm_mul_ps (c4, z4));
+	z2 = z1;
+	z1 = x;
+	z4 = _mm_add_ps (z4, z3);
+	z3 = _mm_add_ps (z3, y);
+	sv = _mm_add_ps (sv, _mm_mul_ps (y, y));
+    }
+
+    _mm_storeu_ps (z [0], z1);
+    _mm_storeu_ps (z [1], z2);
+    _mm_storeu_ps (z [2], z3);
+    _mm_storeu_ps (z [3], z4);
+    _mm_storeu_ps (s, sv);
+
+    for (i = 0; i < n; i++)
+    {
+	Ebu_r128_fst *S = _fst + chan + i;
+	S->_z1 = !isfinite_local(z [0][i]) ? 0 : z [0][i];
+	S->_z2 = !isfinite_local(z [1][i]) ? 0 : z [1][i];
+	S->_z3 = !isfinite_local(z [2][i]) ? 0 : z [2][i];
+	S->_z4 = !isfinite_local(z [3][i]) ? 0 : z [3][i];
+	sj [i] = s [i];
+    }
+#endif
+}
+
 };
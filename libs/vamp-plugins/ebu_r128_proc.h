@@ -77,6 +77,10 @@ public:
     void  integr_pause (void) { _integr = false; }
     void  integr_start (void) { _integr = true; }
 
+    // Filter several channels at once using SIMD instructions,
+    // if available. Enabled by default.
+    void  use_simd (bool yn) { _simd = yn; }
+
     float loudness_M (void) const { return _loudness_M; }
     float maxloudn_M (void) const { return _maxloudn_M; }
     float loudness_S (void) const { return _loudness_S; }
@@ -98,8 +102,10 @@ private:
     void  detect_init (float fsamp);
     void  detect_reset (void);
     float detect_process (int nfram);
+    void  detect_process_sse (int chan, int nfram, float *sj);
 
     bool              _integr;       // Integration on/off.
+    bool              _simd;         // Use SIMD filter if available.
     int               _nchan;        // Number of channels, 2 or 5.
     float             _fsamp;        // Sample rate.
     int               _fragm;        // Fragmenst size, 1/20 second.
@@ -0,0 +1,92 @@
+#include <math.h>
+#include <stdint.h>
+#include <vector>
+
+#include "ebu_r128_proc.h"
+#include "TruePeak.h"
+
+#include "SimdTest.hpp"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SimdTest);
+
+/* Compare the SIMD implementations of loudness and true-peak measurement
+ * with the scalar ones, using the same noisy, partly sinusoidal signal.
+ */
+
+static void
+fill_signal (std::vector<float>& buf, uint32_t& seed, double phase, double freq, float rate)
+{
+	for (size_t i = 0; i < buf.size (); ++i) {
+		seed = seed * 1664525u + 1013904223u;
+		const float noise = (seed >> 8) / (float) (1 << 24) - .5f;
+		buf[i] = .3f * noise + .6f * sin (2 * M_PI * freq * (phase + i) / rate);
+	}
+}
+
+static const float rate = 48000;
+static const int block_size = 1024;
+static const int n_blocks = 480; // 10 seconds
+
+void
+SimdTest::loudness_test ()
+{
+	for (int nchan = 1; nchan <= MAXCH; ++nchan) {
+		Fons::Ebu_r128_proc scalar;
+		Fons::Ebu_r128_proc simd;
+		scalar.use_simd (false);
+		simd.use_simd (true);
+		scalar.init (nchan, rate);
+		simd.init (nchan, rate);
+		scalar.integr_start ();
+		simd.integr_start ();
+
+		std::vector<std::vector<float> > bufs (nchan, std::vector<float> (block_size));
+		float const* data[MAXCH];
+		uint32_t seed = 1;
+
+		for (int b = 0; b < n_blocks; ++b) {
+			for (int c = 0; c < nchan; ++c) {
+				fill_signal (bufs[c], seed, b * block_size, 440. * (c + 1), rate);
+				data[c] = &bufs[c][0];
+			}
+			scalar.process (block_size, data);
+			simd.process (block_size, data);
+
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (scalar.loudness_M (), simd.loudness_M (), 1e-4);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (scalar.loudness_S (), simd.loudness_S (), 1e-4);
+		}
+
+		CPPUNIT_ASSERT (scalar.integrated () > -200);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (scalar.integrated (), simd.integrated (), 1e-4);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (scalar.range_min (), simd.range_min (), 1e-4);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (scalar.range_max (), simd.range_max (), 1e-4);
+	}
+}
+
+void
+SimdTest::true_peak_test ()
+{
+	TruePeakMeter::TruePeakdsp scalar;
+	TruePeakMeter::TruePeakdsp simd;
+	scalar.use_simd (false);
+	simd.use_simd (true);
+	CPPUNIT_ASSERT (scalar.init (rate));
+	CPPUNIT_ASSERT (simd.init (rate));
+
+	std::vector<float> buf (block_size);
+	uint32_t seed = 1;
+
+	for (int b = 0; b < n_blocks; ++b) {
+		fill_signal (buf, seed, b * block_size, 997., rate);
+		scalar.process (&buf[0], block_size);
+		simd.process (&buf[0], block_size);
+
+		float m_scalar, p_scalar, m_simd, p_simd;
+		scalar.read (m_scalar, p_scalar);
+		simd.read (m_simd, p_simd);
+
+		CPPUNIT_ASSERT (m_scalar > .5f);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (m_scalar, m_simd, 1e-5 * m_scalar);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (p_scalar, p_simd, 1e-5 * p_scalar);
+	}
+}
@@ -0,0 +1,14 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class SimdTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE(SimdTest);
+	CPPUNIT_TEST(loudness_test);
+	CPPUNIT_TEST(true_peak_test);
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void loudness_test ();
+	void true_peak_test ();
+};